@@ -17,16 +17,80 @@
 #include "scenarios/scenario4/scenario4-api.h"
 #include "scenarios/scenario4/scenario4-config.h"
 #include "scenarios/scenario4/scenario4-params.h"
+#include "../model/routing/scenario4/ground-node-routing/cell-cooperation.h"
+#include "../model/routing/scenario4/ground-node-routing/confidence-fusion.h"
 #include "../model/routing/scenario4/ground-node-routing/ground-node-routing.h"
 #include "../model/routing/scenario4/base-station-node/fragment-generator.h"
 #include "../model/routing/scenario4/node-routing.h"
+#include "../model/routing/scenario4/event-log.h"
+#include "../model/async-trace-sink.h"
 
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
+#include <vector>
+
+#include <sys/resource.h>
 
 namespace
 {
+/**
+ * Peak resident set size of this process in KiB (0 if unavailable).
+ */
+uint64_t
+GetPeakRssKb()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024; // bytes on macOS
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss); // KiB on Linux
+#endif
+}
+
+/**
+ * What-if sweep: nodes reaching each alert threshold under every built-in
+ * fusion policy, recomputed from the observations of this run.
+ */
+void
+WriteConfidenceSweep(std::ostream& out, double alertThreshold)
+{
+    using namespace ns3::wsn::scenario4::routing;
+
+    std::vector<double> thresholds = {0.25, 0.5, alertThreshold, 0.9};
+    std::sort(thresholds.begin(), thresholds.end());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+
+    const ConfidenceFusionEngine& fusion = GetGroundConfidenceFusion();
+    out << "\n[CONFIDENCE]\n";
+    out << "policy=" << fusion.GetPolicy().GetName() << "\n";
+    out << "thresholds=";
+    for (size_t i = 0; i < thresholds.size(); ++i)
+    {
+        out << (i > 0 ? "," : "") << thresholds[i];
+    }
+    out << "\n";
+
+    for (ConfidenceFusionType type : {ConfidenceFusionType::SUM,
+                                      ConfidenceFusionType::NOISY_OR,
+                                      ConfidenceFusionType::LOG_ODDS,
+                                      ConfidenceFusionType::RSSI_WEIGHTED})
+    {
+        const auto policy = CreateConfidenceFusionPolicy(type);
+        const std::vector<uint32_t> counts = fusion.CountNodesAtOrAbove(*policy, thresholds);
+        out << policy->GetName() << "=";
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            out << (i > 0 ? "," : "") << counts[i];
+        }
+        out << "\n";
+    }
+}
+
 void
 WriteScenario4Summary(const std::string& outputPath, const ns3::wsn::scenario4::Scenario4RunConfig& config)
 {
@@ -57,6 +121,8 @@ WriteScenario4Summary(const std::string& outputPath, const ns3::wsn::scenario4::
     out << "cooperationThreshold=" << config.cooperationThreshold << "\n";
     out << "alertThreshold=" << config.alertThreshold << "\n";
     out << "suspiciousPercent=" << config.suspiciousPercent << "\n";
+    out << "uav2KmeansK=" << config.uav2KmeansK << "\n";
+    out << "uav2KmeansTolerance=" << config.uav2KmeansTolerance << "\n";
 
     out << "\n[PARAMS]\n";
     out << "cellRadius=" << ns3::wsn::scenario4::params::HEX_CELL_RADIUS << "\n";
@@ -72,7 +138,7 @@ WriteScenario4Summary(const std::string& outputPath, const ns3::wsn::scenario4::
     out << "groundNodes=" << states.size() << "\n";
     out << "suspiciousNodes=" << suspiciousNodes.size() << "\n";
     out << "uavPaths=" << ns3::wsn::scenario4::routing::GetUavFlightPaths().size() << "\n";
-    out << "generatedFragments=" << ns3::wsn::scenario4::routing::GetBsGeneratedFragments().fragments.size() << "\n";
+    out << "generatedFragments=" << ns3::wsn::scenario4::routing::GetBsGeneratedFragments().GetCount() << "\n";
 
     out << "\n[MISSION]\n";
     if (ns3::wsn::scenario4::routing::IsUav1MissionCompleted())
@@ -91,6 +157,34 @@ WriteScenario4Summary(const std::string& outputPath, const ns3::wsn::scenario4::
     {
         out << "uav2CompletedTime=not-completed\n";
     }
+
+    WriteConfidenceSweep(out, config.alertThreshold);
+
+    out << "\n[RESOURCES]\n";
+    out << "peakRssKb=" << GetPeakRssKb() << "\n";
+    out << "fragmentPayloadBytes="
+        << ns3::wsn::scenario4::routing::GetBsFragmentPayloadPool().GetTotalBytes() << "\n";
+
+    const auto& coop = ns3::wsn::scenario4::routing::GetCooperationStats();
+    const uint32_t endedSessions = coop.sessionsCompleted + coop.sessionsPartial;
+    out << "\n[COOPERATION]\n";
+    out << "packetized=" << (ns3::wsn::scenario4::params::COOPERATION_PACKETIZED ? 1 : 0) << "\n";
+    out << "sessionsStarted=" << coop.sessionsStarted << "\n";
+    out << "sessionsCompleted=" << coop.sessionsCompleted << "\n";
+    out << "sessionsPartial=" << coop.sessionsPartial << "\n";
+    out << "sessionsUnroutable=" << coop.sessionsUnroutable << "\n";
+    out << "queryFrames=" << coop.queryFrames << "\n";
+    out << "reportFrames=" << coop.reportFrames << "\n";
+    out << "pullFrames=" << coop.pullFrames << "\n";
+    out << "dataFrames=" << coop.dataFrames << "\n";
+    out << "unroutableFrames=" << coop.unroutableFrames << "\n";
+    out << "bytesOnAir=" << coop.bytesOnAir << "\n";
+    out << "airtimeSec=" << coop.airtimeSec << "\n";
+    out << "fragmentsDelivered=" << coop.fragmentsDelivered << "\n";
+    out << "pullRetries=" << coop.pullRetries << "\n";
+    out << "avgLatencySec="
+        << (endedSessions > 0 ? coop.totalLatencySec / endedSessions : 0.0) << "\n";
+    out << "maxLatencySec=" << coop.maxLatencySec << "\n";
 }
 } // namespace
 
@@ -99,6 +193,111 @@ using namespace ns3::wsn::scenario4;
 
 NS_LOG_COMPONENT_DEFINE("Example4");
 
+/**
+ * Event output of one run, selected by config.resultLog:
+ *  - summary: nothing besides the summary sections
+ *  - text:    events in <base>.txt ahead of the summary (<base>_events.txt.gz
+ *             when compressed)
+ *  - binary:  columnar event log <base>.evt (<base>.evt.gz when compressed)
+ * The summary itself is always appended to <base>.txt.
+ */
+class ResultLogOutput
+{
+public:
+    bool Open(const Scenario4RunConfig& config, const std::string& basePath);
+    void Close();
+
+private:
+    std::string m_eventPath;
+    std::ofstream m_textStream;
+    ns3::wsn::AsyncTraceSink m_asyncStream;
+};
+
+bool
+ResultLogOutput::Open(const Scenario4RunConfig& config, const std::string& basePath)
+{
+    using ns3::wsn::AsyncTraceSink;
+
+    const std::string summaryPath = basePath + ".txt";
+    const bool compress = config.compressResults && AsyncTraceSink::IsGzipAvailable();
+    const AsyncTraceSink::Compression compression =
+        compress ? AsyncTraceSink::Compression::GZIP : AsyncTraceSink::Compression::NONE;
+    params::g_resultFileStream = nullptr;
+
+    if (config.resultLog == "binary")
+    {
+        m_eventPath = basePath + (compress ? ".evt.gz" : ".evt");
+        routing::EventLog& eventLog = routing::GetResultEventLog();
+        if (!eventLog.Open(m_eventPath,
+                           params::RESULT_LOG_BLOCK_RECORDS,
+                           params::RESULT_LOG_ASYNC_BUFFER_BYTES,
+                           compression))
+        {
+            return false;
+        }
+        params::g_resultFileStream = &eventLog.GetTextStream();
+    }
+    else if (config.resultLog == "text" && (compress || params::RESULT_LOG_ASYNC_BUFFER_BYTES > 0))
+    {
+        m_eventPath = compress ? basePath + "_events.txt.gz" : summaryPath;
+        if (!m_asyncStream.Open(m_eventPath,
+                                params::RESULT_LOG_ASYNC_BUFFER_BYTES,
+                                params::RESULT_LOG_ASYNC_DROP ? AsyncTraceSink::OverflowPolicy::DROP
+                                                              : AsyncTraceSink::OverflowPolicy::BLOCK,
+                                false,
+                                compression))
+        {
+            return false;
+        }
+        params::g_resultFileStream = &m_asyncStream.GetStream();
+    }
+    else if (config.resultLog == "text")
+    {
+        m_eventPath = summaryPath;
+        m_textStream.open(summaryPath, std::ios::out | std::ios::trunc);
+        if (!m_textStream.is_open())
+        {
+            return false;
+        }
+        params::g_resultFileStream = &m_textStream;
+    }
+
+    // Start the summary file empty unless the text log already owns it
+    if (m_eventPath != summaryPath)
+    {
+        std::ofstream truncate(summaryPath, std::ios::out | std::ios::trunc);
+    }
+    return true;
+}
+
+void
+ResultLogOutput::Close()
+{
+    params::g_resultFileStream = nullptr;
+
+    routing::EventLog& eventLog = routing::GetResultEventLog();
+    if (eventLog.IsOpen())
+    {
+        eventLog.Close();
+        NS_LOG_INFO("Event log: " << eventLog.GetRecordCount() << " records, "
+                    << eventLog.GetBytesWritten() << " bytes -> " << m_eventPath);
+    }
+    if (m_asyncStream.IsOpen())
+    {
+        m_asyncStream.Close();
+        if (m_asyncStream.GetDroppedRecords() > 0)
+        {
+            NS_LOG_WARN("Result log dropped " << m_asyncStream.GetDroppedRecords() << " records");
+        }
+        NS_LOG_INFO("Event log: " << m_asyncStream.GetBytesQueued() << " bytes ("
+                    << m_asyncStream.GetBytesWritten() << " written) -> " << m_eventPath);
+    }
+    if (m_textStream.is_open())
+    {
+        m_textStream.close();
+    }
+}
+
 int main(int argc, char* argv[])
 {
     // ===== Default Configuration =====
@@ -124,8 +323,12 @@ int main(int argc, char* argv[])
     cmd.AddValue("cooperationThreshold", "Cooperation threshold (0,1)", config.cooperationThreshold);
     cmd.AddValue("alertThreshold", "Alert threshold (0,1)", config.alertThreshold);
     cmd.AddValue("suspiciousPercent", "Suspicious coverage percent (0,1)", config.suspiciousPercent);
+    cmd.AddValue("uav2KmeansK", "UAV2 centroid count (0 = auto)", config.uav2KmeansK);
+    cmd.AddValue("uav2KmeansTolerance", "UAV2 k-means convergence tolerance (meters)", config.uav2KmeansTolerance);
     cmd.AddValue("seed", "Random seed for reproducibility", config.seed);
     cmd.AddValue("runId", "Run ID for multiple simulation runs", config.runId);
+    cmd.AddValue("resultLog", "Result output: summary, text or binary", config.resultLog);
+    cmd.AddValue("compressResults", "gzip the event log (zlib builds)", config.compressResults);
     cmd.Parse(argc, argv);
     
     // ===== Logging =====
@@ -139,18 +342,18 @@ int main(int argc, char* argv[])
         return 1;
     }
     
-    std::ostringstream resultFilename;
-    resultFilename << "/Users/mophan/Github/ns-3-dev-git-ns-3.46/src/wsn/examples/visualize/results/scenario4_result_"
-                   << config.seed << "_" << config.runId << ".txt";
+    std::ostringstream resultBasePath;
+    resultBasePath << "/Users/mophan/Github/ns-3-dev-git-ns-3.46/src/wsn/examples/visualize/results/scenario4_result_"
+                   << config.seed << "_" << config.runId;
+    const std::string resultFilename = resultBasePath.str() + ".txt";
 
-    std::ofstream resultStream(resultFilename.str(), std::ios::out | std::ios::trunc);
-    if (!resultStream.is_open())
+    ResultLogOutput resultLog;
+    if (!resultLog.Open(config, resultBasePath.str()))
     {
-        NS_LOG_ERROR("Failed to open result log file: " << resultFilename.str());
+        NS_LOG_ERROR("Failed to open result log file: " << resultBasePath.str());
         return 1;
     }
-    ns3::wsn::scenario4::params::g_resultFileStream = &resultStream;
-    
+
     // ===== Run Scenario =====
     NS_LOG_INFO("=== Scenario 4 Starting ===");
     NS_LOG_INFO("Grid: " << config.gridSize << "x" << config.gridSize 
@@ -170,13 +373,11 @@ int main(int argc, char* argv[])
     runner.Run();
 
     // Close event log stream before writing summary section.
-    resultStream.flush();
-    ns3::wsn::scenario4::params::g_resultFileStream = nullptr;
-    resultStream.close();
+    resultLog.Close();
     
     NS_LOG_INFO("=== Scenario 4 Complete ===");
     
-    WriteScenario4Summary(resultFilename.str(), config);
+    WriteScenario4Summary(resultFilename, config);
     NS_LOG_INFO("UAV1 completion time: "
                 << (ns3::wsn::scenario4::routing::IsUav1MissionCompleted()
                         ? std::to_string(ns3::wsn::scenario4::routing::GetUav1MissionCompletedTime()) + "s"
@@ -185,7 +386,7 @@ int main(int argc, char* argv[])
                 << (ns3::wsn::scenario4::routing::IsUav2MissionCompleted()
                         ? std::to_string(ns3::wsn::scenario4::routing::GetUav2MissionCompletedTime()) + "s"
                         : std::string("not-completed")));
-    NS_LOG_INFO("Results saved to: " << resultFilename.str());
+    NS_LOG_INFO("Results saved to: " << resultFilename);
     
     Simulator::Destroy();
     return 0;
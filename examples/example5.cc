@@ -13,20 +13,115 @@
 #include "scenarios/scenario5/scenario5-api.h"
 #include "scenarios/scenario5/scenario5-config.h"
 #include "scenarios/scenario5/scenario5-params.h"
+#include "scenarios/scenario5/scenario5-visualizer.h"
+#include "../model/routing/scenario5/ground-node-routing/confidence-fusion.h"
 #include "../model/routing/scenario5/ground-node-routing/ground-node-routing.h"
 #include "../model/routing/scenario5/base-station-node/fragment-generator.h"
 #include "../model/routing/scenario5/node-routing.h"
+#include "../model/routing/scenario5/event-log.h"
+#include "../model/routing/scenario5/base-station-node/base-station-node.h"
+#include "../model/routing/scenario5/helper/calc-utils.h"
+#include "../model/async-trace-sink.h"
+#include "../model/wsn-log.h"
+#include "../model/wsn-metrics.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
 
 namespace
 {
+/**
+ * Peak resident set size of this process in KiB (0 if unavailable).
+ */
+uint64_t
+GetPeakRssKb()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024; // bytes on macOS
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss); // KiB on Linux
+#endif
+}
+
+/**
+ * What-if sweep: nodes reaching each alert threshold under every built-in
+ * fusion policy, recomputed from the observations of this run.
+ */
+struct ConfidenceSweep
+{
+    std::string policy; ///< Policy used during the run
+    std::vector<double> thresholds;
+    std::vector<std::pair<std::string, std::vector<uint32_t>>> nodesAtOrAbove; ///< Per policy
+};
+
+ConfidenceSweep
+ComputeConfidenceSweep(double alertThreshold)
+{
+    using namespace ns3::wsn::scenario5::routing;
+
+    ConfidenceSweep sweep;
+    sweep.thresholds = {0.25, 0.5, alertThreshold, 0.9};
+    std::sort(sweep.thresholds.begin(), sweep.thresholds.end());
+    sweep.thresholds.erase(std::unique(sweep.thresholds.begin(), sweep.thresholds.end()),
+                           sweep.thresholds.end());
+
+    const ConfidenceFusionEngine& fusion = GetGroundConfidenceFusion();
+    sweep.policy = fusion.GetPolicy().GetName();
+    for (ConfidenceFusionType type : {ConfidenceFusionType::SUM,
+                                      ConfidenceFusionType::NOISY_OR,
+                                      ConfidenceFusionType::LOG_ODDS,
+                                      ConfidenceFusionType::RSSI_WEIGHTED})
+    {
+        const auto policy = CreateConfidenceFusionPolicy(type);
+        sweep.nodesAtOrAbove.emplace_back(policy->GetName(),
+                                          fusion.CountNodesAtOrAbove(*policy, sweep.thresholds));
+    }
+    return sweep;
+}
+
+void
+WriteConfidenceSweep(std::ostream& out, const ConfidenceSweep& sweep)
+{
+    out << "\n[CONFIDENCE]\n";
+    out << "policy=" << sweep.policy << "\n";
+    out << "thresholds=";
+    for (size_t i = 0; i < sweep.thresholds.size(); ++i)
+    {
+        out << (i > 0 ? "," : "") << sweep.thresholds[i];
+    }
+    out << "\n";
+
+    for (const auto& [name, counts] : sweep.nodesAtOrAbove)
+    {
+        out << name << "=";
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            out << (i > 0 ? "," : "") << counts[i];
+        }
+        out << "\n";
+    }
+}
+
 void
 WriteScenario5Summary(const std::string& outputPath, const ns3::wsn::scenario5::Scenario5RunConfig& config)
 {
-    std::ofstream out(outputPath, std::ios::out | std::ios::trunc);
+    // Appended: in text mode the event log owns the head of the file
+    std::ofstream out(outputPath, std::ios::out | std::ios::app);
     if (!out.is_open())
     {
         return;
@@ -67,7 +162,7 @@ WriteScenario5Summary(const std::string& outputPath, const ns3::wsn::scenario5::
     out << "groundNodes=" << states.size() << "\n";
     out << "suspiciousNodes=" << suspiciousNodes.size() << "\n";
     out << "uavPaths=" << ns3::wsn::scenario5::routing::GetUavFlightPaths().size() << "\n";
-    out << "generatedFragments=" << ns3::wsn::scenario5::routing::GetBsGeneratedFragments().fragments.size() << "\n";
+    out << "generatedFragments=" << ns3::wsn::scenario5::routing::GetBsGeneratedFragments().GetCount() << "\n";
 
     out << "\n[MISSION]\n";
     if (ns3::wsn::scenario5::routing::IsUav1MissionCompleted())
@@ -86,6 +181,394 @@ WriteScenario5Summary(const std::string& outputPath, const ns3::wsn::scenario5::
     {
         out << "uav2CompletedTime=not-completed\n";
     }
+
+    out << "\n[CODING]\n";
+    const auto& coded = ns3::wsn::scenario5::routing::GetBsCodedFragments();
+    out << "enabled=" << (coded.IsBuilt() ? 1 : 0) << "\n";
+    out << "broadcastLossProbability=" << ns3::wsn::scenario5::params::UAV_BROADCAST_LOSS_PROBABILITY << "\n";
+    if (coded.IsBuilt())
+    {
+        uint64_t symbolsReceived = 0;
+        uint64_t fragmentsDecoded = 0;
+        uint32_t nodesDecoded = 0;
+        for (const auto& [nodeId, state] : states)
+        {
+            symbolsReceived += state.codedSymbolsReceived;
+            fragmentsDecoded += state.fragmentsDecoded;
+            nodesDecoded += (state.fragmentsDecoded > 0) ? 1 : 0;
+        }
+        out << "k=" << coded.GetSourceCount() << "\n";
+        out << "n=" << coded.GetSymbolCount() << "\n";
+        out << "symbolBytes=" << coded.GetBlockSize() << "\n";
+        out << "paritySymbolsReceived=" << symbolsReceived << "\n";
+        out << "fragmentsDecoded=" << fragmentsDecoded << "\n";
+        out << "nodesDecoded=" << nodesDecoded << "\n";
+        out << "decodes=" << coded.GetDecodeCount() << "\n";
+        out << "decodeCacheHits=" << coded.GetDecodeCacheHits() << "\n";
+    }
+
+    WriteConfidenceSweep(out, ComputeConfidenceSweep(config.alertThreshold));
+
+    out << "\n[RESOURCES]\n";
+    out << "peakRssKb=" << GetPeakRssKb() << "\n";
+    out << "fragmentPayloadBytes="
+        << ns3::wsn::scenario5::routing::GetBsFragmentPayloadPool().GetTotalBytes() << "\n";
+}
+
+/**
+ * Compact JSON writer for the one-line run record.
+ */
+class JsonWriter
+{
+public:
+    explicit JsonWriter(std::ostream& out)
+        : m_out(out)
+    {
+        m_out << std::setprecision(10);
+    }
+
+    void BeginObject(const char* key = nullptr)
+    {
+        Key(key);
+        m_out << '{';
+        m_first.push_back(true);
+    }
+
+    void EndObject()
+    {
+        m_out << '}';
+        m_first.pop_back();
+    }
+
+    void BeginArray(const char* key = nullptr)
+    {
+        Key(key);
+        m_out << '[';
+        m_first.push_back(true);
+    }
+
+    void EndArray()
+    {
+        m_out << ']';
+        m_first.pop_back();
+    }
+
+    void Field(const char* key, const std::string& value)
+    {
+        Key(key);
+        String(value);
+    }
+
+    void Field(const char* key, const char* value)
+    {
+        Field(key, std::string(value));
+    }
+
+    void Field(const char* key, bool value)
+    {
+        Key(key);
+        m_out << (value ? "true" : "false");
+    }
+
+    void Field(const char* key, double value)
+    {
+        Key(key);
+        if (std::isfinite(value))
+        {
+            m_out << value;
+        }
+        else
+        {
+            m_out << "null";
+        }
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    void Field(const char* key, T value)
+    {
+        Key(key);
+        m_out << +value;
+    }
+
+    /**
+     * Write a number, or null when the value is unset (e.g. a mission
+     * that did not complete).
+     */
+    void OptionalField(const char* key, bool isSet, double value)
+    {
+        if (isSet)
+        {
+            Field(key, value);
+        }
+        else
+        {
+            Key(key);
+            m_out << "null";
+        }
+    }
+
+    /**
+     * Write an already serialized JSON value.
+     */
+    void RawField(const char* key, const std::string& json)
+    {
+        Key(key);
+        m_out << json;
+    }
+
+private:
+    void Key(const char* key)
+    {
+        if (!m_first.empty())
+        {
+            if (!m_first.back())
+            {
+                m_out << ',';
+            }
+            m_first.back() = false;
+        }
+        if (key)
+        {
+            String(key);
+            m_out << ':';
+        }
+    }
+
+    void String(const std::string& text)
+    {
+        m_out << '"';
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                m_out << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                m_out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                      << static_cast<int>(c) << std::dec << std::setfill(' ');
+            }
+            else
+            {
+                m_out << c;
+            }
+        }
+        m_out << '"';
+    }
+
+    std::ostream& m_out;
+    std::vector<bool> m_first; ///< Per open container: no member written yet
+};
+
+/**
+ * Append the run as one JSON object (one line) to a JSON-lines file, so
+ * a batch of runs can be aggregated in a single streaming pass. Carries
+ * everything of the text summary plus per-UAV mission metrics, topology
+ * statistics, BS init step timings and the metrics registry.
+ */
+void
+WriteScenario5JsonSummary(const std::string& outputPath,
+                          const ns3::wsn::scenario5::Scenario5RunConfig& config,
+                          double wallClockSec)
+{
+    namespace params = ns3::wsn::scenario5::params;
+    namespace routing = ns3::wsn::scenario5::routing;
+
+    const auto& states = routing::g_groundNetworkPerNode;
+
+    std::ostringstream record;
+    JsonWriter json(record);
+    json.BeginObject();
+    json.Field("scenario", "scenario5");
+    json.Field("seed", config.seed);
+    json.Field("runId", config.runId);
+    json.Field("wallClockSec", wallClockSec);
+
+    json.BeginObject("config");
+    json.Field("gridSize", config.gridSize);
+    json.Field("gridSpacing", config.gridSpacing);
+    json.Field("simTime", config.simTime);
+    json.Field("startupPhaseDuration", config.startupPhaseDuration);
+    json.Field("fragmentBroadcastInterval", config.fragmentBroadcastInterval);
+    json.Field("numFragments", config.numFragments);
+    json.Field("numUavs", config.numUavs);
+    json.BeginArray("bsPosition");
+    json.Field(nullptr, config.bsPositionX);
+    json.Field(nullptr, config.bsPositionY);
+    json.Field(nullptr, config.bsPositionZ);
+    json.EndArray();
+    json.Field("uavAltitude", config.uavAltitude);
+    json.Field("uavSpeed", config.uavSpeed);
+    json.Field("cooperationThreshold", config.cooperationThreshold);
+    json.Field("alertThreshold", config.alertThreshold);
+    json.Field("suspiciousPercent", config.suspiciousPercent);
+    json.Field("resultLog", config.resultLog);
+    json.Field("replay", config.replay);
+    json.Field("snapshots", config.snapshots);
+    json.Field("snapshotIntervalMs", config.snapshotIntervalMs);
+    json.Field("traceSampleReceived", config.traceSampleReceived);
+    json.Field("traceSampleShared", config.traceSampleShared);
+    json.Field("traceSampleCoded", config.traceSampleCoded);
+    json.Field("traceSampleBroadcast", config.traceSampleBroadcast);
+    json.Field("traceNodes", config.traceNodes);
+    json.Field("traceStart", config.traceStart);
+    json.Field("traceStop", config.traceStop);
+    json.EndObject();
+
+    json.BeginObject("params");
+    json.Field("cellRadius", params::HEX_CELL_RADIUS);
+    json.Field("neighborDiscoveryRadius", params::NEIGHBOR_DISCOVERY_RADIUS);
+    json.Field("broadcastRadius", params::UAV_BROADCAST_RADIUS);
+    json.Field("uav1Speed", params::UAV1_SPEED);
+    json.Field("uav1HoverTime", params::UAV1_HOVER_TIME);
+    json.Field("uav2Speed", params::UAV2_SPEED);
+    json.Field("uav2HoverTime", params::UAV2_HOVER_TIME);
+    json.Field("masterFileConfidence", params::DEFAULT_MASTER_FILE_CONFIDENCE);
+    json.EndObject();
+
+    json.BeginObject("network");
+    json.Field("groundNodes", states.size());
+    json.Field("suspiciousNodes", routing::GetSuspiciousNodes().size());
+    json.Field("uavPaths", routing::GetUavFlightPaths().size());
+    json.Field("generatedFragments", routing::GetBsGeneratedFragments().GetCount());
+    json.EndObject();
+
+    // Topology built by BS init
+    uint32_t cellLeaders = 0;
+    uint64_t neighborEntries = 0;
+    for (const auto& [nodeId, state] : states)
+    {
+        cellLeaders += state.isCellLeader ? 1 : 0;
+        neighborEntries += state.neighbors.size();
+    }
+    uint64_t gatewayEntries = 0;
+    for (const auto& [cellId, neighbors] : params::g_cellGatewayPairs)
+    {
+        gatewayEntries += neighbors.size();
+    }
+    json.BeginObject("topology");
+    json.Field("cells", cellLeaders);
+    json.Field("neighborLinks", neighborEntries / 2);
+    json.Field("avgNeighbors",
+               states.empty() ? 0.0 : static_cast<double>(neighborEntries) / states.size());
+    json.Field("gatewayPairs", gatewayEntries / 2);
+    json.Field("routingEntries", params::g_intraCellRoutingTree.size());
+    json.EndObject();
+
+    json.BeginObject("mission");
+    json.OptionalField("uav1CompletedTime",
+                       routing::IsUav1MissionCompleted(),
+                       routing::GetUav1MissionCompletedTime());
+    json.OptionalField("uav2CompletedTime",
+                       routing::IsUav2MissionCompleted(),
+                       routing::GetUav2MissionCompletedTime());
+    json.BeginArray("uavs");
+    const auto& missionStats = routing::GetUavMissionStats();
+    for (const auto& [uavNodeId, path] : routing::GetUavFlightPaths())
+    {
+        double plannedDistance = 0.0;
+        for (size_t i = 1; i < path.waypoints.size(); ++i)
+        {
+            plannedDistance += ns3::wsn::scenario5::helper::CalculateDistance(
+                path.waypoints[i - 1].position.x, path.waypoints[i - 1].position.y,
+                path.waypoints[i].position.x, path.waypoints[i].position.y);
+        }
+        const auto statsIt = missionStats.find(uavNodeId);
+        const routing::UavMissionStats stats =
+            (statsIt != missionStats.end()) ? statsIt->second : routing::UavMissionStats{};
+
+        json.BeginObject();
+        json.Field("nodeId", uavNodeId);
+        json.Field("role",
+                   path.role == routing::UavMissionRole::NODE_VISIT ? "node-visit" : "area-coverage");
+        json.Field("plannedWaypoints", path.waypoints.size());
+        json.Field("plannedTime", path.totalTime);
+        json.Field("plannedDistance", plannedDistance);
+        json.Field("waypointsReached", stats.waypointsReached);
+        json.Field("distanceFlown", stats.distanceFlown);
+        json.OptionalField("lastWaypointTime", stats.lastWaypointTime >= 0.0, stats.lastWaypointTime);
+        json.Field("broadcasts", stats.broadcasts);
+        json.EndObject();
+    }
+    json.EndArray();
+    json.EndObject();
+
+    double bsInitTotal = 0.0;
+    json.BeginObject("bsInitSec");
+    for (const auto& phase : routing::GetBsInitPhaseTimings())
+    {
+        json.Field(phase.name.c_str(), phase.wallSeconds);
+        bsInitTotal += phase.wallSeconds;
+    }
+    json.Field("total", bsInitTotal);
+    json.EndObject();
+
+    const auto& coded = routing::GetBsCodedFragments();
+    json.BeginObject("coding");
+    json.Field("enabled", coded.IsBuilt());
+    json.Field("broadcastLossProbability", params::UAV_BROADCAST_LOSS_PROBABILITY);
+    if (coded.IsBuilt())
+    {
+        uint64_t symbolsReceived = 0;
+        uint64_t fragmentsDecoded = 0;
+        uint32_t nodesDecoded = 0;
+        for (const auto& [nodeId, state] : states)
+        {
+            symbolsReceived += state.codedSymbolsReceived;
+            fragmentsDecoded += state.fragmentsDecoded;
+            nodesDecoded += (state.fragmentsDecoded > 0) ? 1 : 0;
+        }
+        json.Field("k", coded.GetSourceCount());
+        json.Field("n", coded.GetSymbolCount());
+        json.Field("symbolBytes", coded.GetBlockSize());
+        json.Field("paritySymbolsReceived", symbolsReceived);
+        json.Field("fragmentsDecoded", fragmentsDecoded);
+        json.Field("nodesDecoded", nodesDecoded);
+        json.Field("decodes", coded.GetDecodeCount());
+        json.Field("decodeCacheHits", coded.GetDecodeCacheHits());
+    }
+    json.EndObject();
+
+    const ConfidenceSweep sweep = ComputeConfidenceSweep(config.alertThreshold);
+    json.BeginObject("confidence");
+    json.Field("policy", sweep.policy);
+    json.BeginArray("thresholds");
+    for (double threshold : sweep.thresholds)
+    {
+        json.Field(nullptr, threshold);
+    }
+    json.EndArray();
+    json.BeginObject("nodesAtOrAbove");
+    for (const auto& [name, counts] : sweep.nodesAtOrAbove)
+    {
+        json.BeginArray(name.c_str());
+        for (uint32_t count : counts)
+        {
+            json.Field(nullptr, count);
+        }
+        json.EndArray();
+    }
+    json.EndObject();
+    json.EndObject();
+
+    json.BeginObject("resources");
+    json.Field("peakRssKb", GetPeakRssKb());
+    json.Field("fragmentPayloadBytes", routing::GetBsFragmentPayloadPool().GetTotalBytes());
+    json.EndObject();
+
+    std::ostringstream metrics;
+    ns3::wsn::MetricsRegistry::Get().WriteJson(metrics);
+    json.RawField("metrics", metrics.str());
+    json.EndObject();
+    record << '\n';
+
+    // One write per record keeps lines whole when runs share the file
+    std::ofstream out(outputPath, std::ios::out | std::ios::app);
+    if (out.is_open())
+    {
+        const std::string line = record.str();
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
 }
 } // namespace
 
@@ -94,6 +577,111 @@ using namespace ns3::wsn::scenario5;
 
 NS_LOG_COMPONENT_DEFINE("Example5");
 
+/**
+ * Event output of one run, selected by config.resultLog:
+ *  - summary: nothing besides the summary sections
+ *  - text:    events in <base>.txt ahead of the summary (<base>_events.txt.gz
+ *             when compressed)
+ *  - binary:  columnar event log <base>.evt (<base>.evt.gz when compressed)
+ * The summary itself is always appended to <base>.txt.
+ */
+class ResultLogOutput
+{
+public:
+    bool Open(const Scenario5RunConfig& config, const std::string& basePath);
+    void Close();
+
+private:
+    std::string m_eventPath;
+    std::ofstream m_textStream;
+    ns3::wsn::AsyncTraceSink m_asyncStream;
+};
+
+bool
+ResultLogOutput::Open(const Scenario5RunConfig& config, const std::string& basePath)
+{
+    using ns3::wsn::AsyncTraceSink;
+
+    const std::string summaryPath = basePath + ".txt";
+    const bool compress = config.compressResults && AsyncTraceSink::IsGzipAvailable();
+    const AsyncTraceSink::Compression compression =
+        compress ? AsyncTraceSink::Compression::GZIP : AsyncTraceSink::Compression::NONE;
+    params::g_resultFileStream = nullptr;
+
+    if (config.resultLog == "binary")
+    {
+        m_eventPath = basePath + (compress ? ".evt.gz" : ".evt");
+        routing::EventLog& eventLog = routing::GetResultEventLog();
+        if (!eventLog.Open(m_eventPath,
+                           params::RESULT_LOG_BLOCK_RECORDS,
+                           params::RESULT_LOG_ASYNC_BUFFER_BYTES,
+                           compression))
+        {
+            return false;
+        }
+        params::g_resultFileStream = &eventLog.GetTextStream();
+    }
+    else if (config.resultLog == "text" && (compress || params::RESULT_LOG_ASYNC_BUFFER_BYTES > 0))
+    {
+        m_eventPath = compress ? basePath + "_events.txt.gz" : summaryPath;
+        if (!m_asyncStream.Open(m_eventPath,
+                                params::RESULT_LOG_ASYNC_BUFFER_BYTES,
+                                params::RESULT_LOG_ASYNC_DROP ? AsyncTraceSink::OverflowPolicy::DROP
+                                                              : AsyncTraceSink::OverflowPolicy::BLOCK,
+                                false,
+                                compression))
+        {
+            return false;
+        }
+        params::g_resultFileStream = &m_asyncStream.GetStream();
+    }
+    else if (config.resultLog == "text")
+    {
+        m_eventPath = summaryPath;
+        m_textStream.open(summaryPath, std::ios::out | std::ios::trunc);
+        if (!m_textStream.is_open())
+        {
+            return false;
+        }
+        params::g_resultFileStream = &m_textStream;
+    }
+
+    // Start the summary file empty unless the text log already owns it
+    if (m_eventPath != summaryPath)
+    {
+        std::ofstream truncate(summaryPath, std::ios::out | std::ios::trunc);
+    }
+    return true;
+}
+
+void
+ResultLogOutput::Close()
+{
+    params::g_resultFileStream = nullptr;
+
+    routing::EventLog& eventLog = routing::GetResultEventLog();
+    if (eventLog.IsOpen())
+    {
+        eventLog.Close();
+        NS_LOG_INFO("Event log: " << eventLog.GetRecordCount() << " records, "
+                    << eventLog.GetBytesWritten() << " bytes -> " << m_eventPath);
+    }
+    if (m_asyncStream.IsOpen())
+    {
+        m_asyncStream.Close();
+        if (m_asyncStream.GetDroppedRecords() > 0)
+        {
+            NS_LOG_WARN("Result log dropped " << m_asyncStream.GetDroppedRecords() << " records");
+        }
+        NS_LOG_INFO("Event log: " << m_asyncStream.GetBytesQueued() << " bytes ("
+                    << m_asyncStream.GetBytesWritten() << " written) -> " << m_eventPath);
+    }
+    if (m_textStream.is_open())
+    {
+        m_textStream.close();
+    }
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -122,6 +710,23 @@ main(int argc, char* argv[])
     cmd.AddValue("suspiciousPercent", "Suspicious coverage percent (0,1)", config.suspiciousPercent);
     cmd.AddValue("seed", "Random seed for reproducibility", config.seed);
     cmd.AddValue("runId", "Run ID for multiple simulation runs", config.runId);
+    cmd.AddValue("resultLog", "Result output: summary, text or binary", config.resultLog);
+    cmd.AddValue("compressResults", "gzip the event log (zlib builds)", config.compressResults);
+    cmd.AddValue("outputDir", "Directory of the result files", config.outputDir);
+    cmd.AddValue("jsonSummary", "Append a JSON run record to <outputDir>/scenario5_summary.jsonl", config.jsonSummary);
+    cmd.AddValue("replay", "Write the binary replay <base>.rpl", config.replay);
+    cmd.AddValue("replaySeekMs", "Replay seek index interval (ms)", config.replaySeekMs);
+    cmd.AddValue("snapshots", "Write network state snapshots <base>.snap", config.snapshots);
+    cmd.AddValue("snapshotIntervalMs", "Snapshot sampling interval (ms)", config.snapshotIntervalMs);
+    cmd.AddValue("traceSampleReceived", "Fraction of fragment-received tokens logged [0,1]", config.traceSampleReceived);
+    cmd.AddValue("traceSampleShared", "Fraction of fragment-shared tokens logged [0,1]", config.traceSampleShared);
+    cmd.AddValue("traceSampleCoded", "Fraction of coded-symbol tokens logged [0,1]", config.traceSampleCoded);
+    cmd.AddValue("traceSampleBroadcast", "Fraction of UAV broadcast events logged [0,1]", config.traceSampleBroadcast);
+    cmd.AddValue("traceNodes", "Token node filter: all, suspicious or a comma-separated ID list", config.traceNodes);
+    cmd.AddValue("traceStart", "Start of the token trace window (s)", config.traceStart);
+    cmd.AddValue("traceStop", "End of the token trace window (s, -1 = end of run)", config.traceStop);
+    std::string hotLog = "all";
+    cmd.AddValue("hotLog", "Per-packet log categories: all, none or a list of rx, broadcast, mac", hotLog);
     cmd.Parse(argc, argv);
 
     // ===== Logging =====
@@ -135,11 +740,31 @@ main(int argc, char* argv[])
         NS_LOG_ERROR("Configuration validation failed: " << errorMsg);
         return 1;
     }
+    if (!ns3::wsn::SetHotLogCategories(hotLog))
+    {
+        NS_LOG_ERROR("Unknown hot-path log category list: " << hotLog);
+        return 1;
+    }
 
-    std::ostringstream resultFilename;
-    resultFilename << "/Users/mophan/Github/ns-3-dev-git-ns-3.46/src/wsn/examples/visualize/results/scenario5_result_"
-                   << config.seed << "_" << config.runId << ".txt";
-    ns3::wsn::scenario5::params::g_resultFileStream = nullptr;
+    std::error_code dirError;
+    std::filesystem::create_directories(config.outputDir, dirError);
+    if (dirError)
+    {
+        NS_LOG_ERROR("Cannot create output directory " << config.outputDir << ": " << dirError.message());
+        return 1;
+    }
+
+    std::ostringstream resultBasePath;
+    resultBasePath << config.outputDir << "/scenario5_result_" << config.seed << "_" << config.runId;
+    const std::string resultFilename = resultBasePath.str() + ".txt";
+    const std::string jsonSummaryFilename = config.outputDir + "/scenario5_summary.jsonl";
+
+    ResultLogOutput resultLog;
+    if (!resultLog.Open(config, resultBasePath.str()))
+    {
+        NS_LOG_ERROR("Failed to open result log file: " << resultBasePath.str());
+        return 1;
+    }
 
     // ===== Run Scenario =====
     NS_LOG_INFO("=== Scenario 5 Starting ===");
@@ -152,15 +777,42 @@ main(int argc, char* argv[])
     NS_LOG_INFO("Params: cellRadius=" << ns3::wsn::scenario5::params::HEX_CELL_RADIUS
                 << ", neighborRadius=" << ns3::wsn::scenario5::params::NEIGHBOR_DISCOVERY_RADIUS
                 << ", broadcastRadius=" << ns3::wsn::scenario5::params::UAV_BROADCAST_RADIUS);
+    NS_LOG_INFO("Hot-path logs: level=" << ns3::wsn::GetHotLogLevelName()
+                << ", categories=" << ns3::wsn::GetHotLogCategories());
 
+    const auto wallClockStart = std::chrono::steady_clock::now();
     Scenario5Runner runner(config);
     runner.Build();
+    // Both need the built topology; on failure still tear down what is open
+    const bool outputsOpen =
+        (!config.replay || OpenScenario5Replay(resultBasePath.str() + ".rpl", config.replaySeekMs)) &&
+        (!config.snapshots || OpenScenario5Snapshots(resultBasePath.str() + ".snap",
+                                                     config.snapshotIntervalMs,
+                                                     params::RESULT_SNAPSHOT_KEYFRAME_INTERVAL));
+    if (!outputsOpen)
+    {
+        CloseScenario5Replay();
+        resultLog.Close();
+        Simulator::Destroy();
+        return 1;
+    }
     runner.Schedule();
     runner.Run();
+    const std::chrono::duration<double> wallClock = std::chrono::steady_clock::now() - wallClockStart;
+    CloseScenario5Replay();
+    CloseScenario5Snapshots();
+
+    // Close event log stream before writing summary section.
+    resultLog.Close();
 
     NS_LOG_INFO("=== Scenario 5 Complete ===");
 
-    WriteScenario5Summary(resultFilename.str(), config);
+    WriteScenario5Summary(resultFilename, config);
+    if (config.jsonSummary)
+    {
+        WriteScenario5JsonSummary(jsonSummaryFilename, config, wallClock.count());
+        NS_LOG_INFO("Run record appended to: " << jsonSummaryFilename);
+    }
     NS_LOG_INFO("UAV1 completion time: "
                 << (ns3::wsn::scenario5::routing::IsUav1MissionCompleted()
                         ? std::to_string(ns3::wsn::scenario5::routing::GetUav1MissionCompletedTime()) + "s"
@@ -169,7 +821,7 @@ main(int argc, char* argv[])
                 << (ns3::wsn::scenario5::routing::IsUav2MissionCompleted()
                         ? std::to_string(ns3::wsn::scenario5::routing::GetUav2MissionCompletedTime()) + "s"
                         : std::string("not-completed")));
-    NS_LOG_INFO("Results saved to: " << resultFilename.str());
+    NS_LOG_INFO("Results saved to: " << resultFilename);
 
     Simulator::Destroy();
     return 0;
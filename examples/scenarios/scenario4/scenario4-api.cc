@@ -17,6 +17,10 @@
 #include "../../../model/radio/cc2420/cc2420-net-device.h"
 #include "../../../model/radio/cc2420/cc2420-phy.h"
 #include "../../../model/propagation/cc2420-spectrum-propagation-loss-model.h"
+#include "../../../model/wsn-metrics.h"
+#include "../../../model/wsn-profiler.h"
+
+#include <iostream>
 
 namespace ns3 {
 
@@ -128,7 +132,13 @@ Scenario4Runner::Build()
 
     InstallProtocolStack();
     
+    // Metric handles persist across runs in one process; counts do not
+    MetricsRegistry::Get().Reset();
+    Profiler::Get().Reset();
+
     // Initialize routing layers
+    params::g_uav2KmeansNumCentroids = m_config.uav2KmeansK;
+    params::g_uav2KmeansTolerance = m_config.uav2KmeansTolerance;
     routing::InitializeGroundNodeRouting(m_groundNodes, m_config.numFragments);
     routing::InitializeBaseStation(m_bsNode->GetId());
 
@@ -300,8 +310,15 @@ Scenario4Runner::Run()
     NS_LOG_FUNCTION(this);
     NS_LOG_INFO("Running simulation...");
     
-    Simulator::Run();
+    {
+        WSN_PROFILE_SCOPE("sim.Run");
+        Simulator::Run();
+    }
     ReportScenario4Metrics();
+    if (Profiler::IsEnabled())
+    {
+        Profiler::Get().WriteTable(std::clog);
+    }
     
     NS_LOG_INFO("Simulation complete");
 }
@@ -102,6 +102,18 @@ Scenario4RunConfig::Validate(std::string& errorMsg) const
         errorMsg = oss.str();
         return false;
     }
+
+    if (uav2KmeansTolerance <= 0.0) {
+        oss << "UAV2 k-means tolerance must be > 0";
+        errorMsg = oss.str();
+        return false;
+    }
+
+    if (resultLog != "summary" && resultLog != "text" && resultLog != "binary") {
+        oss << "Result log must be summary, text or binary";
+        errorMsg = oss.str();
+        return false;
+    }
     
     return true;
 }
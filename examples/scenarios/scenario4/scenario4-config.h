@@ -52,6 +52,14 @@ struct Scenario4RunConfig
     double cooperationThreshold = params::COOPERATION_THRESHOLD;
     double alertThreshold = params::ALERT_THRESHOLD;
     double suspiciousPercent = params::SUSPICIOUS_COVERAGE_PERCENT;
+
+    // Result output ("summary", "text" or "binary")
+    std::string resultLog = params::RESULT_LOG_MODE;
+    bool compressResults = params::RESULT_LOG_COMPRESS;
+
+    // UAV2 centroid candidates
+    uint32_t uav2KmeansK = 0;  // 0 = auto
+    double uav2KmeansTolerance = params::UAV2_KMEANS_TOLERANCE;
     
     /**
      * Validate configuration parameters.
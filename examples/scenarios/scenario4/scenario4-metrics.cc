@@ -1,9 +1,12 @@
 #include "scenario4-metrics.h"
+#include "scenario4-params.h"
 #include "ns3/log.h"
 #include "../../../model/routing/scenario4/ground-node-routing/ground-node-routing.h"
+#include "../../../model/wsn-metrics.h"
 
 #include <algorithm>
 #include <limits>
+#include <sstream>
 
 namespace ns3 {
 
@@ -52,6 +55,26 @@ ReportScenario4Metrics()
     NS_LOG_INFO("Packets per node: avg=" << avgPackets
                 << ", total=" << totalPackets);
     NS_LOG_INFO("Neighbors per node: avg=" << avgNeighbors);
+
+    // Run-level aggregates join the counters and histograms of the routing layers
+    static const Gauge groundNodes("ground.nodes");
+    static const Gauge confidenceAvg("ground.confidence_avg");
+    static const Gauge confidenceMin("ground.confidence_min");
+    static const Gauge confidenceMax("ground.confidence_max");
+    static const Gauge neighborsAvg("ground.neighbors_avg");
+    groundNodes.Set(static_cast<double>(states.size()));
+    confidenceAvg.Set(avgConfidence);
+    confidenceMin.Set(minConfidence);
+    confidenceMax.Set(maxConfidence);
+    neighborsAvg.Set(avgNeighbors);
+
+    std::ostringstream json;
+    MetricsRegistry::Get().WriteJson(json);
+    NS_LOG_INFO("Metrics: " << json.str());
+    if (params::g_resultFileStream)
+    {
+        *params::g_resultFileStream << "\n[METRICS] " << json.str() << "\n";
+    }
 }
 
 } // namespace scenario4
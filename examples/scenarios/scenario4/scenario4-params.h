@@ -57,6 +57,18 @@ constexpr double COOPERATION_THRESHOLD = 0.35;  // trigger cell cooperation
 constexpr double ALERT_THRESHOLD = 0.75;        // trigger alert state
 constexpr double SUSPICIOUS_COVERAGE_PERCENT = 0.30;  // top 30% nodes
 
+// Cell cooperation protocol (availability query -> reports -> pulls -> fragment batches)
+constexpr bool COOPERATION_PACKETIZED = true;      // false = direct in-memory sharing
+constexpr double COOPERATION_REPORT_WINDOW = 0.1;  // seconds - collect availability reports
+constexpr double COOPERATION_PULL_TIMEOUT = 0.2;   // seconds - re-pull fragments still missing
+constexpr uint32_t COOPERATION_MAX_PULL_RETRIES = 2;
+
+// CC2420 / IEEE 802.15.4 framing used for cooperation airtime
+constexpr double CC2420_BITRATE_BPS = 250000.0;
+constexpr uint32_t CC2420_MAX_FRAME_BYTES = 127;    // aMaxPHYPacketSize (MPDU)
+constexpr uint32_t CC2420_MAC_OVERHEAD_BYTES = 13;  // MAC header (11) + FCS (2)
+constexpr uint32_t CC2420_PHY_OVERHEAD_BYTES = 6;   // preamble (4) + SFD (1) + length (1)
+
 // BS init suspicious-region selection parameters
 constexpr double BS_INIT_SUSPICIOUS_TARGET_PERCENT = SUSPICIOUS_COVERAGE_PERCENT;
 constexpr uint32_t BS_INIT_SUSPICIOUS_MAX_ITERATIONS = 100;
@@ -98,6 +110,8 @@ constexpr bool UAV2_USE_NEW_ALGO = true;
 constexpr bool UAV2_USE_CENTROIDS = true;
 constexpr uint32_t UAV2_NUM_CENTROIDS_MAX = 8;
 constexpr uint32_t UAV2_KMEANS_MAX_ITER = 20;
+constexpr double UAV2_KMEANS_TOLERANCE = 1e-3;  // meters - max center shift at convergence
+constexpr bool UAV2_KMEANS_USE_PRUNING = true;  // Hamerly bounds skip unchanged assignments
 constexpr double UAV2_ALPHA = 1.0;
 constexpr double UAV2_SCORE_EPS = 1e-6;
 constexpr bool UAV2_USE_TRAVEL_TIME = true;
@@ -122,12 +136,45 @@ constexpr double DEFAULT_MASTER_FILE_CONFIDENCE = 0.95;
 constexpr double FRAGMENT_WEIGHT_MIN = 0.5;
 constexpr double FRAGMENT_WEIGHT_MAX = 2.0;
 constexpr uint32_t BS_INIT_FRAGMENT_GENERATION_COUNT = DEFAULT_NUM_FRAGMENTS;
+// UAV round-robin order: false = ascending fragment ID, true = highest confidence first
+constexpr bool FRAGMENT_BROADCAST_HIGHEST_CONFIDENCE_FIRST = false;
+
+// Adaptive UAV round broadcast: send the fragment most in-range nodes lack,
+// stop once every node in range holds the full set. Off: UAVs keep the fixed
+// 8-round broadcast.
+constexpr bool UAV_ADAPTIVE_BROADCAST = false;
+constexpr double UAV_ADAPTIVE_BROADCAST_INTERVAL = FRAGMENT_BROADCAST_INTERVAL;  // seconds
+constexpr uint32_t UAV_ADAPTIVE_BROADCAST_MAX_ROUNDS = 64;
+
+// Ground-node protocol timer wheel resolution
+constexpr double GROUND_TIMER_TICK = 0.01;  // seconds
+
+// Node confidence fusion (0 = sum, 1 = noisy-OR, 2 = log-odds, 3 = RSSI-weighted)
+constexpr uint32_t CONFIDENCE_FUSION_POLICY = 0;
+constexpr double CONFIDENCE_FUSION_LOG_ODDS_PRIOR = 0.01;
+constexpr double CONFIDENCE_FUSION_RSSI_FLOOR_DBM = RX_SENSITIVITY_DBM;  // weight 0
+constexpr double CONFIDENCE_FUSION_RSSI_CEILING_DBM = -60.0;  // weight 1
+
+// Result log: "summary" (summary sections only), "text" (events in the .txt)
+// or "binary" (columnar .evt; convert with examples/visualize/event-log-to-text.py)
+constexpr const char* RESULT_LOG_MODE = "binary";
+// gzip the event log on the writer thread (needs a build with WSN_ENABLE_ZLIB)
+constexpr bool RESULT_LOG_COMPRESS = true;
+constexpr uint32_t RESULT_LOG_BLOCK_RECORDS = 65536;  // records per written group
+// Result log written by a background thread (0 bytes = on the simulation thread)
+constexpr uint32_t RESULT_LOG_ASYNC_BUFFER_BYTES = 8 * 1024 * 1024;
+constexpr bool RESULT_LOG_ASYNC_DROP = false;  // text log: drop on overflow instead of blocking
 
 // ===== GLOBAL RESULT FILE STREAM =====
 // Global file stream for logging all scenario4 results to a single file
 // Example4.cc will open/close this stream
 // Other files can write directly: if (g_resultFileStream) *g_resultFileStream << "text";
-extern std::ofstream* g_resultFileStream;
+extern std::ostream* g_resultFileStream;
+
+// ===== RUN-TIME OVERRIDES =====
+// Set by Scenario4Runner from Scenario4RunConfig before the base station is initialized
+extern uint32_t g_uav2KmeansNumCentroids;  // 0 = auto (min(UAV2_NUM_CENTROIDS_MAX, n/4))
+extern double g_uav2KmeansTolerance;
 
 } // namespace params
 } // namespace scenario4
@@ -2,22 +2,32 @@
 """
 Scenario5 Autorun v1
 - Run ~100 rounds of example5 automatically
-- Parse per-round summary file
+- Read each round's JSON record from <output-dir>/scenario5_summary.jsonl
+  (one line per run; the text summary is only a fallback)
 - Keep only one final TXT summary file
 - Delete all intermediate result files after each run to save space
+- Run example5 with --resultLog=summary by default, so no per-event output is written
+- --aggregate FILE.jsonl: recompute the conclusion from existing run records in one
+  streaming pass, without running anything
+- --check-event-log: run one round with --resultLog=text and one with
+  --resultLog=binary, convert the binary log and compare it with the text log
 """
 
 from __future__ import annotations
 
 import argparse
+import json
 import shlex
 import shutil
-import statistics
 import subprocess
+import sys
 import time
 from dataclasses import dataclass
 from pathlib import Path
-from typing import Optional
+from typing import Iterator, Optional
+
+SUMMARY_JSONL_NAME = "scenario5_summary.jsonl"
+EVENT_LOG_CONVERTER = Path(__file__).resolve().parents[3] / "visualize" / "event-log-to-text.py"
 
 
 @dataclass
@@ -87,6 +97,92 @@ def parse_summary_file(summary_path: Path) -> dict:
     return result
 
 
+def iter_summary_records(jsonl_path: Path) -> Iterator[dict]:
+    """Stream the run records of a JSON-lines summary, skipping torn lines."""
+    with jsonl_path.open("r", encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            try:
+                yield json.loads(line)
+            except json.JSONDecodeError:
+                continue
+
+
+def read_new_records(jsonl_path: Path, offset: int) -> tuple[list[dict], int]:
+    """Read the complete records appended after byte offset; return them and the new offset."""
+    if not jsonl_path.exists():
+        return [], offset
+    records = []
+    with jsonl_path.open("rb") as f:
+        f.seek(offset)
+        for raw in f:
+            if not raw.endswith(b"\n"):
+                break  # still being written
+            offset += len(raw)
+            try:
+                records.append(json.loads(raw))
+            except json.JSONDecodeError:
+                continue
+    return records, offset
+
+
+class CompletionAggregate:
+    """Constant-memory aggregate of UAV completion times over many runs."""
+
+    def __init__(self) -> None:
+        self.total_rounds = 0
+        self.ok_rounds = 0
+        self.uav1_count = 0
+        self.uav1_sum = 0.0
+        self.uav2_count = 0
+        self.uav2_sum = 0.0
+        self.uav1_earlier_count = 0
+        self.uav2_earlier_count = 0
+        self.advantage_count = 0
+        self.advantage_sum = 0.0
+
+    def add(self, ok: bool, uav1_time: Optional[float], uav2_time: Optional[float]) -> None:
+        self.total_rounds += 1
+        self.ok_rounds += 1 if ok else 0
+        if uav1_time is not None:
+            self.uav1_count += 1
+            self.uav1_sum += uav1_time
+        if uav2_time is not None:
+            self.uav2_count += 1
+            self.uav2_sum += uav2_time
+        if uav1_time is not None and uav2_time is not None:
+            self.advantage_count += 1
+            self.advantage_sum += uav1_time - uav2_time
+            if uav2_time < uav1_time:
+                self.uav2_earlier_count += 1
+            elif uav1_time < uav2_time:
+                self.uav1_earlier_count += 1
+
+    def as_dict(self) -> dict:
+        def mean(total: float, count: int) -> Optional[float]:
+            return total / count if count else None
+
+        return {
+            "total_rounds": self.total_rounds,
+            "ok_rounds": self.ok_rounds,
+            "failed_rounds": self.total_rounds - self.ok_rounds,
+            "uav1_completion_count": self.uav1_count,
+            "uav2_completion_count": self.uav2_count,
+            "uav1_time_mean": mean(self.uav1_sum, self.uav1_count),
+            "uav2_time_mean": mean(self.uav2_sum, self.uav2_count),
+            "uav2_earlier_count": self.uav2_earlier_count,
+            "uav1_earlier_count": self.uav1_earlier_count,
+            "uav2_advantage_mean_sec": mean(self.advantage_sum, self.advantage_count),
+        }
+
+
+def _record_completion_times(record: dict) -> tuple[Optional[float], Optional[float]]:
+    mission = record.get("mission", {})
+    return mission.get("uav1CompletedTime"), mission.get("uav2CompletedTime")
+
+
 def _parse_int(value: Optional[str]) -> Optional[int]:
     if value is None:
         return None
@@ -169,7 +265,7 @@ def _append_round_summary(report_txt_path: Path, row: RoundResult) -> None:
         f.write("\n".join(lines))
 
 
-def _append_conclusion_txt(report_txt_path: Path, agg: dict) -> None:
+def _format_conclusion(agg: dict) -> list[str]:
     earlier_rate = None
     denominator = agg["uav2_earlier_count"] + agg["uav1_earlier_count"]
     if denominator > 0:
@@ -190,11 +286,24 @@ def _append_conclusion_txt(report_txt_path: Path, agg: dict) -> None:
         f"averageEarlierTime={agg['uav2_advantage_mean_sec']}",
         "",
     ]
+    return lines
+
+
+def _append_conclusion_txt(report_txt_path: Path, agg: dict) -> None:
     with report_txt_path.open("a", encoding="utf-8") as f:
-        f.write("\n".join(lines))
+        f.write("\n".join(_format_conclusion(agg)))
+
 
+def aggregate_jsonl(jsonl_path: Path) -> dict:
+    """Conclusion over every run record of a JSON-lines summary (one streaming pass)."""
+    agg = CompletionAggregate()
+    for record in iter_summary_records(jsonl_path):
+        uav1_time, uav2_time = _record_completion_times(record)
+        agg.add(record.get("scenario") == "scenario5", uav1_time, uav2_time)
+    return agg.as_dict()
 
-def _build_command(args: argparse.Namespace, seed: int, run_id: int) -> list[str]:
+
+def _build_command(args: argparse.Namespace, seed: int, run_id: int, output_dir: Path) -> list[str]:
     sim_args = [
         f"--seed={seed}",
         f"--runId={run_id}",
@@ -203,6 +312,9 @@ def _build_command(args: argparse.Namespace, seed: int, run_id: int) -> list[str
         f"--gridSpacing={args.grid_spacing}",
         f"--numFragments={args.num_fragments}",
         f"--numUavs={args.num_uavs}",
+        f"--resultLog={args.result_log}",
+        f"--outputDir={output_dir}",
+        "--jsonSummary=1",
     ]
 
     if args.extra_args.strip():
@@ -211,27 +323,64 @@ def _build_command(args: argparse.Namespace, seed: int, run_id: int) -> list[str
     return ["./ns3", "run", f"example5 {' '.join(sim_args)}"]
 
 
-def _safe_stat(values: list[float], op: str) -> Optional[float]:
-    if not values:
-        return None
-    if op == "mean":
-        return float(statistics.mean(values))
-    if op == "median":
-        return float(statistics.median(values))
-    if op == "min":
-        return float(min(values))
-    if op == "max":
-        return float(max(values))
-    raise ValueError(op)
+def check_event_log(args: argparse.Namespace) -> int:
+    """Run the start seed in text and binary mode and compare the event output."""
+    repo_root = Path(args.repo_root).resolve()
+    check_root = repo_root / "src/wsn/examples/visualize/results/batch/scenario5/event-log-check"
+    shutil.rmtree(check_root, ignore_errors=True)
+
+    if args.build_first:
+        print("[build] Running ./ns3 build ...")
+        subprocess.run(["./ns3", "build"], cwd=repo_root, check=True)
+
+    seed, run_id = args.start_seed, args.start_run_id
+    paths = {}
+    for mode in ("text", "binary"):
+        output_dir = check_root / mode
+        output_dir.mkdir(parents=True, exist_ok=True)
+        mode_args = argparse.Namespace(**vars(args))
+        mode_args.result_log = mode
+        mode_args.extra_args = f"{args.extra_args} --compressResults=0"
+        print(f"[check] seed={seed} runId={run_id} resultLog={mode}")
+        completed = subprocess.run(
+            _build_command(mode_args, seed, run_id, output_dir),
+            cwd=repo_root,
+            text=True,
+            capture_output=True,
+            timeout=args.timeout_sec,
+        )
+        if completed.returncode != 0:
+            print(completed.stderr)
+            print(f"[check] example5 failed with resultLog={mode}")
+            return 1
+        paths[mode] = output_dir / f"scenario5_result_{seed}_{run_id}"
+
+    completed = subprocess.run(
+        [sys.executable, str(EVENT_LOG_CONVERTER),
+         str(paths["binary"].with_suffix(".evt")),
+         "--compare", str(paths["text"].with_suffix(".txt"))],
+        text=True,
+    )
+    if completed.returncode == 0:
+        shutil.rmtree(check_root, ignore_errors=True)
+    else:
+        print(f"[check] outputs kept under {check_root}")
+    return completed.returncode
 
 
 def run_batch(args: argparse.Namespace) -> tuple[list[RoundResult], dict]:
     repo_root = Path(args.repo_root).resolve()
-    results_root = repo_root / "src/wsn/examples/visualize/results"
-    batch_root = results_root / "batch/scenario5"
+    batch_root = repo_root / "src/wsn/examples/visualize/results/batch/scenario5"
+    results_root = Path(args.output_dir).resolve() if args.output_dir else batch_root / "runs"
     logs_dir = batch_root / "logs"
 
     logs_dir.mkdir(parents=True, exist_ok=True)
+    results_root.mkdir(parents=True, exist_ok=True)
+
+    # Fresh record file per batch; read incrementally after every round
+    jsonl_path = results_root / SUMMARY_JSONL_NAME
+    jsonl_path.unlink(missing_ok=True)
+    jsonl_offset = 0
 
     for legacy_path in [
         batch_root / "raw-summary",
@@ -252,6 +401,7 @@ def run_batch(args: argparse.Namespace) -> tuple[list[RoundResult], dict]:
         subprocess.run(["./ns3", "build"], cwd=repo_root, check=True)
 
     all_rows: list[RoundResult] = []
+    aggregate = CompletionAggregate()
     params_written = False
 
     for i in range(args.rounds):
@@ -259,7 +409,7 @@ def run_batch(args: argparse.Namespace) -> tuple[list[RoundResult], dict]:
         seed = args.start_seed + i
         run_id = args.start_run_id + i
 
-        cmd = _build_command(args, seed, run_id)
+        cmd = _build_command(args, seed, run_id, results_root)
         start = time.time()
         status = "ok"
 
@@ -294,7 +444,27 @@ def run_batch(args: argparse.Namespace) -> tuple[list[RoundResult], dict]:
         uav2_time: Optional[float] = None
         suspicious_nodes: Optional[int] = None
 
-        if summary_file.exists():
+        new_records, jsonl_offset = read_new_records(jsonl_path, jsonl_offset)
+        record = next(
+            (r for r in new_records if r.get("seed") == seed and r.get("runId") == run_id),
+            None,
+        )
+
+        if record is not None:
+            uav1_time, uav2_time = _record_completion_times(record)
+            suspicious_nodes = record.get("network", {}).get("suspiciousNodes")
+
+            if not params_written:
+                params = {
+                    key: value if isinstance(value, str) else json.dumps(value)
+                    for key, value in record.get("params", {}).items()
+                }
+                _inject_params_into_txt_report(report_txt_path, params)
+                params_written = True
+
+            if status == "ok" and record.get("scenario") != "scenario5":
+                status = "invalid-summary"
+        elif summary_file.exists():
             parsed = parse_summary_file(summary_file)
             mission = parsed.get("mission", {})
             network = parsed.get("network", {})
@@ -309,12 +479,14 @@ def run_batch(args: argparse.Namespace) -> tuple[list[RoundResult], dict]:
 
             if status == "ok" and (parsed.get("scenario") != "scenario5"):
                 status = "invalid-summary"
-
-            summary_file.unlink(missing_ok=True)
         else:
             if status == "ok":
                 status = "missing-summary"
 
+        summary_file.unlink(missing_ok=True)
+        for event_file in results_root.glob(f"scenario5_result_{seed}_{run_id}[._]*"):
+            event_file.unlink(missing_ok=True)
+
         row = RoundResult(
                 round_index=round_index,
                 seed=seed,
@@ -326,47 +498,13 @@ def run_batch(args: argparse.Namespace) -> tuple[list[RoundResult], dict]:
                 suspicious_nodes=suspicious_nodes,
             )
         all_rows.append(row)
+        aggregate.add(status == "ok", uav1_time, uav2_time)
         _append_round_summary(report_txt_path, row)
 
         stdout_file.unlink(missing_ok=True)
         stderr_file.unlink(missing_ok=True)
 
-    uav1_values = [r.uav1_completed_time for r in all_rows if r.uav1_completed_time is not None]
-    uav2_values = [r.uav2_completed_time for r in all_rows if r.uav2_completed_time is not None]
-    both_completed = [r for r in all_rows if r.uav1_completed_time is not None and r.uav2_completed_time is not None]
-    uav2_advantage_values = [
-        r.uav1_completed_time - r.uav2_completed_time
-        for r in both_completed
-        if r.uav1_completed_time is not None and r.uav2_completed_time is not None
-    ]
-
-    uav2_earlier_count = sum(
-        1
-        for r in both_completed
-        if r.uav1_completed_time is not None
-        and r.uav2_completed_time is not None
-        and r.uav2_completed_time < r.uav1_completed_time
-    )
-    uav1_earlier_count = sum(
-        1
-        for r in both_completed
-        if r.uav1_completed_time is not None
-        and r.uav2_completed_time is not None
-        and r.uav1_completed_time < r.uav2_completed_time
-    )
-
-    agg = {
-        "total_rounds": len(all_rows),
-        "ok_rounds": sum(1 for r in all_rows if r.status == "ok"),
-        "failed_rounds": sum(1 for r in all_rows if r.status != "ok"),
-        "uav1_completion_count": len(uav1_values),
-        "uav2_completion_count": len(uav2_values),
-        "uav1_time_mean": _safe_stat(uav1_values, "mean"),
-        "uav2_time_mean": _safe_stat(uav2_values, "mean"),
-        "uav2_earlier_count": uav2_earlier_count,
-        "uav1_earlier_count": uav1_earlier_count,
-        "uav2_advantage_mean_sec": _safe_stat(uav2_advantage_values, "mean"),
-    }
+    agg = aggregate.as_dict()
     _append_conclusion_txt(report_txt_path, agg)
 
     if logs_dir.exists():
@@ -374,6 +512,7 @@ def run_batch(args: argparse.Namespace) -> tuple[list[RoundResult], dict]:
 
     print("\n=== Batch done ===")
     print(f"TXT   : {report_txt_path}")
+    print(f"JSONL : {jsonl_path}")
 
     return all_rows, agg
 
@@ -391,14 +530,47 @@ def main() -> int:
     parser.add_argument("--num-uavs", type=int, default=2, help="numUavs")
     parser.add_argument("--timeout-sec", type=int, default=180, help="Timeout per round")
     parser.add_argument("--build-first", action="store_true", help="Run ./ns3 build first")
+    parser.add_argument(
+        "--result-log",
+        choices=["summary", "text", "binary"],
+        default="summary",
+        help="Result output of each round (only the summary is parsed)",
+    )
     parser.add_argument(
         "--extra-args",
         default="",
         help="Extra CLI args forwarded to example5 (raw string)",
     )
+    parser.add_argument(
+        "--output-dir",
+        default=None,
+        help="Directory for per-round results and the JSONL summary (default: <batch>/runs)",
+    )
+    parser.add_argument(
+        "--aggregate",
+        type=Path,
+        default=None,
+        metavar="JSONL",
+        help="Only aggregate an existing scenario5_summary.jsonl and exit",
+    )
+
+    parser.add_argument(
+        "--check-event-log",
+        action="store_true",
+        help="Compare a text-mode run with the converted binary event log of the same seed and exit",
+    )
 
     args = parser.parse_args()
 
+    if args.aggregate is not None:
+        if not args.aggregate.exists():
+            raise SystemExit(f"not found: {args.aggregate}")
+        print("\n".join(_format_conclusion(aggregate_jsonl(args.aggregate))))
+        return 0
+
+    if args.check_event_log:
+        return check_event_log(args)
+
     if args.rounds <= 0:
         raise SystemExit("--rounds must be > 0")
 
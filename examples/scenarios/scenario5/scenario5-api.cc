@@ -16,6 +16,10 @@
 #include "../../../model/routing/scenario5/ground-node-routing/ground-node-routing.h"
 #include "../../../model/routing/scenario5/node-routing.h"
 #include "../../../model/routing/scenario5/uav-node-routing/uav-node-routing.h"
+#include "../../../model/wsn-metrics.h"
+#include "../../../model/wsn-profiler.h"
+
+#include <iostream>
 
 namespace ns3 {
 
@@ -51,6 +55,10 @@ Scenario5Runner::Build()
 
     InstallProtocolStack();
 
+    // Metric handles persist across runs in one process; counts do not
+    MetricsRegistry::Get().Reset();
+    Profiler::Get().Reset();
+
     // Use scenario5 routing layers
     routing::InitializeGroundNodeRouting(m_groundNodes, m_config.numFragments);
     routing::InitializeBaseStation(m_bsNode->GetId());
@@ -59,6 +67,9 @@ Scenario5Runner::Build()
     {
         routing::InitializeUavRouting(m_uavNodes.Get(i));
     }
+
+    // Fresh per-run loss draws on a fixed stream
+    routing::AssignUavBroadcastStreams(params::UAV_BROADCAST_LOSS_STREAM);
 }
 
 void
@@ -168,6 +179,7 @@ Scenario5Runner::Schedule()
     NS_LOG_FUNCTION(this);
     NS_LOG_INFO("Scheduling simulation events...");
     ScheduleSingleScenario5Event(m_config);
+    ScheduleScenario5TracePolicy(m_config);
 
     NS_LOG_INFO("Events scheduled for " << m_config.simTime << " seconds");
 }
@@ -178,8 +190,15 @@ Scenario5Runner::Run()
     NS_LOG_FUNCTION(this);
     NS_LOG_INFO("Running simulation...");
 
-    Simulator::Run();
+    {
+        WSN_PROFILE_SCOPE("sim.Run");
+        Simulator::Run();
+    }
     ReportScenario5Metrics();
+    if (Profiler::IsEnabled())
+    {
+        Profiler::Get().WriteTable(std::clog);
+    }
 
     NS_LOG_INFO("Simulation complete");
 }
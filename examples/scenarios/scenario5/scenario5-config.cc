@@ -117,9 +117,96 @@ Scenario5RunConfig::Validate(std::string& errorMsg) const
         return false;
     }
 
+    if (resultLog != "summary" && resultLog != "text" && resultLog != "binary")
+    {
+        oss << "Result log must be summary, text or binary";
+        errorMsg = oss.str();
+        return false;
+    }
+
+    if (outputDir.empty())
+    {
+        oss << "Output directory must not be empty";
+        errorMsg = oss.str();
+        return false;
+    }
+
+    if (replaySeekMs == 0)
+    {
+        oss << "Replay seek interval must be > 0 ms";
+        errorMsg = oss.str();
+        return false;
+    }
+
+    if (snapshotIntervalMs == 0)
+    {
+        oss << "Snapshot interval must be > 0 ms";
+        errorMsg = oss.str();
+        return false;
+    }
+
+    for (double rate : {traceSampleReceived, traceSampleShared, traceSampleCoded, traceSampleBroadcast})
+    {
+        if (rate < 0.0 || rate > 1.0)
+        {
+            oss << "Trace sample rates must be in [0, 1]";
+            errorMsg = oss.str();
+            return false;
+        }
+    }
+
+    std::vector<uint32_t> traceNodeIds;
+    if (traceNodes != "suspicious" && !ParseTraceNodeList(traceNodes, traceNodeIds))
+    {
+        oss << "Trace nodes must be all, suspicious or a comma-separated node ID list";
+        errorMsg = oss.str();
+        return false;
+    }
+    // Ground nodes, then the BS, then the UAVs
+    const uint64_t nodeCount = static_cast<uint64_t>(gridSize) * gridSize + 1 + numUavs;
+    for (uint32_t nodeId : traceNodeIds)
+    {
+        if (nodeId >= nodeCount)
+        {
+            oss << "Trace node ID " << nodeId << " is out of range (" << nodeCount << " nodes)";
+            errorMsg = oss.str();
+            return false;
+        }
+    }
+
+    if (traceStart < 0.0 || (traceStop >= 0.0 && traceStop <= traceStart))
+    {
+        oss << "Trace window must satisfy 0 <= start < stop (stop = -1 for end of run)";
+        errorMsg = oss.str();
+        return false;
+    }
+
     return true;
 }
 
+bool
+ParseTraceNodeList(const std::string& spec, std::vector<uint32_t>& nodeIds)
+{
+    nodeIds.clear();
+    if (spec == "all")
+    {
+        return true;
+    }
+
+    std::istringstream iss(spec);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        if (item.empty() || item.find_first_not_of("0123456789") != std::string::npos ||
+            item.size() > 9)
+        {
+            return false;
+        }
+        nodeIds.push_back(static_cast<uint32_t>(std::stoul(item)));
+    }
+    return !nodeIds.empty();
+}
+
 } // namespace scenario5
 } // namespace wsn
 } // namespace ns3
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "scenario5-params.h"
 
@@ -53,6 +54,25 @@ struct Scenario5RunConfig
     double alertThreshold = params::ALERT_THRESHOLD;
     double suspiciousPercent = params::SUSPICIOUS_COVERAGE_PERCENT;
 
+    // Result output ("summary", "text" or "binary")
+    std::string resultLog = params::RESULT_LOG_MODE;
+    bool compressResults = params::RESULT_LOG_COMPRESS;
+    std::string outputDir = params::RESULT_OUTPUT_DIR;
+    bool jsonSummary = params::RESULT_JSON_SUMMARY;
+    bool replay = params::RESULT_REPLAY;
+    uint32_t replaySeekMs = params::RESULT_REPLAY_SEEK_INTERVAL_MS;
+    bool snapshots = params::RESULT_SNAPSHOTS;
+    uint32_t snapshotIntervalMs = params::RESULT_SNAPSHOT_INTERVAL_MS;
+
+    // Result trace policy
+    double traceSampleReceived = params::TRACE_SAMPLE_FRAGMENT_RECEIVED;
+    double traceSampleShared = params::TRACE_SAMPLE_FRAGMENT_SHARED;
+    double traceSampleCoded = params::TRACE_SAMPLE_CODED_SYMBOL;
+    double traceSampleBroadcast = params::TRACE_SAMPLE_UAV_BROADCAST;
+    std::string traceNodes = params::TRACE_NODES;
+    double traceStart = params::TRACE_WINDOW_START;
+    double traceStop = params::TRACE_WINDOW_STOP;
+
     /**
      * Validate configuration parameters.
      *
@@ -62,6 +82,15 @@ struct Scenario5RunConfig
     bool Validate(std::string& errorMsg) const;
 };
 
+/**
+ * Parse a trace node list ("all" or comma-separated node IDs).
+ *
+ * \param spec Node list
+ * \param nodeIds Output node IDs (empty for "all")
+ * \return false if the list is malformed
+ */
+bool ParseTraceNodeList(const std::string& spec, std::vector<uint32_t>& nodeIds);
+
 } // namespace scenario5
 } // namespace wsn
 } // namespace ns3
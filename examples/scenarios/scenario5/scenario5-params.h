@@ -70,6 +70,21 @@ constexpr double UAV1_HOVER_TIME = 2.0;
 constexpr double UAV2_SPEED = 80.0;
 constexpr double UAV2_HOVER_TIME = 0.0;
 
+// Multi-UAV planning: the first ceil(N/2) UAVs visit every suspicious node
+// (UAV1 role), the rest fly coverage waypoints and broadcast (UAV2 role).
+// Suspicious nodes are partitioned inside each group by estimated mission time.
+constexpr bool UAV_PLANNER_PARALLEL = true;
+
+// UAV1 route refinement: 2-opt / Or-opt over K-nearest candidate lists after
+// nearest-neighbor construction. Very large tours are capped by a move count,
+// which keeps tours identical across machines; a wall-clock limit (> 0) is
+// available but makes tours depend on machine speed and load.
+constexpr bool UAV1_ROUTE_REFINE = true;
+constexpr uint32_t UAV1_ROUTE_NEIGHBORS = 8;
+constexpr uint32_t UAV1_ROUTE_REFINE_MAX_PASSES = 50;
+constexpr uint32_t UAV1_ROUTE_REFINE_MAX_MOVES = 200000;  // per UAV (0 = no cap)
+constexpr double UAV1_ROUTE_REFINE_TIME_LIMIT = 0.0;      // seconds per UAV (0 = no cap); not reproducible
+
 inline int32_t
 ComputeDefaultHexGridOffset(uint32_t nodeCount)
 {
@@ -90,7 +105,71 @@ constexpr double FRAGMENT_WEIGHT_MIN = 0.5;
 constexpr double FRAGMENT_WEIGHT_MAX = 2.0;
 constexpr uint32_t BS_INIT_FRAGMENT_GENERATION_COUNT = DEFAULT_NUM_FRAGMENTS;
 
-extern std::ofstream* g_resultFileStream;
+// UAV round-robin order: false = ascending fragment ID, true = highest confidence first
+constexpr bool FRAGMENT_BROADCAST_HIGHEST_CONFIDENCE_FIRST = false;
+
+// Adaptive UAV round broadcast: send the fragment most in-range nodes lack,
+// stop once every node in range holds the full set. Off: UAVs keep the fixed
+// 8-round broadcast.
+constexpr bool UAV_ADAPTIVE_BROADCAST = false;
+constexpr double UAV_ADAPTIVE_BROADCAST_INTERVAL = FRAGMENT_BROADCAST_INTERVAL;  // seconds
+constexpr uint32_t UAV_ADAPTIVE_BROADCAST_MAX_ROUNDS = 64;
+
+// Ground-node protocol timer wheel resolution
+constexpr double GROUND_TIMER_TICK = 0.01;  // seconds
+
+// Node confidence fusion (0 = sum, 1 = noisy-OR, 2 = log-odds, 3 = RSSI-weighted)
+constexpr uint32_t CONFIDENCE_FUSION_POLICY = 0;
+constexpr double CONFIDENCE_FUSION_LOG_ODDS_PRIOR = 0.01;
+constexpr double CONFIDENCE_FUSION_RSSI_FLOOR_DBM = RX_SENSITIVITY_DBM;  // weight 0
+constexpr double CONFIDENCE_FUSION_RSSI_CEILING_DBM = -60.0;  // weight 1
+
+// Result log: "summary" (summary sections only), "text" (events in the .txt)
+// or "binary" (columnar .evt; convert with examples/visualize/event-log-to-text.py)
+constexpr const char* RESULT_LOG_MODE = "summary";
+// gzip the event log on the writer thread (needs a build with WSN_ENABLE_ZLIB)
+constexpr bool RESULT_LOG_COMPRESS = true;
+constexpr uint32_t RESULT_LOG_BLOCK_RECORDS = 65536;  // records per written group
+// Result log written by a background thread (0 bytes = on the simulation thread)
+constexpr uint32_t RESULT_LOG_ASYNC_BUFFER_BYTES = 8 * 1024 * 1024;
+constexpr bool RESULT_LOG_ASYNC_DROP = false;  // text log: drop on overflow instead of blocking
+// Directory of the per-run result files (overridable with --outputDir)
+constexpr const char* RESULT_OUTPUT_DIR =
+    "/Users/mophan/Github/ns-3-dev-git-ns-3.46/src/wsn/examples/visualize/results";
+// Append one JSON object per run to <outputDir>/scenario5_summary.jsonl
+constexpr bool RESULT_JSON_SUMMARY = true;
+// Memory-mappable replay <base>.rpl (topology + events, replay-file.h)
+constexpr bool RESULT_REPLAY = false;
+constexpr uint32_t RESULT_REPLAY_SEEK_INTERVAL_MS = 100;  // one seek entry per interval
+// Network state snapshots <base>.snap (snapshot-file.h): per-node confidence,
+// fragment count, energy and lifecycle phase every interval
+constexpr bool RESULT_SNAPSHOTS = false;
+constexpr uint32_t RESULT_SNAPSHOT_INTERVAL_MS = 1000;
+constexpr uint32_t RESULT_SNAPSHOT_KEYFRAME_INTERVAL = 60;  // frames between full frames
+
+// Result trace policy (trace-policy.h): which fragment/symbol tokens and UAV
+// broadcasts reach the result log and the replay. Rates are the kept
+// fraction per event type (0 = off). The node filter applies to the
+// per-reception tokens: "all", "suspicious" or a comma-separated ID list.
+constexpr double TRACE_SAMPLE_FRAGMENT_RECEIVED = 1.0;
+constexpr double TRACE_SAMPLE_FRAGMENT_SHARED = 1.0;
+constexpr double TRACE_SAMPLE_CODED_SYMBOL = 1.0;
+constexpr double TRACE_SAMPLE_UAV_BROADCAST = 1.0;
+constexpr const char* TRACE_NODES = "all";
+constexpr double TRACE_WINDOW_START = 0.0;  // s
+constexpr double TRACE_WINDOW_STOP = -1.0;  // s, -1 = end of run
+
+// Erasure-coded broadcast: UAVs cycle over n = k + parity Reed-Solomon symbols
+// and a ground node recovers every fragment from any k of them.
+constexpr bool FRAGMENT_CODING_ENABLED = false;
+constexpr uint32_t FRAGMENT_CODING_PARITY_SYMBOLS = 6;
+// Per-receiver drop probability of a UAV broadcast (0 = ideal link)
+constexpr double UAV_BROADCAST_LOSS_PROBABILITY = 0.0;
+// RNG stream of the broadcast loss draws (fixed, so the erasure pattern
+// depends only on seed/runId)
+constexpr int64_t UAV_BROADCAST_LOSS_STREAM = 50;
+
+extern std::ostream* g_resultFileStream;
 
 } // namespace params
 } // namespace scenario5
@@ -3,7 +3,9 @@
 #include "ns3/simulator.h"
 #include "../../../model/routing/scenario5/ground-node-routing/ground-node-routing.h"
 #include "../../../model/routing/scenario5/ground-node-routing/startup-phase.h"
+#include "../../../model/routing/scenario5/base-station-node/base-station-node.h"
 #include "../../../model/routing/scenario5/node-routing.h"
+#include "../../../model/routing/scenario5/trace-policy.h"
 
 namespace ns3 {
 
@@ -29,6 +31,27 @@ SchedulePeriodicTopologyTick(double intervalSec, double endSec)
 
     Simulator::Schedule(Seconds(intervalSec), &SchedulePeriodicTopologyTick, intervalSec, endSec);
 }
+
+void
+SetTraceWindowOpen(bool open)
+{
+    routing::g_resultTracePolicy.SetWindowOpen(open);
+    NS_LOG_INFO("Result trace window " << (open ? "opened" : "closed") << " at t="
+                                       << Simulator::Now().GetSeconds() << "s");
+}
+
+void
+ApplySuspiciousTraceFilter(const std::set<uint32_t>& suspiciousNodes)
+{
+    if (suspiciousNodes.empty())
+    {
+        NS_LOG_WARN("No suspicious region selected, result trace keeps all nodes");
+        return;
+    }
+    routing::g_resultTracePolicy.SetNodeFilter(
+        std::vector<uint32_t>(suspiciousNodes.begin(), suspiciousNodes.end()));
+    NS_LOG_INFO("Result trace policy: " << routing::g_resultTracePolicy.Describe());
+}
 } // namespace
 
 void
@@ -59,6 +82,52 @@ ScheduleSingleScenario5Event(const Scenario5RunConfig& config)
     NS_LOG_INFO("Single Scenario5 event scheduled");
 }
 
+void
+ScheduleScenario5TracePolicy(const Scenario5RunConfig& config)
+{
+    routing::TracePolicy& policy = routing::g_resultTracePolicy;
+    policy.Reset();
+    policy.SetSeed((static_cast<uint64_t>(config.seed) << 32) ^ config.runId);
+    policy.SetSampleRate(routing::EventLogType::FRAGMENT_RECEIVED, config.traceSampleReceived);
+    policy.SetSampleRate(routing::EventLogType::FRAGMENT_SHARED, config.traceSampleShared);
+    policy.SetSampleRate(routing::EventLogType::CODED_SYMBOL_RECEIVED, config.traceSampleCoded);
+    policy.SetSampleRate(routing::EventLogType::UAV_FRAGMENT_BROADCAST, config.traceSampleBroadcast);
+    policy.SetSampleRate(routing::EventLogType::UAV_CODED_SYMBOL_BROADCAST, config.traceSampleBroadcast);
+
+    routing::g_bsSuspiciousRegionCallback = nullptr;
+    if (config.traceNodes == "suspicious")
+    {
+        // The region is selected by BS init: already at Build() in the
+        // single-event run, after the startup phase otherwise
+        if (routing::GetSuspiciousNodes().empty())
+        {
+            routing::g_bsSuspiciousRegionCallback = &ApplySuspiciousTraceFilter;
+        }
+        else
+        {
+            ApplySuspiciousTraceFilter(routing::GetSuspiciousNodes());
+        }
+    }
+    else
+    {
+        std::vector<uint32_t> nodeIds;
+        ParseTraceNodeList(config.traceNodes, nodeIds);
+        policy.SetNodeFilter(nodeIds);
+    }
+
+    if (config.traceStart > 0.0)
+    {
+        policy.SetWindowOpen(false);
+        Simulator::Schedule(Seconds(config.traceStart), &SetTraceWindowOpen, true);
+    }
+    if (config.traceStop >= 0.0)
+    {
+        Simulator::Schedule(Seconds(config.traceStop), &SetTraceWindowOpen, false);
+    }
+
+    NS_LOG_INFO("Result trace policy: " << policy.Describe());
+}
+
 } // namespace scenario5
 } // namespace wsn
 } // namespace ns3
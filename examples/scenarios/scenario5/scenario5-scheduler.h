@@ -11,6 +11,12 @@ void ScheduleScenario5Events(const Scenario5RunConfig& config);
 
 void ScheduleSingleScenario5Event(const Scenario5RunConfig& config);
 
+/**
+ * Configure the result trace policy from the run config and schedule its
+ * time window.
+ */
+void ScheduleScenario5TracePolicy(const Scenario5RunConfig& config);
+
 } // namespace scenario5
 } // namespace wsn
 } // namespace ns3
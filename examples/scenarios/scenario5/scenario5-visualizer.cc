@@ -1,15 +1,25 @@
 #include "scenario5-visualizer.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
+#include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "../../../model/routing/scenario5/base-station-node/base-station-node.h"
+#include "../../../model/routing/scenario5/base-station-node/fragment-generator.h"
 #include "../../../model/routing/scenario5/ground-node-routing/ground-node-routing.h"
+#include "../../../model/routing/scenario5/node-routing.h"
+#include "../../../model/routing/scenario5/replay-file.h"
+#include "../../../model/routing/scenario5/snapshot-file.h"
+#include "../../../model/wsn-profiler.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <map>
+#include <set>
 #include <sstream>
 #include <vector>
 
@@ -59,6 +69,50 @@ JoinIntList(const std::vector<int32_t>& values)
     }
     return oss.str();
 }
+
+// Snapshot sampling: states are looked up once, a frame costs one pass
+std::vector<const routing::GroundNetworkState*> g_snapshotStates;
+routing::SnapshotFrame g_snapshotFrame;
+uint32_t g_snapshotIntervalMs = 0;
+
+constexpr double kSnapshotConfidenceScale = 1e4; // 1e-4 resolution
+constexpr double kSnapshotEnergyScale = 1e3;     // mJ
+
+void
+AppendScenario5Snapshot()
+{
+    WSN_PROFILE_SCOPE("log.AppendScenario5Snapshot");
+    std::vector<int64_t>& confidence =
+        g_snapshotFrame.columns[static_cast<uint32_t>(routing::SnapshotColumn::CONFIDENCE)];
+    std::vector<int64_t>& fragments =
+        g_snapshotFrame.columns[static_cast<uint32_t>(routing::SnapshotColumn::FRAGMENT_COUNT)];
+    std::vector<int64_t>& energy =
+        g_snapshotFrame.columns[static_cast<uint32_t>(routing::SnapshotColumn::ENERGY)];
+    std::vector<int64_t>& phase =
+        g_snapshotFrame.columns[static_cast<uint32_t>(routing::SnapshotColumn::LIFECYCLE_PHASE)];
+
+    g_snapshotFrame.time = Simulator::Now().GetSeconds();
+    for (size_t i = 0; i < g_snapshotStates.size(); ++i)
+    {
+        const routing::GroundNetworkState& state = *g_snapshotStates[i];
+        confidence[i] = std::llround(state.confidence * kSnapshotConfidenceScale);
+        fragments[i] = state.fragments.GetCount();
+        energy[i] = std::llround(state.remainingEnergy * kSnapshotEnergyScale);
+        phase[i] = static_cast<int64_t>(state.lifecyclePhase);
+    }
+    routing::GetResultSnapshots().Append(g_snapshotFrame);
+}
+
+void
+RecordScenario5Snapshot()
+{
+    if (!routing::GetResultSnapshots().IsOpen())
+    {
+        return;
+    }
+    AppendScenario5Snapshot();
+    Simulator::Schedule(MilliSeconds(g_snapshotIntervalMs), &RecordScenario5Snapshot);
+}
 } // namespace
 
 void
@@ -202,6 +256,219 @@ DumpScenario5CellFormationSnapshot()
     NS_LOG_INFO("Scenario5 cell formation snapshot saved: " << outPath);
 }
 
+bool
+OpenScenario5Replay(const std::string& path, uint32_t seekIntervalMs)
+{
+    routing::ReplayTopology topology;
+    topology.cellRadius = params::HEX_CELL_RADIUS;
+
+    const std::set<uint32_t>& suspiciousNodes = routing::GetSuspiciousNodes();
+    const uint32_t suspiciousSeedNodeId = routing::GetSuspiciousSeedNodeId();
+
+    std::set<uint32_t> gatewayNodes;
+    for (const auto& [cellId, neighborCells] : params::g_cellGatewayPairs)
+    {
+        for (const auto& [neighborCellId, gateways] : neighborCells)
+        {
+            gatewayNodes.insert(gateways.begin(), gateways.end());
+        }
+    }
+
+    std::map<int32_t, std::vector<uint32_t>> cellMembers;
+    std::map<int32_t, uint32_t> cellLeaders;
+    std::map<int32_t, uint32_t> cellColors;
+    for (const auto& [nodeId, state] : routing::g_groundNetworkPerNode)
+    {
+        cellMembers[state.cellId].push_back(nodeId);
+        cellColors.emplace(state.cellId, state.cellColor);
+        if (state.isCellLeader)
+        {
+            cellLeaders[state.cellId] = nodeId;
+        }
+    }
+
+    // Nodes: ground nodes carry their cell; the BS and UAVs keep cell -1
+    for (uint32_t i = 0; i < NodeList::GetNNodes(); ++i)
+    {
+        Ptr<Node> node = NodeList::GetNode(i);
+        const uint32_t nodeId = node->GetId();
+        routing::ReplayNode record{};
+        record.nodeId = nodeId;
+        record.cellId = -1;
+        record.leaderId = nodeId;
+        record.role = static_cast<uint8_t>(routing::GetNodeRole(nodeId));
+
+        Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+        if (mobility)
+        {
+            const Vector p = mobility->GetPosition();
+            record.x = static_cast<float>(p.x);
+            record.y = static_cast<float>(p.y);
+            record.z = static_cast<float>(p.z);
+        }
+
+        auto it = routing::g_groundNetworkPerNode.find(nodeId);
+        if (it != routing::g_groundNetworkPerNode.end())
+        {
+            const routing::GroundNetworkState& state = it->second;
+            auto leaderIt = cellLeaders.find(state.cellId);
+            record.cellId = state.cellId;
+            record.leaderId = (leaderIt != cellLeaders.end()) ? leaderIt->second : nodeId;
+            record.color = static_cast<uint8_t>(state.cellColor);
+            record.flags |= state.isCellLeader ? routing::REPLAY_NODE_CELL_LEADER : 0;
+            record.flags |= suspiciousNodes.count(nodeId) ? routing::REPLAY_NODE_SUSPICIOUS : 0;
+            record.flags |= gatewayNodes.count(nodeId) ? routing::REPLAY_NODE_GATEWAY : 0;
+            record.flags |= (nodeId == suspiciousSeedNodeId) ? routing::REPLAY_NODE_SUSPICIOUS_SEED : 0;
+        }
+        topology.nodes.push_back(record);
+    }
+
+    // Links: each neighbour pair once, then each node's next hop in its cell tree
+    for (const auto& [nodeId, state] : routing::g_groundNetworkPerNode)
+    {
+        for (uint32_t neighborId : state.neighbors)
+        {
+            if (neighborId > nodeId)
+            {
+                topology.links.push_back(
+                    {nodeId, neighborId, static_cast<uint16_t>(routing::ReplayLinkKind::NEIGHBOR), 0});
+            }
+        }
+
+        auto routeIt = params::g_intraCellRoutingTree.find(nodeId);
+        if (routeIt == params::g_intraCellRoutingTree.end())
+        {
+            continue;
+        }
+        auto hopIt = routeIt->second.find(state.cellId);
+        if (hopIt != routeIt->second.end() && hopIt->second != nodeId)
+        {
+            topology.links.push_back(
+                {nodeId, hopIt->second, static_cast<uint16_t>(routing::ReplayLinkKind::ROUTE_TREE), 0});
+        }
+    }
+
+    for (auto& [cellId, members] : cellMembers)
+    {
+        std::sort(members.begin(), members.end());
+        auto leaderIt = cellLeaders.find(cellId);
+        routing::ReplayCell cell{};
+        cell.cellId = cellId;
+        cell.leaderId = (leaderIt != cellLeaders.end()) ? leaderIt->second : members.front();
+        cell.color = cellColors[cellId];
+        cell.firstMember = static_cast<uint32_t>(topology.cellMembers.size());
+        cell.memberCount = static_cast<uint32_t>(members.size());
+        topology.cells.push_back(cell);
+        topology.cellMembers.insert(topology.cellMembers.end(), members.begin(), members.end());
+    }
+
+    const size_t nodeCount = topology.nodes.size();
+    const size_t linkCount = topology.links.size();
+    const size_t cellCount = topology.cells.size();
+    if (!routing::GetResultReplay().Open(path, seekIntervalMs, std::move(topology)))
+    {
+        NS_LOG_ERROR("Cannot open replay file: " << path);
+        return false;
+    }
+    NS_LOG_INFO("Scenario5 replay: " << nodeCount << " nodes, " << linkCount << " links, "
+                << cellCount << " cells -> " << path);
+    return true;
+}
+
+void
+CloseScenario5Replay()
+{
+    routing::ReplayWriter& replay = routing::GetResultReplay();
+    if (!replay.IsOpen())
+    {
+        return;
+    }
+
+    // Paths are planned during the run, so they are only known now
+    std::vector<routing::ReplayPath> paths;
+    std::vector<routing::ReplayPathPoint> points;
+    for (const auto& [uavNodeId, path] : routing::GetUavFlightPaths())
+    {
+        paths.push_back({uavNodeId,
+                         static_cast<uint32_t>(path.role),
+                         static_cast<uint32_t>(points.size()),
+                         static_cast<uint32_t>(path.waypoints.size()),
+                         path.totalTime});
+        for (const routing::Waypoint& wp : path.waypoints)
+        {
+            points.push_back({static_cast<float>(wp.position.x),
+                              static_cast<float>(wp.position.y),
+                              static_cast<float>(wp.position.z),
+                              static_cast<float>(wp.arrivalTime)});
+        }
+    }
+    replay.SetPaths(std::move(paths), std::move(points));
+    replay.Close();
+
+    NS_LOG_INFO("Scenario5 replay: " << replay.GetEventCount() << " events, "
+                << replay.GetBytesWritten() << " bytes");
+}
+
+bool
+OpenScenario5Snapshots(const std::string& path, uint32_t intervalMs, uint32_t keyframeInterval)
+{
+    // Column order: node ID order of the ground state map
+    std::vector<uint32_t> nodeIds;
+    g_snapshotStates.clear();
+    nodeIds.reserve(routing::g_groundNetworkPerNode.size());
+    g_snapshotStates.reserve(routing::g_groundNetworkPerNode.size());
+    for (const auto& [nodeId, state] : routing::g_groundNetworkPerNode)
+    {
+        nodeIds.push_back(nodeId);
+        g_snapshotStates.push_back(&state);
+    }
+    for (std::vector<int64_t>& column : g_snapshotFrame.columns)
+    {
+        column.assign(nodeIds.size(), 0);
+    }
+
+    std::array<double, routing::kSnapshotColumnCount> columnScale{};
+    columnScale[static_cast<uint32_t>(routing::SnapshotColumn::CONFIDENCE)] = kSnapshotConfidenceScale;
+    columnScale[static_cast<uint32_t>(routing::SnapshotColumn::FRAGMENT_COUNT)] = 1.0;
+    columnScale[static_cast<uint32_t>(routing::SnapshotColumn::ENERGY)] = kSnapshotEnergyScale;
+    columnScale[static_cast<uint32_t>(routing::SnapshotColumn::LIFECYCLE_PHASE)] = 1.0;
+
+    routing::SnapshotWriter& snapshots = routing::GetResultSnapshots();
+    if (!snapshots.Open(path, intervalMs, keyframeInterval, nodeIds, columnScale))
+    {
+        NS_LOG_ERROR("Cannot open snapshot file: " << path);
+        return false;
+    }
+    g_snapshotIntervalMs = intervalMs;
+    Simulator::ScheduleNow(&RecordScenario5Snapshot);
+
+    NS_LOG_INFO("Scenario5 snapshots: " << nodeIds.size() << " nodes every " << intervalMs
+                << " ms -> " << path);
+    return true;
+}
+
+void
+CloseScenario5Snapshots()
+{
+    routing::SnapshotWriter& snapshots = routing::GetResultSnapshots();
+    if (!snapshots.IsOpen())
+    {
+        return;
+    }
+
+    // The periodic frame of the stop time may not have run
+    if (snapshots.GetFrameCount() == 0 ||
+        Simulator::Now().GetSeconds() > g_snapshotFrame.time)
+    {
+        AppendScenario5Snapshot();
+    }
+    snapshots.Close();
+    g_snapshotStates.clear();
+
+    NS_LOG_INFO("Scenario5 snapshots: " << snapshots.GetFrameCount() << " frames, "
+                << snapshots.GetBytesWritten() << " bytes");
+}
+
 } // namespace scenario5
 } // namespace wsn
 } // namespace ns3
@@ -17,6 +17,41 @@ void DumpScenario5InitialNodesToFile(const NodeContainer& groundNodes,
 
 void DumpScenario5CellFormationSnapshot();
 
+/**
+ * Open the binary replay file of the run (routing::GetResultReplay()) and
+ * write its topology: every node of the NodeList, neighbour and routing
+ * tree links, and cells. Call after the runner has built the scenario.
+ *
+ * \param path Output file (.rpl)
+ * \param seekIntervalMs Seek index granularity (ms)
+ * \return false if the file cannot be created
+ */
+bool OpenScenario5Replay(const std::string& path, uint32_t seekIntervalMs);
+
+/**
+ * Add the planned UAV paths and close the replay file (no-op if closed).
+ */
+void CloseScenario5Replay();
+
+/**
+ * Open the network state snapshot file of the run
+ * (routing::GetResultSnapshots()) and start sampling every ground node's
+ * confidence, fragment count, energy and lifecycle phase. Call after the
+ * runner has built the scenario.
+ *
+ * \param path Output file (.snap)
+ * \param intervalMs Sampling interval (ms)
+ * \param keyframeInterval Frames between keyframes
+ * \return false if the file cannot be created
+ */
+bool OpenScenario5Snapshots(const std::string& path, uint32_t intervalMs, uint32_t keyframeInterval);
+
+/**
+ * Record a last frame at the current time and close the snapshot file
+ * (no-op if closed).
+ */
+void CloseScenario5Snapshots();
+
 } // namespace scenario5
 } // namespace wsn
 } // namespace ns3
@@ -0,0 +1,161 @@
+/*
+ * Scenario 5 - Multi-UAV Planner Benchmark
+ *
+ * Plans node-visit and coverage groups over random fields of suspicious
+ * nodes and reports planning time and mission completion time per
+ * (UAV count, node count) pair. No simulation is run.
+ *
+ * Usage:
+ *   ./ns3 run "uav-planner-benchmark --uavCounts=2,4,8,16,32 --nodeCounts=1000,10000,50000"
+ *   ./ns3 run "uav-planner-benchmark --refine=false"   (unrefined node-visit routes)
+ */
+
+#include "ns3/core-module.h"
+
+#include "scenarios/scenario5/scenario5-params.h"
+#include "../model/routing/scenario5/base-station-node/uav-path-planner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::wsn::scenario5;
+
+NS_LOG_COMPONENT_DEFINE("UavPlannerBenchmark");
+
+namespace
+{
+
+std::vector<uint32_t>
+ParseCountList(const std::string& text)
+{
+    std::vector<uint32_t> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            values.push_back(static_cast<uint32_t>(std::stoul(item)));
+        }
+    }
+    return values;
+}
+
+std::vector<routing::PlannerTarget>
+MakeRandomField(uint32_t numNodes, double spacing, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    const double side = std::sqrt(static_cast<double>(numNodes)) * spacing;
+    std::uniform_real_distribution<double> coord(0.0, side);
+
+    std::vector<routing::PlannerTarget> targets;
+    targets.reserve(numNodes);
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        targets.push_back({i, Vector(coord(rng), coord(rng), 0.0)});
+    }
+    return targets;
+}
+
+double
+GetMissionTime(const std::vector<routing::UavPlanResult>& results)
+{
+    double missionTime = 0.0;
+    for (const auto& result : results)
+    {
+        missionTime = std::max(missionTime, result.path.totalTime);
+    }
+    return missionTime;
+}
+
+double
+GetImbalance(const std::vector<routing::UavPlanResult>& results)
+{
+    if (results.empty())
+    {
+        return 1.0;
+    }
+    double sum = 0.0;
+    for (const auto& result : results)
+    {
+        sum += result.path.totalTime;
+    }
+    const double mean = sum / results.size();
+    return (mean > 0.0) ? GetMissionTime(results) / mean : 1.0;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    std::string uavCounts = "2,4,8,16,32";
+    std::string nodeCounts = "1000,5000,10000,50000";
+    double spacing = params::DEFAULT_SPACING;
+    uint32_t seed = 1;
+    bool parallel = params::UAV_PLANNER_PARALLEL;
+    bool refine = params::UAV1_ROUTE_REFINE;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("uavCounts", "Comma-separated UAV counts", uavCounts);
+    cmd.AddValue("nodeCounts", "Comma-separated suspicious node counts", nodeCounts);
+    cmd.AddValue("spacing", "Average node spacing of the random field (meters)", spacing);
+    cmd.AddValue("seed", "Random seed for field generation", seed);
+    cmd.AddValue("parallel", "Plan UAVs on worker threads", parallel);
+    cmd.AddValue("refine", "Apply 2-opt / Or-opt to node-visit routes", refine);
+    cmd.Parse(argc, argv);
+
+    routing::UavFleetPlanOptions options = routing::GetBsInitFleetPlanOptions();
+    options.refinement.enabled = refine;
+    options.parallel = parallel;
+    const Vector startPos(params::BS_POSITION_X, params::BS_POSITION_Y, params::BS_INIT_UAV_STARTING_ALTITUDE);
+
+    std::cout << std::left
+              << std::setw(6) << "uavs"
+              << std::setw(8) << "nodes"
+              << std::setw(14) << "planMs"
+              << std::setw(14) << "visitMission"
+              << std::setw(14) << "coverMission"
+              << std::setw(12) << "visitImbal"
+              << std::setw(12) << "coverImbal" << std::endl;
+
+    for (uint32_t numNodes : ParseCountList(nodeCounts))
+    {
+        const std::vector<routing::PlannerTarget> targets = MakeRandomField(numNodes, spacing, seed);
+
+        for (uint32_t numUavs : ParseCountList(uavCounts))
+        {
+            std::vector<uint32_t> uavNodeIds(numUavs);
+            std::iota(uavNodeIds.begin(), uavNodeIds.end(), 0);
+            const std::vector<Vector> startPositions(numUavs, startPos);
+
+            // Same fleet split and planners as PlanUavFlightPathsForBsInit
+            const auto start = std::chrono::steady_clock::now();
+            const routing::UavFleetPlanResult fleet =
+                routing::PlanUavFleet(uavNodeIds, startPositions, targets, options);
+            const double planMs =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << std::left << std::fixed << std::setprecision(1)
+                      << std::setw(6) << numUavs
+                      << std::setw(8) << numNodes
+                      << std::setw(14) << planMs
+                      << std::setw(14) << GetMissionTime(fleet.visitResults)
+                      << std::setw(14) << GetMissionTime(fleet.coverageResults)
+                      << std::setprecision(3)
+                      << std::setw(12) << GetImbalance(fleet.visitResults)
+                      << std::setw(12) << GetImbalance(fleet.coverageResults) << std::endl;
+        }
+    }
+
+    return 0;
+}
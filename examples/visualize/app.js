@@ -1063,15 +1063,164 @@ async function loadAndRenderNodes() {
   }
 }
 
+// Binary replay (.rpl) written by example5 --replay=1.
+// Layout: model/routing/scenario5/replay-file.h (little-endian, fixed-size records).
+const REPLAY_MAGIC = 'WSNRPL01';
+const REPLAY_VERSION = 1;
+const REPLAY_NODE_SIZE = 32;
+const REPLAY_EVENT_SIZE = 40;
+const REPLAY_PATH_SIZE = 24;
+const REPLAY_PATH_POINT_SIZE = 16;
+const REPLAY_ROLE_GROUND = 1;
+const REPLAY_NODE_CELL_LEADER = 1;
+const REPLAY_NODE_SUSPICIOUS = 2;
+const REPLAY_NODE_SUSPICIOUS_SEED = 8;
+const REPLAY_EVENT_LINK_TYPES = { 1: 'R', 2: 'S' };
+const REPLAY_EVENT_WAYPOINT = 6;
+const REPLAY_EVENT_UAV1_COMPLETE = 7;
+const REPLAY_EVENT_UAV2_COMPLETE = 8;
+const REPLAY_NO_NODE = 0xffffffff;
+
+function parseReplayFile(buffer) {
+  const view = new DataView(buffer);
+  const magic = String.fromCharCode(...new Uint8Array(buffer, 0, 8));
+  if (magic !== REPLAY_MAGIC || view.getUint32(8, true) !== REPLAY_VERSION) {
+    throw new Error('Không phải file replay hợp lệ');
+  }
+
+  const section = (at) => ({
+    offset: Number(view.getBigUint64(at, true)),
+    count: Number(view.getBigUint64(at + 8, true)),
+  });
+  const complete = view.getUint32(28, true) === 1;
+  const nodeSection = section(32);
+  const eventSection = section(96);
+  const pathSection = section(128);
+  const pointSection = section(144);
+  const cellRadius = view.getFloat64(176, true) || DEFAULT_CELL_RADIUS_M;
+
+  // Unclosed file: events run to the end of the file
+  const eventCount = complete
+    ? eventSection.count
+    : Math.floor((buffer.byteLength - eventSection.offset) / REPLAY_EVENT_SIZE);
+
+  const nodes = [];
+  const leaders = new Set();
+  const suspiciousNodes = new Set();
+  const suspiciousCells = new Set();
+  let suspiciousPoint = null;
+  for (let i = 0; i < nodeSection.count; i++) {
+    const at = nodeSection.offset + i * REPLAY_NODE_SIZE;
+    if (view.getUint8(at + 12) !== REPLAY_ROLE_GROUND) {
+      continue;
+    }
+    const node = {
+      nodeId: view.getUint32(at, true),
+      cellId: view.getInt32(at + 4, true),
+      colorId: view.getUint8(at + 13),
+      x: view.getFloat32(at + 16, true),
+      y: view.getFloat32(at + 20, true),
+    };
+    const flags = view.getUint8(at + 14);
+    if (flags & REPLAY_NODE_CELL_LEADER) {
+      leaders.add(node.nodeId);
+    }
+    if (flags & REPLAY_NODE_SUSPICIOUS) {
+      suspiciousNodes.add(node.nodeId);
+      suspiciousCells.add(node.cellId);
+    }
+    if (flags & REPLAY_NODE_SUSPICIOUS_SEED) {
+      suspiciousPoint = { x: node.x, y: node.y };
+    }
+    nodes.push(node);
+  }
+
+  const uavPaths = [];
+  if (complete) {
+    for (let i = 0; i < pathSection.count; i++) {
+      const at = pathSection.offset + i * REPLAY_PATH_SIZE;
+      const firstPoint = view.getUint32(at + 8, true);
+      const pointCount = view.getUint32(at + 12, true);
+      const waypoints = [];
+      for (let k = firstPoint; k < firstPoint + pointCount && k < pointSection.count; k++) {
+        const pointAt = pointSection.offset + k * REPLAY_PATH_POINT_SIZE;
+        waypoints.push({ x: view.getFloat32(pointAt, true), y: view.getFloat32(pointAt + 4, true) });
+      }
+      if (waypoints.length > 0) {
+        uavPaths.push({ uavId: view.getUint32(at, true), waypoints });
+      }
+    }
+    uavPaths.sort((a, b) => a.uavId - b.uavId);
+  }
+
+  const waypointEvents = [];
+  const communicationLinks = [];
+  const missionEvents = [];
+  for (let i = 0; i < eventCount; i++) {
+    const at = eventSection.offset + i * REPLAY_EVENT_SIZE;
+    const time = view.getFloat64(at, true);
+    const type = view.getUint16(at + 8, true);
+    const nodeId = view.getUint32(at + 12, true);
+    const peerId = view.getUint32(at + 16, true);
+
+    if (REPLAY_EVENT_LINK_TYPES[type]) {
+      communicationLinks.push({ time, srcId: peerId, dstId: nodeId, linkType: REPLAY_EVENT_LINK_TYPES[type] });
+    } else if (type === REPLAY_EVENT_WAYPOINT) {
+      waypointEvents.push({
+        time,
+        nodeId,
+        x: view.getFloat32(at + 24, true),
+        y: view.getFloat32(at + 28, true),
+        z: view.getFloat32(at + 32, true),
+      });
+    } else if (type === REPLAY_EVENT_UAV1_COMPLETE) {
+      missionEvents.push({ time, uavIndex: 1 });
+    } else if (type === REPLAY_EVENT_UAV2_COMPLETE) {
+      missionEvents.push({
+        time,
+        uavIndex: 2,
+        triggerNodeId: peerId !== REPLAY_NO_NODE ? peerId : null,
+        confidence: view.getFloat32(at + 36, true),
+      });
+    }
+  }
+
+  return {
+    config: { cellRadius },
+    nodes,
+    leaders,
+    suspiciousInfo: { suspiciousNodes, suspiciousCells, suspiciousPoint },
+    uavPaths,
+    waypointEvents,
+    communicationLinks,
+    missionEvents,
+  };
+}
+
 function applyScenarioText(text) {
-  const config = parseConfig(text);
-  const nodes = parseNodeInfo(text);
-  const leaders = parseCellLeaders(text);
-  const suspiciousInfo = parseSuspiciousInfo(text);
-  const uavPaths = parseUavPaths(text);
-  const waypointEvents = parseUavWaypointEvents(text);
-  const communicationLinks = parseCommunicationLinks(text);
-  const missionEvents = parseUavMissionEvents(text);
+  applyScenarioData({
+    config: parseConfig(text),
+    nodes: parseNodeInfo(text),
+    leaders: parseCellLeaders(text),
+    suspiciousInfo: parseSuspiciousInfo(text),
+    uavPaths: parseUavPaths(text),
+    waypointEvents: parseUavWaypointEvents(text),
+    communicationLinks: parseCommunicationLinks(text),
+    missionEvents: parseUavMissionEvents(text),
+  });
+}
+
+function applyScenarioData(data) {
+  const {
+    config,
+    nodes,
+    leaders,
+    suspiciousInfo,
+    uavPaths,
+    waypointEvents,
+    communicationLinks,
+    missionEvents,
+  } = data;
   const cells = buildCellInfo(nodes, config.cellRadius);
   const world = buildWorldMapper(nodes);
 
@@ -1128,8 +1277,11 @@ function bindFileInput() {
     }
 
     try {
-      const text = await file.text();
-      applyScenarioText(text);
+      if (file.name.endsWith('.rpl')) {
+        applyScenarioData(parseReplayFile(await file.arrayBuffer()));
+      } else {
+        applyScenarioText(await file.text());
+      }
     } catch (error) {
       nodeStats.textContent = 'Không đọc được file đã chọn';
       console.error(error);
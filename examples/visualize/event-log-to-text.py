@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""
+Event log converter
+- Read a binary result event log (.evt, or gzipped .evt.gz) written by EventLog
+- Rebuild the text result log from the per-type templates in the file header
+- Optionally print per-type record counts instead (--stats)
+- Optionally check the result against a text-mode run (--compare)
+
+The layout is documented in model/routing/scenario5/event-log.h. A float
+placeholder {x:@fmt} is printed the way the C++ text stream would have
+printed it, using the floatfield/precision stored in column "fmt".
+
+Example:
+    python3 event-log-to-text.py binary/scenario5_result_1_1.evt \
+        --compare text/scenario5_result_1_1.txt
+"""
+
+from __future__ import annotations
+
+import argparse
+import gzip
+import heapq
+import re
+import struct
+import io
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import BinaryIO, Dict, Iterator, List, Tuple
+
+MAGIC = b"WSNEVT01"
+
+COLUMN_U32 = 1
+COLUMN_U64 = 2
+COLUMN_F64 = 3
+COLUMN_TEXT = 4
+
+COLUMN_FORMATS = {
+    COLUMN_U32: "<{}I",
+    COLUMN_U64: "<{}Q",
+    COLUMN_F64: "<{}d",
+}
+COLUMN_WIDTHS = {COLUMN_U32: 4, COLUMN_U64: 8, COLUMN_F64: 8}
+
+PLACEHOLDER = re.compile(r"\{(\w+)(?::([^}]*))?\}")
+
+# First line of the summary example5 appends after the text-mode events
+SUMMARY_HEADER = "SCENARIO scenario5\n"
+
+
+def format_stream_float(value: float, stream_format: int) -> str:
+    """Format like an ostream with floatfield/precision packed as in EventLog."""
+    mode, precision = stream_format >> 16, stream_format & 0xFFFF
+    if mode == 1:
+        return format(value, ".{}f".format(precision))
+    if mode == 2:
+        return format(value, ".{}e".format(precision))
+    return format(value, ".{}g".format(max(precision, 1)))
+
+
+@dataclass
+class Schema:
+    type_id: int
+    template: str
+    columns: List[Tuple[int, str]] = field(default_factory=list)
+
+    def render(self, row: Dict[str, object]) -> str:
+        def replace(match: re.Match) -> str:
+            value = row[match.group(1)]
+            spec = match.group(2)
+            if spec and spec.startswith("@"):
+                return format_stream_float(value, row[spec[1:]])
+            if spec:
+                return format(value, spec)
+            if isinstance(value, float):
+                return format(value, "g")
+            return str(value)
+
+        return PLACEHOLDER.sub(replace, self.template)
+
+
+def _read_exact(stream: BinaryIO, size: int) -> bytes:
+    data = stream.read(size)
+    if len(data) != size:
+        raise EOFError("truncated event log")
+    return data
+
+
+def _read_string(stream: BinaryIO) -> str:
+    (length,) = struct.unpack("<H", _read_exact(stream, 2))
+    return _read_exact(stream, length).decode("utf-8")
+
+
+def read_header(stream: BinaryIO) -> Dict[int, Schema]:
+    if _read_exact(stream, len(MAGIC)) != MAGIC:
+        raise ValueError("not an event log (bad magic)")
+    (schema_count,) = struct.unpack("<I", _read_exact(stream, 4))
+    schemas: Dict[int, Schema] = {}
+    for _ in range(schema_count):
+        type_id, column_count = struct.unpack("<HH", _read_exact(stream, 4))
+        schema = Schema(type_id, _read_string(stream))
+        for _ in range(column_count):
+            (column_type,) = struct.unpack("<B", _read_exact(stream, 1))
+            schema.columns.append((column_type, _read_string(stream)))
+        schemas[type_id] = schema
+    return schemas
+
+
+def _read_block(stream: BinaryIO, schema: Schema, rows: int) -> List[Dict[str, object]]:
+    values: Dict[str, list] = {}
+    for column_type, name in schema.columns:
+        if column_type == COLUMN_TEXT:
+            lengths = struct.unpack("<{}I".format(rows), _read_exact(stream, 4 * rows))
+            values[name] = list(lengths)  # payload follows the last column
+        else:
+            width = COLUMN_WIDTHS[column_type]
+            fmt = COLUMN_FORMATS[column_type].format(rows)
+            values[name] = list(struct.unpack(fmt, _read_exact(stream, width * rows)))
+
+    for column_type, name in schema.columns:
+        if column_type == COLUMN_TEXT:
+            payload = _read_exact(stream, sum(values[name]))
+            texts, offset = [], 0
+            for length in values[name]:
+                texts.append(payload[offset:offset + length].decode("utf-8", errors="replace"))
+                offset += length
+            values[name] = texts
+
+    names = [name for _, name in schema.columns]
+    return [{name: values[name][i] for name in names} for i in range(rows)]
+
+
+def iter_records(stream: BinaryIO, schemas: Dict[int, Schema]) -> Iterator[Tuple[Schema, Dict[str, object]]]:
+    """Yield (schema, row) in the original write order."""
+    while True:
+        head = stream.read(4)
+        if not head:
+            return
+        if len(head) != 4:
+            raise EOFError("truncated event log")
+        (block_count,) = struct.unpack("<I", head)
+
+        # Each block is seq-sorted; a group covers one contiguous seq range
+        blocks = []
+        for _ in range(block_count):
+            type_id, _reserved, rows = struct.unpack("<HHI", _read_exact(stream, 8))
+            schema = schemas[type_id]
+            blocks.append([(row["seq"], type_id, row) for row in _read_block(stream, schema, rows)])
+        for _seq, type_id, row in heapq.merge(*blocks, key=lambda entry: entry[0]):
+            yield schemas[type_id], row
+
+
+def open_event_log(path: Path) -> BinaryIO:
+    with path.open("rb") as probe:
+        gzipped = probe.read(2) == b"\x1f\x8b"
+    return gzip.open(path, "rb") if gzipped else path.open("rb")
+
+
+def compare_with_text_log(converted: str, text_path: Path) -> int:
+    """Compare converted events with the event part of a text-mode result log."""
+    text = text_path.read_text()
+    if text.startswith(SUMMARY_HEADER):
+        events = ""
+    else:
+        cut = text.find("\n" + SUMMARY_HEADER)
+        events = text if cut < 0 else text[:cut + 1]
+    if events == converted:
+        print(f"match: {len(converted)} bytes of events identical to {text_path}")
+        return 0
+
+    expected_lines = events.splitlines(keepends=True)
+    actual_lines = converted.splitlines(keepends=True)
+    for number, (expected, actual) in enumerate(zip(expected_lines, actual_lines), start=1):
+        if expected != actual:
+            print(f"mismatch at line {number}:\n  text:      {expected!r}\n  converted: {actual!r}")
+            return 1
+    print(f"mismatch: text log has {len(expected_lines)} event lines, converted has {len(actual_lines)}")
+    return 1
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Convert a binary result event log to text")
+    parser.add_argument("input", type=Path, help="event log (.evt or .evt.gz)")
+    parser.add_argument("-o", "--output", type=Path, help="text output (default: stdout)")
+    parser.add_argument("--stats", action="store_true", help="print record counts per type")
+    parser.add_argument("--compare", type=Path, metavar="TEXT_LOG",
+                        help="compare with the .txt of a text-mode run (same seed/config)")
+    args = parser.parse_args()
+
+    with open_event_log(args.input) as stream:
+        schemas = read_header(stream)
+        if args.stats:
+            counts: Dict[int, int] = {type_id: 0 for type_id in schemas}
+            for schema, _row in iter_records(stream, schemas):
+                counts[schema.type_id] += 1
+            for type_id, count in sorted(counts.items()):
+                print(f"type={type_id} records={count} template={schemas[type_id].template!r}")
+            return 0
+
+        if args.compare:
+            converted = io.StringIO()
+            for schema, row in iter_records(stream, schemas):
+                converted.write(schema.render(row))
+            return compare_with_text_log(converted.getvalue(), args.compare)
+
+        out = args.output.open("w") if args.output else sys.stdout
+        try:
+            for schema, row in iter_records(stream, schemas):
+                out.write(schema.render(row))
+        finally:
+            if args.output:
+                out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
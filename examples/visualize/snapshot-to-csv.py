@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Snapshot converter
+- Read a network state snapshot file (.snap) written by SnapshotWriter
+- Print one column as a wide CSV: one row per frame, one column per node
+- Or print every column in long form (--long), or per-frame statistics (--stats)
+
+The layout is documented in model/routing/scenario5/snapshot-file.h. Values
+are divided by the column scales of the file header (confidence, energy in J).
+"""
+
+from __future__ import annotations
+
+import argparse
+import csv
+import mmap
+import struct
+import sys
+from pathlib import Path
+from typing import Iterator, List, Optional, Tuple
+
+MAGIC = b"WSNSNP01"
+VERSION = 1
+HEADER = struct.Struct("<8sIIIIIIQII4ddd")
+FRAME_HEADER = struct.Struct("<dIHH")
+KEYFRAME = 1
+
+COLUMNS = ["confidence", "fragments", "energy", "phase"]
+PHASES = ["BOOTSTRAP", "DISCOVERY", "ACTIVE", "DEGRADED", "DEAD"]
+
+
+def _get_varint(data: bytes, pos: int, end: int) -> Tuple[int, int]:
+    value = 0
+    shift = 0
+    while pos < end:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, pos
+        shift += 7
+    raise ValueError("corrupt snapshot frame (truncated varint)")
+
+
+class SnapshotFile:
+    def __init__(self, path: Path):
+        with path.open("rb") as stream:
+            self.data = mmap.mmap(stream.fileno(), 0, access=mmap.ACCESS_READ)
+        if len(self.data) < HEADER.size:
+            raise ValueError("not a snapshot file (too small)")
+        fields = HEADER.unpack_from(self.data, 0)
+        if fields[0] != MAGIC:
+            raise ValueError("not a snapshot file (bad magic)")
+        (_, version, header_size, self.node_count, column_count, self.interval_ms,
+         self.keyframe_interval, self.frame_count, self.complete, _) = fields[:10]
+        self.scales = list(fields[10:14])
+        if version != VERSION or header_size != HEADER.size or column_count != len(COLUMNS):
+            raise ValueError("unsupported snapshot version/layout")
+        self.node_ids = list(struct.unpack_from(f"<{self.node_count}I", self.data, HEADER.size))
+        self.frames_offset = (HEADER.size + 4 * self.node_count + 7) & ~7
+
+    def iter_frames(self) -> Iterator[Tuple[float, List[List[int]]]]:
+        """Yield (time, columns) in file order; the column lists are reused."""
+        columns = [[0] * self.node_count for _ in COLUMNS]
+        offset = self.frames_offset
+        frames = 0
+        while offset + FRAME_HEADER.size <= len(self.data):
+            if self.complete and frames == self.frame_count:
+                break
+            time, payload_bytes, flags, _ = FRAME_HEADER.unpack_from(self.data, offset)
+            pos = offset + FRAME_HEADER.size
+            end = pos + payload_bytes
+            if end > len(self.data):
+                break  # unclosed file: partial last frame
+            for values in columns:
+                if flags & KEYFRAME:
+                    values[:] = [0] * self.node_count
+                node = 0
+                while node < self.node_count:
+                    run, pos = _get_varint(self.data, pos, end)
+                    node += run
+                    if node >= self.node_count:
+                        break
+                    delta, pos = _get_varint(self.data, pos, end)
+                    values[node] += (delta >> 1) ^ -(delta & 1)
+                    node += 1
+            yield time, columns
+            offset = end
+            frames += 1
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Convert a network state snapshot file to CSV")
+    parser.add_argument("input", type=Path, help="snapshot file (.snap)")
+    parser.add_argument("-o", "--output", type=Path, help="CSV output (default: stdout)")
+    parser.add_argument("--column", choices=COLUMNS, default="confidence", help="column of the wide CSV")
+    parser.add_argument("--nodes", help="comma-separated node IDs (default: all)")
+    parser.add_argument("--long", action="store_true", help="time,node,<every column> rows")
+    parser.add_argument("--stats", action="store_true", help="per-frame min/mean/max of --column")
+    args = parser.parse_args()
+
+    snap = SnapshotFile(args.input)
+    selected: Optional[List[int]] = None
+    if args.nodes:
+        index = {node_id: i for i, node_id in enumerate(snap.node_ids)}
+        wanted = [int(item) for item in args.nodes.split(",")]
+        missing = [node_id for node_id in wanted if node_id not in index]
+        if missing:
+            print(f"unknown node IDs: {missing}", file=sys.stderr)
+            return 1
+        selected = [index[node_id] for node_id in wanted]
+    indices = selected if selected is not None else list(range(snap.node_count))
+
+    out = args.output.open("w", newline="") if args.output else sys.stdout
+    try:
+        writer = csv.writer(out)
+        column = COLUMNS.index(args.column)
+        scale = snap.scales[column]
+        if args.long:
+            writer.writerow(["time", "node"] + COLUMNS)
+        elif args.stats:
+            writer.writerow(["time", f"min_{args.column}", f"mean_{args.column}", f"max_{args.column}"])
+        else:
+            writer.writerow(["time"] + [snap.node_ids[i] for i in indices])
+
+        for time, columns in snap.iter_frames():
+            if args.long:
+                for i in indices:
+                    confidence, fragments, energy, phase = (columns[c][i] / snap.scales[c]
+                                                            for c in range(len(COLUMNS)))
+                    writer.writerow([f"{time:.3f}", snap.node_ids[i], f"{confidence:.4f}", int(fragments),
+                                     f"{energy:.3f}", PHASES[int(phase)] if int(phase) < len(PHASES) else int(phase)])
+            elif args.stats:
+                values = [columns[column][i] / scale for i in indices]
+                mean = sum(values) / len(values) if values else 0.0
+                writer.writerow([f"{time:.3f}", f"{min(values, default=0.0):g}", f"{mean:g}",
+                                 f"{max(values, default=0.0):g}"])
+            else:
+                writer.writerow([f"{time:.3f}"] + [f"{columns[column][i] / scale:g}" for i in indices])
+    finally:
+        if args.output:
+            out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
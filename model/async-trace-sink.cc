@@ -0,0 +1,455 @@
+#include "async-trace-sink.h"
+#include "wsn-profiler.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef WSN_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ns3 {
+namespace wsn {
+
+namespace {
+
+// Pending bytes that make the producer wake the writer early; below this
+// the writer picks data up on its periodic poll.
+constexpr size_t kWakeBytes = 64 * 1024;
+constexpr auto kWriterPoll = std::chrono::milliseconds(10);
+constexpr size_t kStreamBufferBytes = 16 * 1024;
+constexpr size_t kDeflateOutBytes = 256 * 1024;
+
+size_t RoundUpPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+} // namespace
+
+/**
+ * Buffers stream output locally and queues the complete lines of each
+ * flush as one record; a trailing partial line is carried over, so DROP
+ * never splits a line. A line longer than the buffer grows it.
+ */
+class AsyncTraceSink::StreamBuffer : public std::streambuf
+{
+public:
+    explicit StreamBuffer(AsyncTraceSink &sink)
+        : m_sink(sink),
+          m_buffer(kStreamBufferBytes)
+    {
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    }
+
+    /**
+     * Queue the pending bytes up to the last newline, or all of them.
+     */
+    void Push(bool partialLine)
+    {
+        const size_t pending = static_cast<size_t>(pptr() - pbase());
+        size_t cut = pending;
+        if (!partialLine)
+        {
+            while (cut > 0 && m_buffer[cut - 1] != '\n')
+                cut--;
+        }
+        if (cut > 0)
+            m_sink.Write(m_buffer.data(), cut);
+
+        const size_t rest = pending - cut;
+        std::memmove(m_buffer.data(), m_buffer.data() + cut, rest);
+        if (rest == m_buffer.size())
+            m_buffer.resize(m_buffer.size() * 2);
+        else if (rest < kStreamBufferBytes && m_buffer.size() > kStreamBufferBytes)
+            m_buffer.resize(kStreamBufferBytes); // back to normal records after a long line
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        pbump(static_cast<int>(rest));
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        Push(false);
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override
+    {
+        Push(false);
+        return 0;
+    }
+
+private:
+    AsyncTraceSink &m_sink;
+    std::vector<char> m_buffer;
+};
+
+/**
+ * gzip encoder of the writer thread.
+ */
+class AsyncTraceSink::Deflater
+{
+public:
+    Deflater()
+        : m_out(kDeflateOutBytes)
+    {
+#ifdef WSN_HAVE_ZLIB
+        m_stream = z_stream{};
+        // windowBits 15 + 16: gzip wrapper instead of zlib
+        m_ok = deflateInit2(&m_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                            Z_DEFAULT_STRATEGY) == Z_OK;
+#endif
+    }
+
+    ~Deflater()
+    {
+#ifdef WSN_HAVE_ZLIB
+        if (m_ok)
+            deflateEnd(&m_stream);
+#endif
+    }
+
+    bool IsOk() const { return m_ok; }
+
+    /**
+     * Compress data; every full output buffer is passed to sink.
+     */
+    template <typename Sink>
+    void Compress(const char *data, size_t size, bool finish, Sink &&sink)
+    {
+#ifdef WSN_HAVE_ZLIB
+        m_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        m_stream.avail_in = static_cast<uInt>(size);
+        const int flush = finish ? Z_FINISH : Z_NO_FLUSH;
+        int ret = Z_OK;
+        do
+        {
+            m_stream.next_out = reinterpret_cast<Bytef *>(m_out.data());
+            m_stream.avail_out = static_cast<uInt>(m_out.size());
+            ret = deflate(&m_stream, flush);
+            const size_t produced = m_out.size() - m_stream.avail_out;
+            if (produced > 0)
+                sink(m_out.data(), produced);
+        } while (m_stream.avail_out == 0 || (finish && ret == Z_OK));
+#else
+        (void)data;
+        (void)size;
+        (void)finish;
+        (void)sink;
+#endif
+    }
+
+private:
+#ifdef WSN_HAVE_ZLIB
+    z_stream m_stream;
+#endif
+    std::vector<char> m_out;
+    bool m_ok = false;
+};
+
+bool AsyncTraceSink::IsGzipAvailable()
+{
+#ifdef WSN_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+AsyncTraceSink::AsyncTraceSink()
+    : m_fd(-1),
+      m_policy(OverflowPolicy::BLOCK),
+      m_mask(0),
+      m_head(0),
+      m_tail(0),
+      m_stop(false),
+      m_lastWakeHead(0),
+      m_bytesWritten(0),
+      m_droppedRecords(0),
+      m_droppedBytes(0),
+      m_blockedWrites(0)
+{
+    m_streamBuffer = std::make_unique<StreamBuffer>(*this);
+    m_stream = std::make_unique<std::ostream>(m_streamBuffer.get());
+}
+
+AsyncTraceSink::~AsyncTraceSink()
+{
+    Close();
+}
+
+bool AsyncTraceSink::Open(const std::string &path,
+                          size_t capacityBytes,
+                          OverflowPolicy policy,
+                          bool append,
+                          Compression compression)
+{
+    Close();
+
+    m_deflater.reset();
+    if (compression == Compression::GZIP)
+    {
+        if (IsGzipAvailable())
+        {
+            m_deflater = std::make_unique<Deflater>();
+        }
+        else
+        {
+            std::cerr << "[AsyncTraceSink] Built without zlib, writing " << path
+                      << " uncompressed" << std::endl;
+        }
+    }
+
+    const int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+    m_fd = ::open(path.c_str(), flags, 0644);
+    if (m_fd < 0)
+    {
+        std::cerr << "[AsyncTraceSink] Could not open file: " << path << std::endl;
+        return false;
+    }
+
+    m_policy = policy;
+    m_ring.assign(RoundUpPowerOfTwo(std::max<size_t>(capacityBytes, kWakeBytes)), 0);
+    m_mask = m_ring.size() - 1;
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_stop.store(false, std::memory_order_relaxed);
+    m_lastWakeHead = 0;
+    m_bytesWritten.store(0, std::memory_order_relaxed);
+    m_droppedRecords = 0;
+    m_droppedBytes = 0;
+    m_blockedWrites = 0;
+    m_stream->clear();
+
+    m_writer = std::thread(&AsyncTraceSink::WriterLoop, this);
+    m_destroyEvent = Simulator::ScheduleDestroy(&AsyncTraceSink::Close, this);
+    return true;
+}
+
+void AsyncTraceSink::Close()
+{
+    if (m_fd < 0)
+        return;
+
+    m_stream->flush();
+    m_streamBuffer->Push(true);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop.store(true, std::memory_order_release);
+    }
+    m_dataReady.notify_one();
+    m_writer.join();
+
+    ::close(m_fd);
+    m_fd = -1;
+    Simulator::Cancel(m_destroyEvent);
+
+    if (m_droppedRecords > 0)
+    {
+        std::cerr << "[AsyncTraceSink] Dropped " << m_droppedRecords << " records ("
+                  << m_droppedBytes << " bytes) on overflow" << std::endl;
+    }
+}
+
+bool AsyncTraceSink::IsOpen() const
+{
+    return m_fd >= 0;
+}
+
+std::ostream &AsyncTraceSink::GetStream()
+{
+    return *m_stream;
+}
+
+void AsyncTraceSink::WakeWriter()
+{
+    m_lastWakeHead = m_head.load(std::memory_order_relaxed);
+    m_dataReady.notify_one();
+}
+
+bool AsyncTraceSink::WaitForSpace(size_t size)
+{
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (m_ring.size() - (head - m_tail.load(std::memory_order_acquire)) >= size)
+        return true;
+
+    if (m_policy == OverflowPolicy::DROP)
+        return false;
+
+    WSN_PROFILE_SCOPE("log.AsyncTraceSink::Blocked");
+    m_blockedWrites++;
+    WakeWriter();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_spaceFreed.wait(lock, [&] {
+        return m_ring.size() - (head - m_tail.load(std::memory_order_acquire)) >= size;
+    });
+    return true;
+}
+
+void AsyncTraceSink::CopyIn(uint64_t head, const char *data, size_t size)
+{
+    const size_t offset = static_cast<size_t>(head & m_mask);
+    const size_t first = std::min(size, m_ring.size() - offset);
+    std::memcpy(m_ring.data() + offset, data, first);
+    std::memcpy(m_ring.data(), data + first, size - first);
+    m_head.store(head + size, std::memory_order_release);
+}
+
+bool AsyncTraceSink::Write(const void *data, size_t size)
+{
+    if (m_fd < 0 || size == 0)
+        return m_fd >= 0;
+
+    const char *bytes = static_cast<const char *>(data);
+    if (size > m_ring.size() && m_policy == OverflowPolicy::DROP)
+    {
+        m_droppedRecords++;
+        m_droppedBytes += size;
+        return false;
+    }
+
+    // Oversized records (BLOCK only) go through the ring in ring-sized pieces
+    while (size > 0)
+    {
+        const size_t chunk = std::min(size, m_ring.size());
+        if (!WaitForSpace(chunk))
+        {
+            m_droppedRecords++;
+            m_droppedBytes += size;
+            return false;
+        }
+        CopyIn(m_head.load(std::memory_order_relaxed), bytes, chunk);
+        bytes += chunk;
+        size -= chunk;
+    }
+
+    if (m_head.load(std::memory_order_relaxed) - m_lastWakeHead >= kWakeBytes)
+        WakeWriter();
+    return true;
+}
+
+void AsyncTraceSink::Flush()
+{
+    if (m_fd < 0)
+        return;
+
+    m_stream->flush();
+    const uint64_t target = m_head.load(std::memory_order_relaxed);
+    WakeWriter();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_spaceFreed.wait(lock, [&] { return m_tail.load(std::memory_order_acquire) >= target; });
+}
+
+void AsyncTraceSink::WriterLoop()
+{
+    while (true)
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+
+        if (head == tail)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_stop.load(std::memory_order_acquire))
+            {
+                // Close() runs on the producer thread, so nothing follows stop
+                if (m_head.load(std::memory_order_acquire) == tail)
+                {
+                    WriteOut(nullptr, 0, true);
+                    break;
+                }
+                continue;
+            }
+            m_dataReady.wait_for(lock, kWriterPoll);
+            continue;
+        }
+
+        // One write() (or deflate pass) per contiguous span of the ring
+        const size_t offset = static_cast<size_t>(tail & m_mask);
+        const size_t span = static_cast<size_t>(std::min<uint64_t>(head - tail, m_ring.size() - offset));
+        WriteOut(m_ring.data() + offset, span, false);
+        tail += span;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tail.store(tail, std::memory_order_release);
+        }
+        m_spaceFreed.notify_all();
+    }
+}
+
+void AsyncTraceSink::WriteOut(const char *data, size_t size, bool finish)
+{
+    if (m_deflater && m_deflater->IsOk())
+    {
+        m_deflater->Compress(data, size, finish,
+                             [this](const char *out, size_t n) { WriteFile(out, n); });
+        return;
+    }
+    if (size > 0)
+        WriteFile(data, size);
+}
+
+void AsyncTraceSink::WriteFile(const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        const ssize_t written = ::write(m_fd, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            // Discard rather than spin; the producer must not deadlock
+            std::cerr << "[AsyncTraceSink] write failed: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        m_bytesWritten.fetch_add(static_cast<uint64_t>(written), std::memory_order_relaxed);
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+uint64_t AsyncTraceSink::GetBytesQueued() const
+{
+    return m_head.load(std::memory_order_relaxed);
+}
+
+uint64_t AsyncTraceSink::GetBytesWritten() const
+{
+    return m_bytesWritten.load(std::memory_order_relaxed);
+}
+
+uint64_t AsyncTraceSink::GetDroppedRecords() const
+{
+    return m_droppedRecords;
+}
+
+uint64_t AsyncTraceSink::GetDroppedBytes() const
+{
+    return m_droppedBytes;
+}
+
+uint64_t AsyncTraceSink::GetBlockedWrites() const
+{
+    return m_blockedWrites;
+}
+
+} // namespace wsn
+} // namespace ns3
@@ -0,0 +1,158 @@
+#ifndef WSN_ASYNC_TRACE_SINK_H
+#define WSN_ASYNC_TRACE_SINK_H
+
+#pragma once
+#include "ns3/event-id.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+
+/**
+ * Background file writer for traces and result logs.
+ *
+ * The simulation thread (single producer) copies each record into a
+ * bounded lock-free byte ring; a writer thread drains it to the file with
+ * large write() calls, so disk latency never stalls event processing.
+ * Records are opaque bytes (preformatted text or binary) and are either
+ * queued whole or not at all; the stream view queues whole lines.
+ *
+ * The writer thread can also gzip the stream (builds with WSN_ENABLE_ZLIB),
+ * so compression costs nothing on the simulation thread.
+ *
+ * The sink is closed (drained, thread joined) on Simulator::Destroy, on
+ * Close() or on destruction, whichever comes first.
+ */
+class AsyncTraceSink
+{
+public:
+    /**
+     * What Write() does when the ring has no room for a record.
+     */
+    enum class OverflowPolicy : uint8_t
+    {
+        BLOCK = 0, ///< Wait for the writer thread (lossless)
+        DROP = 1   ///< Discard the record and count it
+    };
+
+    /**
+     * File encoding applied by the writer thread.
+     */
+    enum class Compression : uint8_t
+    {
+        NONE = 0,
+        GZIP = 1 ///< gzip member; falls back to NONE without zlib
+    };
+
+    /**
+     * \return true if the library was built with zlib (GZIP is honoured)
+     */
+    static bool IsGzipAvailable();
+
+    AsyncTraceSink();
+    ~AsyncTraceSink();
+
+    AsyncTraceSink(const AsyncTraceSink&) = delete;
+    AsyncTraceSink& operator=(const AsyncTraceSink&) = delete;
+
+    /**
+     * Open the file and start the writer thread.
+     *
+     * \param path Output file
+     * \param capacityBytes Ring size (rounded up to a power of two)
+     * \param policy Overflow policy
+     * \param append Append instead of truncating
+     * \param compression File encoding
+     * \return false if the file cannot be opened
+     */
+    bool Open(const std::string& path,
+              size_t capacityBytes,
+              OverflowPolicy policy,
+              bool append = false,
+              Compression compression = Compression::NONE);
+
+    /**
+     * Drain the ring, stop the writer thread and close the file.
+     */
+    void Close();
+
+    bool IsOpen() const;
+
+    /**
+     * Queue one record. Simulation thread only.
+     *
+     * \param data Record bytes
+     * \param size Record size
+     * \return false if the record was dropped (DROP policy) or the sink is closed
+     */
+    bool Write(const void* data, size_t size);
+
+    /**
+     * Block until every queued record has been handed to the OS.
+     */
+    void Flush();
+
+    /**
+     * Stream view of the sink, e.g. as a scenario g_resultFileStream target.
+     * Buffered; each flush queues the complete lines as one record and keeps
+     * a trailing partial line until more text or Close().
+     */
+    std::ostream& GetStream();
+
+    uint64_t GetBytesQueued() const;  ///< Bytes accepted from the producer
+    uint64_t GetBytesWritten() const; ///< Bytes written to the file (compressed)
+    uint64_t GetDroppedRecords() const;
+    uint64_t GetDroppedBytes() const;
+    uint64_t GetBlockedWrites() const; ///< Writes that waited for space
+
+private:
+    class StreamBuffer;
+    class Deflater;
+
+    void WriterLoop();
+    void WriteOut(const char* data, size_t size, bool finish);
+    void WriteFile(const char* data, size_t size);
+    void WakeWriter();
+    bool WaitForSpace(size_t size);
+    void CopyIn(uint64_t head, const char* data, size_t size);
+
+    int m_fd;
+    OverflowPolicy m_policy;
+    std::unique_ptr<Deflater> m_deflater; ///< Writer thread only; null = raw
+    std::vector<char> m_ring;
+    size_t m_mask;
+
+    alignas(64) std::atomic<uint64_t> m_head; ///< Bytes queued (producer)
+    alignas(64) std::atomic<uint64_t> m_tail; ///< Bytes written (writer thread)
+    alignas(64) std::atomic<bool> m_stop;
+    uint64_t m_lastWakeHead; ///< Producer only
+
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_dataReady; ///< Producer -> writer
+    std::condition_variable m_spaceFreed; ///< Writer -> producer
+
+    std::unique_ptr<StreamBuffer> m_streamBuffer;
+    std::unique_ptr<std::ostream> m_stream;
+    EventId m_destroyEvent;
+
+    std::atomic<uint64_t> m_bytesWritten;
+    uint64_t m_droppedRecords;
+    uint64_t m_droppedBytes;
+    uint64_t m_blockedWrites;
+};
+
+} // namespace wsn
+} // namespace ns3
+
+#endif // WSN_ASYNC_TRACE_SINK_H
@@ -8,6 +8,7 @@
 
 #include "cc2420-phy.h"
 #include "../../propagation/cc2420-spectrum-propagation-loss-model.h"
+#include "../../wsn-profiler.h"
 
 #include "ns3/boolean.h"
 #include "ns3/double.h"
@@ -115,6 +116,8 @@ Cc2420ContactWindowModel::HasContactForPacket(Ptr<const Cc2420Phy> txPhy,
                                               Ptr<const Cc2420Phy> rxPhy,
                                               uint32_t packetSizeBytes) const
 {
+    WSN_PROFILE_SCOPE("contact.HasContactForPacket");
+
     if (!m_enabled || packetSizeBytes == 0)
     {
         return true;
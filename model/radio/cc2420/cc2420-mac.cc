@@ -6,6 +6,8 @@
 
 #include "cc2420-mac.h"
 #include "cc2420-contact-window-model.h"
+#include "../../wsn-metrics.h"
+#include "../../wsn-profiler.h"
 
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -25,6 +27,10 @@ namespace wsn
 namespace
 {
 std::vector<Cc2420Mac*> g_allMacs;
+
+// Registry metrics (wsn-metrics.h)
+const Counter g_metricMacTx("mac.cc2420.tx_frames");
+const Counter g_metricMacRx("mac.cc2420.rx_frames");
 }
 
 NS_LOG_COMPONENT_DEFINE("Cc2420Mac");
@@ -127,6 +133,7 @@ Cc2420Mac::McpsDataRequest(Ptr<Packet> packet, Mac16Address destAddr, bool reque
 {
     NS_LOG_FUNCTION(this << packet << destAddr << requestAck);
     EmitDebugTrace("McpsDataRequest", packet);
+    WSN_PROFILE_SCOPE("mac.McpsDataRequest");
 
     if (!packet)
     {
@@ -136,6 +143,7 @@ Cc2420Mac::McpsDataRequest(Ptr<Packet> packet, Mac16Address destAddr, bool reque
     // Minimal functional MAC path: send through CC2420 MAC and dispatch to peers.
     // This keeps all traffic traversing cc2420-mac while PHY is still skeleton.
     m_txCount++;
+    g_metricMacTx.Add();
 
     const bool isBroadcast = (destAddr == Mac16Address("FF:FF"));
     const Mac16Address src = m_config.shortAddress;
@@ -259,6 +267,7 @@ Cc2420Mac::FrameReceptionCallback(Ptr<Packet> packet, double rssi, uint8_t lqi)
     NS_LOG_FUNCTION(this << packet << rssi << (uint16_t)lqi);
     EmitDebugTrace("FrameReceptionCallback", packet);
     m_rxCount++;
+    g_metricMacRx.Add();
 }
 
 void
@@ -6,6 +6,7 @@
 
 #include "cc2420-phy.h"
 #include "../../propagation/cc2420-spectrum-propagation-loss-model.h"
+#include "../../wsn-profiler.h"
 
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -349,6 +350,8 @@ Cc2420Phy::EvaluateReceptionFrom(Ptr<Cc2420Phy> txPhy,
                                   uint8_t& lqi,
                                   uint32_t packetSizeBytes)
 {
+    WSN_PROFILE_SCOPE("phy.EvaluateReceptionFrom");
+
     // Default outputs for safety
     rssiDbm = m_noiseFloorDbm;
     lqi = 0;
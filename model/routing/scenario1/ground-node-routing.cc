@@ -5,6 +5,7 @@
  */
 
 #include "ground-node-routing.h"
+#include "../../wsn-metrics.h"
 #include "fragment.h"
 
 #include "ns3/cc2420-net-device.h"
@@ -33,6 +34,10 @@ uint32_t g_groundTotalTx = 0;
 uint32_t g_groundTotalRx = 0;
 std::map<uint32_t, uint32_t> g_groundRxPerNode;
 
+// Registry metrics (wsn-metrics.h)
+const Counter g_metricGroundTx("ground.tx_packets");
+const Counter g_metricGroundRx("ground.rx_packets");
+
 struct GroundLogicState
 {
     uint32_t packetsReceived = 0;
@@ -73,6 +78,7 @@ static void
 OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<Packet> packet, Mac16Address src, double rssiDbm)
 {
     g_groundTotalRx++;
+    g_metricGroundRx.Add();
     g_groundRxPerNode[nodeId]++;
 
     // Try to extract fragment header
@@ -158,6 +164,7 @@ SendGroundPacketFrom(NodeContainer nodes, uint32_t srcNodeId, Mac16Address dst,
     if (dev->Send(p, dst, 0))
     {
         g_groundTotalTx++;
+        g_metricGroundTx.Add();
         NS_LOG_DEBUG("Ground Node " << srcNodeId << " TX to " << dst << " size=" << packetSize);
     }
 }
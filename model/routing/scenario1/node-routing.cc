@@ -5,6 +5,7 @@
  */
 
 #include "node-routing.h"
+#include "../../wsn-metrics.h"
 
 #include "ns3/cc2420-net-device.h"
 #include "ns3/cc2420-mac.h"
@@ -28,6 +29,10 @@ namespace
 uint32_t g_totalTx = 0;
 uint32_t g_totalRx = 0;
 std::map<uint32_t, uint32_t> g_rxPerNode;
+
+// Registry metrics (wsn-metrics.h)
+const Counter g_metricTx("node.tx_packets");
+const Counter g_metricRx("node.rx_packets");
 } // anonymous namespace
 
 /**
@@ -37,6 +42,7 @@ static void
 OnNodeReceivePacket(uint32_t nodeId, Ptr<Packet> packet, Mac16Address src, double rssiDbm)
 {
     g_totalRx++;
+    g_metricRx.Add();
     g_rxPerNode[nodeId]++;
 
     NS_LOG_INFO("t=" << Simulator::Now().GetSeconds() << "s Node " << nodeId 
@@ -79,6 +85,7 @@ SendPacketFrom(NodeContainer nodes, uint32_t srcNodeId, Mac16Address dst, uint32
     if (dev->Send(p, dst, 0))
     {
         g_totalTx++;
+        g_metricTx.Add();
         NS_LOG_DEBUG("Node " << srcNodeId << " TX to " << dst << " size=" << packetSize);
     }
 }
@@ -5,6 +5,7 @@
  */
 
 #include "uav-node-routing.h"
+#include "../../wsn-metrics.h"
 #include "ground-node-routing.h"
 #include "fragment.h"
 
@@ -34,6 +35,10 @@ uint32_t g_uavTotalTx = 0;
 uint32_t g_uavTotalRx = 0;
 std::map<uint32_t, uint32_t> g_uavRxPerNode;
 
+// Registry metrics (wsn-metrics.h)
+const Counter g_metricUavTx("uav.tx_packets");
+const Counter g_metricUavRx("uav.rx_packets");
+
 struct UavLogicFragment
 {
     uint32_t fragmentId;
@@ -69,6 +74,7 @@ static void
 OnUavNodeReceivePacket(uint32_t nodeId, Ptr<Packet> packet, Mac16Address src, double rssiDbm)
 {
     g_uavTotalRx++;
+    g_metricUavRx.Add();
     g_uavRxPerNode[nodeId]++;
 
     NS_LOG_INFO("t=" << Simulator::Now().GetSeconds() << "s UAV Node " << nodeId 
@@ -144,6 +150,7 @@ SendUavPacketFrom(NodeContainer nodes, uint32_t srcNodeId, Mac16Address dst, uin
     if (dev->Send(p, dst, 0))
     {
         g_uavTotalTx++;
+        g_metricUavTx.Add();
         NS_LOG_DEBUG("UAV Node " << srcNodeId << " TX to " << dst << " size=" << p->GetSize());
     }
 }
@@ -5,6 +5,7 @@
  */
 
 #include "uav-node-routing.h"
+#include "../../wsn-metrics.h"
 
 #include "fragment.h"
 #include "../../../examples/scenarios/scenario3.h"
@@ -33,6 +34,9 @@ namespace
 uint32_t g_uavTotalTransmissions = 0;
 uint32_t g_uavTotalReceptions = 0;
 
+// Registry metrics (wsn-metrics.h)
+const Counter g_metricUavTx("uav.tx_packets");
+
 // Per-UAV fragment round-robin index
 std::map<uint32_t, uint32_t> g_fragmentIndex;
 std::map<uint32_t, uint32_t> g_sequenceNumber;
@@ -169,6 +173,7 @@ ScheduleUavPeriodicBroadcasts(NodeContainer nodes,
             if (dev->Send(packet, broadcast, 0))
             {
                 g_uavTotalTransmissions++;
+                g_metricUavTx.Add();
                 NS_LOG_INFO("UAV node " << uavNodeId << " (index=" << uavIndex 
                             << ") TX broadcast, size=" << packet->GetSize() << " bytes");
             }
@@ -5,7 +5,10 @@
 #include "base-station-node.h"
 #include "fragment-generator.h"
 #include "../helper/calc-utils.h"
+#include "../helper/kmeans.h"
+#include "../ground-node-routing/cell-cooperation.h"
 #include "../ground-node-routing/ground-node-routing.h"
+#include "../../../wsn-profiler.h"
 #include "../../../../examples/scenarios/scenario4/scenario4-params.h"
 #include "region-selection.h"
 #include "uav-control.h"
@@ -13,7 +16,9 @@
 #include "ns3/mobility-model.h"
 #include "ns3/node-list.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/simulator.h"
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -96,6 +101,7 @@ AssignCellIdAndColorForGroundNodes(double cellRadius)
         }
     }
 
+    InitializeCellCooperation();
 
     NS_LOG_INFO("[BS-INIT] Assigned cellId/cellColor for " << updatedCount
         << " ground nodes (gridOffset=" << gridOffset << ")");
@@ -952,19 +958,18 @@ GenerateFragmentsForBsInit()
     FragmentCollection generated = GenerateBsFragments(fragmentCount);
     SetBsGeneratedFragments(generated);
 
-    NS_LOG_INFO("[BS-FRAGMENT] Generated " << generated.fragments.size()
+    NS_LOG_INFO("[BS-FRAGMENT] Generated " << generated.GetCount()
                 << " fragments at BS init"
                 << " | totalConfidence=" << std::fixed << std::setprecision(3)
-                << generated.totalConfidence);
+                << generated.GetTotalConfidence());
 
     // TODO: in log vào `g_resultFileStream` tại đây
     // Format: [FRAGMENTS] fragmentSize1(confidence1) fragmentSize2(confidence2) ...
     if (ns3::wsn::scenario4::params::g_resultFileStream)
     {        *ns3::wsn::scenario4::params::g_resultFileStream
             << "[FRAGMENTS]";
-        for (int i = 0; i < generated.fragments.size(); ++i)
+        for (const auto& frag : generated)
         {
-            const auto& frag = generated.fragments[i];
             *ns3::wsn::scenario4::params::g_resultFileStream
                 << " " << frag.size << "(" << std::fixed << std::setprecision(3) << frag.confidence << ")";
         }
@@ -1145,97 +1150,72 @@ PlanUavFlightPathsForBsInit()
             suspiciousPoints.push_back(pos);
         }
 
+        std::vector<double> pointX(suspiciousPoints.size());
+        std::vector<double> pointY(suspiciousPoints.size());
+        for (uint32_t ni = 0; ni < suspiciousPoints.size(); ++ni)
+        {
+            pointX[ni] = suspiciousPoints[ni].x;
+            pointY[ni] = suspiciousPoints[ni].y;
+        }
+
         std::vector<Vector> candidates = suspiciousPoints;
         if (::ns3::wsn::scenario4::params::UAV2_USE_NEW_ALGO &&
             ::ns3::wsn::scenario4::params::UAV2_USE_CENTROIDS &&
             !suspiciousPoints.empty())
         {
             const uint32_t n = static_cast<uint32_t>(suspiciousPoints.size());
-            const uint32_t defaultK = std::max<uint32_t>(1, std::min<uint32_t>(
+            const uint32_t autoK = std::max<uint32_t>(1, std::min<uint32_t>(
                 ::ns3::wsn::scenario4::params::UAV2_NUM_CENTROIDS_MAX,
                 n / 4));
-            const uint32_t k = std::min<uint32_t>(defaultK, n);
-
-            if (k > 0)
+            const uint32_t requestedK = ::ns3::wsn::scenario4::params::g_uav2KmeansNumCentroids;
+
+            helper::KMeansOptions kmeansOptions;
+            kmeansOptions.k = std::min<uint32_t>((requestedK > 0) ? requestedK : autoK, n);
+            kmeansOptions.maxIter = ::ns3::wsn::scenario4::params::UAV2_KMEANS_MAX_ITER;
+            kmeansOptions.tolerance = ::ns3::wsn::scenario4::params::g_uav2KmeansTolerance;
+            kmeansOptions.useHamerly = ::ns3::wsn::scenario4::params::UAV2_KMEANS_USE_PRUNING;
+            // Derived from the run seed so seeding does not consume simulator streams
+            kmeansOptions.seed = (static_cast<uint64_t>(RngSeedManager::GetSeed()) << 32) ^
+                                 RngSeedManager::GetRun();
+
+            const auto kmeansStart = std::chrono::steady_clock::now();
+            const helper::KMeansResult kmeans = helper::RunKMeans(pointX, pointY, kmeansOptions);
+            const double kmeansMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - kmeansStart).count();
+
+            for (uint32_t c = 0; c < kmeans.centerX.size(); ++c)
             {
-                std::vector<Vector> centers;
-                centers.reserve(k);
-                for (uint32_t i = 0; i < k; ++i)
-                {
-                    const uint32_t idx = (i * n) / k;
-                    centers.push_back(suspiciousPoints[idx]);
-                }
-
-                std::vector<uint32_t> assignment(n, 0);
-                const uint32_t maxIter = ::ns3::wsn::scenario4::params::UAV2_KMEANS_MAX_ITER;
-                for (uint32_t iter = 0; iter < maxIter; ++iter)
-                {
-                    for (uint32_t p = 0; p < n; ++p)
-                    {
-                        double bestD2 = std::numeric_limits<double>::max();
-                        uint32_t bestC = 0;
-                        for (uint32_t c = 0; c < k; ++c)
-                        {
-                            const double dx = suspiciousPoints[p].x - centers[c].x;
-                            const double dy = suspiciousPoints[p].y - centers[c].y;
-                            const double d2 = dx * dx + dy * dy;
-                            if (d2 < bestD2)
-                            {
-                                bestD2 = d2;
-                                bestC = c;
-                            }
-                        }
-                        assignment[p] = bestC;
-                    }
-
-                    std::vector<double> sumX(k, 0.0);
-                    std::vector<double> sumY(k, 0.0);
-                    std::vector<uint32_t> count(k, 0);
-                    for (uint32_t p = 0; p < n; ++p)
-                    {
-                        const uint32_t c = assignment[p];
-                        sumX[c] += suspiciousPoints[p].x;
-                        sumY[c] += suspiciousPoints[p].y;
-                        count[c]++;
-                    }
-
-                    double maxShift = 0.0;
-                    for (uint32_t c = 0; c < k; ++c)
-                    {
-                        if (count[c] == 0)
-                        {
-                            continue;
-                        }
-                        const Vector newCenter(sumX[c] / count[c], sumY[c] / count[c], altitude);
-                        const double shift = helper::CalculateDistance(
-                            centers[c].x, centers[c].y, newCenter.x, newCenter.y);
-                        maxShift = std::max(maxShift, shift);
-                        centers[c] = newCenter;
-                    }
-
-                    if (maxShift < 1e-3)
-                    {
-                        break;
-                    }
-                }
+                candidates.push_back(Vector(kmeans.centerX[c], kmeans.centerY[c], altitude));
+            }
 
-                candidates.insert(candidates.end(), centers.begin(), centers.end());
+            NS_LOG_INFO("[BS-UAV-PATH] UAV2: k-means centroids"
+                        << " | k=" << kmeans.centerX.size()
+                        << " | iterations=" << kmeans.iterations
+                        << " | converged=" << (kmeans.converged ? "yes" : "no")
+                        << " | distanceEvals=" << kmeans.distanceEvaluations
+                        << " | elapsed=" << std::fixed << std::setprecision(3) << kmeansMs << "ms");
+            if (::ns3::wsn::scenario4::params::g_resultFileStream)
+            {
+                *::ns3::wsn::scenario4::params::g_resultFileStream
+                    << "[UAV2-KMEANS] points=" << n
+                    << " k=" << kmeans.centerX.size()
+                    << " iterations=" << kmeans.iterations
+                    << " converged=" << (kmeans.converged ? 1 : 0)
+                    << " distanceEvals=" << kmeans.distanceEvaluations
+                    << std::endl;
             }
         }
 
-        std::vector<std::vector<uint32_t>> coverageSets(candidates.size());
+        // Coverage lists from a spatial grid at broadcastRadius (same sets as a full scan)
+        std::vector<double> candidateX(candidates.size());
+        std::vector<double> candidateY(candidates.size());
         for (uint32_t ci = 0; ci < candidates.size(); ++ci)
         {
-            for (uint32_t ni = 0; ni < suspiciousPoints.size(); ++ni)
-            {
-                const double dist = helper::CalculateDistance(
-                    candidates[ci].x, candidates[ci].y, suspiciousPoints[ni].x, suspiciousPoints[ni].y);
-                if (dist <= broadcastRadius)
-                {
-                    coverageSets[ci].push_back(ni);
-                }
-            }
+            candidateX[ci] = candidates[ci].x;
+            candidateY[ci] = candidates[ci].y;
         }
+        std::vector<std::vector<uint32_t>> coverageSets;
+        helper::BuildCoverageLists(candidateX, candidateY, pointX, pointY, broadcastRadius, coverageSets);
 
         std::vector<bool> covered(suspiciousPoints.size(), false);
         uint32_t coveredCount = 0;
@@ -1527,12 +1507,13 @@ void
 routing::BaseStationNode::Initialize()
 {
     NS_LOG_FUNCTION(this);
+    WSN_PROFILE_SCOPE("bs.Initialize");
     
     NS_LOG_INFO("BS Node " << m_nodeId << " initialized");
 
     // Write to global result file if open
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "\n=== Base Station Initialization ===" << std::endl
@@ -1543,9 +1524,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 1: tính cellId + cellColor cho từng ground node từ position hiện tại
-    AssignCellIdAndColorForGroundNodes(::ns3::wsn::scenario4::params::HEX_CELL_RADIUS);
+    {
+        WSN_PROFILE_SCOPE("bs.init.assign_cells");
+        AssignCellIdAndColorForGroundNodes(::ns3::wsn::scenario4::params::HEX_CELL_RADIUS);
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "Step 1: Assign Cell ID and Color" << std::endl
@@ -1556,9 +1540,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 2: neighbor + 2-hop discovery theo bán kính truyền tin
-    DiscoverNeighborsAndTwoHopsForGroundNodes(::ns3::wsn::scenario4::params::NEIGHBOR_DISCOVERY_RADIUS);
+    {
+        WSN_PROFILE_SCOPE("bs.init.discover_neighbors");
+        DiscoverNeighborsAndTwoHopsForGroundNodes(::ns3::wsn::scenario4::params::NEIGHBOR_DISCOVERY_RADIUS);
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         uint32_t totalNeighbors = 0;
         for (const auto& [nodeId, state] : g_groundNetworkPerNode)
@@ -1574,9 +1561,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 3: chọn cell leader (CL) gần tâm cell nhất
-    SelectCellLeadersByNearestCellCenter(::ns3::wsn::scenario4::params::HEX_CELL_RADIUS);
+    {
+        WSN_PROFILE_SCOPE("bs.init.select_leaders");
+        SelectCellLeadersByNearestCellCenter(::ns3::wsn::scenario4::params::HEX_CELL_RADIUS);
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         uint32_t leaderCount = 0;
         std::map<int32_t, uint32_t> cellLeaders;
@@ -1601,9 +1591,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 4: chọn gateway pairs cho cross-cell communication
-    SelectCrosscellGatewayPairs(::ns3::wsn::scenario4::params::NEIGHBOR_DISCOVERY_RADIUS);
+    {
+        WSN_PROFILE_SCOPE("bs.init.select_gateways");
+        SelectCrosscellGatewayPairs(::ns3::wsn::scenario4::params::NEIGHBOR_DISCOVERY_RADIUS);
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         uint32_t gatewayPairCount = 0;
         for (const auto& [cellId, neighbors] : ::ns3::wsn::scenario4::params::g_cellGatewayPairs)
@@ -1618,9 +1611,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 5: xây dựng intra-cell routing trees cho mỗi cell
-    BuildIntraCellRoutingTrees();
+    {
+        WSN_PROFILE_SCOPE("bs.init.build_trees");
+        BuildIntraCellRoutingTrees();
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "Step 5: Build Intra-Cell Routing Trees" << std::endl
@@ -1630,9 +1626,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 6: bổ sung route để đảm bảo reachability tới neighboring cells
-    EnhanceRoutingTreesForGatewayAccess();
+    {
+        WSN_PROFILE_SCOPE("bs.init.enhance_trees");
+        EnhanceRoutingTreesForGatewayAccess();
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "Step 6: Enhance Routing for Gateway Access" << std::endl
@@ -1642,9 +1641,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 7: kiểm tra tính hợp lệ của routing trees
-    ValidateIntraCellRoutingTrees();
+    {
+        WSN_PROFILE_SCOPE("bs.init.validate_trees");
+        ValidateIntraCellRoutingTrees();
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "Step 7: Validate Routing Trees" << std::endl
@@ -1654,9 +1656,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 8: cập nhật các biến trạng thái còn lại
-    FinalizeGroundNodeStateFields();
+    {
+        WSN_PROFILE_SCOPE("bs.init.finalize_state");
+        FinalizeGroundNodeStateFields();
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "Step 8: Finalize Ground Node States" << std::endl
@@ -1666,9 +1671,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 9: chọn vùng khả nghi cho UAV flight planning
-    SelectSuspiciousRegionForBsInit();
+    {
+        WSN_PROFILE_SCOPE("bs.init.select_region");
+        SelectSuspiciousRegionForBsInit();
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "Step 9: Select Suspicious Region" << std::endl
@@ -1685,24 +1693,30 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 10: BS generate fragments để UAV broadcast
-    GenerateFragmentsForBsInit();
+    {
+        WSN_PROFILE_SCOPE("bs.init.generate_fragments");
+        GenerateFragmentsForBsInit();
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         const FragmentCollection& fragments = GetBsGeneratedFragments();
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "Step 10: Generate Fragments" << std::endl
-            << "  Total fragments: " << fragments.fragments.size() << std::endl
+            << "  Total fragments: " << fragments.GetCount() << std::endl
             << "  Total confidence: " << std::fixed << std::setprecision(3) 
-            << fragments.totalConfidence << std::endl
+            << fragments.GetTotalConfidence() << std::endl
             << std::endl;
         ::ns3::wsn::scenario4::params::g_resultFileStream->flush();
     }
 
     // Step 11: lên lịch đường bay cho UAV
-    PlanUavFlightPathsForBsInit();
+    {
+        WSN_PROFILE_SCOPE("bs.init.plan_uav_paths");
+        PlanUavFlightPathsForBsInit();
+    }
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         const auto& uavPaths = GetUavFlightPaths();
         *::ns3::wsn::scenario4::params::g_resultFileStream
@@ -1742,7 +1756,7 @@ routing::BaseStationNode::Initialize()
     }
 
     if (::ns3::wsn::scenario4::params::g_resultFileStream && 
-        ::ns3::wsn::scenario4::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario4::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario4::params::g_resultFileStream
             << "=== Base Station Initialization Complete ===" << std::endl
@@ -0,0 +1,115 @@
+/*
+ * Scenario 4 - UAV Fragment Broadcast Schedule Implementation
+ */
+
+#include "broadcast-schedule.h"
+#include "../../../../examples/scenarios/scenario4/scenario4-params.h"
+#include <algorithm>
+#include <numeric>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario4 {
+namespace routing {
+
+// ===== Policies =====
+
+std::vector<uint32_t>
+FragmentIdOrderPolicy::BuildOrder(const std::vector<Fragment>& fragments) const
+{
+    std::vector<uint32_t> order(fragments.size());
+    std::iota(order.begin(), order.end(), 0);
+    return order;
+}
+
+std::string
+FragmentIdOrderPolicy::GetName() const
+{
+    return "fragment-id";
+}
+
+std::vector<uint32_t>
+HighestConfidenceFirstPolicy::BuildOrder(const std::vector<Fragment>& fragments) const
+{
+    std::vector<uint32_t> order(fragments.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&fragments](uint32_t a, uint32_t b) {
+        return fragments[a].confidence > fragments[b].confidence;
+    });
+    return order;
+}
+
+std::string
+HighestConfidenceFirstPolicy::GetName() const
+{
+    return "highest-confidence-first";
+}
+
+std::unique_ptr<BroadcastSchedulePolicy>
+CreateDefaultBroadcastSchedulePolicy()
+{
+    if (::ns3::wsn::scenario4::params::FRAGMENT_BROADCAST_HIGHEST_CONFIDENCE_FIRST)
+    {
+        return std::make_unique<HighestConfidenceFirstPolicy>();
+    }
+    return std::make_unique<FragmentIdOrderPolicy>();
+}
+
+// ===== FragmentBroadcastSchedule =====
+
+void
+FragmentBroadcastSchedule::Build(const FragmentCollection& fragments,
+                                 const BroadcastSchedulePolicy& policy)
+{
+    m_fragments.assign(fragments.begin(), fragments.end());
+    m_order = policy.BuildOrder(m_fragments);
+
+    // Drop out-of-range indices a policy might produce
+    const uint32_t count = static_cast<uint32_t>(m_fragments.size());
+    m_order.erase(std::remove_if(m_order.begin(),
+                                 m_order.end(),
+                                 [count](uint32_t index) { return index >= count; }),
+                  m_order.end());
+}
+
+void
+FragmentBroadcastSchedule::Clear()
+{
+    m_fragments.clear();
+    m_order.clear();
+}
+
+bool
+FragmentBroadcastSchedule::IsEmpty() const
+{
+    return m_order.empty();
+}
+
+uint32_t
+FragmentBroadcastSchedule::GetLength() const
+{
+    return static_cast<uint32_t>(m_order.size());
+}
+
+const Fragment&
+FragmentBroadcastSchedule::GetByRound(uint32_t round) const
+{
+    return m_fragments[m_order[round % m_order.size()]];
+}
+
+const std::vector<Fragment>&
+FragmentBroadcastSchedule::GetFragments() const
+{
+    return m_fragments;
+}
+
+const std::vector<uint32_t>&
+FragmentBroadcastSchedule::GetOrder() const
+{
+    return m_order;
+}
+
+} // namespace routing
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
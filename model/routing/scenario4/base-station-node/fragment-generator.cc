@@ -6,11 +6,31 @@ namespace scenario4 {
 namespace routing {
 
 FragmentCollection g_bsGeneratedFragments;
+FragmentPayloadPool g_bsFragmentPayloadPool;
+FragmentBroadcastSchedule g_bsBroadcastSchedule;
+static std::unique_ptr<BroadcastSchedulePolicy> g_bsBroadcastSchedulePolicy;
+
+static const BroadcastSchedulePolicy&
+GetBsBroadcastSchedulePolicy()
+{
+    if (!g_bsBroadcastSchedulePolicy)
+    {
+        g_bsBroadcastSchedulePolicy = CreateDefaultBroadcastSchedulePolicy();
+    }
+    return *g_bsBroadcastSchedulePolicy;
+}
 
 FragmentCollection
 GenerateBsFragments(uint32_t numFragments)
 {
-    return GenerateFragments(numFragments);
+    g_bsFragmentPayloadPool.Clear();
+    return GenerateFragments(numFragments, g_bsFragmentPayloadPool);
+}
+
+const FragmentPayloadPool&
+GetBsFragmentPayloadPool()
+{
+    return g_bsFragmentPayloadPool;
 }
 
 const FragmentCollection&
@@ -23,6 +43,20 @@ void
 SetBsGeneratedFragments(const FragmentCollection& fragments)
 {
     g_bsGeneratedFragments = fragments;
+    g_bsBroadcastSchedule.Build(g_bsGeneratedFragments, GetBsBroadcastSchedulePolicy());
+}
+
+const FragmentBroadcastSchedule&
+GetBsBroadcastSchedule()
+{
+    return g_bsBroadcastSchedule;
+}
+
+void
+SetBsBroadcastSchedulePolicy(std::unique_ptr<BroadcastSchedulePolicy> policy)
+{
+    g_bsBroadcastSchedulePolicy = std::move(policy);
+    g_bsBroadcastSchedule.Build(g_bsGeneratedFragments, GetBsBroadcastSchedulePolicy());
 }
 
 // Global UAV flight paths storage
@@ -2,8 +2,10 @@
 #define SCENARIO4_FRAGMENT_GENERATOR_H
 
 #include "../fragment.h"
+#include "broadcast-schedule.h"
 #include "base-station-node.h"
 #include <map>
+#include <memory>
 
 namespace ns3 {
 namespace wsn {
@@ -12,9 +14,19 @@ namespace routing {
 
 FragmentCollection GenerateBsFragments(uint32_t numFragments);
 extern FragmentCollection g_bsGeneratedFragments;
+
+// Payloads of the BS-generated fragments; every node's copy shares these
+extern FragmentPayloadPool g_bsFragmentPayloadPool;
+const FragmentPayloadPool& GetBsFragmentPayloadPool();
 const FragmentCollection& GetBsGeneratedFragments();
 void SetBsGeneratedFragments(const FragmentCollection& fragments);
 
+// Broadcast order over the BS fragments, rebuilt by SetBsGeneratedFragments()
+extern FragmentBroadcastSchedule g_bsBroadcastSchedule;
+const FragmentBroadcastSchedule& GetBsBroadcastSchedule();
+// Replace the ordering policy (nullptr restores the params default) and rebuild
+void SetBsBroadcastSchedulePolicy(std::unique_ptr<BroadcastSchedulePolicy> policy);
+
 // Global storage for UAV flight paths (key = uavNodeId, value = flight path)
 extern std::map<uint32_t, UavFlightPath> g_uavFlightPaths;
 const std::map<uint32_t, UavFlightPath>& GetUavFlightPaths();
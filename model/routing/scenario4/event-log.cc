@@ -0,0 +1,446 @@
+/*
+ * Scenario 4 - Binary Result Event Log Implementation
+ */
+
+#include "event-log.h"
+#include "../../wsn-profiler.h"
+#include "../../../examples/scenarios/scenario4/scenario4-params.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <streambuf>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario4 {
+namespace routing {
+
+namespace {
+
+constexpr char kFileMagic[8] = {'W', 'S', 'N', 'E', 'V', 'T', '0', '1'};
+
+enum ColumnType : uint8_t
+{
+    COLUMN_U32 = 1,
+    COLUMN_U64 = 2,
+    COLUMN_F64 = 3,
+    COLUMN_TEXT = 4 ///< u32 length per row + concatenated bytes
+};
+
+struct ColumnSchema
+{
+    ColumnType type;
+    const char* name;
+};
+
+struct TypeSchema
+{
+    EventLogType type;
+    const char* textTemplate;
+    std::vector<ColumnSchema> columns;
+};
+
+const std::vector<TypeSchema>&
+GetSchemas()
+{
+    static const std::vector<TypeSchema> schemas = {
+        {EventLogType::TEXT, "{text}", {{COLUMN_U64, "seq"}, {COLUMN_TEXT, "text"}}},
+        {EventLogType::FRAGMENT_RECEIVED,
+         "{src}-R-{dst}({fragmentId}) ",
+         {{COLUMN_U64, "seq"}, {COLUMN_U32, "src"}, {COLUMN_U32, "dst"}, {COLUMN_U32, "fragmentId"}}},
+        {EventLogType::FRAGMENT_SHARED,
+         "{src}-S-{dst}({fragmentId}) ",
+         {{COLUMN_U64, "seq"}, {COLUMN_U32, "src"}, {COLUMN_U32, "dst"}, {COLUMN_U32, "fragmentId"}}},
+        {EventLogType::CODED_SYMBOL_RECEIVED,
+         "{src}-C-{dst}({symbolIndex}) ",
+         {{COLUMN_U64, "seq"}, {COLUMN_U32, "src"}, {COLUMN_U32, "dst"}, {COLUMN_U32, "symbolIndex"}}},
+        {EventLogType::UAV_FRAGMENT_BROADCAST,
+         "\n[EVENT] {time} | event=UAVFragmentBroadcast | nodeId={nodeId} | fragmentId={fragmentId}"
+         " | cycle={cycle} | confidence={confidence:.3f} | size={size}\n",
+         {{COLUMN_U64, "seq"},
+          {COLUMN_F64, "time"},
+          {COLUMN_U32, "nodeId"},
+          {COLUMN_U32, "fragmentId"},
+          {COLUMN_U32, "cycle"},
+          {COLUMN_F64, "confidence"},
+          {COLUMN_U32, "size"}}},
+        {EventLogType::UAV_CODED_SYMBOL_BROADCAST,
+         "\n[EVENT] {time} | event=UAVCodedSymbolBroadcast | nodeId={nodeId}"
+         " | symbolIndex={symbolIndex} | cycle={cycle}\n",
+         {{COLUMN_U64, "seq"},
+          {COLUMN_F64, "time"},
+          {COLUMN_U32, "nodeId"},
+          {COLUMN_U32, "symbolIndex"},
+          {COLUMN_U32, "cycle"}}},
+    };
+    return schemas;
+}
+
+template <typename T>
+void
+Put(std::vector<uint8_t>& column, T value)
+{
+    const size_t offset = column.size();
+    column.resize(offset + sizeof(T));
+    std::memcpy(column.data() + offset, &value, sizeof(T));
+}
+
+} // namespace
+
+/**
+ * Stream buffer collecting text into the pending TEXT record.
+ */
+class EventLog::TextBuffer : public std::streambuf
+{
+public:
+    explicit TextBuffer(std::string& sink)
+        : m_sink(sink)
+    {
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            m_sink.push_back(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        m_sink.append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+private:
+    std::string& m_sink;
+};
+
+EventLog::EventLog()
+    : m_blockRecords(1),
+      m_bufferedRecords(0),
+      m_nextSequence(0),
+      m_bytesWritten(0)
+{
+    m_textBuffer = std::make_unique<TextBuffer>(m_pendingText);
+    m_textStream = std::make_unique<std::ostream>(m_textBuffer.get());
+    for (const TypeSchema& schema : GetSchemas())
+    {
+        m_buffers[static_cast<uint16_t>(schema.type)].columns.resize(schema.columns.size());
+    }
+}
+
+EventLog::~EventLog()
+{
+    Close();
+}
+
+bool
+EventLog::Open(const std::string& path,
+               uint32_t blockRecords,
+               size_t asyncBufferBytes,
+               AsyncTraceSink::Compression compression)
+{
+    Close();
+    if (asyncBufferBytes > 0 || compression != AsyncTraceSink::Compression::NONE)
+    {
+        // Groups must never be dropped: a partial group corrupts the file
+        if (!m_asyncFile.Open(path,
+                              asyncBufferBytes,
+                              AsyncTraceSink::OverflowPolicy::BLOCK,
+                              false,
+                              compression))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        m_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open())
+        {
+            return false;
+        }
+    }
+    m_blockRecords = std::max<uint32_t>(1, blockRecords);
+    m_bufferedRecords = 0;
+    m_nextSequence = 0;
+    m_bytesWritten = 0;
+    m_pendingText.clear();
+    WriteHeader();
+    return true;
+}
+
+void
+EventLog::Close()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    Flush();
+    if (m_asyncFile.IsOpen())
+    {
+        m_asyncFile.Close();
+    }
+    else
+    {
+        m_file.close();
+    }
+}
+
+bool
+EventLog::IsOpen() const
+{
+    return m_file.is_open() || m_asyncFile.IsOpen();
+}
+
+std::ostream&
+EventLog::GetTextStream()
+{
+    return *m_textStream;
+}
+
+void
+EventLog::Write(const void* data, size_t size)
+{
+    if (m_asyncFile.IsOpen())
+    {
+        m_asyncFile.Write(data, size);
+    }
+    else
+    {
+        m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+    m_bytesWritten += size;
+}
+
+void
+EventLog::WriteHeader()
+{
+    Write(kFileMagic, sizeof(kFileMagic));
+    const auto& schemas = GetSchemas();
+    const uint32_t schemaCount = static_cast<uint32_t>(schemas.size());
+    Write(&schemaCount, sizeof(schemaCount));
+
+    auto writeString = [this](const char* text) {
+        const uint16_t length = static_cast<uint16_t>(std::strlen(text));
+        Write(&length, sizeof(length));
+        Write(text, length);
+    };
+
+    for (const TypeSchema& schema : schemas)
+    {
+        const uint16_t typeId = static_cast<uint16_t>(schema.type);
+        const uint16_t columnCount = static_cast<uint16_t>(schema.columns.size());
+        Write(&typeId, sizeof(typeId));
+        Write(&columnCount, sizeof(columnCount));
+        writeString(schema.textTemplate);
+        for (const ColumnSchema& column : schema.columns)
+        {
+            Write(&column.type, sizeof(column.type));
+            writeString(column.name);
+        }
+    }
+}
+
+void
+EventLog::SealText()
+{
+    if (m_pendingText.empty())
+    {
+        return;
+    }
+    TypeBuffer& buffer = m_buffers[static_cast<uint16_t>(EventLogType::TEXT)];
+    Put<uint64_t>(buffer.columns[0], m_nextSequence++);
+    Put<uint32_t>(buffer.columns[1], static_cast<uint32_t>(m_pendingText.size()));
+    buffer.textBytes.insert(buffer.textBytes.end(), m_pendingText.begin(), m_pendingText.end());
+    buffer.rows++;
+    m_bufferedRecords++;
+    m_pendingText.clear();
+}
+
+void
+EventLog::BeginRecord(EventLogType type)
+{
+    // Text written before this record must come first
+    SealText();
+    TypeBuffer& buffer = m_buffers[static_cast<uint16_t>(type)];
+    Put<uint64_t>(buffer.columns[0], m_nextSequence++);
+    buffer.rows++;
+    m_bufferedRecords++;
+}
+
+void
+EventLog::AppendToken(EventLogType type, uint32_t srcNodeId, uint32_t dstNodeId, uint32_t id)
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    BeginRecord(type);
+    TypeBuffer& buffer = m_buffers[static_cast<uint16_t>(type)];
+    Put<uint32_t>(buffer.columns[1], srcNodeId);
+    Put<uint32_t>(buffer.columns[2], dstNodeId);
+    Put<uint32_t>(buffer.columns[3], id);
+    if (m_bufferedRecords >= m_blockRecords)
+    {
+        Flush();
+    }
+}
+
+void
+EventLog::AppendUavBroadcast(EventLogType type,
+                             double time,
+                             uint32_t uavNodeId,
+                             uint32_t index,
+                             uint32_t cycle,
+                             double confidence,
+                             uint32_t size)
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    BeginRecord(type);
+    TypeBuffer& buffer = m_buffers[static_cast<uint16_t>(type)];
+    Put<double>(buffer.columns[1], time);
+    Put<uint32_t>(buffer.columns[2], uavNodeId);
+    Put<uint32_t>(buffer.columns[3], index);
+    Put<uint32_t>(buffer.columns[4], cycle);
+    if (type == EventLogType::UAV_FRAGMENT_BROADCAST)
+    {
+        Put<double>(buffer.columns[5], confidence);
+        Put<uint32_t>(buffer.columns[6], size);
+    }
+    if (m_bufferedRecords >= m_blockRecords)
+    {
+        Flush();
+    }
+}
+
+void
+EventLog::Flush()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    WSN_PROFILE_SCOPE("log.EventLog::Flush");
+    SealText();
+    if (m_bufferedRecords == 0)
+    {
+        return;
+    }
+
+    uint32_t blockCount = 0;
+    for (const TypeBuffer& buffer : m_buffers)
+    {
+        blockCount += (buffer.rows > 0) ? 1 : 0;
+    }
+    Write(&blockCount, sizeof(blockCount));
+
+    for (uint16_t typeId = 0; typeId < kEventLogTypeCount; ++typeId)
+    {
+        TypeBuffer& buffer = m_buffers[typeId];
+        if (buffer.rows == 0)
+        {
+            continue;
+        }
+        const uint16_t reserved = 0;
+        Write(&typeId, sizeof(typeId));
+        Write(&reserved, sizeof(reserved));
+        Write(&buffer.rows, sizeof(buffer.rows));
+        for (std::vector<uint8_t>& column : buffer.columns)
+        {
+            Write(column.data(), column.size());
+            column.clear();
+        }
+        Write(buffer.textBytes.data(), buffer.textBytes.size());
+        buffer.textBytes.clear();
+        buffer.rows = 0;
+    }
+    m_bufferedRecords = 0;
+}
+
+uint64_t
+EventLog::GetRecordCount() const
+{
+    return m_nextSequence;
+}
+
+uint64_t
+EventLog::GetBytesWritten() const
+{
+    return m_bytesWritten;
+}
+
+EventLog&
+GetResultEventLog()
+{
+    static EventLog eventLog;
+    return eventLog;
+}
+
+void
+LogResultToken(EventLogType type, uint32_t srcNodeId, uint32_t dstNodeId, uint32_t id)
+{
+    EventLog& eventLog = GetResultEventLog();
+    if (eventLog.IsOpen())
+    {
+        eventLog.AppendToken(type, srcNodeId, dstNodeId, id);
+        return;
+    }
+
+    // Format: srcNodeId1-R-nodeId1(fragId1) srcNodeId2-S-nodeId2(fragId2) ...
+    if (ns3::wsn::scenario4::params::g_resultFileStream)
+    {
+        const char* tag = (type == EventLogType::FRAGMENT_SHARED)         ? "-S-"
+                          : (type == EventLogType::CODED_SYMBOL_RECEIVED) ? "-C-"
+                                                                          : "-R-";
+        *ns3::wsn::scenario4::params::g_resultFileStream << srcNodeId
+            << tag << dstNodeId
+            << "(" << id << ") ";
+    }
+}
+
+void
+LogResultUavBroadcast(EventLogType type,
+                      double time,
+                      uint32_t uavNodeId,
+                      uint32_t index,
+                      uint32_t cycle,
+                      double confidence,
+                      uint32_t size)
+{
+    EventLog& eventLog = GetResultEventLog();
+    if (eventLog.IsOpen())
+    {
+        eventLog.AppendUavBroadcast(type, time, uavNodeId, index, cycle, confidence, size);
+        return;
+    }
+
+    if (ns3::wsn::scenario4::params::g_resultFileStream)
+    {
+        const bool isParity = (type == EventLogType::UAV_CODED_SYMBOL_BROADCAST);
+        std::ostream& out = *ns3::wsn::scenario4::params::g_resultFileStream;
+        out << "\n[EVENT] " << time
+            << " | event=" << (isParity ? "UAVCodedSymbolBroadcast" : "UAVFragmentBroadcast")
+            << " | nodeId=" << uavNodeId
+            << (isParity ? " | symbolIndex=" : " | fragmentId=") << index
+            << " | cycle=" << cycle;
+        if (!isParity)
+        {
+            out << " | confidence=" << std::fixed << std::setprecision(3) << confidence
+                << " | size=" << size;
+        }
+        out << std::endl;
+    }
+}
+
+} // namespace routing
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 namespace ns3 {
@@ -20,46 +21,312 @@ namespace wsn {
 namespace scenario4 {
 namespace routing {
 
+// ===== FragmentBitset =====
+
+void
+FragmentBitset::Reserve(uint32_t capacity)
+{
+    const size_t words = (static_cast<size_t>(capacity) + 63) / 64;
+    if (words > m_words.size()) {
+        m_words.resize(words, 0);
+    }
+}
+
+uint32_t
+FragmentBitset::GetCapacity() const
+{
+    return static_cast<uint32_t>(m_words.size() * 64);
+}
+
+bool
+FragmentBitset::Test(uint32_t id) const
+{
+    const size_t w = id / 64;
+    return w < m_words.size() && ((m_words[w] >> (id % 64)) & 1u);
+}
+
+void
+FragmentBitset::Set(uint32_t id)
+{
+    Reserve(id + 1);
+    m_words[id / 64] |= (uint64_t{1} << (id % 64));
+}
+
+void
+FragmentBitset::Reset(uint32_t id)
+{
+    const size_t w = id / 64;
+    if (w < m_words.size()) {
+        m_words[w] &= ~(uint64_t{1} << (id % 64));
+    }
+}
+
+void
+FragmentBitset::Clear()
+{
+    std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+uint32_t
+FragmentBitset::Count() const
+{
+    uint32_t count = 0;
+    for (uint64_t word : m_words) {
+        count += static_cast<uint32_t>(__builtin_popcountll(word));
+    }
+    return count;
+}
+
+bool
+FragmentBitset::Any() const
+{
+    for (uint64_t word : m_words) {
+        if (word != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t
+FragmentBitset::FindNext(uint32_t from) const
+{
+    size_t w = from / 64;
+    if (w >= m_words.size()) {
+        return GetCapacity();
+    }
+    uint64_t word = m_words[w] & (~uint64_t{0} << (from % 64));
+    while (word == 0) {
+        if (++w >= m_words.size()) {
+            return GetCapacity();
+        }
+        word = m_words[w];
+    }
+    return static_cast<uint32_t>(w * 64 + __builtin_ctzll(word));
+}
+
+FragmentBitset
+FragmentBitset::AndNot(const FragmentBitset& other) const
+{
+    FragmentBitset result = *this;
+    const size_t shared = std::min(m_words.size(), other.m_words.size());
+    for (size_t w = 0; w < shared; ++w) {
+        result.m_words[w] &= ~other.m_words[w];
+    }
+    return result;
+}
+
+bool
+FragmentBitset::AnyAndNot(const FragmentBitset& other) const
+{
+    for (size_t w = 0; w < m_words.size(); ++w) {
+        const uint64_t otherWord = (w < other.m_words.size()) ? other.m_words[w] : 0;
+        if ((m_words[w] & ~otherWord) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+FragmentBitset::UnionWith(const FragmentBitset& other)
+{
+    if (other.m_words.size() > m_words.size()) {
+        m_words.resize(other.m_words.size(), 0);
+    }
+    for (size_t w = 0; w < other.m_words.size(); ++w) {
+        m_words[w] |= other.m_words[w];
+    }
+}
+
+// ===== FragmentCollection =====
+
+FragmentCollection::ConstIterator::ConstIterator(const FragmentCollection* owner, uint32_t id)
+    : m_owner(owner),
+      m_id(id)
+{
+}
+
+FragmentCollection::ConstIterator::reference
+FragmentCollection::ConstIterator::operator*() const
+{
+    return m_owner->m_slots[m_id];
+}
+
+FragmentCollection::ConstIterator::pointer
+FragmentCollection::ConstIterator::operator->() const
+{
+    return &m_owner->m_slots[m_id];
+}
+
+FragmentCollection::ConstIterator&
+FragmentCollection::ConstIterator::operator++()
+{
+    m_id = m_owner->NextHeldId(m_id + 1);
+    return *this;
+}
+
+FragmentCollection::ConstIterator
+FragmentCollection::ConstIterator::operator++(int)
+{
+    ConstIterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+bool
+FragmentCollection::ConstIterator::operator==(const ConstIterator& other) const
+{
+    return m_id == other.m_id;
+}
+
+bool
+FragmentCollection::ConstIterator::operator!=(const ConstIterator& other) const
+{
+    return m_id != other.m_id;
+}
+
+void
+FragmentCollection::Reserve(uint32_t capacity)
+{
+    if (capacity > m_slots.size()) {
+        m_slots.resize(capacity, Fragment{0, 0.0, 0, nullptr});
+    }
+    m_held.Reserve(capacity);
+}
+
 void
 FragmentCollection::AddFragment(const Fragment& frag)
 {
-    fragments[frag.fragmentId] = frag;
-    UpdateTotalConfidence();
+    const uint32_t id = frag.fragmentId;
+    Reserve(id + 1);
+    if (m_held.Test(id)) {
+        m_totalConfidence += frag.confidence - m_slots[id].confidence;
+    } else {
+        m_held.Set(id);
+        m_count++;
+        m_totalConfidence += frag.confidence;
+    }
+    m_slots[id] = frag;
 }
 
 bool
 FragmentCollection::HasFragment(uint32_t fragmentId) const
 {
-    return fragments.find(fragmentId) != fragments.end();
+    return m_held.Test(fragmentId);
 }
 
 const Fragment*
 FragmentCollection::GetFragment(uint32_t fragmentId) const
 {
-    auto it = fragments.find(fragmentId);
-    if (it != fragments.end()) {
-        return &(it->second);
+    if (m_held.Test(fragmentId)) {
+        return &m_slots[fragmentId];
     }
     return nullptr;
 }
 
+void
+FragmentCollection::Clear()
+{
+    m_held.ForEach([this](uint32_t id) { m_slots[id].payload.reset(); });
+    m_held.Clear();
+    m_count = 0;
+    m_totalConfidence = 0.0;
+}
+
+uint32_t
+FragmentCollection::GetCount() const
+{
+    return m_count;
+}
+
+bool
+FragmentCollection::IsEmpty() const
+{
+    return m_count == 0;
+}
+
+double
+FragmentCollection::GetTotalConfidence() const
+{
+    return m_totalConfidence;
+}
+
+const FragmentBitset&
+FragmentCollection::GetHeldIds() const
+{
+    return m_held;
+}
+
 void
 FragmentCollection::UpdateTotalConfidence()
 {
-    if (fragments.empty()) {
-        totalConfidence = 0.0;
-        return;
-    }
-    
     double sum = 0.0;
-    for (const auto& pair : fragments) {
-        sum += pair.second.confidence;
+    m_held.ForEach([this, &sum](uint32_t id) { sum += m_slots[id].confidence; });
+    m_totalConfidence = sum;
+}
+
+FragmentCollection::ConstIterator
+FragmentCollection::begin() const
+{
+    return ConstIterator(this, NextHeldId(0));
+}
+
+FragmentCollection::ConstIterator
+FragmentCollection::end() const
+{
+    return ConstIterator(this, kEndId);
+}
+
+uint32_t
+FragmentCollection::NextHeldId(uint32_t from) const
+{
+    const uint32_t id = m_held.FindNext(from);
+    return (id < m_held.GetCapacity()) ? id : kEndId;
+}
+
+FragmentPayload
+FragmentPayloadPool::Store(uint32_t fragmentId, std::vector<uint8_t> bytes)
+{
+    FragmentPayload payload = std::make_shared<const std::vector<uint8_t>>(std::move(bytes));
+    m_payloads[fragmentId] = payload;
+    return payload;
+}
+
+FragmentPayload
+FragmentPayloadPool::Get(uint32_t fragmentId) const
+{
+    auto it = m_payloads.find(fragmentId);
+    if (it != m_payloads.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+void
+FragmentPayloadPool::Clear()
+{
+    m_payloads.clear();
+}
+
+size_t
+FragmentPayloadPool::GetCount() const
+{
+    return m_payloads.size();
+}
+
+uint64_t
+FragmentPayloadPool::GetTotalBytes() const
+{
+    uint64_t total = 0;
+    for (const auto& pair : m_payloads) {
+        total += pair.second->size();
     }
-    totalConfidence = sum;
+    return total;
 }
 
 FragmentCollection
-GenerateFragments(uint32_t numFragments)
+GenerateFragments(uint32_t numFragments, FragmentPayloadPool& payloadPool)
 {
     NS_LOG_FUNCTION(numFragments);
     
@@ -119,6 +386,7 @@ GenerateFragments(uint32_t numFragments)
     }
     
     // 2) Confidence depends on fragment size and is split from master-file confidence budget.
+    collection.Reserve(numFragments);
     for (uint32_t i = 0; i < numFragments; ++i) {
         Fragment frag;
         frag.fragmentId = i;
@@ -126,17 +394,16 @@ GenerateFragments(uint32_t numFragments)
         frag.confidence = (static_cast<double>(frag.size) / static_cast<double>(masterFileSize))
                           * masterFileConfidence;
 
-        // Placeholder payload chunk (simulating file split).
-        frag.data.resize(frag.size, static_cast<uint8_t>(i % 256));
+        // Placeholder payload chunk (simulating file split), stored once in the pool.
+        frag.payload = payloadPool.Store(i, std::vector<uint8_t>(frag.size, static_cast<uint8_t>(i % 256)));
         
         collection.AddFragment(frag);
     }
 
     uint64_t totalSize = 0;
     double totalConfidence = 0.0;
-    for (const auto& [id, frag] : collection.fragments)
+    for (const auto& frag : collection)
     {
-        (void)id;
         totalSize += frag.size;
         totalConfidence += frag.confidence;
     }
@@ -146,7 +413,7 @@ GenerateFragments(uint32_t numFragments)
                 << " | totalFragmentSize=" << totalSize << " bytes"
                 << " | masterConfidence=" << masterFileConfidence
                 << " | allocatedConfidence=" << totalConfidence
-                << " | collectionConfidence=" << collection.totalConfidence);
+                << " | collectionConfidence=" << collection.GetTotalConfidence());
     
     return collection;
 }
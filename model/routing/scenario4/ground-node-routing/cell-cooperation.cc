@@ -1,8 +1,21 @@
 #include "cell-cooperation.h"
 #include "ground-node-routing.h"
+#include "confidence-fusion.h"
+#include "../event-log.h"
+#include "../../../wsn-metrics.h"
+#include "../../../wsn-profiler.h"
+#include "../packet-header.h"
+#include "../base-station-node/fragment-generator.h"
 #include "../helper/calc-utils.h"
+#include "../../../radio/cc2420/cc2420-net-device.h"
 #include "ns3/log.h"
+#include "ns3/mac16-address.h"
+#include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
 #include "../../../../examples/scenarios/scenario4/scenario4-params.h"
 
 namespace ns3 {
@@ -14,8 +27,783 @@ namespace scenario4 {
 namespace routing {
 
 static constexpr double kCooperationThreshold = 0.35;
+static constexpr uint32_t kNoRoute = 0xFFFFFFFF;
 
-void InitializeCellCooperation() {}
+/**
+ * Members of one cell and the union of the fragment IDs they hold.
+ */
+struct CellCooperationGroup
+{
+    std::vector<uint32_t> members; ///< ascending node ID
+    FragmentBitset heldUnion;
+    bool treeIndexed = false;      ///< treeChildren built from g_intraCellRoutingTree
+    std::map<uint32_t, std::vector<uint32_t>> treeChildren;
+};
+
+/**
+ * Pull session of one requesting node.
+ */
+struct CooperationSession
+{
+    int32_t cellId = -1;
+    double startTime = 0.0;
+    bool collecting = false;                    ///< still accepting availability reports
+    std::map<uint32_t, FragmentBitset> offers;  ///< peer -> IDs it can supply
+    std::map<uint32_t, FragmentBitset> pending; ///< peer -> pulled IDs not yet received
+    uint32_t pullAttempts = 0;
+    uint32_t fragmentsReceived = 0;
+};
+
+static std::map<int32_t, CellCooperationGroup> g_cellGroups;
+static std::map<uint32_t, CooperationSession> g_cooperationSessions;
+static std::map<uint32_t, double> g_cooperationTxBusyUntil; ///< node -> end of its last queued frame
+static CooperationStats g_cooperationStats;
+
+// Registry metrics (wsn-metrics.h)
+static const Counter g_metricFragmentsShared("cooperation.fragments_shared");
+static const Counter g_metricRequestsSent("cooperation.requests_sent");
+
+static CellCooperationGroup*
+FindNodeCellGroup(uint32_t nodeId)
+{
+    auto nodeIt = g_groundNetworkPerNode.find(nodeId);
+    if (nodeIt == g_groundNetworkPerNode.end())
+    {
+        return nullptr;
+    }
+    auto groupIt = g_cellGroups.find(nodeIt->second.cellId);
+    return (groupIt != g_cellGroups.end()) ? &groupIt->second : nullptr;
+}
+
+static Ptr<wsn::Cc2420NetDevice>
+GetCc2420Device(uint32_t nodeId)
+{
+    if (nodeId >= NodeList::GetNNodes())
+    {
+        return nullptr;
+    }
+    Ptr<Node> node = NodeList::GetNode(nodeId);
+    if (!node || node->GetNDevices() == 0)
+    {
+        return nullptr;
+    }
+    return DynamicCast<wsn::Cc2420NetDevice>(node->GetDevice(0));
+}
+
+// ===== Intra-cell tree routing =====
+
+static uint32_t
+GetTreeParent(uint32_t nodeId, int32_t cellId)
+{
+    const auto& tree = ::ns3::wsn::scenario4::params::g_intraCellRoutingTree;
+    auto nodeIt = tree.find(nodeId);
+    if (nodeIt == tree.end())
+    {
+        return kNoRoute;
+    }
+    auto routeIt = nodeIt->second.find(cellId);
+    return (routeIt != nodeIt->second.end()) ? routeIt->second : kNoRoute;
+}
+
+/**
+ * \return nodeId followed by its ancestors up to the cell leader, or empty if
+ *         nodeId is not in the cell tree
+ */
+static std::vector<uint32_t>
+GetTreeAncestors(uint32_t nodeId, int32_t cellId)
+{
+    std::vector<uint32_t> path;
+    uint32_t current = nodeId;
+    // Bounded walk, a malformed tree must not loop forever
+    for (size_t step = 0; step <= g_groundNetworkPerNode.size(); ++step)
+    {
+        const uint32_t parent = GetTreeParent(current, cellId);
+        if (parent == kNoRoute)
+        {
+            return {};
+        }
+        path.push_back(current);
+        if (parent == current)
+        {
+            return path;
+        }
+        current = parent;
+    }
+    return {};
+}
+
+/**
+ * \return next hop from fromId towards toId in the cell tree, or kNoRoute
+ */
+static uint32_t
+GetNextTreeHop(uint32_t fromId, uint32_t toId, int32_t cellId)
+{
+    const std::vector<uint32_t> destPath = GetTreeAncestors(toId, cellId);
+    if (destPath.empty())
+    {
+        return kNoRoute;
+    }
+    auto it = std::find(destPath.begin(), destPath.end(), fromId);
+    if (it != destPath.end())
+    {
+        // fromId is an ancestor of toId: step down towards it
+        return (it == destPath.begin()) ? kNoRoute : *(it - 1);
+    }
+    const uint32_t parent = GetTreeParent(fromId, cellId);
+    return (parent == kNoRoute || parent == fromId) ? kNoRoute : parent;
+}
+
+static uint32_t
+GetTreeHopCount(uint32_t nodeA, uint32_t nodeB, int32_t cellId)
+{
+    const std::vector<uint32_t> pathA = GetTreeAncestors(nodeA, cellId);
+    const std::vector<uint32_t> pathB = GetTreeAncestors(nodeB, cellId);
+    for (size_t i = 0; i < pathA.size(); ++i)
+    {
+        auto it = std::find(pathB.begin(), pathB.end(), pathA[i]);
+        if (it != pathB.end())
+        {
+            return static_cast<uint32_t>(i + (it - pathB.begin()));
+        }
+    }
+    return kNoRoute;
+}
+
+static const std::vector<uint32_t>&
+GetTreeChildren(CellCooperationGroup& group, int32_t cellId, uint32_t nodeId)
+{
+    if (!group.treeIndexed)
+    {
+        group.treeChildren.clear();
+        for (uint32_t memberId : group.members)
+        {
+            const uint32_t parent = GetTreeParent(memberId, cellId);
+            if (parent != kNoRoute && parent != memberId)
+            {
+                group.treeChildren[parent].push_back(memberId);
+            }
+        }
+        group.treeIndexed = true;
+    }
+
+    static const std::vector<uint32_t> kNoChildren;
+    auto it = group.treeChildren.find(nodeId);
+    return (it != group.treeChildren.end()) ? it->second : kNoChildren;
+}
+
+// ===== Framing and transmission =====
+
+/**
+ * \return bytes left for cooperation message bodies in one CC2420 frame
+ */
+static uint32_t
+GetCooperationBodyBudget()
+{
+    return ::ns3::wsn::scenario4::params::CC2420_MAX_FRAME_BYTES -
+           ::ns3::wsn::scenario4::params::CC2420_MAC_OVERHEAD_BYTES -
+           PacketHeader().GetSerializedSize() - CooperationPacket::GetCommonSerializedSize();
+}
+
+/**
+ * Split IDs into runs whose bitmap fits in one frame.
+ */
+static std::vector<std::vector<uint32_t>>
+SplitIdsForFrames(const FragmentBitset& ids)
+{
+    const uint32_t maxSpan =
+        (GetCooperationBodyBudget() - CooperationPacket::GetBitmapSerializedSize(0)) * 8;
+    std::vector<std::vector<uint32_t>> chunks;
+    ids.ForEach([&](uint32_t id) {
+        if (chunks.empty() || id - chunks.back().front() >= maxSpan)
+        {
+            chunks.emplace_back();
+        }
+        chunks.back().push_back(id);
+    });
+    return chunks;
+}
+
+static uint32_t
+GetMaxRecordsPerFrame()
+{
+    const uint32_t records =
+        (GetCooperationBodyBudget() - 1) / CooperationPacket::GetRecordSerializedSize();
+    return std::min<uint32_t>(records, 255);
+}
+
+/**
+ * Queue one cooperation frame to a tree neighbor.
+ *
+ * Frames from the same node are serialized at the CC2420 bit rate and handed
+ * to the MAC once their airtime has elapsed.
+ */
+static void
+TransmitCooperationFrame(uint32_t fromId, uint32_t nextHopId, CooperationPacket coop)
+{
+    Ptr<wsn::Cc2420NetDevice> srcDev = GetCc2420Device(fromId);
+    Ptr<wsn::Cc2420NetDevice> dstDev = GetCc2420Device(nextHopId);
+    if (!srcDev || !dstDev)
+    {
+        NS_LOG_WARN("[COOP] No CC2420 device for hop " << fromId << " -> " << nextHopId);
+        return;
+    }
+
+    coop.SetHopId(fromId);
+    Ptr<Packet> p = Create<Packet>();
+    p->AddHeader(coop);
+    PacketHeader base;
+    base.SetType(PACKET_TYPE_COOPERATION);
+    p->AddHeader(base);
+
+    const uint32_t onAirBytes = ::ns3::wsn::scenario4::params::CC2420_PHY_OVERHEAD_BYTES +
+                                ::ns3::wsn::scenario4::params::CC2420_MAC_OVERHEAD_BYTES +
+                                p->GetSize();
+    const double airtime = onAirBytes * 8.0 / ::ns3::wsn::scenario4::params::CC2420_BITRATE_BPS;
+    const double now = Simulator::Now().GetSeconds();
+    double& busyUntil = g_cooperationTxBusyUntil[fromId];
+    busyUntil = std::max(now, busyUntil) + airtime;
+
+    switch (coop.GetMessageType())
+    {
+        case COOPERATION_AVAILABILITY_QUERY:
+            g_cooperationStats.queryFrames++;
+            break;
+        case COOPERATION_AVAILABILITY_REPORT:
+            g_cooperationStats.reportFrames++;
+            break;
+        case COOPERATION_PULL_REQUEST:
+            g_cooperationStats.pullFrames++;
+            break;
+        case COOPERATION_FRAGMENT_DATA:
+            g_cooperationStats.dataFrames++;
+            break;
+    }
+    g_cooperationStats.bytesOnAir += onAirBytes;
+    g_cooperationStats.airtimeSec += airtime;
+
+    auto stateIt = g_groundNetworkPerNode.find(fromId);
+    if (stateIt != g_groundNetworkPerNode.end())
+    {
+        auto& state = stateIt->second;
+        const double txEnergyCost = 0.001 * p->GetSize() / 1024.0; // same scale as reception
+        state.packetsSent++;
+        state.totalBytesSent += p->GetSize();
+        state.energyConsumedTx += txEnergyCost;
+        state.remainingEnergy = std::max(0.0, state.remainingEnergy - txEnergyCost);
+    }
+
+    const Mac16Address dstAddr = Mac16Address::ConvertFrom(dstDev->GetAddress());
+    Simulator::Schedule(Seconds(busyUntil - now), [srcDev, p, dstAddr]() {
+        srcDev->Send(p, dstAddr, 0);
+    });
+}
+
+/**
+ * Forward a unicast cooperation message one hop towards its destination.
+ */
+static void
+RouteCooperationFrame(uint32_t fromId, const CooperationPacket& coop)
+{
+    const uint32_t nextHop = GetNextTreeHop(fromId, coop.GetDestinationId(), coop.GetCellId());
+    if (nextHop == kNoRoute)
+    {
+        g_cooperationStats.unroutableFrames++;
+        NS_LOG_DEBUG("[COOP] No tree route " << fromId << " -> " << coop.GetDestinationId());
+        return;
+    }
+    TransmitCooperationFrame(fromId, nextHop, coop);
+}
+
+/**
+ * Pass an availability query to every tree neighbor except the one it came from.
+ */
+static void
+FloodCooperationQuery(uint32_t fromId, uint32_t previousHopId, const CooperationPacket& query)
+{
+    auto groupIt = g_cellGroups.find(query.GetCellId());
+    if (groupIt == g_cellGroups.end())
+    {
+        return;
+    }
+
+    const uint32_t parent = GetTreeParent(fromId, query.GetCellId());
+    if (parent != kNoRoute && parent != fromId && parent != previousHopId)
+    {
+        TransmitCooperationFrame(fromId, parent, query);
+    }
+    for (uint32_t childId : GetTreeChildren(groupIt->second, query.GetCellId(), fromId))
+    {
+        if (childId != previousHopId)
+        {
+            TransmitCooperationFrame(fromId, childId, query);
+        }
+    }
+}
+
+/**
+ * Send fragment IDs as bitmap messages, one frame per run that fits.
+ */
+static void
+SendIdMessages(CooperationMessageType type,
+               uint32_t fromId,
+               uint32_t destinationId,
+               uint32_t requesterId,
+               int32_t cellId,
+               const FragmentBitset& ids)
+{
+    for (const auto& chunk : SplitIdsForFrames(ids))
+    {
+        CooperationPacket coop;
+        coop.SetMessageType(type);
+        coop.SetRequesterId(requesterId);
+        coop.SetCellId(cellId);
+        coop.SetSourceId(fromId);
+        coop.SetDestinationId(destinationId);
+        coop.SetFragmentIds(chunk);
+
+        if (destinationId == CooperationPacket::kFloodDestination)
+        {
+            FloodCooperationQuery(fromId, kNoRoute, coop);
+        }
+        else
+        {
+            RouteCooperationFrame(fromId, coop);
+        }
+    }
+}
+
+// ===== Pull sessions =====
+
+static void
+FinishCooperationSession(uint32_t nodeId, bool complete)
+{
+    auto it = g_cooperationSessions.find(nodeId);
+    if (it == g_cooperationSessions.end())
+    {
+        return;
+    }
+    const CooperationSession& session = it->second;
+    const double now = Simulator::Now().GetSeconds();
+    const double latency = now - session.startTime;
+
+    if (complete)
+    {
+        g_cooperationStats.sessionsCompleted++;
+    }
+    else
+    {
+        g_cooperationStats.sessionsPartial++;
+    }
+    g_cooperationStats.totalLatencySec += latency;
+    g_cooperationStats.maxLatencySec = std::max(g_cooperationStats.maxLatencySec, latency);
+
+    NS_LOG_INFO("[COOP] Session end node=" << nodeId << " cell=" << session.cellId
+                << " peers=" << session.offers.size()
+                << " received=" << session.fragmentsReceived
+                << " latency=" << latency << "s complete=" << complete);
+
+    // Format: [EVENT] time | event=CooperationSessionEnd | nodeId=... | cellId=... | peers=... | received=... | latency=... | complete=0/1
+    if (ns3::wsn::scenario4::params::g_resultFileStream)
+    {
+        *ns3::wsn::scenario4::params::g_resultFileStream << "\n[EVENT] " << now
+            << " | event=CooperationSessionEnd"
+            << " | nodeId=" << nodeId
+            << " | cellId=" << session.cellId
+            << " | peers=" << session.offers.size()
+            << " | received=" << session.fragmentsReceived
+            << " | latency=" << latency
+            << " | complete=" << (complete ? 1 : 0) << "\n";
+    }
+
+    g_cooperationSessions.erase(it);
+}
+
+/**
+ * Drop pulled IDs the requester already holds.
+ *
+ * \return true if nothing is pending any more
+ */
+static bool
+PrunePendingPulls(uint32_t nodeId, CooperationSession& session)
+{
+    const FragmentBitset& held = g_groundNetworkPerNode[nodeId].fragments.GetHeldIds();
+    for (auto it = session.pending.begin(); it != session.pending.end();)
+    {
+        it->second = it->second.AndNot(held);
+        it = it->second.Any() ? std::next(it) : session.pending.erase(it);
+    }
+    return session.pending.empty();
+}
+
+static void CheckCooperationPulls(uint32_t nodeId, uint32_t pullAttempt);
+
+static void
+SendCooperationPulls(uint32_t nodeId, CooperationSession& session)
+{
+    for (const auto& [peerId, ids] : session.pending)
+    {
+        SendIdMessages(COOPERATION_PULL_REQUEST, nodeId, peerId, nodeId, session.cellId, ids);
+    }
+    session.pullAttempts++;
+    Simulator::Schedule(Seconds(::ns3::wsn::scenario4::params::COOPERATION_PULL_TIMEOUT),
+                        &CheckCooperationPulls,
+                        nodeId,
+                        session.pullAttempts);
+}
+
+static void
+CheckCooperationPulls(uint32_t nodeId, uint32_t pullAttempt)
+{
+    auto it = g_cooperationSessions.find(nodeId);
+    if (it == g_cooperationSessions.end() || it->second.pullAttempts != pullAttempt)
+    {
+        return;
+    }
+    CooperationSession& session = it->second;
+
+    if (PrunePendingPulls(nodeId, session))
+    {
+        FinishCooperationSession(nodeId, true);
+        return;
+    }
+    if (session.pullAttempts > ::ns3::wsn::scenario4::params::COOPERATION_MAX_PULL_RETRIES)
+    {
+        FinishCooperationSession(nodeId, false);
+        return;
+    }
+
+    g_cooperationStats.pullRetries++;
+    SendCooperationPulls(nodeId, session);
+}
+
+/**
+ * Close the report window and pull each missing ID from the nearest peer
+ * offering it (fewest tree hops, then lowest node ID).
+ */
+static void
+DispatchCooperationPulls(uint32_t nodeId)
+{
+    auto it = g_cooperationSessions.find(nodeId);
+    if (it == g_cooperationSessions.end())
+    {
+        return;
+    }
+    CooperationSession& session = it->second;
+    session.collecting = false;
+
+    std::vector<std::pair<uint32_t, uint32_t>> peersByDistance; // (hops, peerId)
+    for (const auto& [peerId, offer] : session.offers)
+    {
+        (void)offer;
+        peersByDistance.emplace_back(GetTreeHopCount(nodeId, peerId, session.cellId), peerId);
+    }
+    std::sort(peersByDistance.begin(), peersByDistance.end());
+
+    const FragmentBitset& held = g_groundNetworkPerNode[nodeId].fragments.GetHeldIds();
+    FragmentBitset assigned;
+    for (const auto& [hops, peerId] : peersByDistance)
+    {
+        (void)hops;
+        FragmentBitset take = session.offers[peerId].AndNot(held).AndNot(assigned);
+        if (take.Any())
+        {
+            assigned.UnionWith(take);
+            session.pending[peerId] = std::move(take);
+        }
+    }
+
+    if (session.pending.empty())
+    {
+        FinishCooperationSession(nodeId, true);
+        return;
+    }
+    SendCooperationPulls(nodeId, session);
+}
+
+/**
+ * Flood an availability query for every expected ID the node lacks.
+ */
+static void
+StartCooperationSession(uint32_t nodeId, int32_t cellId)
+{
+    if (g_cooperationSessions.count(nodeId))
+    {
+        NS_LOG_DEBUG("[COOP] Node " << nodeId << " already has a cooperation session");
+        return;
+    }
+    if (GetTreeAncestors(nodeId, cellId).empty())
+    {
+        g_cooperationStats.sessionsUnroutable++;
+        NS_LOG_DEBUG("[COOP] Node " << nodeId << " is not in the tree of cell " << cellId);
+        return;
+    }
+
+    const auto& state = g_groundNetworkPerNode[nodeId];
+    FragmentBitset missing;
+    missing.Reserve(state.expectedFragmentCount);
+    for (uint32_t fragId = 0; fragId < state.expectedFragmentCount; ++fragId)
+    {
+        if (!state.fragments.HasFragment(fragId))
+        {
+            missing.Set(fragId);
+        }
+    }
+    if (!missing.Any())
+    {
+        return;
+    }
+
+    CooperationSession& session = g_cooperationSessions[nodeId];
+    session.cellId = cellId;
+    session.startTime = Simulator::Now().GetSeconds();
+    session.collecting = true;
+    g_cooperationStats.sessionsStarted++;
+
+    SendIdMessages(COOPERATION_AVAILABILITY_QUERY,
+                   nodeId,
+                   CooperationPacket::kFloodDestination,
+                   nodeId,
+                   cellId,
+                   missing);
+    Simulator::Schedule(Seconds(::ns3::wsn::scenario4::params::COOPERATION_REPORT_WINDOW),
+                        &DispatchCooperationPulls,
+                        nodeId);
+}
+
+/**
+ * \return RSSI the node last heard from a neighbor, or kUnknownRssiDbm
+ */
+static double
+GetNeighborRssiDbm(uint32_t nodeId, uint32_t neighborId)
+{
+    const auto& neighborRssi = g_groundNetworkPerNode[nodeId].neighborRssi;
+    const auto it = neighborRssi.find(neighborId);
+    return (it != neighborRssi.end()) ? it->second : kUnknownRssiDbm;
+}
+
+/**
+ * Merge fragment records pulled from a peer.
+ */
+static void
+MergeCooperationRecords(uint32_t nodeId,
+                        uint32_t peerId,
+                        const std::vector<CooperationFragmentRecord>& records)
+{
+    auto& state = g_groundNetworkPerNode[nodeId];
+    const double now = Simulator::Now().GetSeconds();
+    uint32_t mergedCount = 0;
+    ConfidenceFusionEngine& fusion = GetGroundConfidenceFusion();
+    const double rssiDbm = GetNeighborRssiDbm(nodeId, peerId);
+
+    for (const auto& record : records)
+    {
+        if (record.fragmentId >= state.expectedFragmentCount)
+        {
+            NS_LOG_WARN("Node " << nodeId << " dropped fragment " << record.fragmentId
+                        << " from " << peerId << " (expected < " << state.expectedFragmentCount << ")");
+            continue;
+        }
+        if (state.fragments.HasFragment(record.fragmentId))
+        {
+            state.duplicateFragmentsDiscarded++;
+            continue;
+        }
+
+        Fragment frag;
+        frag.fragmentId = record.fragmentId;
+        frag.confidence = std::clamp(record.confidence, 0.0, 1.0);
+        frag.size = 0; // records carry no payload bytes, as UAV fragment frames
+        frag.payload = GetBsFragmentPayloadPool().Get(record.fragmentId);
+        state.fragments.AddFragment(frag);
+        fusion.Observe(nodeId, record.fragmentId, frag.confidence, rssiDbm);
+        OnCellMemberFragmentAdded(nodeId, record.fragmentId);
+        state.fragmentLastUpdateTime[record.fragmentId] = now;
+        mergedCount++;
+        g_metricFragmentsShared.Add();
+        // Format: srcNodeId1-S-dstNodeId1(fragId1) srcNodeId2-S-dstNodeId2(fragId2) ...
+        LogResultToken(EventLogType::FRAGMENT_SHARED, peerId, nodeId, record.fragmentId);
+    }
+
+    state.confidence = fusion.GetConfidence(nodeId);
+    state.fragmentsReceivedFromPeers += mergedCount;
+    state.fragmentCoverageRatio = (state.expectedFragmentCount > 0)
+                                  ? static_cast<double>(state.fragments.GetCount()) /
+                                        state.expectedFragmentCount
+                                  : 0.0;
+    state.lastCooperationTime = now;
+    state.cellPeers.insert(peerId);
+    g_cooperationStats.fragmentsDelivered += mergedCount;
+
+    auto it = g_cooperationSessions.find(nodeId);
+    if (it == g_cooperationSessions.end())
+    {
+        return;
+    }
+    it->second.fragmentsReceived += mergedCount;
+    if (!it->second.collecting && PrunePendingPulls(nodeId, it->second))
+    {
+        FinishCooperationSession(nodeId, true);
+    }
+}
+
+/**
+ * Answer a pull with as few data frames as the records fit in.
+ */
+static void
+AnswerCooperationPull(uint32_t nodeId, const CooperationPacket& pull)
+{
+    const auto& state = g_groundNetworkPerNode[nodeId];
+    const uint32_t maxRecords = GetMaxRecordsPerFrame();
+
+    std::vector<CooperationFragmentRecord> records;
+    auto flush = [&]() {
+        if (records.empty())
+        {
+            return;
+        }
+        CooperationPacket data;
+        data.SetMessageType(COOPERATION_FRAGMENT_DATA);
+        data.SetRequesterId(pull.GetRequesterId());
+        data.SetCellId(pull.GetCellId());
+        data.SetSourceId(nodeId);
+        data.SetDestinationId(pull.GetRequesterId());
+        data.SetRecords(records);
+        RouteCooperationFrame(nodeId, data);
+        records.clear();
+    };
+
+    for (uint32_t fragId : pull.GetFragmentIds())
+    {
+        const Fragment* frag = state.fragments.GetFragment(fragId);
+        if (!frag)
+        {
+            continue;
+        }
+        records.push_back({fragId, frag->confidence});
+        if (records.size() >= maxRecords)
+        {
+            flush();
+        }
+    }
+    flush();
+}
+
+// ===== Public interface =====
+
+void
+InitializeCellCooperation()
+{
+    g_cellGroups.clear();
+    g_cooperationSessions.clear();
+    g_cooperationTxBusyUntil.clear();
+    g_cooperationStats = CooperationStats();
+
+    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
+    {
+        CellCooperationGroup& group = g_cellGroups[state.cellId];
+        group.members.push_back(nodeId);
+        group.heldUnion.UnionWith(state.fragments.GetHeldIds());
+    }
+
+    NS_LOG_INFO("[CELL-COOPERATION] Indexed " << g_groundNetworkPerNode.size() << " nodes in "
+                << g_cellGroups.size() << " cells");
+}
+
+void
+OnCellMemberFragmentAdded(uint32_t nodeId, uint32_t fragmentId)
+{
+    if (CellCooperationGroup* group = FindNodeCellGroup(nodeId))
+    {
+        group->heldUnion.Set(fragmentId);
+    }
+}
+
+void
+HandleCooperationPacket(uint32_t nodeId, Ptr<Packet> packet)
+{
+    CooperationPacket coop;
+    if (packet->RemoveHeader(coop) == 0)
+    {
+        NS_LOG_WARN("Node " << nodeId << " received malformed COOPERATION packet");
+        return;
+    }
+    auto stateIt = g_groundNetworkPerNode.find(nodeId);
+    if (stateIt == g_groundNetworkPerNode.end() || stateIt->second.cellId != coop.GetCellId())
+    {
+        return;
+    }
+    auto& state = stateIt->second;
+    state.lastCooperationTime = Simulator::Now().GetSeconds();
+
+    if (coop.GetDestinationId() == CooperationPacket::kFloodDestination)
+    {
+        // Availability query: offer what we hold, then pass it along the tree
+        if (nodeId != coop.GetRequesterId())
+        {
+            state.cooperationRequestsReceived++;
+            FragmentBitset offer;
+            for (uint32_t fragId : coop.GetFragmentIds())
+            {
+                if (state.fragments.HasFragment(fragId))
+                {
+                    offer.Set(fragId);
+                }
+            }
+            if (offer.Any())
+            {
+                SendIdMessages(COOPERATION_AVAILABILITY_REPORT,
+                               nodeId,
+                               coop.GetRequesterId(),
+                               coop.GetRequesterId(),
+                               coop.GetCellId(),
+                               offer);
+            }
+        }
+        FloodCooperationQuery(nodeId, coop.GetHopId(), coop);
+        return;
+    }
+
+    if (coop.GetDestinationId() != nodeId)
+    {
+        RouteCooperationFrame(nodeId, coop);
+        return;
+    }
+
+    switch (coop.GetMessageType())
+    {
+        case COOPERATION_AVAILABILITY_REPORT: {
+            auto it = g_cooperationSessions.find(nodeId);
+            if (it != g_cooperationSessions.end() && it->second.collecting)
+            {
+                FragmentBitset& offer = it->second.offers[coop.GetSourceId()];
+                for (uint32_t fragId : coop.GetFragmentIds())
+                {
+                    if (fragId < state.expectedFragmentCount)
+                    {
+                        offer.Set(fragId);
+                    }
+                }
+            }
+            break;
+        }
+        case COOPERATION_PULL_REQUEST:
+            state.cooperationRequestsReceived++;
+            AnswerCooperationPull(nodeId, coop);
+            break;
+        case COOPERATION_FRAGMENT_DATA:
+            MergeCooperationRecords(nodeId, coop.GetSourceId(), coop.GetRecords());
+            break;
+        default:
+            NS_LOG_WARN("Node " << nodeId << " received unknown cooperation message");
+            break;
+    }
+}
+
+const CooperationStats&
+GetCooperationStats()
+{
+    return g_cooperationStats;
+}
 
 void
 ShareFragments(uint32_t fromNode, uint32_t toNode)
@@ -24,32 +812,34 @@ ShareFragments(uint32_t fromNode, uint32_t toNode)
     {
         return;
     }
-    auto& src = g_groundNetworkPerNode[fromNode].fragments.fragments;
+    const auto& src = g_groundNetworkPerNode[fromNode].fragments;
     auto& dst = g_groundNetworkPerNode[toNode].fragments;
     uint32_t mergedCount = 0;
-    
-    for (const auto& [id, frag] : src)
-    {
-        // Only accept fragments that destination node does not have yet
-        if (!dst.HasFragment(id))
-        {
-            dst.AddFragment(frag);
-            g_groundNetworkPerNode[toNode].fragmentLastUpdateTime[id] = Simulator::Now().GetSeconds();
-            mergedCount++;
-            // Format: srcNodeId1-S-dstNodeId1(fragId1) srcNodeId2-S-dstNodeId2(fragId2) ...
-            if (ns3::wsn::scenario4::params::g_resultFileStream)
-            {        *ns3::wsn::scenario4::params::g_resultFileStream << fromNode
-                    << "-S-" << toNode
-                    << "(" << id << ") ";
-            }
-        }
+    ConfidenceFusionEngine& fusion = GetGroundConfidenceFusion();
+    const double rssiDbm = GetNeighborRssiDbm(toNode, fromNode);
+
+    // Only accept fragments that destination node does not have yet
+    const FragmentBitset missing = src.GetHeldIds().AndNot(dst.GetHeldIds());
+    missing.ForEach([&](uint32_t id) {
+        const Fragment& frag = *src.GetFragment(id);
+        dst.AddFragment(frag);
+        fusion.Observe(toNode, id, frag.confidence, rssiDbm);
+        g_groundNetworkPerNode[toNode].fragmentLastUpdateTime[id] = Simulator::Now().GetSeconds();
+        mergedCount++;
+        g_metricFragmentsShared.Add();
+        // Format: srcNodeId1-S-dstNodeId1(fragId1) srcNodeId2-S-dstNodeId2(fragId2) ...
+        LogResultToken(EventLogType::FRAGMENT_SHARED, fromNode, toNode, id);
+    });
+    if (CellCooperationGroup* group = FindNodeCellGroup(toNode))
+    {
+        group->heldUnion.UnionWith(missing);
     }
-    
-    g_groundNetworkPerNode[toNode].confidence = dst.totalConfidence;
+
+    g_groundNetworkPerNode[toNode].confidence = fusion.GetConfidence(toNode);
     auto& toState = g_groundNetworkPerNode[toNode];
     toState.fragmentsReceivedFromPeers += mergedCount;
     toState.fragmentCoverageRatio = (toState.expectedFragmentCount > 0)
-                                    ? static_cast<double>(dst.fragments.size()) /
+                                    ? static_cast<double>(dst.GetCount()) /
                                           toState.expectedFragmentCount
                                     : 0.0;
     toState.lastCooperationTime = Simulator::Now().GetSeconds();
@@ -58,6 +848,8 @@ ShareFragments(uint32_t fromNode, uint32_t toNode)
 void
 RequestFragmentSharing(uint32_t nodeId, int32_t cellId)
 {
+    WSN_PROFILE_SCOPE("cooperation.RequestFragmentSharing");
+
     if (!g_groundNetworkPerNode.count(nodeId))
     {
         return;
@@ -66,37 +858,59 @@ RequestFragmentSharing(uint32_t nodeId, int32_t cellId)
 
     // Node already has full fragment set -> no need to request sharing
     if (state.expectedFragmentCount > 0 &&
-        state.fragments.fragments.size() >= state.expectedFragmentCount)
+        state.fragments.GetCount() >= state.expectedFragmentCount)
     {
         return;
     }
-    
+
     state.cooperationRequestsSent++;
+    g_metricRequestsSent.Add();
     state.lastCooperationTime = Simulator::Now().GetSeconds();
-    
-    for (const auto& [peerId, peerState] : g_groundNetworkPerNode)
+
+    if (::ns3::wsn::scenario4::params::COOPERATION_PACKETIZED)
     {
-        if (peerId != nodeId && peerState.cellId == cellId)
-        {
-            bool peerHasUsefulFragment = false;
-            for (const auto& [fragId, frag] : peerState.fragments.fragments)
+        // Fragments arrive later through the query / pull exchange
+        StartCooperationSession(nodeId, cellId);
+    }
+    else
+    {
+        auto tryPeer = [&](uint32_t peerId, const GroundNetworkState& peerState) {
+            if (peerId == nodeId || peerState.cellId != cellId)
             {
-                (void)frag;
-                if (!state.fragments.HasFragment(fragId))
-                {
-                    peerHasUsefulFragment = true;
-                    break;
-                }
+                return;
             }
-
-            if (!peerHasUsefulFragment)
+            // Peer must hold at least one fragment this node lacks
+            if (!peerState.fragments.GetHeldIds().AnyAndNot(state.fragments.GetHeldIds()))
             {
-                continue;
+                return;
             }
 
             state.cellPeers.insert(peerId);
             state.peerConfidence[peerId] = peerState.confidence;
             ShareFragments(peerId, nodeId);
+        };
+
+        auto groupIt = g_cellGroups.find(cellId);
+        if (groupIt != g_cellGroups.end())
+        {
+            // Visit only this cell's members, and none at all when the cell holds
+            // nothing this node lacks
+            const CellCooperationGroup& group = groupIt->second;
+            if (group.heldUnion.AnyAndNot(state.fragments.GetHeldIds()))
+            {
+                for (uint32_t peerId : group.members)
+                {
+                    tryPeer(peerId, g_groundNetworkPerNode[peerId]);
+                }
+            }
+        }
+        else
+        {
+            // Cell not indexed yet: full scan
+            for (const auto& [peerId, peerState] : g_groundNetworkPerNode)
+            {
+                tryPeer(peerId, peerState);
+            }
         }
     }
     // Format: [EVENT] time | event=RequestFragmentSharing | nodeId=... | cellId=... | confidence=... | fragments= fragId1 fragId2 ...
@@ -107,8 +921,8 @@ RequestFragmentSharing(uint32_t nodeId, int32_t cellId)
             << " | cellId=" << cellId
             << " | confidence=" << state.confidence
             << " | fragments=";
-        for (const auto& [fragId, frag] : state.fragments.fragments)
-        {             *ns3::wsn::scenario4::params::g_resultFileStream << fragId << " ";
+        for (const auto& frag : state.fragments)
+        {             *ns3::wsn::scenario4::params::g_resultFileStream << frag.fragmentId << " ";
         }
         *ns3::wsn::scenario4::params::g_resultFileStream << "\n";
     }
@@ -1,6 +1,7 @@
 #ifndef SCENARIO4_CELL_COOPERATION_H
 #define SCENARIO4_CELL_COOPERATION_H
 
+#include "ns3/packet.h"
 #include <cstdint>
 
 namespace ns3 {
@@ -8,13 +9,79 @@ namespace wsn {
 namespace scenario4 {
 namespace routing {
 
+/**
+ * Channel usage and latency of packetized cell cooperation.
+ *
+ * Frames and bytes are counted per hop; bytes include PHY and MAC overhead.
+ */
+struct CooperationStats
+{
+    uint32_t sessionsStarted = 0;
+    uint32_t sessionsCompleted = 0;  ///< every pulled fragment arrived
+    uint32_t sessionsPartial = 0;    ///< pulls still missing after the last retry
+    uint32_t sessionsUnroutable = 0; ///< requester outside its cell tree
+    uint32_t queryFrames = 0;
+    uint32_t reportFrames = 0;
+    uint32_t pullFrames = 0;
+    uint32_t dataFrames = 0;
+    uint32_t unroutableFrames = 0;   ///< dropped for lack of a tree route
+    uint64_t bytesOnAir = 0;
+    double airtimeSec = 0.0;
+    uint32_t fragmentsDelivered = 0;
+    uint32_t pullRetries = 0;
+    double totalLatencySec = 0.0;    ///< query to session end, summed over ended sessions
+    double maxLatencySec = 0.0;
+};
+
+/**
+ * Index cell members and the union of their held fragment IDs.
+ *
+ * Cells follow each node's cellId, so call this once the BS has assigned them.
+ */
 void InitializeCellCooperation();
+
+/**
+ * Keep the cell union current after a node gains a fragment.
+ *
+ * \param nodeId Node that now holds the fragment
+ * \param fragmentId Fragment ID
+ */
+void OnCellMemberFragmentAdded(uint32_t nodeId, uint32_t fragmentId);
+
+/**
+ * Request missing fragments from cell peers.
+ *
+ * With COOPERATION_PACKETIZED the node floods an availability query over its
+ * intra-cell routing tree, collects reports, pulls each missing fragment from
+ * the nearest peer offering it and receives batched data frames. Otherwise
+ * peers' fragments are copied directly.
+ *
+ * \param nodeId Requesting node
+ * \param cellId Cell of the requesting node
+ */
 void RequestFragmentSharing(uint32_t nodeId, int32_t cellId);
+
+/**
+ * Copy fragments toNode lacks from fromNode (direct, no packets).
+ */
 void ShareFragments(uint32_t fromNode, uint32_t toNode);
 
+/**
+ * Handle a cooperation message received by a ground node.
+ *
+ * \param nodeId Receiving node
+ * \param packet Packet with the base PacketHeader already removed
+ */
+void HandleCooperationPacket(uint32_t nodeId, Ptr<Packet> packet);
+
+/**
+ * \return cooperation counters since InitializeCellCooperation()
+ */
+const CooperationStats& GetCooperationStats();
+
 } // namespace routing
 } // namespace scenario4
 } // namespace wsn
 } // namespace ns3
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Scenario 4 - Confidence Fusion
+ *
+ * Turns the fragment confidences a ground node has observed into one node
+ * confidence. The aggregation rule is a pluggable policy; observations are
+ * kept so any policy can be re-evaluated over every node after the run.
+ */
+
+#ifndef SCENARIO4_CONFIDENCE_FUSION_H
+#define SCENARIO4_CONFIDENCE_FUSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario4 {
+namespace routing {
+
+/**
+ * Built-in fusion policies (params::CONFIDENCE_FUSION_POLICY).
+ */
+enum class ConfidenceFusionType : uint8_t
+{
+    SUM = 0,          ///< Plain sum (fragments partition the file confidence)
+    NOISY_OR = 1,     ///< 1 - prod(1 - c)
+    LOG_ODDS = 2,     ///< Bayesian update of a prior in log-odds space
+    RSSI_WEIGHTED = 3 ///< Sum with each fragment scaled by its link quality
+};
+
+/**
+ * Unknown RSSI (fragment not taken from a radio reception).
+ */
+constexpr double kUnknownRssiDbm = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * Confidence aggregation rule.
+ *
+ * Every policy is additive in some transformed space: an observation adds
+ * Term(confidence, rssi) to the node's accumulator and the node confidence
+ * is Finalize(accumulator). Replacing an observation subtracts its old term,
+ * so an update is O(1) whatever the number of fragments.
+ */
+class ConfidenceFusionPolicy
+{
+public:
+    virtual ~ConfidenceFusionPolicy() = default;
+
+    /**
+     * \param confidence Fragment confidence [0, 1]
+     * \param rssiDbm Reception RSSI, or kUnknownRssiDbm
+     * \return contribution to the accumulator
+     */
+    virtual double Term(double confidence, double rssiDbm) const = 0;
+
+    /**
+     * \param accumulator Sum of the terms of every held fragment
+     * \return node confidence
+     */
+    virtual double Finalize(double accumulator) const = 0;
+
+    /**
+     * Sum of the terms of n observations (batch path, one call per node).
+     *
+     * \param confidence Confidences, n entries
+     * \param rssiDbm RSSIs, n entries
+     * \param n Number of observations
+     */
+    virtual double Accumulate(const double* confidence, const double* rssiDbm, size_t n) const;
+
+    virtual std::string GetName() const = 0;
+};
+
+class SumFusionPolicy : public ConfidenceFusionPolicy
+{
+public:
+    double Term(double confidence, double rssiDbm) const override;
+    double Accumulate(const double* confidence, const double* rssiDbm, size_t n) const override;
+    double Finalize(double accumulator) const override;
+    std::string GetName() const override;
+};
+
+/**
+ * Fragments as independent detections: P = 1 - prod(1 - c_i), accumulated
+ * as sum(log(1 - c_i)).
+ */
+class NoisyOrFusionPolicy : public ConfidenceFusionPolicy
+{
+public:
+    double Term(double confidence, double rssiDbm) const override;
+    double Finalize(double accumulator) const override;
+    std::string GetName() const override;
+};
+
+/**
+ * Bayesian log-odds: each fragment moves the prior by
+ * logit(c) - logit(prior).
+ */
+class LogOddsFusionPolicy : public ConfidenceFusionPolicy
+{
+public:
+    /**
+     * \param prior Event probability before any fragment (0, 1)
+     */
+    explicit LogOddsFusionPolicy(double prior);
+
+    double Term(double confidence, double rssiDbm) const override;
+    double Finalize(double accumulator) const override;
+    std::string GetName() const override;
+
+private:
+    double m_priorLogOdds;
+};
+
+/**
+ * Sum with each fragment weighted by its reception RSSI, linear from 0 at
+ * floorDbm to 1 at ceilingDbm. Fragments without RSSI get weight 1.
+ */
+class RssiWeightedFusionPolicy : public ConfidenceFusionPolicy
+{
+public:
+    RssiWeightedFusionPolicy(double floorDbm, double ceilingDbm);
+
+    double Term(double confidence, double rssiDbm) const override;
+    double Finalize(double accumulator) const override;
+    std::string GetName() const override;
+
+private:
+    double m_floorDbm;
+    double m_ceilingDbm;
+};
+
+/**
+ * \return policy of the given type, configured from scenario params
+ */
+std::unique_ptr<ConfidenceFusionPolicy> CreateConfidenceFusionPolicy(ConfidenceFusionType type);
+
+/**
+ * \return policy selected by params::CONFIDENCE_FUSION_POLICY
+ */
+std::unique_ptr<ConfidenceFusionPolicy> CreateDefaultConfidenceFusionPolicy();
+
+/**
+ * Per-node fragment observations and their fused confidence.
+ *
+ * Observations are stored per node as contiguous arrays (confidence, RSSI),
+ * so a batch recomputation under another policy is a flat loop per node.
+ */
+class ConfidenceFusionEngine
+{
+public:
+    ConfidenceFusionEngine();
+
+    /**
+     * Drop every observation.
+     *
+     * \param numFragments Expected fragment ID range (sizing hint)
+     */
+    void Reset(uint32_t numFragments);
+
+    /**
+     * Change the live policy; accumulators are rebuilt from the stored
+     * observations.
+     */
+    void SetPolicy(std::unique_ptr<ConfidenceFusionPolicy> policy);
+
+    const ConfidenceFusionPolicy& GetPolicy() const;
+
+    /**
+     * Record or replace a node's observation of one fragment. O(1).
+     *
+     * \param nodeId Ground node ID
+     * \param fragmentId Fragment ID
+     * \param confidence Fragment confidence [0, 1]
+     * \param rssiDbm Reception RSSI, or kUnknownRssiDbm
+     * \return fused node confidence after the update
+     */
+    double Observe(uint32_t nodeId, uint32_t fragmentId, double confidence, double rssiDbm);
+
+    /**
+     * \return fused confidence of a node under the live policy (0 if unseen)
+     */
+    double GetConfidence(uint32_t nodeId) const;
+
+    /**
+     * \return number of fragments observed by a node
+     */
+    uint32_t GetObservationCount(uint32_t nodeId) const;
+
+    /**
+     * Recompute every node's confidence under another policy (the live
+     * policy and accumulators are untouched).
+     *
+     * \param policy Policy to evaluate
+     * \param nodeIds Output: nodes with observations (ascending ID)
+     * \param confidences Output: fused confidence per entry of nodeIds
+     */
+    void Recompute(const ConfidenceFusionPolicy& policy,
+                   std::vector<uint32_t>& nodeIds,
+                   std::vector<double>& confidences) const;
+
+    /**
+     * Threshold sweep: count nodes whose fused confidence under policy
+     * reaches each threshold.
+     *
+     * \param policy Policy to evaluate
+     * \param thresholds Alert thresholds
+     * \return node count per threshold
+     */
+    std::vector<uint32_t> CountNodesAtOrAbove(const ConfidenceFusionPolicy& policy,
+                                              const std::vector<double>& thresholds) const;
+
+private:
+    static constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+
+    struct NodeObservations
+    {
+        std::vector<uint32_t> slotOfFragment; ///< fragment ID -> index, or kNoSlot
+        std::vector<double> confidence;        ///< per slot
+        std::vector<double> rssiDbm;           ///< per slot
+        std::vector<double> term;              ///< per slot, under the live policy
+        double accumulator = 0.0;
+    };
+
+    NodeObservations& GetNode(uint32_t nodeId);
+    void Rebuild();
+
+    std::unique_ptr<ConfidenceFusionPolicy> m_policy;
+    std::vector<NodeObservations> m_nodes; ///< indexed by node ID
+    uint32_t m_numFragments;
+};
+
+/**
+ * \return engine fed by the ground-node fragment paths
+ */
+ConfidenceFusionEngine& GetGroundConfidenceFusion();
+
+} // namespace routing
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO4_CONFIDENCE_FUSION_H
@@ -6,7 +6,13 @@
 #include "../packet-header.h"
 #include "../helper/calc-utils.h"
 #include "../node-routing.h"
+#include "../base-station-node/fragment-generator.h"
 #include "cell-cooperation.h"
+#include "ground-node-timers.h"
+#include "confidence-fusion.h"
+#include "../event-log.h"
+#include "../../../wsn-metrics.h"
+#include "../../../wsn-profiler.h"
 #include "../../../radio/cc2420/cc2420-net-device.h"
 #include "../../../radio/cc2420/cc2420-mac.h"
 #include "ns3/log.h"
@@ -30,6 +36,66 @@ std::map<uint32_t, GroundNetworkState> g_groundNetworkPerNode;
 GlobalTopology g_latestTopologySnapshot;
 bool g_hasLatestTopologySnapshot = false;
 
+// Registry metrics (wsn-metrics.h)
+static const Counter g_metricRxPackets("ground.rx_packets");
+static const Counter g_metricFragmentsReceived("ground.fragments_received");
+static const Counter g_metricFragmentsDuplicate("ground.fragments_duplicate");
+static const LatencyHistogram g_metricAlertLatency("ground.fragment_to_alert_latency", "us");
+
+// Per node: first fragment arrival (< 0 = none yet) and whether the
+// fragment-to-alert latency has been recorded
+static std::vector<double> g_firstFragmentTime;
+static std::vector<uint8_t> g_alertLatencyRecorded;
+
+/**
+ * Track the time from a node's first fragment until its confidence first
+ * reaches ALERT_THRESHOLD.
+ *
+ * \param nodeId Ground node ID
+ * \param confidence Node confidence after the update
+ * \param now Current time (s)
+ */
+static void
+TrackAlertLatency(uint32_t nodeId, double confidence, double now)
+{
+    if (nodeId >= g_firstFragmentTime.size())
+    {
+        g_firstFragmentTime.resize(nodeId + 1, -1.0);
+        g_alertLatencyRecorded.resize(nodeId + 1, 0);
+    }
+    if (g_firstFragmentTime[nodeId] < 0.0)
+    {
+        g_firstFragmentTime[nodeId] = now;
+    }
+    if (!g_alertLatencyRecorded[nodeId] &&
+        confidence >= ::ns3::wsn::scenario4::params::ALERT_THRESHOLD)
+    {
+        g_alertLatencyRecorded[nodeId] = 1;
+        g_metricAlertLatency.RecordSeconds(now - g_firstFragmentTime[nodeId]);
+    }
+}
+
+/**
+ * Cooperation timeout: ask the cell for the fragments still missing.
+ */
+static void
+OnCooperationTimeout(uint32_t nodeId)
+{
+    if (g_groundNetworkPerNode.find(nodeId) == g_groundNetworkPerNode.end())
+        return;
+    
+    auto& state = g_groundNetworkPerNode[nodeId];
+    const bool hasAllFragments =
+        (state.expectedFragmentCount > 0) &&
+        (state.fragments.GetCount() >= state.expectedFragmentCount);
+    if (state.cooperationEnabled && state.cellId >= 0 && !hasAllFragments)
+    {
+        NS_LOG_INFO("Node " << nodeId << " cooperation timeout triggered"
+                   << " | confidence=" << state.confidence);
+        RequestFragmentSharing(nodeId, state.cellId);
+    }
+}
+
 namespace
 {
 void
@@ -72,11 +138,19 @@ void
 InitializeGroundNodeRouting(NodeContainer nodes, uint32_t numFragments)
 {
     NS_LOG_FUNCTION(nodes.GetN() << numFragments);
+
+    ResetGroundTimers();
+    SetGroundTimerHandler(GroundTimerType::COOPERATION_TIMEOUT, &OnCooperationTimeout);
+    GetGroundConfidenceFusion().Reset(numFragments);
+    GetGroundConfidenceFusion().SetPolicy(CreateDefaultConfidenceFusionPolicy());
+    g_firstFragmentTime.clear();
+    g_alertLatencyRecorded.clear();
     
     // Initialize state for each ground node
     for (uint32_t i = 0; i < nodes.GetN(); ++i) {
         Ptr<Node> node = nodes.Get(i);
         uint32_t nodeId = node->GetId();
+        SetNodeRole(nodeId, NodeRole::GROUND);
         
         GroundNetworkState state;
         
@@ -90,7 +164,8 @@ InitializeGroundNodeRouting(NodeContainer nodes, uint32_t numFragments)
         state.lastSyncTime = 0.0;
         
         // === Fragment Management ===
-        state.fragments.fragments.clear();
+        state.fragments.Clear();
+        state.fragments.Reserve(numFragments);
         state.confidence = 0.0; // Tính toán sau khi nhận fragment
         state.expectedFragmentCount = numFragments;
         state.fragmentCoverageRatio = 0.0;
@@ -172,16 +247,19 @@ void
 OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssiDbm)
 {
     NS_LOG_FUNCTION(nodeId << packet->GetSize() << rssiDbm);
+    WSN_PROFILE_SCOPE("ground.OnGroundNodeReceivePacket");
     
-    if (g_groundNetworkPerNode.find(nodeId) == g_groundNetworkPerNode.end()) {
+    auto stateIt = g_groundNetworkPerNode.find(nodeId);
+    if (stateIt == g_groundNetworkPerNode.end()) {
         NS_LOG_WARN("Node " << nodeId << " not initialized");
         return;
     }
     
-    GroundNetworkState& state = g_groundNetworkPerNode[nodeId];
+    GroundNetworkState& state = stateIt->second;
     
     // Update statistics
     state.packetCount++;
+    g_metricRxPackets.Add();
     state.totalBytesReceived += packet->GetSize();
     state.lastActivityTime = Simulator::Now().GetSeconds();
     state.lastPacketRssiDbm = rssiDbm;
@@ -196,12 +274,19 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
     state.energyConsumedRx += rxEnergyCost;
     state.remainingEnergy = std::max(0.0, state.remainingEnergy - rxEnergyCost);
     
-    // Try to extract packet header
-    Ptr<Packet> copy = packet->Copy();
-    PacketHeader header;
-    copy->RemoveHeader(header);
+    // Peek type (and fragment fields) in one pass on the const packet; only
+    // the other packet types pay for a copy
+    FragmentPacketView view;
+    packet->PeekHeader(view);
+    Ptr<Packet> copy;
+    if (view.GetType() != PACKET_TYPE_FRAGMENT)
+    {
+        copy = packet->Copy();
+        PacketHeader header;
+        copy->RemoveHeader(header);
+    }
     
-    switch (header.GetType()) {
+    switch (view.GetType()) {
         case PACKET_TYPE_STARTUP:
             NS_LOG_DEBUG("Node " << nodeId << " received STARTUP packet");
             state.startupPacketsReceived++;
@@ -230,31 +315,24 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
 
             // Handle fragment reception
             {
-                FragmentPacket fragPkt;
-                if (copy->RemoveHeader(fragPkt) == 0)
+                if (!view.IsFragment())
                 {
                     NS_LOG_WARN("Node " << nodeId << " received malformed FRAGMENT packet");
                     break;
                 }
                 
+                const FragmentPacket& fragPkt = view.GetFragment();
                 uint32_t fragId = fragPkt.GetFragmentId();
+                if (fragId >= state.expectedFragmentCount)
+                {
+                    NS_LOG_WARN("Node " << nodeId << " dropped fragment " << fragId
+                                << " (expected < " << state.expectedFragmentCount << ")");
+                    break;
+                }
                 double confidence = std::clamp(fragPkt.GetConfidence(), 0.0, 1.0);
                 uint32_t srcNodeId = fragPkt.GetSourceId();
                 const double now = Simulator::Now().GetSeconds();
-
-                bool fromUav = false;
-                if (srcNodeId < NodeList::GetNNodes())
-                {
-                    Ptr<Node> srcNode = NodeList::GetNode(srcNodeId);
-                    if (srcNode)
-                    {
-                        Ptr<MobilityModel> srcMobility = srcNode->GetObject<MobilityModel>();
-                        if (srcMobility)
-                        {
-                            fromUav = srcMobility->GetPosition().z > 1.0;
-                        }
-                    }
-                }
+                const bool fromUav = IsUavNode(srcNodeId);
                 
                 // Update fragment if new or higher confidence
                 bool updated = false;
@@ -264,13 +342,17 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
                     Fragment frag;
                     frag.fragmentId = fragId;
                     frag.confidence = confidence;
-                    frag.size = copy->GetSize();
+                    frag.size = packet->GetSize() - view.GetSerializedSize();
+                    frag.payload = GetBsFragmentPayloadPool().Get(fragId);
                     
                     state.fragments.AddFragment(frag);
-                    state.confidence = state.fragments.totalConfidence;
+                    OnCellMemberFragmentAdded(nodeId, fragId);
+                    state.confidence =
+                        GetGroundConfidenceFusion().Observe(nodeId, fragId, confidence, rssiDbm);
+                    TrackAlertLatency(nodeId, state.confidence, now);
                     state.fragmentLastUpdateTime[fragId] = now;
                     state.fragmentCoverageRatio = (state.expectedFragmentCount > 0)
-                                                  ? static_cast<double>(state.fragments.fragments.size()) /
+                                                  ? static_cast<double>(state.fragments.GetCount()) /
                                                         state.expectedFragmentCount
                                                   : 0.0;
                     
@@ -301,15 +383,12 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
                 else
                 {
                     state.duplicateFragmentsDiscarded++;
+                    g_metricFragmentsDuplicate.Add();
                 }
 
                 // Format: srcNodeId1-R-nodeId1 (fragId1) srcNodeId2-R-nodeId2 (fragId2) ...
-                if (ns3::wsn::scenario4::params::g_resultFileStream)
-                {
-                    *ns3::wsn::scenario4::params::g_resultFileStream << srcNodeId
-                        << "-R-" << nodeId
-                        << "(" << fragId << ") ";
-                }
+                LogResultToken(EventLogType::FRAGMENT_RECEIVED, srcNodeId, nodeId, fragId);
+                g_metricFragmentsReceived.Add();
 
                 // Schedule per-node cooperation timeout after first fragment
                 if (state.cooperationEnabled && updated && !state.cooperationTimeoutScheduled)
@@ -325,22 +404,8 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
                                 << " | delay=" << cooperationDelay << "s"
                                 << " | timeout_at=" << timeoutTime << "s");
                     
-                    // Schedule timeout callback
-                    Simulator::Schedule(Seconds(cooperationDelay), [nodeId]() {
-                        if (g_groundNetworkPerNode.find(nodeId) == g_groundNetworkPerNode.end())
-                            return;
-                        
-                        auto& state = g_groundNetworkPerNode[nodeId];
-                        const bool hasAllFragments =
-                            (state.expectedFragmentCount > 0) &&
-                            (state.fragments.fragments.size() >= state.expectedFragmentCount);
-                        if (state.cooperationEnabled && state.cellId >= 0 && !hasAllFragments)
-                        {
-                            NS_LOG_INFO("Node " << nodeId << " cooperation timeout triggered"
-                                       << " | confidence=" << state.confidence);
-                            RequestFragmentSharing(nodeId, state.cellId);
-                        }
-                    });
+                    // Shared timer wheel: nodes timing out in the same tick run in one event
+                    ScheduleGroundTimer(nodeId, GroundTimerType::COOPERATION_TIMEOUT, cooperationDelay);
                 }
             }
             break;
@@ -348,9 +413,7 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
         case PACKET_TYPE_COOPERATION:
             NS_LOG_DEBUG("Node " << nodeId << " received COOPERATION packet");
             state.cooperationPacketsReceived++;
-            state.cooperationRequestsReceived++;
-            state.lastCooperationTime = Simulator::Now().GetSeconds();
-            // Handle cooperation (will be implemented in cell-cooperation module)
+            HandleCooperationPacket(nodeId, copy);
             break;
             
         default:
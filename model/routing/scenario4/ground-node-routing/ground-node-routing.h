@@ -54,7 +54,7 @@ struct GroundNetworkState
     
     // === Fragment Management ===
     FragmentCollection fragments;             // Collection của các fragment node đang giữ
-    double confidence;                        // Tổng confidence = fragments.totalConfidence
+    double confidence;                        // Confidence hợp nhất (confidence-fusion); policy SUM = fragments.GetTotalConfidence()
     uint32_t expectedFragmentCount;           // Tổng số fragment kỳ vọng trong phiên
     double fragmentCoverageRatio;             // Tỉ lệ fragment hiện có / kỳ vọng
     std::map<uint32_t, double> fragmentLastUpdateTime; // Lần cập nhật cuối của từng fragment
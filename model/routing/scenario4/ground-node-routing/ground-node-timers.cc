@@ -0,0 +1,159 @@
+/*
+ * Scenario 4 - Ground Node Protocol Timers Implementation
+ */
+
+#include "ground-node-timers.h"
+#include "../helper/timer-wheel.h"
+#include "ns3/event-id.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "../../../../examples/scenarios/scenario4/scenario4-params.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("Scenario4GroundNodeTimers");
+
+namespace wsn {
+namespace scenario4 {
+namespace routing {
+
+static helper::TimerWheel g_groundTimerWheel;
+static EventId g_groundTimerEvent;
+static uint64_t g_groundTimerEventTick = helper::TimerWheel::kNever;
+static GroundTimerHandler g_groundTimerHandlers[kGroundTimerTypeCount] = {};
+
+static helper::TimerWheel::Key
+MakeTimerKey(uint32_t nodeId, GroundTimerType type)
+{
+    return (static_cast<uint64_t>(nodeId) << 8) | static_cast<uint8_t>(type);
+}
+
+static uint64_t
+SecondsToTick(double seconds)
+{
+    const double tick = ::ns3::wsn::scenario4::params::GROUND_TIMER_TICK;
+    // Round up (with a small tolerance) so a timer never fires early
+    return static_cast<uint64_t>(std::ceil(seconds / tick - 1e-9));
+}
+
+static double
+TickToSeconds(uint64_t tick)
+{
+    return static_cast<double>(tick) * ::ns3::wsn::scenario4::params::GROUND_TIMER_TICK;
+}
+
+static void ProcessGroundTimers();
+
+/**
+ * Make sure one simulator event is pending at the wheel's next wake tick.
+ */
+static void
+ArmGroundTimerEvent()
+{
+    const uint64_t wake = g_groundTimerWheel.GetNextWakeTick();
+    if (wake == helper::TimerWheel::kNever)
+    {
+        if (!g_groundTimerEvent.IsExpired())
+        {
+            g_groundTimerEvent.Cancel();
+        }
+        g_groundTimerEventTick = helper::TimerWheel::kNever;
+        return;
+    }
+    if (!g_groundTimerEvent.IsExpired() && g_groundTimerEventTick <= wake)
+    {
+        return;
+    }
+
+    if (!g_groundTimerEvent.IsExpired())
+    {
+        g_groundTimerEvent.Cancel();
+    }
+    const double delay = std::max(0.0, TickToSeconds(wake) - Simulator::Now().GetSeconds());
+    g_groundTimerEvent = Simulator::Schedule(Seconds(delay), &ProcessGroundTimers);
+    g_groundTimerEventTick = wake;
+}
+
+/**
+ * Batch event: advance the wheel to now and run every expired timer.
+ */
+static void
+ProcessGroundTimers()
+{
+    g_groundTimerEventTick = helper::TimerWheel::kNever;
+
+    std::vector<helper::TimerWheel::Key> expired;
+    g_groundTimerWheel.Advance(SecondsToTick(Simulator::Now().GetSeconds()), expired);
+
+    NS_LOG_DEBUG("[GROUND-TIMERS] t=" << Simulator::Now().GetSeconds()
+                 << " | expired=" << expired.size()
+                 << " | pending=" << g_groundTimerWheel.GetPendingCount());
+
+    for (helper::TimerWheel::Key key : expired)
+    {
+        const uint32_t nodeId = static_cast<uint32_t>(key >> 8);
+        const uint8_t type = static_cast<uint8_t>(key & 0xFF);
+        if (type < kGroundTimerTypeCount && g_groundTimerHandlers[type])
+        {
+            g_groundTimerHandlers[type](nodeId);
+        }
+    }
+
+    ArmGroundTimerEvent();
+}
+
+void
+SetGroundTimerHandler(GroundTimerType type, GroundTimerHandler handler)
+{
+    g_groundTimerHandlers[static_cast<uint8_t>(type)] = handler;
+}
+
+void
+ScheduleGroundTimer(uint32_t nodeId, GroundTimerType type, double delaySec)
+{
+    const double expiry = Simulator::Now().GetSeconds() + std::max(0.0, delaySec);
+    g_groundTimerWheel.Schedule(MakeTimerKey(nodeId, type), SecondsToTick(expiry));
+    ArmGroundTimerEvent();
+}
+
+bool
+CancelGroundTimer(uint32_t nodeId, GroundTimerType type)
+{
+    // The batch event stays armed; it re-arms for whatever is left
+    return g_groundTimerWheel.Cancel(MakeTimerKey(nodeId, type));
+}
+
+bool
+IsGroundTimerPending(uint32_t nodeId, GroundTimerType type)
+{
+    return g_groundTimerWheel.IsPending(MakeTimerKey(nodeId, type));
+}
+
+double
+GetGroundTimerExpiry(uint32_t nodeId, GroundTimerType type)
+{
+    const uint64_t tick = g_groundTimerWheel.GetExpiry(MakeTimerKey(nodeId, type));
+    return (tick == helper::TimerWheel::kNever) ? -1.0 : TickToSeconds(tick);
+}
+
+void
+ResetGroundTimers()
+{
+    if (!g_groundTimerEvent.IsExpired())
+    {
+        g_groundTimerEvent.Cancel();
+    }
+    g_groundTimerEventTick = helper::TimerWheel::kNever;
+    // Restart at the current tick so new timers are placed relative to now
+    g_groundTimerWheel.Clear();
+    std::vector<helper::TimerWheel::Key> none;
+    g_groundTimerWheel.Advance(SecondsToTick(Simulator::Now().GetSeconds()), none);
+}
+
+} // namespace routing
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
@@ -10,6 +10,7 @@
 
 #include <cstdint>
 #include <cmath>
+#include <vector>
 
 namespace ns3 {
 namespace wsn {
@@ -79,6 +80,27 @@ uint32_t ComputeCellColor(int32_t cellId);
 void ComputeHexCellCenter(int32_t q, int32_t r, double cellRadius,
                           double& outCenterX, double& outCenterY);
 
+/**
+ * Build per-center coverage lists using a uniform grid with cell size = radius.
+ *
+ * outCoverage[c] receives the indices i (ascending) of all points with
+ * CalculateDistance(center c, point i) <= radius. Only the 3x3 grid cells
+ * around each center are scanned.
+ *
+ * \param centerX Center X coordinates
+ * \param centerY Center Y coordinates (same size as centerX)
+ * \param pointX Point X coordinates
+ * \param pointY Point Y coordinates (same size as pointX)
+ * \param radius Coverage radius
+ * \param outCoverage Output: one index list per center
+ */
+void BuildCoverageLists(const std::vector<double>& centerX,
+                        const std::vector<double>& centerY,
+                        const std::vector<double>& pointX,
+                        const std::vector<double>& pointY,
+                        double radius,
+                        std::vector<std::vector<uint32_t>>& outCoverage);
+
 /**
  * Compute suspicious score for a node.
  * 
@@ -0,0 +1,305 @@
+/*
+ * Scenario 4 - K-Means Clustering Implementation
+ */
+
+#include "kmeans.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario4 {
+namespace helper {
+
+namespace {
+
+// Bounds are carried in floating point; keep a margin so rounding never
+// lets a pruned point skip a center that a full scan would pick.
+constexpr double kBoundSlack = 1e-9;
+
+// Below this many clusters a full scan is cheaper than maintaining bounds
+constexpr uint32_t kMinPruningClusters = 16;
+
+/**
+ * Squared distance from (px,py) to every center, written to d2.
+ * Kept branch-free so the loop vectorizes.
+ */
+inline void
+ComputeSquaredDistances(double px,
+                        double py,
+                        const double* cx,
+                        const double* cy,
+                        uint32_t k,
+                        double* d2)
+{
+    for (uint32_t c = 0; c < k; ++c)
+    {
+        const double dx = px - cx[c];
+        const double dy = py - cy[c];
+        d2[c] = dx * dx + dy * dy;
+    }
+}
+
+/**
+ * Index of the smallest squared distance; ties go to the lower index.
+ */
+inline uint32_t
+FindNearest(const double* d2, uint32_t k)
+{
+    uint32_t best = 0;
+    double bestD2 = d2[0];
+    for (uint32_t c = 1; c < k; ++c)
+    {
+        if (d2[c] < bestD2)
+        {
+            bestD2 = d2[c];
+            best = c;
+        }
+    }
+    return best;
+}
+
+/**
+ * Closest and second-closest squared distances; ties go to the lower index.
+ */
+inline void
+FindTwoNearest(const double* d2, uint32_t k, uint32_t& best, double& bestD2, double& secondD2)
+{
+    best = 0;
+    bestD2 = std::numeric_limits<double>::max();
+    secondD2 = std::numeric_limits<double>::max();
+    for (uint32_t c = 0; c < k; ++c)
+    {
+        if (d2[c] < bestD2)
+        {
+            secondD2 = bestD2;
+            bestD2 = d2[c];
+            best = c;
+        }
+        else if (d2[c] < secondD2)
+        {
+            secondD2 = d2[c];
+        }
+    }
+}
+
+void
+SeedKMeansPlusPlus(const std::vector<double>& xs,
+                   const std::vector<double>& ys,
+                   uint32_t k,
+                   uint64_t seed,
+                   KMeansResult& result)
+{
+    const uint32_t n = static_cast<uint32_t>(xs.size());
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    result.centerX.assign(k, 0.0);
+    result.centerY.assign(k, 0.0);
+
+    const uint32_t first = static_cast<uint32_t>(unit(rng) * n) % n;
+    result.centerX[0] = xs[first];
+    result.centerY[0] = ys[first];
+
+    // D^2 weights: squared distance to the nearest chosen center
+    std::vector<double> minD2(n);
+    for (uint32_t p = 0; p < n; ++p)
+    {
+        const double dx = xs[p] - result.centerX[0];
+        const double dy = ys[p] - result.centerY[0];
+        minD2[p] = dx * dx + dy * dy;
+    }
+    result.distanceEvaluations += n;
+
+    for (uint32_t c = 1; c < k; ++c)
+    {
+        double total = 0.0;
+        for (uint32_t p = 0; p < n; ++p)
+        {
+            total += minD2[p];
+        }
+
+        uint32_t chosen = n - 1;
+        if (total > 0.0)
+        {
+            double target = unit(rng) * total;
+            for (uint32_t p = 0; p < n; ++p)
+            {
+                target -= minD2[p];
+                if (target <= 0.0)
+                {
+                    chosen = p;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            // All points coincide with existing centers
+            chosen = static_cast<uint32_t>(unit(rng) * n) % n;
+        }
+
+        result.centerX[c] = xs[chosen];
+        result.centerY[c] = ys[chosen];
+
+        for (uint32_t p = 0; p < n; ++p)
+        {
+            const double dx = xs[p] - result.centerX[c];
+            const double dy = ys[p] - result.centerY[c];
+            minD2[p] = std::min(minD2[p], dx * dx + dy * dy);
+        }
+        result.distanceEvaluations += n;
+    }
+}
+
+} // namespace
+
+KMeansResult
+RunKMeans(const std::vector<double>& xs, const std::vector<double>& ys, const KMeansOptions& options)
+{
+    KMeansResult result;
+    const uint32_t n = static_cast<uint32_t>(std::min(xs.size(), ys.size()));
+    if (n == 0)
+    {
+        return result;
+    }
+    const uint32_t k = std::max<uint32_t>(1, std::min(options.k, n));
+
+    const bool useHamerly = options.useHamerly && k >= kMinPruningClusters;
+
+    SeedKMeansPlusPlus(xs, ys, k, options.seed, result);
+
+    std::vector<double>& cx = result.centerX;
+    std::vector<double>& cy = result.centerY;
+    result.assignment.assign(n, 0);
+
+    // Hamerly bounds: upper = distance to assigned center,
+    // lower = distance to the second-closest center.
+    std::vector<double> upper(useHamerly ? n : 0, std::numeric_limits<double>::max());
+    std::vector<double> lower(useHamerly ? n : 0, 0.0);
+    std::vector<double> halfNearestCenter(k, 0.0);
+    std::vector<double> shift(k, 0.0);
+    std::vector<double> d2(k);
+    std::vector<double> sumX(k);
+    std::vector<double> sumY(k);
+    std::vector<uint32_t> count(k);
+
+    for (uint32_t iter = 0; iter < options.maxIter; ++iter)
+    {
+        result.iterations = iter + 1;
+
+        if (useHamerly && iter > 0)
+        {
+            for (uint32_t c = 0; c < k; ++c)
+            {
+                double nearest = std::numeric_limits<double>::max();
+                for (uint32_t o = 0; o < k; ++o)
+                {
+                    if (o == c)
+                    {
+                        continue;
+                    }
+                    const double dx = cx[c] - cx[o];
+                    const double dy = cy[c] - cy[o];
+                    nearest = std::min(nearest, dx * dx + dy * dy);
+                }
+                halfNearestCenter[c] = 0.5 * std::sqrt(nearest);
+            }
+        }
+
+        // ===== Assignment =====
+        for (uint32_t p = 0; p < n; ++p)
+        {
+            if (useHamerly && iter > 0)
+            {
+                const uint32_t a = result.assignment[p];
+                const double bound = std::max(halfNearestCenter[a], lower[p]);
+                if (upper[p] + kBoundSlack * (1.0 + upper[p]) < bound)
+                {
+                    continue;
+                }
+
+                // Tighten the upper bound before falling back to a full scan
+                const double dx = xs[p] - cx[a];
+                const double dy = ys[p] - cy[a];
+                upper[p] = std::sqrt(dx * dx + dy * dy);
+                result.distanceEvaluations++;
+                if (upper[p] + kBoundSlack * (1.0 + upper[p]) < bound)
+                {
+                    continue;
+                }
+            }
+
+            ComputeSquaredDistances(xs[p], ys[p], cx.data(), cy.data(), k, d2.data());
+            result.distanceEvaluations += k;
+
+            if (!useHamerly)
+            {
+                result.assignment[p] = FindNearest(d2.data(), k);
+                continue;
+            }
+
+            uint32_t best = 0;
+            double bestD2 = 0.0;
+            double secondD2 = 0.0;
+            FindTwoNearest(d2.data(), k, best, bestD2, secondD2);
+            result.assignment[p] = best;
+            upper[p] = std::sqrt(bestD2);
+            lower[p] = (k > 1) ? std::sqrt(secondD2) : std::numeric_limits<double>::max();
+        }
+
+        // ===== Update =====
+        std::fill(sumX.begin(), sumX.end(), 0.0);
+        std::fill(sumY.begin(), sumY.end(), 0.0);
+        std::fill(count.begin(), count.end(), 0);
+        for (uint32_t p = 0; p < n; ++p)
+        {
+            const uint32_t c = result.assignment[p];
+            sumX[c] += xs[p];
+            sumY[c] += ys[p];
+            count[c]++;
+        }
+
+        double maxShift = 0.0;
+        for (uint32_t c = 0; c < k; ++c)
+        {
+            shift[c] = 0.0;
+            if (count[c] == 0)
+            {
+                continue;
+            }
+            const double newX = sumX[c] / count[c];
+            const double newY = sumY[c] / count[c];
+            const double dx = newX - cx[c];
+            const double dy = newY - cy[c];
+            shift[c] = std::sqrt(dx * dx + dy * dy);
+            maxShift = std::max(maxShift, shift[c]);
+            cx[c] = newX;
+            cy[c] = newY;
+        }
+
+        if (maxShift < options.tolerance)
+        {
+            result.converged = true;
+            break;
+        }
+
+        if (useHamerly)
+        {
+            for (uint32_t p = 0; p < n; ++p)
+            {
+                upper[p] += shift[result.assignment[p]];
+                lower[p] -= maxShift;
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace helper
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
@@ -0,0 +1,67 @@
+/*
+ * Scenario 4 - K-Means Clustering
+ *
+ * k-means++ seeded Lloyd iterations over structure-of-arrays coordinates,
+ * with optional Hamerly triangle-inequality pruning.
+ * No simulation state or event scheduling.
+ */
+
+#ifndef SCENARIO4_KMEANS_H
+#define SCENARIO4_KMEANS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario4 {
+namespace helper {
+
+/**
+ * K-means run options.
+ */
+struct KMeansOptions
+{
+    uint32_t k = 1;
+    uint32_t maxIter = 20;
+    double tolerance = 1e-3;   ///< stop when no center moves more than this (meters)
+    bool useHamerly = true;    ///< skip points whose bounds prove the assignment unchanged (k >= 16)
+    uint64_t seed = 1;         ///< k-means++ seeding RNG seed
+};
+
+/**
+ * K-means result.
+ */
+struct KMeansResult
+{
+    std::vector<double> centerX;
+    std::vector<double> centerY;
+    std::vector<uint32_t> assignment;
+    uint32_t iterations = 0;
+    bool converged = false;
+    uint64_t distanceEvaluations = 0;
+};
+
+/**
+ * Cluster 2D points.
+ *
+ * Centers are seeded with k-means++ (D^2 sampling), then refined with Lloyd
+ * iterations until the largest center shift is below tolerance or maxIter
+ * is reached. Empty clusters keep their previous center. Hamerly pruning
+ * yields the same assignments as a full scan.
+ *
+ * \param xs Point X coordinates
+ * \param ys Point Y coordinates (same size as xs)
+ * \param options Run options (k is clamped to [1, n])
+ * \return centers, assignment and run statistics (empty if no points)
+ */
+KMeansResult RunKMeans(const std::vector<double>& xs,
+                       const std::vector<double>& ys,
+                       const KMeansOptions& options);
+
+} // namespace helper
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO4_KMEANS_H
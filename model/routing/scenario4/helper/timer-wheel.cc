@@ -0,0 +1,249 @@
+/*
+ * Scenario 4 - Hierarchical Timer Wheel Implementation
+ */
+
+#include "timer-wheel.h"
+#include <algorithm>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario4 {
+namespace helper {
+
+namespace {
+
+constexpr uint64_t kSlotMask = TimerWheel::kSlots - 1;
+
+uint32_t
+SlotIndex(uint64_t tick, uint32_t level)
+{
+    return static_cast<uint32_t>((tick >> (level * TimerWheel::kSlotBits)) & kSlotMask);
+}
+
+} // namespace
+
+TimerWheel::TimerWheel()
+    : m_now(0),
+      m_nextGeneration(0)
+{
+}
+
+void
+TimerWheel::Place(const SlotEntry& entry)
+{
+    const uint64_t delta = entry.expiry - m_now;
+    for (uint32_t level = 0; level < kLevels; ++level)
+    {
+        if (delta < (uint64_t{1} << ((level + 1) * kSlotBits)))
+        {
+            m_slots[level][SlotIndex(entry.expiry, level)].push_back(entry);
+            return;
+        }
+    }
+    m_overflow.push_back(entry);
+}
+
+bool
+TimerWheel::IsLive(const SlotEntry& entry) const
+{
+    auto it = m_timers.find(entry.key);
+    return it != m_timers.end() && it->second.generation == entry.generation;
+}
+
+void
+TimerWheel::Schedule(Key key, uint64_t expiryTick)
+{
+    const uint64_t expiry = std::max(expiryTick, m_now + 1);
+    const uint32_t generation = m_nextGeneration++;
+    m_timers[key] = {expiry, generation};
+    Place({key, expiry, generation});
+}
+
+bool
+TimerWheel::Cancel(Key key)
+{
+    return m_timers.erase(key) > 0;
+}
+
+bool
+TimerWheel::IsPending(Key key) const
+{
+    return m_timers.count(key) > 0;
+}
+
+uint64_t
+TimerWheel::GetExpiry(Key key) const
+{
+    auto it = m_timers.find(key);
+    return it != m_timers.end() ? it->second.expiry : kNever;
+}
+
+size_t
+TimerWheel::GetPendingCount() const
+{
+    return m_timers.size();
+}
+
+uint64_t
+TimerWheel::GetCurrentTick() const
+{
+    return m_now;
+}
+
+uint64_t
+TimerWheel::GetNextWakeTick() const
+{
+    if (m_timers.empty())
+    {
+        return kNever;
+    }
+
+    uint64_t wake = kNever;
+
+    // Level 0 holds expiries in (now, now + 64): exact earliest live one
+    for (uint32_t k = 1; k < kSlots && wake == kNever; ++k)
+    {
+        const uint64_t tick = m_now + k;
+        for (const SlotEntry& entry : m_slots[0][SlotIndex(tick, 0)])
+        {
+            if (entry.expiry == tick && IsLive(entry))
+            {
+                wake = tick;
+                break;
+            }
+        }
+    }
+
+    // Higher levels: the tick at which the first non-empty slot cascades
+    for (uint32_t level = 1; level < kLevels; ++level)
+    {
+        const uint32_t shift = level * kSlotBits;
+        const uint64_t base = m_now >> shift;
+        for (uint32_t k = 1; k <= kSlots; ++k)
+        {
+            if (!m_slots[level][(base + k) & kSlotMask].empty())
+            {
+                wake = std::min(wake, (base + k) << shift);
+                break;
+            }
+        }
+    }
+    if (!m_overflow.empty())
+    {
+        const uint32_t shift = kLevels * kSlotBits;
+        wake = std::min(wake, ((m_now >> shift) + 1) << shift);
+    }
+
+    // Live timers exist, so something must wake the wheel
+    return (wake == kNever) ? m_now + 1 : wake;
+}
+
+void
+TimerWheel::Cascade(uint32_t level)
+{
+    std::vector<SlotEntry> entries;
+    if (level == kLevels)
+    {
+        entries.swap(m_overflow);
+    }
+    else
+    {
+        entries.swap(m_slots[level][SlotIndex(m_now, level)]);
+    }
+    for (const SlotEntry& entry : entries)
+    {
+        if (IsLive(entry))
+        {
+            Place(entry);
+        }
+    }
+}
+
+void
+TimerWheel::Step(std::vector<Key>& expired)
+{
+    ++m_now;
+
+    // Find how many levels wrapped, then cascade top-down so entries land in
+    // the lower slots before those are processed
+    uint32_t wrapped = 0;
+    while (wrapped < kLevels && SlotIndex(m_now, wrapped) == 0)
+    {
+        ++wrapped;
+    }
+    for (uint32_t level = wrapped; level >= 1; --level)
+    {
+        Cascade(level);
+    }
+
+    std::vector<SlotEntry> due;
+    due.swap(m_slots[0][SlotIndex(m_now, 0)]);
+    for (const SlotEntry& entry : due)
+    {
+        if (!IsLive(entry))
+        {
+            continue;
+        }
+        if (entry.expiry > m_now)
+        {
+            Place(entry);
+            continue;
+        }
+        m_timers.erase(entry.key);
+        expired.push_back(entry.key);
+    }
+}
+
+void
+TimerWheel::Advance(uint64_t tick, std::vector<Key>& expired)
+{
+    while (m_now < tick)
+    {
+        if (m_timers.empty())
+        {
+            // Nothing live: stale entries are harmless, jump straight there
+            for (auto& level : m_slots)
+            {
+                for (auto& slot : level)
+                {
+                    slot.clear();
+                }
+            }
+            m_overflow.clear();
+            m_now = tick;
+            return;
+        }
+        if (m_slots[0][SlotIndex(m_now + 1, 0)].empty())
+        {
+            // Nothing due or cascading before the wake tick: skip the gap
+            const uint64_t wake = GetNextWakeTick();
+            if (wake > m_now + 1)
+            {
+                m_now = std::min(tick, wake - 1);
+                continue;
+            }
+        }
+        Step(expired);
+    }
+}
+
+void
+TimerWheel::Clear()
+{
+    for (auto& level : m_slots)
+    {
+        for (auto& slot : level)
+        {
+            slot.clear();
+        }
+    }
+    m_overflow.clear();
+    m_timers.clear();
+    m_now = 0;
+    m_nextGeneration = 0;
+}
+
+} // namespace helper
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
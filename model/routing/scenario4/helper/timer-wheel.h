@@ -0,0 +1,120 @@
+/*
+ * Scenario 4 - Hierarchical Timer Wheel
+ *
+ * Integer-tick timing wheel for large numbers of short protocol timers.
+ * Pure data structure: the owner advances it and dispatches expired keys.
+ */
+
+#ifndef SCENARIO4_TIMER_WHEEL_H
+#define SCENARIO4_TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario4 {
+namespace helper {
+
+/**
+ * Four-level hierarchical timer wheel (64 slots per level).
+ *
+ * Level l holds timers due within 64^(l+1) ticks; a slot is cascaded into
+ * the level below when the wheel reaches it, so schedule, cancel and fire
+ * are O(1) amortized. Timers further out than 64^4 ticks wait in an overflow
+ * list. Cancel and reschedule are lazy: stale slot entries are skipped when
+ * their slot is processed.
+ */
+class TimerWheel
+{
+public:
+    using Key = uint64_t;
+
+    static constexpr uint32_t kLevels = 4;
+    static constexpr uint32_t kSlotBits = 6;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr uint64_t kNever = UINT64_MAX;
+
+    TimerWheel();
+
+    /**
+     * Schedule or reschedule a timer.
+     *
+     * \param key Timer key (one pending timer per key)
+     * \param expiryTick Tick at which the timer fires; ticks at or before
+     *        the current tick fire on the next tick
+     */
+    void Schedule(Key key, uint64_t expiryTick);
+
+    /**
+     * \return true if a pending timer was cancelled
+     */
+    bool Cancel(Key key);
+
+    bool IsPending(Key key) const;
+
+    /**
+     * \return expiry tick of a pending timer, or kNever
+     */
+    uint64_t GetExpiry(Key key) const;
+
+    size_t GetPendingCount() const;
+
+    /**
+     * \return last tick processed by Advance()
+     */
+    uint64_t GetCurrentTick() const;
+
+    /**
+     * \return earliest tick at which Advance() may have work to do (never
+     *         later than the next expiry), or kNever when nothing is pending
+     */
+    uint64_t GetNextWakeTick() const;
+
+    /**
+     * Advance to tick and collect the timers that expired on the way.
+     *
+     * \param tick Target tick
+     * \param expired Output: keys appended in expiry order
+     */
+    void Advance(uint64_t tick, std::vector<Key>& expired);
+
+    /**
+     * Drop every timer and restart at tick 0.
+     */
+    void Clear();
+
+private:
+    struct SlotEntry
+    {
+        Key key;
+        uint64_t expiry;
+        uint32_t generation;
+    };
+
+    struct TimerState
+    {
+        uint64_t expiry;
+        uint32_t generation;
+    };
+
+    void Place(const SlotEntry& entry);
+    bool IsLive(const SlotEntry& entry) const;
+    void Cascade(uint32_t level);
+    void Step(std::vector<Key>& expired);
+
+    uint64_t m_now;
+    uint32_t m_nextGeneration;
+    std::vector<SlotEntry> m_slots[kLevels][kSlots];
+    std::vector<SlotEntry> m_overflow;
+    std::unordered_map<Key, TimerState> m_timers;
+};
+
+} // namespace helper
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO4_TIMER_WHEEL_H
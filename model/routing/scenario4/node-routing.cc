@@ -9,6 +9,8 @@
 #include "ground-node-routing/ground-node-routing.h"
 #include "ground-node-routing/cell-cooperation.h"
 #include "packet-header.h"
+#include "event-log.h"
+#include "../../wsn-metrics.h"
 #include "../../radio/cc2420/cc2420-net-device.h"
 #include "ns3/mac16-address.h"
 #include "ns3/log.h"
@@ -21,6 +23,7 @@
 #include <cmath>
 #include <iomanip>
 #include <limits>
+#include <vector>
 
 namespace ns3 {
 
@@ -38,6 +41,9 @@ static double g_uav1MissionCompletedTime = -1.0;
 static bool g_uav2MissionCompleted = false;
 static double g_uav2MissionCompletedTime = -1.0;
 
+// Registry metrics (wsn-metrics.h)
+static const Counter g_metricUavBroadcasts("uav.broadcasts");
+
 namespace
 {
 Ptr<wsn::Cc2420NetDevice>
@@ -51,8 +57,34 @@ GetCc2420Device(Ptr<Node> node)
 }
 }
 
+// Per-node role table, indexed by node ID
+static std::vector<NodeRole> g_nodeRoles;
+
+void
+SetNodeRole(uint32_t nodeId, NodeRole role)
+{
+    if (nodeId >= g_nodeRoles.size())
+    {
+        g_nodeRoles.resize(nodeId + 1, NodeRole::UNKNOWN);
+    }
+    g_nodeRoles[nodeId] = role;
+}
+
+NodeRole
+GetNodeRole(uint32_t nodeId)
+{
+    return (nodeId < g_nodeRoles.size()) ? g_nodeRoles[nodeId] : NodeRole::UNKNOWN;
+}
+
+bool
+IsUavNode(uint32_t nodeId)
+{
+    return GetNodeRole(nodeId) == NodeRole::UAV;
+}
+
 void InitializeBaseStation(uint32_t nodeId)
 {
+    SetNodeRole(nodeId, NodeRole::BASE_STATION);
     if (g_baseStation == nullptr) {
         g_baseStation = new BaseStationNode(nodeId);
         g_baseStation->Initialize();
@@ -298,7 +330,7 @@ void InitializeUavBroadcast()
     // Get fragments to broadcast
     const FragmentCollection& fragments = GetBsGeneratedFragments();
     
-    if (fragments.fragments.empty())
+    if (fragments.IsEmpty())
     {
         NS_LOG_WARN("[UAV-BROADCAST] No fragments available for broadcast");
         return;
@@ -311,13 +343,13 @@ void InitializeUavBroadcast()
     
     // Calculate total broadcast duration and number of cycles
     const double totalBroadcastDuration = broadcastEndTime - broadcastStartTime;
-    const double singleCycleDuration = fragments.fragments.size() * broadcastInterval;
+    const double singleCycleDuration = fragments.GetCount() * broadcastInterval;
     const uint32_t numBroadcastCycles = static_cast<uint32_t>(
         std::ceil(totalBroadcastDuration / singleCycleDuration));
     
     NS_LOG_INFO("[UAV-BROADCAST] Initializing UAV2 fragment broadcast"
                 << " | uavNodeId=" << uav2NodeId
-                << " | numFragments=" << fragments.fragments.size()
+                << " | numFragments=" << fragments.GetCount()
                 << " | startTime=" << broadcastStartTime << "s"
                 << " | endTime=" << broadcastEndTime << "s"
                 << " | duration=" << totalBroadcastDuration << "s"
@@ -329,10 +361,15 @@ void InitializeUavBroadcast()
     double currentTime = broadcastStartTime;
     uint32_t totalBroadcasts = 0;
     
+    // One cycle in the BS broadcast schedule order
+    const FragmentBroadcastSchedule& schedule = GetBsBroadcastSchedule();
+
     for (uint32_t cycle = 0; cycle < numBroadcastCycles; ++cycle)
     {
-        for (const auto& [fragmentId, fragment] : fragments.fragments)
+        for (uint32_t round = 0; round < schedule.GetLength(); ++round)
         {
+            const Fragment& fragment = schedule.GetByRound(round);
+            const uint32_t fragmentId = fragment.fragmentId;
             // Stop scheduling if we've reached the last waypoint time
             if (currentTime > broadcastEndTime)
             {
@@ -354,18 +391,14 @@ void InitializeUavBroadcast()
                             << " | t=" << Simulator::Now().GetSeconds() << "s");
                 
                 // Log to result file
-                if (ns3::wsn::scenario4::params::g_resultFileStream)
-                {
-                    *ns3::wsn::scenario4::params::g_resultFileStream
-                        << "\n[EVENT] " << Simulator::Now().GetSeconds()
-                        << " | event=UAVFragmentBroadcast"
-                        << " | nodeId=" << uav2NodeId
-                        << " | fragmentId=" << fragmentId
-                        << " | cycle=" << (cycleNum + 1)
-                        << " | confidence=" << std::fixed << std::setprecision(3) << fragment.confidence
-                        << " | size=" << fragment.size
-                        << std::endl;
-                }
+                g_metricUavBroadcasts.Add();
+                LogResultUavBroadcast(EventLogType::UAV_FRAGMENT_BROADCAST,
+                                      Simulator::Now().GetSeconds(),
+                                      uav2NodeId,
+                                      fragmentId,
+                                      cycleNum + 1,
+                                      fragment.confidence,
+                                      fragment.size);
                 
                 // Broadcast fragment through CC2420 MAC/PHY.
                 // Receiver filtering is handled by CC2420 PHY link evaluation.
@@ -460,7 +493,7 @@ void InitializeCellCooperationTimeout()
         {
             const bool hasAllFragments =
                 (state.expectedFragmentCount > 0) &&
-                (state.fragments.fragments.size() >= state.expectedFragmentCount);
+                (state.fragments.GetCount() >= state.expectedFragmentCount);
             if (state.cooperationEnabled && state.cellId >= 0 && !state.cooperationTimeoutScheduled && !hasAllFragments)
             {
                 RequestFragmentSharing(nodeId, state.cellId);
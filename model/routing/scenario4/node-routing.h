@@ -12,6 +12,32 @@ namespace wsn {
 namespace scenario4 {
 namespace routing {
 
+/**
+ * Role of a simulation node, recorded once when the network is built.
+ */
+enum class NodeRole : uint8_t
+{
+    UNKNOWN = 0,
+    GROUND = 1,
+    BASE_STATION = 2,
+    UAV = 3
+};
+
+/**
+ * Record the role of a node (called by the Initialize* functions).
+ */
+void SetNodeRole(uint32_t nodeId, NodeRole role);
+
+/**
+ * \return role of a node, or UNKNOWN if never recorded
+ */
+NodeRole GetNodeRole(uint32_t nodeId);
+
+/**
+ * Check if a node is a UAV without touching its mobility model.
+ */
+bool IsUavNode(uint32_t nodeId);
+
 /**
  * Initialize base station component.
  */
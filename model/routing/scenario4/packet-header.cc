@@ -277,12 +277,108 @@ FragmentPacket::Deserialize(Buffer::Iterator start)
     return GetSerializedSize();
 }
 
+// ===== FragmentPacketView =====
+
+NS_OBJECT_ENSURE_REGISTERED(FragmentPacketView);
+
+FragmentPacketView::FragmentPacketView()
+    : m_isFragment(false)
+{
+}
+
+FragmentPacketView::~FragmentPacketView()
+{
+}
+
+PacketType
+FragmentPacketView::GetType() const
+{
+    return m_header.GetType();
+}
+
+bool
+FragmentPacketView::IsFragment() const
+{
+    return m_isFragment;
+}
+
+const FragmentPacket&
+FragmentPacketView::GetFragment() const
+{
+    return m_fragment;
+}
+
+TypeId
+FragmentPacketView::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::wsn::scenario4::routing::FragmentPacketView")
+        .SetParent<Header>()
+        .SetGroupName("Wsn")
+        .AddConstructor<FragmentPacketView>();
+    return tid;
+}
+
+TypeId
+FragmentPacketView::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+FragmentPacketView::Print(std::ostream& os) const
+{
+    m_header.Print(os);
+    if (m_isFragment)
+    {
+        os << " ";
+        m_fragment.Print(os);
+    }
+}
+
+uint32_t
+FragmentPacketView::GetSerializedSize() const
+{
+    return m_header.GetSerializedSize() +
+           (m_isFragment ? m_fragment.GetSerializedSize() : 0);
+}
+
+void
+FragmentPacketView::Serialize(Buffer::Iterator start) const
+{
+    m_header.Serialize(start);
+    if (m_isFragment)
+    {
+        start.Next(m_header.GetSerializedSize());
+        m_fragment.Serialize(start);
+    }
+}
+
+uint32_t
+FragmentPacketView::Deserialize(Buffer::Iterator start)
+{
+    start.Next(m_header.Deserialize(start));
+    
+    // Other packet types stop after the type byte
+    m_isFragment = (m_header.GetType() == PACKET_TYPE_FRAGMENT) &&
+                   (start.GetRemainingSize() >= m_fragment.GetSerializedSize());
+    if (m_isFragment)
+    {
+        m_fragment.Deserialize(start);
+    }
+    return GetSerializedSize();
+}
+
 // ===== CooperationPacket =====
 
 NS_OBJECT_ENSURE_REGISTERED(CooperationPacket);
 
 CooperationPacket::CooperationPacket()
-    : m_requesterId(0), m_cellId(0)
+    : m_messageType(COOPERATION_AVAILABILITY_QUERY),
+      m_requesterId(0),
+      m_cellId(0),
+      m_sourceId(0),
+      m_destinationId(kFloodDestination),
+      m_hopId(0)
 {
 }
 
@@ -290,6 +386,18 @@ CooperationPacket::~CooperationPacket()
 {
 }
 
+void
+CooperationPacket::SetMessageType(CooperationMessageType type)
+{
+    m_messageType = static_cast<uint8_t>(type);
+}
+
+CooperationMessageType
+CooperationPacket::GetMessageType() const
+{
+    return static_cast<CooperationMessageType>(m_messageType);
+}
+
 void
 CooperationPacket::SetRequesterId(uint32_t requesterId)
 {
@@ -315,15 +423,87 @@ CooperationPacket::GetCellId() const
 }
 
 void
-CooperationPacket::SetNeededFragments(const std::vector<uint32_t>& fragmentIds)
+CooperationPacket::SetSourceId(uint32_t sourceId)
 {
-    m_neededFragments = fragmentIds;
+    m_sourceId = sourceId;
+}
+
+uint32_t
+CooperationPacket::GetSourceId() const
+{
+    return m_sourceId;
+}
+
+void
+CooperationPacket::SetDestinationId(uint32_t destinationId)
+{
+    m_destinationId = destinationId;
+}
+
+uint32_t
+CooperationPacket::GetDestinationId() const
+{
+    return m_destinationId;
+}
+
+void
+CooperationPacket::SetHopId(uint32_t hopId)
+{
+    m_hopId = hopId;
+}
+
+uint32_t
+CooperationPacket::GetHopId() const
+{
+    return m_hopId;
+}
+
+void
+CooperationPacket::SetFragmentIds(const std::vector<uint32_t>& fragmentIds)
+{
+    m_fragmentIds = fragmentIds;
 }
 
 const std::vector<uint32_t>&
-CooperationPacket::GetNeededFragments() const
+CooperationPacket::GetFragmentIds() const
+{
+    return m_fragmentIds;
+}
+
+void
+CooperationPacket::SetRecords(const std::vector<CooperationFragmentRecord>& records)
+{
+    m_records = records;
+}
+
+const std::vector<CooperationFragmentRecord>&
+CooperationPacket::GetRecords() const
+{
+    return m_records;
+}
+
+uint32_t
+CooperationPacket::GetCommonSerializedSize()
+{
+    return 1 + 4 + 4 + 4 + 4 + 4; // type + requester + cell + source + destination + hop
+}
+
+uint32_t
+CooperationPacket::GetRecordSerializedSize()
+{
+    return 4 + 8; // fragmentId + confidence
+}
+
+uint32_t
+CooperationPacket::GetBitmapSerializedSize(uint32_t span)
 {
-    return m_neededFragments;
+    return 4 + 2 + (span + 7) / 8; // first ID + bit count + bits
+}
+
+bool
+CooperationPacket::HasRecords() const
+{
+    return m_messageType == COOPERATION_FRAGMENT_DATA;
 }
 
 TypeId
@@ -345,37 +525,94 @@ CooperationPacket::GetInstanceTypeId() const
 void
 CooperationPacket::Print(std::ostream& os) const
 {
-    os << "CooperationPacket(requester=" << m_requesterId
+    os << "CooperationPacket(type=" << static_cast<int>(m_messageType)
+       << ", requester=" << m_requesterId
        << ", cell=" << m_cellId
-       << ", fragments=" << m_neededFragments.size() << ")";
+       << ", source=" << m_sourceId
+       << ", destination=" << m_destinationId
+       << ", hop=" << m_hopId
+       << ", fragments=" << (HasRecords() ? m_records.size() : m_fragmentIds.size()) << ")";
 }
 
 uint32_t
 CooperationPacket::GetSerializedSize() const
 {
-    return 4 + 4 + 4 + (m_neededFragments.size() * 4);
+    if (HasRecords()) {
+        return GetCommonSerializedSize() + 1 + m_records.size() * GetRecordSerializedSize();
+    }
+    const uint32_t span = m_fragmentIds.empty()
+                              ? 0
+                              : m_fragmentIds.back() - m_fragmentIds.front() + 1;
+    return GetCommonSerializedSize() + GetBitmapSerializedSize(span);
 }
 
 void
 CooperationPacket::Serialize(Buffer::Iterator start) const
 {
+    start.WriteU8(m_messageType);
     start.WriteHtonU32(m_requesterId);
     start.WriteHtonU32(static_cast<uint32_t>(m_cellId));
-    start.WriteHtonU32(static_cast<uint32_t>(m_neededFragments.size()));
-    for (uint32_t fragId : m_neededFragments) {
-        start.WriteHtonU32(fragId);
+    start.WriteHtonU32(m_sourceId);
+    start.WriteHtonU32(m_destinationId);
+    start.WriteHtonU32(m_hopId);
+
+    if (HasRecords()) {
+        start.WriteU8(static_cast<uint8_t>(m_records.size()));
+        for (const auto& record : m_records) {
+            start.WriteHtonU32(record.fragmentId);
+            start.WriteHtonU64(*reinterpret_cast<const uint64_t*>(&record.confidence));
+        }
+        return;
+    }
+
+    const uint32_t firstId = m_fragmentIds.empty() ? 0 : m_fragmentIds.front();
+    const uint32_t span = m_fragmentIds.empty() ? 0 : m_fragmentIds.back() - firstId + 1;
+    std::vector<uint8_t> bits((span + 7) / 8, 0);
+    for (uint32_t fragId : m_fragmentIds) {
+        const uint32_t offset = fragId - firstId;
+        bits[offset / 8] |= static_cast<uint8_t>(1u << (offset % 8));
+    }
+    start.WriteHtonU32(firstId);
+    start.WriteHtonU16(static_cast<uint16_t>(span));
+    for (uint8_t byte : bits) {
+        start.WriteU8(byte);
     }
 }
 
 uint32_t
 CooperationPacket::Deserialize(Buffer::Iterator start)
 {
+    m_messageType = start.ReadU8();
     m_requesterId = start.ReadNtohU32();
     m_cellId = static_cast<int32_t>(start.ReadNtohU32());
-    uint32_t count = start.ReadNtohU32();
-    m_neededFragments.clear();
-    for (uint32_t i = 0; i < count; ++i) {
-        m_neededFragments.push_back(start.ReadNtohU32());
+    m_sourceId = start.ReadNtohU32();
+    m_destinationId = start.ReadNtohU32();
+    m_hopId = start.ReadNtohU32();
+    m_fragmentIds.clear();
+    m_records.clear();
+
+    if (HasRecords()) {
+        const uint8_t count = start.ReadU8();
+        for (uint8_t i = 0; i < count; ++i) {
+            CooperationFragmentRecord record;
+            record.fragmentId = start.ReadNtohU32();
+            uint64_t confBits = start.ReadNtohU64();
+            record.confidence = *reinterpret_cast<double*>(&confBits);
+            m_records.push_back(record);
+        }
+        return GetSerializedSize();
+    }
+
+    const uint32_t firstId = start.ReadNtohU32();
+    const uint32_t span = start.ReadNtohU16();
+    for (uint32_t byteIndex = 0; byteIndex < (span + 7) / 8; ++byteIndex) {
+        const uint8_t byte = start.ReadU8();
+        for (uint32_t bit = 0; bit < 8; ++bit) {
+            const uint32_t offset = byteIndex * 8 + bit;
+            if (offset < span && (byte & (1u << bit)) != 0) {
+                m_fragmentIds.push_back(firstId + offset);
+            }
+        }
     }
     return GetSerializedSize();
 }
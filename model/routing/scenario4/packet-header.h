@@ -119,24 +119,135 @@ private:
 };
 
 /**
- * Cell cooperation request packet.
+ * Read-only view of a FRAGMENT packet: PacketHeader followed by
+ * FragmentPacket, deserialized in one pass.
+ *
+ * Meant for PeekHeader() on the const received packet, so the fragment
+ * reception path needs neither a packet copy nor two RemoveHeader() calls.
+ * Serializes to the same bytes as the two headers added separately.
+ */
+class FragmentPacketView : public Header
+{
+public:
+    FragmentPacketView();
+    virtual ~FragmentPacketView();
+    
+    PacketType GetType() const;
+    
+    /**
+     * \return true if the packet is a complete FRAGMENT packet
+     */
+    bool IsFragment() const;
+    
+    /**
+     * \return fragment header (valid only if IsFragment())
+     */
+    const FragmentPacket& GetFragment() const;
+    
+    // Header serialization
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Print(std::ostream& os) const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    
+private:
+    PacketHeader m_header;
+    FragmentPacket m_fragment;
+    bool m_isFragment;
+};
+
+/**
+ * Cell cooperation message types.
+ */
+enum CooperationMessageType
+{
+    COOPERATION_AVAILABILITY_QUERY = 1,  ///< Requester's missing IDs, flooded over the cell tree
+    COOPERATION_AVAILABILITY_REPORT = 2, ///< IDs a peer can supply, routed to the requester
+    COOPERATION_PULL_REQUEST = 3,        ///< IDs the requester pulls from one peer
+    COOPERATION_FRAGMENT_DATA = 4        ///< Batch of fragment records answering a pull
+};
+
+/**
+ * One fragment carried in a COOPERATION_FRAGMENT_DATA frame.
+ */
+struct CooperationFragmentRecord
+{
+    uint32_t fragmentId;
+    double confidence;
+};
+
+/**
+ * Cell cooperation packet.
  * 
- * Request for fragment sharing within cell.
+ * Query, report and pull messages carry fragment IDs as a bitmap over
+ * [first ID, last ID]; data messages carry (ID, confidence) records.
+ * Messages travel hop by hop over the intra-cell routing tree.
  */
 class CooperationPacket : public Header
 {
 public:
+    static constexpr uint32_t kFloodDestination = 0xFFFFFFFF; ///< Tree-wide query
+
     CooperationPacket();
     virtual ~CooperationPacket();
     
+    void SetMessageType(CooperationMessageType type);
+    CooperationMessageType GetMessageType() const;
+
     void SetRequesterId(uint32_t requesterId);
     uint32_t GetRequesterId() const;
     
     void SetCellId(int32_t cellId);
     int32_t GetCellId() const;
+
+    /**
+     * Node that created the message.
+     */
+    void SetSourceId(uint32_t sourceId);
+    uint32_t GetSourceId() const;
+
+    /**
+     * Final destination, or kFloodDestination.
+     */
+    void SetDestinationId(uint32_t destinationId);
+    uint32_t GetDestinationId() const;
+
+    /**
+     * Node transmitting this hop.
+     */
+    void SetHopId(uint32_t hopId);
+    uint32_t GetHopId() const;
     
-    void SetNeededFragments(const std::vector<uint32_t>& fragmentIds);
-    const std::vector<uint32_t>& GetNeededFragments() const;
+    /**
+     * Set the fragment IDs of a query, report or pull message.
+     *
+     * \param fragmentIds Fragment IDs in ascending order
+     */
+    void SetFragmentIds(const std::vector<uint32_t>& fragmentIds);
+    const std::vector<uint32_t>& GetFragmentIds() const;
+
+    /**
+     * Set the records of a data message (at most 255).
+     */
+    void SetRecords(const std::vector<CooperationFragmentRecord>& records);
+    const std::vector<CooperationFragmentRecord>& GetRecords() const;
+
+    /**
+     * \return serialized size of a message without IDs or records
+     */
+    static uint32_t GetCommonSerializedSize();
+
+    /**
+     * \return extra bytes of a data message per record
+     */
+    static uint32_t GetRecordSerializedSize();
+
+    /**
+     * \return bytes of an ID bitmap spanning the given number of IDs
+     */
+    static uint32_t GetBitmapSerializedSize(uint32_t span);
     
     // Header serialization
     static TypeId GetTypeId();
@@ -147,9 +258,16 @@ public:
     uint32_t Deserialize(Buffer::Iterator start) override;
     
 private:
+    bool HasRecords() const;
+
+    uint8_t m_messageType;
     uint32_t m_requesterId;
     int32_t m_cellId;
-    std::vector<uint32_t> m_neededFragments;
+    uint32_t m_sourceId;
+    uint32_t m_destinationId;
+    uint32_t m_hopId;
+    std::vector<uint32_t> m_fragmentIds;
+    std::vector<CooperationFragmentRecord> m_records;
 };
 
 } // namespace routing
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include "../../../examples/scenarios/scenario4/scenario4-params.h"
 #include "ns3/wsn-module.h"
 
 namespace ns3
@@ -18,7 +19,11 @@ namespace params
 // Global result file stream definition
 // This is managed by example4.cc - it opens and closes the stream
 // Other files can write directly: if (g_resultFileStream) *g_resultFileStream << "content";
-std::ofstream* g_resultFileStream = nullptr;
+std::ostream* g_resultFileStream = nullptr;
+
+// UAV2 k-means overrides (see Scenario4RunConfig)
+uint32_t g_uav2KmeansNumCentroids = 0;
+double g_uav2KmeansTolerance = UAV2_KMEANS_TOLERANCE;
 
 } // namespace params
 } // namespace scenario4
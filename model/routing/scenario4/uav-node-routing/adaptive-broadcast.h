@@ -0,0 +1,117 @@
+/*
+ * Scenario 4 - Adaptive UAV Broadcast Scheduler
+ *
+ * Picks the next fragment a UAV broadcasts from what the ground nodes in
+ * range still lack, instead of a fixed round-robin.
+ */
+
+#ifndef SCENARIO4_ADAPTIVE_BROADCAST_H
+#define SCENARIO4_ADAPTIVE_BROADCAST_H
+
+#include "../fragment.h"
+#include "../base-station-node/broadcast-schedule.h"
+#include "ns3/vector.h"
+#include <cstdint>
+#include <map>
+#include <queue>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario4 {
+namespace routing {
+
+/**
+ * Per-UAV scheduler driven by ground-node holdings.
+ *
+ * For every fragment of the BS broadcast schedule it keeps the number of
+ * ground nodes in range that still lack it (the fragment's marginal
+ * coverage). Gains are updated incrementally from nodes entering or leaving
+ * range and from fragments they gained since the last round, and a lazy
+ * max-heap returns the best fragment in O(log F) amortized. Ties follow the
+ * BS schedule order.
+ */
+class AdaptiveBroadcastScheduler
+{
+public:
+    /**
+     * \param schedule BS broadcast schedule (fragments and tie-break order)
+     */
+    explicit AdaptiveBroadcastScheduler(const FragmentBroadcastSchedule& schedule);
+
+    /**
+     * Refresh the in-range node set and fragment gains from
+     * g_groundNetworkPerNode. Candidates come from a grid of ground node
+     * positions built on the first call, so a round costs the nodes near
+     * the UAV rather than the whole network.
+     *
+     * \param uavPosition Current UAV position
+     * \param radius Broadcast radius in meters (2D distance)
+     */
+    void Update(const Vector& uavPosition, double radius);
+
+    /**
+     * \param fragmentId Output: fragment lacked by most nodes in range
+     * \return false if no node in range lacks any fragment
+     */
+    bool SelectNext(uint32_t& fragmentId);
+
+    /**
+     * \return ground nodes in range at the last Update()
+     */
+    const std::vector<uint32_t>& GetNodesInRange() const;
+
+    /**
+     * \return number of nodes in range lacking the fragment
+     */
+    uint32_t GetGain(uint32_t fragmentId) const;
+
+private:
+    struct HeapEntry
+    {
+        uint32_t gain;
+        uint32_t rank;
+        uint32_t fragmentId;
+
+        bool operator<(const HeapEntry& other) const
+        {
+            // Larger gain first, then earlier schedule rank
+            return gain != other.gain ? gain < other.gain : rank > other.rank;
+        }
+    };
+
+    /**
+     * Add delta to the gain of every fragment in ids.
+     */
+    void AdjustGains(const FragmentBitset& ids, int32_t delta);
+
+    void PushEntry(uint32_t fragmentId);
+
+    /**
+     * Bucket ground nodes on a uniform grid (ground nodes do not move).
+     */
+    void BuildGrid(double radius);
+
+    double m_gridRadius = -1.0;
+    size_t m_gridNodeCount = 0;
+    double m_gridCellSize = 1.0;
+    double m_gridMinX = 0.0;
+    double m_gridMinY = 0.0;
+    int32_t m_gridCols = 0;
+    int32_t m_gridRows = 0;
+    std::vector<std::vector<uint32_t>> m_gridCells; ///< node IDs per grid cell
+
+    FragmentBitset m_poolIds;
+    std::vector<uint32_t> m_rank;   ///< schedule rank by fragment ID
+    std::vector<uint32_t> m_gain;   ///< nodes in range lacking each fragment ID
+    std::priority_queue<HeapEntry> m_heap;
+    std::map<uint32_t, FragmentBitset> m_trackedMissing;  ///< in-range node -> missing IDs
+    std::vector<uint32_t> m_nodesInRange;
+};
+
+} // namespace routing
+} // namespace scenario4
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO4_ADAPTIVE_BROADCAST_H
@@ -1,4 +1,5 @@
 #include "fragment-broadcast.h"
+#include "adaptive-broadcast.h"
 #include "../packet-header.h"
 #include "../helper/calc-utils.h"
 #include "../ground-node-routing/ground-node-routing.h"
@@ -10,7 +11,9 @@
 #include "ns3/node-list.h"
 #include "ns3/mobility-model.h"
 #include "ns3/log.h"
+#include "../../../../examples/scenarios/scenario4/scenario4-params.h"
 #include <algorithm>
+#include <map>
 
 namespace ns3 {
 
@@ -25,19 +28,18 @@ namespace
 static constexpr double kBroadcastInterval = 1.0;
 static constexpr uint32_t kMaxBroadcastRounds = 8;
 
+// Adaptive scheduler of each broadcasting UAV
+std::map<uint32_t, AdaptiveBroadcastScheduler> g_adaptiveSchedulers;
+
 const Fragment*
 GetFragmentByRound(uint32_t round)
 {
-    const FragmentCollection& pool = GetBsGeneratedFragments();
-    if (pool.fragments.empty())
+    const FragmentBroadcastSchedule& schedule = GetBsBroadcastSchedule();
+    if (schedule.IsEmpty())
     {
         return nullptr;
     }
-
-    const uint32_t index = round % static_cast<uint32_t>(pool.fragments.size());
-    auto it = pool.fragments.begin();
-    std::advance(it, index);
-    return &(it->second);
+    return &schedule.GetByRound(round);
 }
 
 Ptr<wsn::Cc2420NetDevice>
@@ -93,14 +95,90 @@ BroadcastOneRound(uint32_t uavNodeId, uint32_t round)
         Simulator::Schedule(Seconds(kBroadcastInterval), &BroadcastOneRound, uavNodeId, round + 1);
     }
 }
+void
+BroadcastAdaptiveRound(uint32_t uavNodeId, uint32_t round)
+{
+    auto it = g_adaptiveSchedulers.find(uavNodeId);
+    if (it == g_adaptiveSchedulers.end())
+    {
+        return;
+    }
+    AdaptiveBroadcastScheduler& scheduler = it->second;
+
+    Ptr<Node> uav = NodeList::GetNode(uavNodeId);
+    Ptr<MobilityModel> uavMobility = uav ? uav->GetObject<MobilityModel>() : nullptr;
+    Ptr<wsn::Cc2420NetDevice> uavDev = GetCc2420Device(uav);
+    if (!uavMobility || !uavDev)
+    {
+        g_adaptiveSchedulers.erase(it);
+        return;
+    }
+
+    // In-range estimate from the ground positions; the radio decides actual delivery
+    scheduler.Update(uavMobility->GetPosition(), ::ns3::wsn::scenario4::params::UAV_BROADCAST_RADIUS);
+
+    uint32_t fragmentId = 0;
+    if (scheduler.SelectNext(fragmentId))
+    {
+        const Fragment* fragment = GetBsGeneratedFragments().GetFragment(fragmentId);
+
+        Ptr<Packet> p = Create<Packet>();
+        FragmentPacket f;
+        f.SetFragmentId(fragmentId);
+        f.SetSourceId(uavNodeId);
+        f.SetConfidence(fragment ? fragment->confidence : 0.5);
+
+        PacketHeader h;
+        h.SetType(PACKET_TYPE_FRAGMENT);
+
+        p->AddHeader(f);
+        p->AddHeader(h);
+        uavDev->Send(p, Mac16Address("FF:FF"), 0);
+
+        NS_LOG_DEBUG("UAV " << uavNodeId << " round " << round
+                     << " | fragment=" << fragmentId
+                     << " | gain=" << scheduler.GetGain(fragmentId)
+                     << " | inRange=" << scheduler.GetNodesInRange().size());
+    }
+    else if (!scheduler.GetNodesInRange().empty())
+    {
+        NS_LOG_INFO("UAV " << uavNodeId << " stops broadcasting after round " << round
+                    << " | all " << scheduler.GetNodesInRange().size()
+                    << " nodes in range hold every fragment");
+        g_adaptiveSchedulers.erase(it);
+        return;
+    }
+
+    if (round + 1 < ::ns3::wsn::scenario4::params::UAV_ADAPTIVE_BROADCAST_MAX_ROUNDS)
+    {
+        Simulator::Schedule(Seconds(::ns3::wsn::scenario4::params::UAV_ADAPTIVE_BROADCAST_INTERVAL),
+                            &BroadcastAdaptiveRound,
+                            uavNodeId,
+                            round + 1);
+    }
+    else
+    {
+        g_adaptiveSchedulers.erase(it);
+    }
+}
 } // namespace
 
 void
 StartFragmentBroadcast(uint32_t uavNodeId)
 {
-    const uint32_t poolSize = static_cast<uint32_t>(GetBsGeneratedFragments().fragments.size());
+    const uint32_t poolSize = static_cast<uint32_t>(GetBsGeneratedFragments().GetCount());
+    const bool adaptive = ::ns3::wsn::scenario4::params::UAV_ADAPTIVE_BROADCAST &&
+                          !GetBsBroadcastSchedule().IsEmpty();
     NS_LOG_INFO("UAV " << uavNodeId << " starts fragment broadcasting"
-                << " | bsFragmentPool=" << poolSize);
+                << " | bsFragmentPool=" << poolSize
+                << " | adaptive=" << adaptive);
+    if (adaptive)
+    {
+        g_adaptiveSchedulers.erase(uavNodeId);
+        g_adaptiveSchedulers.emplace(uavNodeId, AdaptiveBroadcastScheduler(GetBsBroadcastSchedule()));
+        Simulator::ScheduleNow(&BroadcastAdaptiveRound, uavNodeId, 0);
+        return;
+    }
     Simulator::ScheduleNow(&BroadcastOneRound, uavNodeId, 0);
 }
 
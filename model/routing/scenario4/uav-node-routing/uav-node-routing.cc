@@ -1,5 +1,6 @@
 #include "uav-node-routing.h"
 #include "fragment-broadcast.h"
+#include "../node-routing.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/mobility-model.h"
@@ -78,6 +79,7 @@ InitializeUavRouting(Ptr<Node> uavNode)
 
     uint32_t nodeId = uavNode->GetId();
     g_uavNodes[nodeId] = uavNode;
+    SetNodeRole(nodeId, NodeRole::UAV);
 
     //g_bsUavCommandCallback = &OnUavCommandReceived;
 }
@@ -5,15 +5,19 @@
 #include "base-station-node.h"
 #include "fragment-generator.h"
 #include "../helper/calc-utils.h"
+#include "../ground-node-routing/cell-cooperation.h"
 #include "../ground-node-routing/ground-node-routing.h"
+#include "../../../wsn-profiler.h"
 #include "../../../../examples/scenarios/scenario5/scenario5-params.h"
 #include "region-selection.h"
 #include "uav-control.h"
+#include "uav-path-planner.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node-list.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -37,8 +41,44 @@ namespace routing {
 std::set<uint32_t> g_suspiciousNodes;
 uint32_t g_suspiciousSeedNodeId = std::numeric_limits<uint32_t>::max();
 
+// Cell index shared by BS init passes
+helper::HexCellIndex g_hexCellIndex;
+
+// Step timings of the last BS init
+static std::vector<BsInitPhaseTiming> g_bsInitPhaseTimings;
+
 namespace {
 
+/**
+ * Appends the wall-clock time of its scope to g_bsInitPhaseTimings and,
+ * with WSN_ENABLE_PROFILING, times it as "bs.init.<name>" in the profiler.
+ */
+class BsInitPhaseTimer
+{
+public:
+    explicit BsInitPhaseTimer(const char* name)
+        : m_name(name),
+#ifdef WSN_ENABLE_PROFILING
+          m_profileScope(::ns3::wsn::Profiler::Get().Register(std::string("bs.init.") + name)),
+#endif
+          m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~BsInitPhaseTimer()
+    {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+        g_bsInitPhaseTimings.push_back({m_name, elapsed.count()});
+    }
+
+private:
+    const char* m_name;
+#ifdef WSN_ENABLE_PROFILING
+    ::ns3::wsn::Profiler::Scope m_profileScope;
+#endif
+    std::chrono::steady_clock::time_point m_start;
+};
+
 void
 AssignCellIdAndColorForGroundNodes(double cellRadius)
 {
@@ -55,6 +95,11 @@ AssignCellIdAndColorForGroundNodes(double cellRadius)
                 << "posX" << " "
                 << "posY" << std::endl;
         }
+
+    std::vector<uint32_t> indexedNodeIds;
+    std::vector<helper::HexCellCoord> indexedCoords;
+    indexedNodeIds.reserve(nodeCount);
+    indexedCoords.reserve(nodeCount);
         
     for (auto& [nodeId, state] : g_groundNetworkPerNode)
     {
@@ -77,6 +122,8 @@ AssignCellIdAndColorForGroundNodes(double cellRadius)
         const helper::HexCellCoord coord = helper::ComputeHexCellCoord(pos.x, pos.y, cellRadius);
         state.cellId = helper::MakeCellId(coord.q, coord.r, gridOffset);
         state.cellColor = helper::ComputeHexColor(coord.q, coord.r);
+        indexedNodeIds.push_back(nodeId);
+        indexedCoords.push_back(coord);
 
         updatedCount++;
         NS_LOG_DEBUG("[BS-INIT] node=" << nodeId << " pos=(" << pos.x << "," << pos.y
@@ -96,9 +143,12 @@ AssignCellIdAndColorForGroundNodes(double cellRadius)
         }
     }
 
+    g_hexCellIndex.Build(indexedNodeIds, indexedCoords, gridOffset);
+    InitializeCellCooperation();
 
     NS_LOG_INFO("[BS-INIT] Assigned cellId/cellColor for " << updatedCount
-        << " ground nodes (gridOffset=" << gridOffset << ")");
+        << " ground nodes (gridOffset=" << gridOffset << ", cells="
+        << g_hexCellIndex.GetNumCells() << ")");
 }
 
 void
@@ -184,7 +234,9 @@ DiscoverNeighborsAndTwoHopsForGroundNodes(double neighborRadius)
 
         state.isIsolated = state.neighbors.empty();
         state.startupComplete = true;
+        g_hexCellIndex.AddNodeLinks(nodeId, state.neighbors);
     }
+    g_hexCellIndex.FinalizeLinks();
 
     NS_LOG_INFO("[BS-INIT] Neighbor discovery done with radius=" << neighborRadius
                 << "m, links=" << neighborLinks);
@@ -193,12 +245,6 @@ DiscoverNeighborsAndTwoHopsForGroundNodes(double neighborRadius)
 void
 SelectCellLeadersByNearestCellCenter(double cellRadius)
 {
-    std::map<int32_t, std::vector<uint32_t>> membersByCell;
-    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
-    {
-        membersByCell[state.cellId].push_back(nodeId);
-    }
-
     for (auto& [nodeId, state] : g_groundNetworkPerNode)
     {
         (void)nodeId;
@@ -213,16 +259,16 @@ SelectCellLeadersByNearestCellCenter(double cellRadius)
             << "[CELL-LEADER] " << "cellId" << " leaderNodeId" << " distanceToCenter" << std::endl;
     }
 
-    for (const auto& [cellId, members] : membersByCell)
+    for (uint32_t cell = 0; cell < g_hexCellIndex.GetNumCells(); ++cell)
     {
+        const helper::NodeIdRange members = g_hexCellIndex.GetMembers(cell);
         if (members.empty())
         {
             continue;
         }
 
-        const auto& firstState = g_groundNetworkPerNode.at(members.front());
-        const helper::HexCellCoord cellCoord =
-            helper::ComputeHexCellCoord(firstState.position.x, firstState.position.y, cellRadius);
+        const int32_t cellId = g_hexCellIndex.GetCellId(cell);
+        const helper::HexCellCoord cellCoord = g_hexCellIndex.GetCoord(cell);
 
         double centerX = 0.0;
         double centerY = 0.0;
@@ -272,39 +318,17 @@ void
 ValidateIntraCellRoutingTrees()
 {
     // Validate that all nodes have valid routing paths to neighboring cells
-    std::map<int32_t, std::set<int32_t>> cellNeighbors;
-    std::map<int32_t, std::vector<uint32_t>> nodesByCell;
-    
-    // Build data structures
-    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
-    {
-        nodesByCell[state.cellId].push_back(nodeId);
-        
-        for (uint32_t neighborId : state.neighbors)
-        {
-            auto neighborIt = g_groundNetworkPerNode.find(neighborId);
-            if (neighborIt == g_groundNetworkPerNode.end())
-                continue;
-            
-            const int32_t cellA = state.cellId;
-            const int32_t cellB = neighborIt->second.cellId;
-            if (cellA != cellB)
-            {
-                cellNeighbors[cellA].insert(cellB);
-            }
-        }
-    }
-    
     uint32_t validationErrors = 0;
     uint32_t validatedNodes = 0;
     
     // For each cell, verify all members have valid routes
-    for (const auto& [cellId, members] : nodesByCell)
+    for (uint32_t cell = 0; cell < g_hexCellIndex.GetNumCells(); ++cell)
     {
+        const helper::NodeIdRange members = g_hexCellIndex.GetMembers(cell);
         if (members.empty())
             continue;
         
-        const auto& neighborCells = cellNeighbors[cellId];
+        const int32_t cellId = g_hexCellIndex.GetCellId(cell);
         
         // For each node in the cell
         for (uint32_t nodeId : members)
@@ -335,7 +359,7 @@ ValidateIntraCellRoutingTrees()
                     NS_LOG_WARN("[BS-VALIDATE] Node " << nodeId << " has invalid next-hop " << nextHop);
                     validationErrors++;
                 }
-                else if (g_groundNetworkPerNode[nextHop].cellId != cellId)
+                else if (!g_hexCellIndex.InSameCell(nextHop, nodeId))
                 {
                     NS_LOG_WARN("[BS-VALIDATE] Node " << nodeId << " next-hop " << nextHop 
                                << " not in same cell");
@@ -344,8 +368,9 @@ ValidateIntraCellRoutingTrees()
             }
             
             // For each neighboring cell, verify node can reach a gateway
-            for (int32_t neighborCellId : neighborCells)
+            for (uint32_t neighborCell : g_hexCellIndex.GetLinkedNeighbors(cell))
             {
+                const int32_t neighborCellId = g_hexCellIndex.GetCellId(neighborCell);
                 // Check if gateway exists
                 if (::ns3::wsn::scenario5::params::g_cellGatewayPairs.find(cellId) ==
                     ::ns3::wsn::scenario5::params::g_cellGatewayPairs.end() ||
@@ -437,23 +462,19 @@ ValidateIntraCellRoutingTrees()
 void
 BuildIntraCellRoutingTrees()
 {
-    // Group nodes by cell ID
-    std::map<int32_t, std::vector<uint32_t>> nodesByCell;
-    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
-    {
-        nodesByCell[state.cellId].push_back(nodeId);
-    }
-    
     // Clear routing tree
     ::ns3::wsn::scenario5::params::g_intraCellRoutingTree.clear();
     
     uint32_t totalTreeNodes = 0;
     
-    for (const auto& [cellId, members] : nodesByCell)
+    for (uint32_t cell = 0; cell < g_hexCellIndex.GetNumCells(); ++cell)
     {
+        const helper::NodeIdRange members = g_hexCellIndex.GetMembers(cell);
         if (members.empty())
             continue;
         
+        const int32_t cellId = g_hexCellIndex.GetCellId(cell);
+        
         // Find cell leader (should already be marked during leader selection)
         uint32_t cellLeaderId = members.front();
         for (uint32_t memberId : members)
@@ -465,8 +486,6 @@ BuildIntraCellRoutingTrees()
             }
         }
         
-        std::set<uint32_t> memberSet(members.begin(), members.end());
-        
         // ===== BUILD MAIN INTRA-CELL TREE (rooted at cell leader) =====
         std::queue<uint32_t> q;
         std::set<uint32_t> visited;
@@ -488,7 +507,7 @@ BuildIntraCellRoutingTrees()
             for (uint32_t neighborId : currentState.neighbors)
             {
                 // Only add neighbors in the same cell
-                if (memberSet.find(neighborId) == memberSet.end() || visited.count(neighborId) > 0)
+                if (g_hexCellIndex.GetCellIndexOfNode(neighborId) != cell || visited.count(neighborId) > 0)
                     continue;
                 
                 visited.insert(neighborId);
@@ -522,7 +541,7 @@ BuildIntraCellRoutingTrees()
                 // Use first gateway as root for this neighbor cell's tree
                 const uint32_t gatewayId = gatewayList.front();
                 
-                if (memberSet.find(gatewayId) == memberSet.end())
+                if (g_hexCellIndex.GetCellIndexOfNode(gatewayId) != cell)
                     continue;
                 
                 // Build BFS tree rooted at gateway for this neighbor cell direction
@@ -543,7 +562,7 @@ BuildIntraCellRoutingTrees()
                     
                     for (uint32_t neighborId : currentState.neighbors)
                     {
-                        if (memberSet.find(neighborId) == memberSet.end() || gvisited.count(neighborId) > 0)
+                        if (g_hexCellIndex.GetCellIndexOfNode(neighborId) != cell || gvisited.count(neighborId) > 0)
                             continue;
                         
                         gvisited.insert(neighborId);
@@ -606,38 +625,21 @@ void
 EnhanceRoutingTreesForGatewayAccess()
 {
     // Ensure all nodes can reach gateways to neighbor cells via direct routing entries
-    std::map<int32_t, std::set<int32_t>> cellNeighbors;
-    std::map<int32_t, std::vector<uint32_t>> nodesByCell;
-    
-    // Build data structures
-    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
-    {
-        nodesByCell[state.cellId].push_back(nodeId);
-        
-        for (uint32_t neighborId : state.neighbors)
-        {
-            auto neighborIt = g_groundNetworkPerNode.find(neighborId);
-            if (neighborIt == g_groundNetworkPerNode.end())
-                continue;
-            
-            const int32_t cellA = state.cellId;
-            const int32_t cellB = neighborIt->second.cellId;
-            if (cellA != cellB)
-                cellNeighbors[cellA].insert(cellB);
-        }
-    }
-    
     uint32_t routesAdded = 0;
     
     // For each cell, ensure all nodes can reach at least one gateway
-    for (const auto& [cellId, members] : nodesByCell)
+    for (uint32_t cell = 0; cell < g_hexCellIndex.GetNumCells(); ++cell)
     {
+        const helper::NodeIdRange members = g_hexCellIndex.GetMembers(cell);
         if (members.empty())
             continue;
         
+        const int32_t cellId = g_hexCellIndex.GetCellId(cell);
+        
         // For each neighbor cell
-        for (int32_t neighborCellId : cellNeighbors[cellId])
+        for (uint32_t neighborCell : g_hexCellIndex.GetLinkedNeighbors(cell))
         {
+            const int32_t neighborCellId = g_hexCellIndex.GetCellId(neighborCell);
             // Get gateways for this neighbor
             if (::ns3::wsn::scenario5::params::g_cellGatewayPairs.find(cellId) ==
                 ::ns3::wsn::scenario5::params::g_cellGatewayPairs.end() ||
@@ -678,7 +680,7 @@ EnhanceRoutingTreesForGatewayAccess()
                     const auto& currentState = g_groundNetworkPerNode[current];
                     for (uint32_t nb : currentState.neighbors)
                     {
-                        if (g_groundNetworkPerNode[nb].cellId != cellId || visited.count(nb) > 0)
+                        if (g_hexCellIndex.GetCellIndexOfNode(nb) != cell || visited.count(nb) > 0)
                             continue;
                         
                         visited.insert(nb);
@@ -715,22 +717,15 @@ void
 FinalizeGroundNodeStateFields()
 {
     const double nowSec = Simulator::Now().GetSeconds();
-    std::map<int32_t, std::vector<uint32_t>> membersByCell;
-
-    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
-    {
-        (void)nodeId;
-        membersByCell[state.cellId].push_back(state.nodeId);
-    }
 
     for (auto& [nodeId, state] : g_groundNetworkPerNode)
     {
         // Cell peers
         state.cellPeers.clear();
-        const auto itMembers = membersByCell.find(state.cellId);
-        if (itMembers != membersByCell.end())
+        const uint32_t cell = g_hexCellIndex.GetCellIndexOfNode(nodeId);
+        if (cell != helper::HexCellIndex::kInvalidCell)
         {
-            for (uint32_t peerId : itMembers->second)
+            for (uint32_t peerId : g_hexCellIndex.GetMembers(cell))
             {
                 if (peerId != nodeId)
                 {
@@ -823,11 +818,13 @@ SelectSuspiciousRegionForBsInit()
         
         // (1) Find all nodes in current suspicious region
         suspiciousNodes.clear();
-        for (const auto& [nodeId, state] : g_groundNetworkPerNode)
+        for (int32_t cellId : suspiciousCells)
         {
-            if (suspiciousCells.find(state.cellId) != suspiciousCells.end())
+            const uint32_t cell = g_hexCellIndex.GetCellIndex(cellId);
+            if (cell != helper::HexCellIndex::kInvalidCell)
             {
-                suspiciousNodes.insert(nodeId);
+                const helper::NodeIdRange members = g_hexCellIndex.GetMembers(cell);
+                suspiciousNodes.insert(members.begin(), members.end());
             }
         }
         
@@ -883,11 +880,13 @@ SelectSuspiciousRegionForBsInit()
     
     // Final update of suspicious nodes
     suspiciousNodes.clear();
-    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
+    for (int32_t cellId : suspiciousCells)
     {
-        if (suspiciousCells.find(state.cellId) != suspiciousCells.end())
+        const uint32_t cell = g_hexCellIndex.GetCellIndex(cellId);
+        if (cell != helper::HexCellIndex::kInvalidCell)
         {
-            suspiciousNodes.insert(nodeId);
+            const helper::NodeIdRange members = g_hexCellIndex.GetMembers(cell);
+            suspiciousNodes.insert(members.begin(), members.end());
         }
     }
     
@@ -906,20 +905,19 @@ SelectSuspiciousRegionForBsInit()
     NS_LOG_INFO("[BS-SUSPICIOUS] Cell distribution:");
     for (int32_t cellId : suspiciousCells)
     {
-        uint32_t cellNodeCount = 0;
-        for (const auto& [nodeId, state] : g_groundNetworkPerNode)
-        {
-            if (state.cellId == cellId && suspiciousNodes.find(nodeId) != suspiciousNodes.end())
-            {
-                cellNodeCount++;
-            }
-        }
+        const uint32_t cell = g_hexCellIndex.GetCellIndex(cellId);
+        const uint32_t cellNodeCount =
+            (cell != helper::HexCellIndex::kInvalidCell) ? g_hexCellIndex.GetMembers(cell).size() : 0;
         NS_LOG_INFO("  Cell " << cellId << ": " << cellNodeCount << " nodes");
     }
     
     // Store suspicious nodes globally for UAV flight planning
     g_suspiciousSeedNodeId = seedNodeId;
     g_suspiciousNodes = suspiciousNodes;
+    if (g_bsSuspiciousRegionCallback)
+    {
+        g_bsSuspiciousRegionCallback(g_suspiciousNodes);
+    }
     // TODO: in log vào `g_resultFileStream` tại đây
     // Format: [SUSPICIOUS-POINT] pointX pointY 
     // Format: [SUSPICIOUS-REGION] nodeId1 nodeId2 ... (Cell: cell1 cell2 ...)
@@ -951,20 +949,23 @@ GenerateFragmentsForBsInit()
     const uint32_t fragmentCount = ::ns3::wsn::scenario5::params::BS_INIT_FRAGMENT_GENERATION_COUNT;
     FragmentCollection generated = GenerateBsFragments(fragmentCount);
     SetBsGeneratedFragments(generated);
+    if (::ns3::wsn::scenario5::params::FRAGMENT_CODING_ENABLED)
+    {
+        BuildBsCodedFragments(::ns3::wsn::scenario5::params::FRAGMENT_CODING_PARITY_SYMBOLS);
+    }
 
-    NS_LOG_INFO("[BS-FRAGMENT] Generated " << generated.fragments.size()
+    NS_LOG_INFO("[BS-FRAGMENT] Generated " << generated.GetCount()
                 << " fragments at BS init"
                 << " | totalConfidence=" << std::fixed << std::setprecision(3)
-                << generated.totalConfidence);
+                << generated.GetTotalConfidence());
 
     // TODO: in log vào `g_resultFileStream` tại đây
     // Format: [FRAGMENTS] fragmentSize1(confidence1) fragmentSize2(confidence2) ...
     if (ns3::wsn::scenario5::params::g_resultFileStream)
     {        *ns3::wsn::scenario5::params::g_resultFileStream
             << "[FRAGMENTS]";
-        for (int i = 0; i < generated.fragments.size(); ++i)
+        for (const auto& frag : generated)
         {
-            const auto& frag = generated.fragments[i];
             *ns3::wsn::scenario5::params::g_resultFileStream
                 << " " << frag.size << "(" << std::fixed << std::setprecision(3) << frag.confidence << ")";
         }
@@ -972,6 +973,45 @@ GenerateFragmentsForBsInit()
     }    
 }
 
+void
+WriteUavPathResult(const UavPlanResult& result, const char* strategy, double broadcastRadius)
+{
+    if (!ns3::wsn::scenario5::params::g_resultFileStream)
+    {
+        return;
+    }
+
+    const UavFlightPath& path = result.path;
+    const double hoverTime = result.request.hoverTime;
+    const bool isCoverage = (path.role == UavMissionRole::AREA_COVERAGE);
+    const double flightTime = isCoverage
+        ? std::max(0.001, path.totalTime - path.waypoints.size() * hoverTime)
+        : (path.totalTime - path.waypoints.size() * hoverTime);
+
+    *ns3::wsn::scenario5::params::g_resultFileStream
+        << "[UAV-PATH] " << result.request.uavNodeId
+        << " strategy=" << strategy
+        << " totalDistance=" << std::fixed << std::setprecision(1) << result.totalDistance << "m"
+        << " totalTime=" << path.totalTime << "s"
+        << " flightSpeed=" << result.request.speed << "m/s"
+        << " hoverTime=" << hoverTime << "s"
+        << " avgSpeed=" << (result.totalDistance / flightTime) << "m/s";
+    if (isCoverage)
+    {
+        *ns3::wsn::scenario5::params::g_resultFileStream
+            << " broadcastRadius=" << broadcastRadius << "m"
+            << " coverage=" << result.servedTargets << "/" << result.targets.size();
+    }
+    *ns3::wsn::scenario5::params::g_resultFileStream << " waypoints:";
+    for (const auto& wp : path.waypoints)
+    {
+        *ns3::wsn::scenario5::params::g_resultFileStream
+            << " (" << std::fixed << std::setprecision(1)
+            << wp.position.x << "," << wp.position.y << ")";
+    }
+    *ns3::wsn::scenario5::params::g_resultFileStream << std::endl;
+}
+
 void
 PlanUavFlightPathsForBsInit()
 {
@@ -984,18 +1024,19 @@ PlanUavFlightPathsForBsInit()
     // Clear previous paths
     ClearUavFlightPaths();
 
-    // Get suspicious node positions with node IDs
-    std::vector<std::pair<uint32_t, Vector>> suspiciousNodePositions;
+    // Get suspicious node positions with node IDs (ascending nodeId)
+    std::vector<PlannerTarget> targets;
+    targets.reserve(g_suspiciousNodes.size());
     for (uint32_t nodeId : g_suspiciousNodes)
     {
         auto it = g_groundNetworkPerNode.find(nodeId);
         if (it != g_groundNetworkPerNode.end())
         {
-            suspiciousNodePositions.push_back({nodeId, it->second.position});
+            targets.push_back({nodeId, it->second.position});
         }
     }
 
-    if (suspiciousNodePositions.empty())
+    if (targets.empty())
     {
         NS_LOG_WARN("[BS-UAV-PATH] No valid positions for suspicious nodes");
         return;
@@ -1003,6 +1044,7 @@ PlanUavFlightPathsForBsInit()
 
     // Get UAV nodes (assumes UAVs are nodes with specific IDs or mobility model)
     std::vector<uint32_t> uavNodeIds;
+    std::vector<Vector> uavStartPositions;
     for (uint32_t i = 0; i < NodeList::GetNNodes(); ++i)
     {
         Ptr<Node> node = NodeList::GetNode(i);
@@ -1016,6 +1058,7 @@ PlanUavFlightPathsForBsInit()
         if (pos.z > 1.0)
         {
             uavNodeIds.push_back(i);
+            uavStartPositions.push_back(pos);
         }
     }
 
@@ -1025,321 +1068,83 @@ PlanUavFlightPathsForBsInit()
         return;
     }
 
-    const double altitude = ::ns3::wsn::scenario5::params::BS_INIT_UAV_PATROL_ALTITUDE;
-    const double broadcastRadius = ::ns3::wsn::scenario5::params::UAV_BROADCAST_RADIUS;
-    
-    // UAV1: Fast speed with hover time
-    const double uav1Speed = ::ns3::wsn::scenario5::params::UAV1_SPEED;
-    const double uav1HoverTime = ::ns3::wsn::scenario5::params::UAV1_HOVER_TIME;
-    
-    // UAV2: Slow speed without hover time
-    const double uav2Speed = ::ns3::wsn::scenario5::params::UAV2_SPEED;
-    const double uav2HoverTime = ::ns3::wsn::scenario5::params::UAV2_HOVER_TIME;
-
-    // ===== UAV 1: Greedy Nearest Neighbor (visit every node) =====
-    const uint32_t uav1NodeId = uavNodeIds[0];
-    Ptr<Node> uav1Node = NodeList::GetNode(uav1NodeId);
-    Ptr<MobilityModel> uav1Mobility = uav1Node->GetObject<MobilityModel>();
-    const Vector uav1StartPos = uav1Mobility->GetPosition();
-
-    UavFlightPath path1;
-    std::set<uint32_t> visitedNodes;
-    Vector currentPos = uav1StartPos;
-    double currentTime = 0.0;
-    
-    NS_LOG_INFO("[BS-UAV-PATH] UAV1: Planning path using Greedy Nearest Neighbor"
-                << " | suspiciousNodes=" << suspiciousNodePositions.size()
-                << " | startPos=(" << std::fixed << std::setprecision(1) 
-                << uav1StartPos.x << "," << uav1StartPos.y << "," << uav1StartPos.z << ")");
-    
-    // Visit all suspicious nodes using nearest neighbor heuristic
-    while (visitedNodes.size() < suspiciousNodePositions.size())
-    {
-        // Find nearest unvisited node
-        double minDistance = std::numeric_limits<double>::max();
-        uint32_t nearestNodeId = std::numeric_limits<uint32_t>::max();
-        Vector nearestPos;
-        
-        for (const auto& [nodeId, pos] : suspiciousNodePositions)
-        {
-            if (visitedNodes.count(nodeId) > 0)
-                continue;
-            
-            double dist = helper::CalculateDistance(currentPos.x, currentPos.y, pos.x, pos.y);
-            if (dist < minDistance)
-            {
-                minDistance = dist;
-                nearestNodeId = nodeId;
-                nearestPos = pos;
-            }
-        }
-        
-        if (nearestNodeId == std::numeric_limits<uint32_t>::max())
-            break;
-        
-        currentTime += minDistance / uav1Speed;
-        
-        Waypoint wp;
-        wp.position = Vector(nearestPos.x, nearestPos.y, altitude);
-        wp.arrivalTime = currentTime;
-        path1.waypoints.push_back(wp);
-        
-        currentTime += uav1HoverTime;
-        visitedNodes.insert(nearestNodeId);
-        currentPos = nearestPos;
-        
-        NS_LOG_DEBUG("[BS-UAV-PATH] UAV1 Waypoint " << path1.waypoints.size() 
-                     << " | node=" << nearestNodeId
-                     << " | pos=(" << nearestPos.x << "," << nearestPos.y << ")"
-                     << " | dist=" << minDistance << "m");
-    }
-    
-    path1.totalTime = currentTime;
-    SetUavFlightPath(uav1NodeId, path1);
-    
-    // Calculate total path distance for UAV1
-    double totalDistance1 = 0.0;
-    Vector prevPos1 = uav1StartPos;
-    for (const auto& wp : path1.waypoints)
-    {
-        totalDistance1 += helper::CalculateDistance(prevPos1.x, prevPos1.y, wp.position.x, wp.position.y);
-        prevPos1 = wp.position;
-    }
-
-    NS_LOG_INFO("[BS-UAV-PATH] UAV1 path planned"
-                << " | waypoints=" << path1.waypoints.size()
-                << " | totalTime=" << std::fixed << std::setprecision(1) << path1.totalTime << "s"
-                << " | totalDistance=" << totalDistance1 << "m"
-                << " | flightSpeed=" << uav1Speed << "m/s"
-                << " | hoverTime=" << uav1HoverTime << "s/waypoint"
-                << " | avgSpeed=" << (totalDistance1 / (path1.totalTime - path1.waypoints.size() * uav1HoverTime)) << "m/s");
+    const UavFleetPlanOptions options = GetBsInitFleetPlanOptions();
+    const size_t numVisitUavs = (uavNodeIds.size() + 1) / 2;
+    NS_LOG_INFO("[BS-UAV-PATH] Planning " << uavNodeIds.size() << " UAVs"
+                << " | nodeVisit=" << numVisitUavs
+                << " | coverage=" << (uavNodeIds.size() - numVisitUavs)
+                << " | suspiciousNodes=" << targets.size()
+                << " | broadcastRadius=" << options.broadcastRadius << "m");
 
-    // Store UAV1 start time for synchronization
-    const double uav1StartTime = path1.waypoints.empty() ? 0.0 : path1.waypoints[0].arrivalTime;
+    const UavFleetPlanResult fleet = PlanUavFleet(uavNodeIds, uavStartPositions, targets, options);
+    const std::vector<UavPlanResult>& visitResults = fleet.visitResults;
+    const std::vector<UavPlanResult>& coverageResults = fleet.coverageResults;
 
-    // ===== UAV 2: Greedy Set Cover (minimize waypoints with coverage radius) =====
-    if (uavNodeIds.size() >= 2)
+    for (const auto* group : {&visitResults, &coverageResults})
     {
-        const uint32_t uav2NodeId = uavNodeIds[1];
-        Ptr<Node> uav2Node = NodeList::GetNode(uav2NodeId);
-        Ptr<MobilityModel> uav2Mobility = uav2Node->GetObject<MobilityModel>();
-        const Vector uav2StartPos = uav2Mobility->GetPosition();
-
-        UavFlightPath path2;
-        std::set<uint32_t> coveredNodes;  // Nodes already covered by waypoints
-        Vector currentPos2 = uav2StartPos;
-        double currentTime2 = 0.0;  // Both UAVs start at t=0 from base station
-        
-        NS_LOG_INFO("[BS-UAV-PATH] UAV2: Planning coverage-based path"
-                    << " | broadcastRadius=" << broadcastRadius << "m"
-                    << " | startPos=(" << std::fixed << std::setprecision(1)
-                    << uav2StartPos.x << "," << uav2StartPos.y << "," << uav2StartPos.z << ")");
-        
-        // Greedy Set Cover: repeatedly choose waypoint that covers most uncovered nodes
-        while (coveredNodes.size() < suspiciousNodePositions.size())
+        for (const auto& result : *group)
         {
-            Vector bestWaypointPos;
-            uint32_t maxNewCoverage = 0;
-            double bestDistance = std::numeric_limits<double>::max();
-            
-            // Try each suspicious node position as potential waypoint
-            for (const auto& [candidateNodeId, candidatePos] : suspiciousNodePositions)
-            {
-                // Count how many uncovered nodes this waypoint would cover
-                uint32_t newCoverageCount = 0;
-                for (const auto& [nodeId, nodePos] : suspiciousNodePositions)
-                {
-                    if (coveredNodes.count(nodeId) > 0)
-                        continue;  // Already covered
-                    
-                    double dist = helper::CalculateDistance(
-                        candidatePos.x, candidatePos.y, nodePos.x, nodePos.y);
-                    
-                    if (dist <= broadcastRadius)
-                    {
-                        newCoverageCount++;
-                    }
-                }
-                
-                // Select waypoint with best coverage, breaking ties by distance from current position
-                double distFromCurrent = helper::CalculateDistance(
-                    currentPos2.x, currentPos2.y, candidatePos.x, candidatePos.y);
-                
-                if (newCoverageCount > maxNewCoverage ||
-                    (newCoverageCount == maxNewCoverage && distFromCurrent < bestDistance))
-                {
-                    maxNewCoverage = newCoverageCount;
-                    bestWaypointPos = candidatePos;
-                    bestDistance = distFromCurrent;
-                }
-            }
-            
-            if (maxNewCoverage == 0)
-            {
-                NS_LOG_WARN("[BS-UAV-PATH] UAV2: No more nodes can be covered, but "
-                           << (suspiciousNodePositions.size() - coveredNodes.size())
-                           << " nodes remain uncovered");
-                break;
-            }
-            
-            // Add this waypoint
-            currentTime2 += bestDistance / uav2Speed;
-            
-            Waypoint wp2;
-            wp2.position = Vector(bestWaypointPos.x, bestWaypointPos.y, altitude);
-            wp2.arrivalTime = currentTime2;
-            path2.waypoints.push_back(wp2);
-            
-            currentTime2 += uav2HoverTime;
-            
-            // Mark all nodes covered by this waypoint
-            uint32_t actualCovered = 0;
-            for (const auto& [nodeId, nodePos] : suspiciousNodePositions)
-            {
-                if (coveredNodes.count(nodeId) > 0)
-                    continue;
-                
-                double dist = helper::CalculateDistance(
-                    bestWaypointPos.x, bestWaypointPos.y, nodePos.x, nodePos.y);
-                
-                if (dist <= broadcastRadius)
-                {
-                    coveredNodes.insert(nodeId);
-                    actualCovered++;
-                }
-            }
-            
-            currentPos2 = bestWaypointPos;
-            
-            NS_LOG_DEBUG("[BS-UAV-PATH] UAV2 Waypoint " << path2.waypoints.size()
-                        << " | pos=(" << bestWaypointPos.x << "," << bestWaypointPos.y << ")"
-                        << " | covered=" << actualCovered << " new nodes"
-                        << " | totalCovered=" << coveredNodes.size() << "/" << suspiciousNodePositions.size()
-                        << " | dist=" << bestDistance << "m");
-        }
-        
-        path2.totalTime = currentTime2;
-        SetUavFlightPath(uav2NodeId, path2);
-        
-        // Calculate total path distance for UAV2
-        double totalDistance2 = 0.0;
-        Vector prevPos2 = uav2StartPos;
-        for (const auto& wp : path2.waypoints)
-        {
-            totalDistance2 += helper::CalculateDistance(prevPos2.x, prevPos2.y, wp.position.x, wp.position.y);
-            prevPos2 = wp.position;
-        }
-        
-        NS_LOG_INFO("[BS-UAV-PATH] UAV2 coverage-based path planned"
-                    << " | waypoints=" << path2.waypoints.size()
-                    << " | covered=" << coveredNodes.size() << "/" << suspiciousNodePositions.size()
-                    << " | totalTime=" << std::fixed << std::setprecision(1) << path2.totalTime << "s"
-                    << " | totalDistance=" << totalDistance2 << "m"
-                    << " | flightSpeed=" << uav2Speed << "m/s"
-                    << " | hoverTime=" << uav2HoverTime << "s/waypoint"
-                    << " | avgSpeed=" << (totalDistance2 / std::max(0.001, path2.totalTime - path2.waypoints.size() * uav2HoverTime)) << "m/s");
-        
-        // Log UAV2 to file
-        if (ns3::wsn::scenario5::params::g_resultFileStream)
-        {
-            *ns3::wsn::scenario5::params::g_resultFileStream
-                << "[UAV-PATH] uav2NodeId strategy totalDistance totalTime flightSpeed hoverTime avgSpeed broadcastRadius coverage waypoints: (x1, y1) (x2, y2) ..." << std::endl
-                << "[UAV-PATH] " << uav2NodeId
-                << " strategy=GreedySetCover"
-                << " totalDistance=" << std::fixed << std::setprecision(1) << totalDistance2 << "m"
-                << " totalTime=" << path2.totalTime << "s"
-                << " flightSpeed=" << uav2Speed << "m/s"
-                << " hoverTime=" << uav2HoverTime << "s"
-                << " avgSpeed=" << (totalDistance2 / std::max(0.001, path2.totalTime - path2.waypoints.size() * uav2HoverTime)) << "m/s"
-                << " broadcastRadius=" << broadcastRadius << "m"
-                << " coverage=" << coveredNodes.size() << "/" << suspiciousNodePositions.size()
-                << " waypoints:";
-            for (const auto& wp : path2.waypoints)
+            SetUavFlightPath(result.request.uavNodeId, result.path);
+
+            if (result.servedTargets < result.targets.size())
             {
-                *ns3::wsn::scenario5::params::g_resultFileStream
-                    << " (" << std::fixed << std::setprecision(1)
-                    << wp.position.x << "," << wp.position.y << ")";
+                NS_LOG_WARN("[BS-UAV-PATH] UAV " << result.request.uavNodeId
+                            << ": " << (result.targets.size() - result.servedTargets)
+                            << " assigned nodes remain unserved");
             }
-            *ns3::wsn::scenario5::params::g_resultFileStream << std::endl;
+
+            NS_LOG_INFO("[BS-UAV-PATH] UAV " << result.request.uavNodeId << " path planned"
+                        << " | role=" << (result.path.role == UavMissionRole::AREA_COVERAGE
+                                              ? fleet.coverageStrategy
+                                              : fleet.visitStrategy)
+                        << " | waypoints=" << result.path.waypoints.size()
+                        << " | served=" << result.servedTargets << "/" << result.targets.size()
+                        << " | totalTime=" << std::fixed << std::setprecision(1)
+                        << result.path.totalTime << "s"
+                        << " | totalDistance=" << result.totalDistance << "m"
+                        << " | planningTime=" << std::setprecision(3)
+                        << (result.planningTimeSec * 1000.0) << "ms");
         }
     }
 
-    // Log UAV1 to file
-    if (ns3::wsn::scenario5::params::g_resultFileStream)
+    // Log coverage UAVs, then node-visit UAVs, to file
+    if (ns3::wsn::scenario5::params::g_resultFileStream && !coverageResults.empty())
     {
         *ns3::wsn::scenario5::params::g_resultFileStream
-            << "[UAV-PATH] " << uav1NodeId
-            << " strategy=GreedyNearestNeighbor"
-            << " totalDistance=" << std::fixed << std::setprecision(1) << totalDistance1 << "m"
-            << " totalTime=" << path1.totalTime << "s"
-            << " flightSpeed=" << uav1Speed << "m/s"
-            << " hoverTime=" << uav1HoverTime << "s"
-            << " avgSpeed=" << (totalDistance1 / (path1.totalTime - path1.waypoints.size() * uav1HoverTime)) << "m/s"
-            << " waypoints:";
-        for (const auto& wp : path1.waypoints)
-        {
-            *ns3::wsn::scenario5::params::g_resultFileStream
-                << " (" << std::fixed << std::setprecision(1)
-                << wp.position.x << "," << wp.position.y << ")";
-        }
-        *ns3::wsn::scenario5::params::g_resultFileStream << std::endl;
+            << "[UAV-PATH] uav2NodeId strategy totalDistance totalTime flightSpeed hoverTime avgSpeed broadcastRadius coverage waypoints: (x1, y1) (x2, y2) ..." << std::endl;
+    }
+    for (const auto& result : coverageResults)
+    {
+        WriteUavPathResult(result, fleet.coverageStrategy, options.broadcastRadius);
+    }
+    for (const auto& result : visitResults)
+    {
+        WriteUavPathResult(result, fleet.visitStrategy, options.broadcastRadius);
     }
 }
 
 void
 SelectCrosscellGatewayPairs(double neighborRadius)
 {
-    // Build cell neighbor adjacency list
-    std::map<int32_t, std::set<int32_t>> cellNeighbors;
-    
-    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
-    {
-        (void)nodeId;
-        for (uint32_t neighborId : state.neighbors)
-        {
-            auto neighborIt = g_groundNetworkPerNode.find(neighborId);
-            if (neighborIt == g_groundNetworkPerNode.end())
-            {
-                continue;
-            }
-
-            const int32_t cellA = state.cellId;
-            const int32_t cellB = neighborIt->second.cellId;
-
-            if (cellA != cellB)
-            {
-                cellNeighbors[cellA].insert(cellB);
-                cellNeighbors[cellB].insert(cellA);
-            }
-        }
-    }
-    
-    // Group nodes by cell ID
-    std::map<int32_t, std::vector<uint32_t>> nodesByCell;
-    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
-    {
-        nodesByCell[state.cellId].push_back(nodeId);
-    }
-    
     // For each cell, find gateway nodes to neighbor cells
     ::ns3::wsn::scenario5::params::g_cellGatewayPairs.clear();
     uint32_t gatewayPairCount = 0;
     
-    for (const auto& [cellId, neighbors] : cellNeighbors)
+    for (uint32_t cell = 0; cell < g_hexCellIndex.GetNumCells(); ++cell)
     {
-        auto cellMembersIt = nodesByCell.find(cellId);
-        if (cellMembersIt == nodesByCell.end() || cellMembersIt->second.empty())
+        const helper::NodeIdRange members = g_hexCellIndex.GetMembers(cell);
+        if (members.empty())
             continue;
         
-        const auto& members = cellMembersIt->second;
+        const int32_t cellId = g_hexCellIndex.GetCellId(cell);
         
-        for (int32_t neighborCellId : neighbors)
+        for (uint32_t neighborCell : g_hexCellIndex.GetLinkedNeighbors(cell))
         {
-            auto neighborMembersIt = nodesByCell.find(neighborCellId);
-            if (neighborMembersIt == nodesByCell.end() || neighborMembersIt->second.empty())
+            const helper::NodeIdRange neighborMembers = g_hexCellIndex.GetMembers(neighborCell);
+            if (neighborMembers.empty())
                 continue;
             
-            const auto& neighborMembers = neighborMembersIt->second;
+            const int32_t neighborCellId = g_hexCellIndex.GetCellId(neighborCell);
             
             // Find closest pair: node in cellId to node in neighborCellId
             double bestDistance = std::numeric_limits<double>::max();
@@ -1354,10 +1159,11 @@ SelectCrosscellGatewayPairs(double neighborRadius)
                 // Check if this member has a neighbor in neighborCellId
                 for (uint32_t neighborId : memberState.neighbors)
                 {
-                    const auto& neighborState = g_groundNetworkPerNode[neighborId];
-                    if (neighborState.cellId != neighborCellId)
+                    if (g_hexCellIndex.GetCellIndexOfNode(neighborId) != neighborCell)
                         continue;
                     
+                    const auto& neighborState = g_groundNetworkPerNode[neighborId];
+                    
                     const double dist = helper::CalculateDistance(
                         memberState.position.x,
                         memberState.position.y,
@@ -1396,6 +1202,7 @@ SelectCrosscellGatewayPairs(double neighborRadius)
 // Global callback definitions
 std::function<void(const routing::GlobalTopology&)> g_bsTopologyCallback;
 std::function<void(uint32_t, const routing::UavFlightPath&)> g_bsUavCommandCallback;
+std::function<void(const std::set<uint32_t>&)> g_bsSuspiciousRegionCallback;
 
 routing::BaseStationNode::BaseStationNode(uint32_t nodeId)
     : m_nodeId(nodeId),
@@ -1413,12 +1220,14 @@ void
 routing::BaseStationNode::Initialize()
 {
     NS_LOG_FUNCTION(this);
+    WSN_PROFILE_SCOPE("bs.Initialize");
+    g_bsInitPhaseTimings.clear();
     
     NS_LOG_INFO("BS Node " << m_nodeId << " initialized");
 
     // Write to global result file if open
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "\n=== Base Station Initialization ===" << std::endl
@@ -1429,9 +1238,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 1: tính cellId + cellColor cho từng ground node từ position hiện tại
-    AssignCellIdAndColorForGroundNodes(::ns3::wsn::scenario5::params::HEX_CELL_RADIUS);
+    {
+        const BsInitPhaseTimer phaseTimer("assign_cells");
+        AssignCellIdAndColorForGroundNodes(::ns3::wsn::scenario5::params::HEX_CELL_RADIUS);
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "Step 1: Assign Cell ID and Color" << std::endl
@@ -1442,9 +1254,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 2: neighbor + 2-hop discovery theo bán kính truyền tin
-    DiscoverNeighborsAndTwoHopsForGroundNodes(::ns3::wsn::scenario5::params::NEIGHBOR_DISCOVERY_RADIUS);
+    {
+        const BsInitPhaseTimer phaseTimer("discover_neighbors");
+        DiscoverNeighborsAndTwoHopsForGroundNodes(::ns3::wsn::scenario5::params::NEIGHBOR_DISCOVERY_RADIUS);
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         uint32_t totalNeighbors = 0;
         for (const auto& [nodeId, state] : g_groundNetworkPerNode)
@@ -1460,9 +1275,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 3: chọn cell leader (CL) gần tâm cell nhất
-    SelectCellLeadersByNearestCellCenter(::ns3::wsn::scenario5::params::HEX_CELL_RADIUS);
+    {
+        const BsInitPhaseTimer phaseTimer("select_leaders");
+        SelectCellLeadersByNearestCellCenter(::ns3::wsn::scenario5::params::HEX_CELL_RADIUS);
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         uint32_t leaderCount = 0;
         std::map<int32_t, uint32_t> cellLeaders;
@@ -1487,9 +1305,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 4: chọn gateway pairs cho cross-cell communication
-    SelectCrosscellGatewayPairs(::ns3::wsn::scenario5::params::NEIGHBOR_DISCOVERY_RADIUS);
+    {
+        const BsInitPhaseTimer phaseTimer("select_gateways");
+        SelectCrosscellGatewayPairs(::ns3::wsn::scenario5::params::NEIGHBOR_DISCOVERY_RADIUS);
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         uint32_t gatewayPairCount = 0;
         for (const auto& [cellId, neighbors] : ::ns3::wsn::scenario5::params::g_cellGatewayPairs)
@@ -1504,9 +1325,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 5: xây dựng intra-cell routing trees cho mỗi cell
-    BuildIntraCellRoutingTrees();
+    {
+        const BsInitPhaseTimer phaseTimer("build_trees");
+        BuildIntraCellRoutingTrees();
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "Step 5: Build Intra-Cell Routing Trees" << std::endl
@@ -1516,9 +1340,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 6: bổ sung route để đảm bảo reachability tới neighboring cells
-    EnhanceRoutingTreesForGatewayAccess();
+    {
+        const BsInitPhaseTimer phaseTimer("enhance_trees");
+        EnhanceRoutingTreesForGatewayAccess();
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "Step 6: Enhance Routing for Gateway Access" << std::endl
@@ -1528,9 +1355,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 7: kiểm tra tính hợp lệ của routing trees
-    ValidateIntraCellRoutingTrees();
+    {
+        const BsInitPhaseTimer phaseTimer("validate_trees");
+        ValidateIntraCellRoutingTrees();
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "Step 7: Validate Routing Trees" << std::endl
@@ -1540,9 +1370,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 8: cập nhật các biến trạng thái còn lại
-    FinalizeGroundNodeStateFields();
+    {
+        const BsInitPhaseTimer phaseTimer("finalize_state");
+        FinalizeGroundNodeStateFields();
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "Step 8: Finalize Ground Node States" << std::endl
@@ -1552,9 +1385,12 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 9: chọn vùng khả nghi cho UAV flight planning
-    SelectSuspiciousRegionForBsInit();
+    {
+        const BsInitPhaseTimer phaseTimer("select_region");
+        SelectSuspiciousRegionForBsInit();
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "Step 9: Select Suspicious Region" << std::endl
@@ -1571,24 +1407,30 @@ routing::BaseStationNode::Initialize()
     }
 
     // Step 10: BS generate fragments để UAV broadcast
-    GenerateFragmentsForBsInit();
+    {
+        const BsInitPhaseTimer phaseTimer("generate_fragments");
+        GenerateFragmentsForBsInit();
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         const FragmentCollection& fragments = GetBsGeneratedFragments();
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "Step 10: Generate Fragments" << std::endl
-            << "  Total fragments: " << fragments.fragments.size() << std::endl
+            << "  Total fragments: " << fragments.GetCount() << std::endl
             << "  Total confidence: " << std::fixed << std::setprecision(3) 
-            << fragments.totalConfidence << std::endl
+            << fragments.GetTotalConfidence() << std::endl
             << std::endl;
         ::ns3::wsn::scenario5::params::g_resultFileStream->flush();
     }
 
     // Step 11: lên lịch đường bay cho UAV
-    PlanUavFlightPathsForBsInit();
+    {
+        const BsInitPhaseTimer phaseTimer("plan_uav_paths");
+        PlanUavFlightPathsForBsInit();
+    }
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         const auto& uavPaths = GetUavFlightPaths();
         *::ns3::wsn::scenario5::params::g_resultFileStream
@@ -1628,7 +1470,7 @@ routing::BaseStationNode::Initialize()
     }
 
     if (::ns3::wsn::scenario5::params::g_resultFileStream && 
-        ::ns3::wsn::scenario5::params::g_resultFileStream->is_open())
+        ::ns3::wsn::scenario5::params::g_resultFileStream->good())
     {
         *::ns3::wsn::scenario5::params::g_resultFileStream
             << "=== Base Station Initialization Complete ===" << std::endl
@@ -1739,6 +1581,18 @@ GetSuspiciousSeedNodeId()
     return g_suspiciousSeedNodeId;
 }
 
+const helper::HexCellIndex&
+GetHexCellIndex()
+{
+    return g_hexCellIndex;
+}
+
+const std::vector<BsInitPhaseTiming>&
+GetBsInitPhaseTimings()
+{
+    return g_bsInitPhaseTimings;
+}
+
 } // namespace routing
 } // namespace scenario5
 } // namespace wsn
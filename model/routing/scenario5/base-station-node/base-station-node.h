@@ -8,10 +8,12 @@
 #ifndef SCENARIO5_BASE_STATION_NODE_H
 #define SCENARIO5_BASE_STATION_NODE_H
 
+#include "../helper/hex-cell-index.h"
 #include "ns3/node.h"
 #include "ns3/vector.h"
 #include <map>
 #include <set>
+#include <string>
 #include <vector>
 #include <functional>
 
@@ -50,6 +52,17 @@ struct Waypoint
     double arrivalTime;
 };
 
+/**
+ * UAV mission role.
+ * NODE_VISIT UAVs hover over every assigned node (UAV1 role);
+ * AREA_COVERAGE UAVs fly coverage waypoints and broadcast fragments (UAV2 role).
+ */
+enum class UavMissionRole : uint8_t
+{
+    NODE_VISIT = 0,
+    AREA_COVERAGE = 1
+};
+
 /**
  * UAV flight path.
  */
@@ -57,12 +70,15 @@ struct UavFlightPath
 {
     std::vector<Waypoint> waypoints;
     double totalTime;
+    UavMissionRole role = UavMissionRole::NODE_VISIT;
 };
 
 // ===== Global Callbacks =====
 // These are used by ground/UAV nodes to communicate with BS
 extern std::function<void(const GlobalTopology&)> g_bsTopologyCallback;
 extern std::function<void(uint32_t, const UavFlightPath&)> g_bsUavCommandCallback;
+// Called after BS init selects the suspicious region (g_suspiciousNodes set)
+extern std::function<void(const std::set<uint32_t>&)> g_bsSuspiciousRegionCallback;
 
 /**
  * Base Station Node.
@@ -154,6 +170,32 @@ const std::set<uint32_t>& GetSuspiciousNodes();
  */
 uint32_t GetSuspiciousSeedNodeId();
 
+// Cell index built during BS init (Step 1), linked after neighbor discovery (Step 2)
+extern helper::HexCellIndex g_hexCellIndex;
+
+/**
+ * Get the hexagonal cell index built at BS init.
+ *
+ * \return Cell index (empty before BS init)
+ */
+const helper::HexCellIndex& GetHexCellIndex();
+
+/**
+ * Wall-clock duration of one BaseStationNode::Initialize step.
+ */
+struct BsInitPhaseTiming
+{
+    std::string name;
+    double wallSeconds;
+};
+
+/**
+ * Get the step timings of the last BS init, in execution order.
+ *
+ * \return Step timings (empty before BS init)
+ */
+const std::vector<BsInitPhaseTiming>& GetBsInitPhaseTimings();
+
 } // namespace routing
 } // namespace scenario5
 } // namespace wsn
@@ -0,0 +1,114 @@
+/*
+ * Scenario 5 - UAV Fragment Broadcast Schedule
+ *
+ * Contiguous snapshot of the BS fragment pool plus a precomputed broadcast
+ * order, so a round maps to its fragment in O(1). The order comes from a
+ * pluggable policy.
+ */
+
+#ifndef SCENARIO5_BROADCAST_SCHEDULE_H
+#define SCENARIO5_BROADCAST_SCHEDULE_H
+
+#include "../fragment.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+/**
+ * Decides the order in which a UAV cycles through the fragment pool.
+ */
+class BroadcastSchedulePolicy
+{
+public:
+    virtual ~BroadcastSchedulePolicy() = default;
+
+    /**
+     * \param fragments Fragment snapshot (ascending ID)
+     * \return broadcast order as indices into fragments (one cycle)
+     */
+    virtual std::vector<uint32_t> BuildOrder(const std::vector<Fragment>& fragments) const = 0;
+
+    virtual std::string GetName() const = 0;
+};
+
+/**
+ * Ascending fragment ID (the original round-robin).
+ */
+class FragmentIdOrderPolicy : public BroadcastSchedulePolicy
+{
+public:
+    std::vector<uint32_t> BuildOrder(const std::vector<Fragment>& fragments) const override;
+    std::string GetName() const override;
+};
+
+/**
+ * Highest confidence first, ties broken by ascending ID.
+ */
+class HighestConfidenceFirstPolicy : public BroadcastSchedulePolicy
+{
+public:
+    std::vector<uint32_t> BuildOrder(const std::vector<Fragment>& fragments) const override;
+    std::string GetName() const override;
+};
+
+/**
+ * \return policy selected by params::FRAGMENT_BROADCAST_HIGHEST_CONFIDENCE_FIRST
+ */
+std::unique_ptr<BroadcastSchedulePolicy> CreateDefaultBroadcastSchedulePolicy();
+
+/**
+ * Fragment snapshot with a precomputed broadcast order.
+ */
+class FragmentBroadcastSchedule
+{
+public:
+    /**
+     * Snapshot the collection and compute one broadcast cycle.
+     *
+     * \param fragments Fragments to broadcast
+     * \param policy Ordering policy
+     */
+    void Build(const FragmentCollection& fragments, const BroadcastSchedulePolicy& policy);
+
+    void Clear();
+
+    bool IsEmpty() const;
+
+    /**
+     * \return fragments per broadcast cycle
+     */
+    uint32_t GetLength() const;
+
+    /**
+     * \return fragment sent in a round (round modulo cycle length); the
+     *         schedule must not be empty
+     */
+    const Fragment& GetByRound(uint32_t round) const;
+
+    /**
+     * \return fragment snapshot in ascending ID order
+     */
+    const std::vector<Fragment>& GetFragments() const;
+
+    /**
+     * \return one cycle as indices into GetFragments()
+     */
+    const std::vector<uint32_t>& GetOrder() const;
+
+private:
+    std::vector<Fragment> m_fragments;
+    std::vector<uint32_t> m_order;
+};
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_BROADCAST_SCHEDULE_H
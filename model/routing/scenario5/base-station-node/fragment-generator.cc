@@ -1,16 +1,42 @@
 #include "fragment-generator.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <cstring>
 
 namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("Scenario5FragmentGenerator");
+
 namespace wsn {
 namespace scenario5 {
 namespace routing {
 
 FragmentCollection g_bsGeneratedFragments;
+FragmentPayloadPool g_bsFragmentPayloadPool;
+FragmentBroadcastSchedule g_bsBroadcastSchedule;
+static std::unique_ptr<BroadcastSchedulePolicy> g_bsBroadcastSchedulePolicy;
+
+static const BroadcastSchedulePolicy&
+GetBsBroadcastSchedulePolicy()
+{
+    if (!g_bsBroadcastSchedulePolicy)
+    {
+        g_bsBroadcastSchedulePolicy = CreateDefaultBroadcastSchedulePolicy();
+    }
+    return *g_bsBroadcastSchedulePolicy;
+}
 
 FragmentCollection
 GenerateBsFragments(uint32_t numFragments)
 {
-    return GenerateFragments(numFragments);
+    g_bsFragmentPayloadPool.Clear();
+    return GenerateFragments(numFragments, g_bsFragmentPayloadPool);
+}
+
+const FragmentPayloadPool&
+GetBsFragmentPayloadPool()
+{
+    return g_bsFragmentPayloadPool;
 }
 
 const FragmentCollection&
@@ -23,6 +49,246 @@ void
 SetBsGeneratedFragments(const FragmentCollection& fragments)
 {
     g_bsGeneratedFragments = fragments;
+    g_bsBroadcastSchedule.Build(g_bsGeneratedFragments, GetBsBroadcastSchedulePolicy());
+}
+
+const FragmentBroadcastSchedule&
+GetBsBroadcastSchedule()
+{
+    return g_bsBroadcastSchedule;
+}
+
+void
+SetBsBroadcastSchedulePolicy(std::unique_ptr<BroadcastSchedulePolicy> policy)
+{
+    g_bsBroadcastSchedulePolicy = std::move(policy);
+    g_bsBroadcastSchedule.Build(g_bsGeneratedFragments, GetBsBroadcastSchedulePolicy());
+}
+
+// ===== CodedFragmentSet =====
+
+namespace {
+constexpr uint32_t kBlockHeaderBytes = 8 + 4; // confidence + size
+}
+
+CodedFragmentSet g_bsCodedFragments;
+
+CodedFragmentSet::CodedFragmentSet()
+    : m_blockSize(0),
+      m_decodeCount(0),
+      m_decodeCacheHits(0)
+{
+}
+
+void
+CodedFragmentSet::Build(const FragmentCollection& fragments, uint32_t numParity)
+{
+    Clear();
+
+    const uint32_t k = fragments.GetCount();
+    if (k == 0 || k + numParity > helper::ReedSolomonCode::kMaxSymbols)
+    {
+        NS_LOG_WARN("[FRAGMENT-CODING] Cannot code " << k << " fragments with "
+                    << numParity << " parity symbols");
+        return;
+    }
+
+    uint32_t maxPayload = 0;
+    for (uint32_t id = 0; id < k; ++id)
+    {
+        const Fragment* frag = fragments.GetFragment(id);
+        if (frag == nullptr)
+        {
+            NS_LOG_WARN("[FRAGMENT-CODING] Fragment IDs are not dense, coding disabled");
+            Clear();
+            return;
+        }
+        m_sources.push_back(*frag);
+        if (frag->payload)
+        {
+            maxPayload = std::max(maxPayload, static_cast<uint32_t>(frag->payload->size()));
+        }
+    }
+
+    m_code = helper::ReedSolomonCode(k, k + numParity);
+    m_blockSize = kBlockHeaderBytes + maxPayload;
+
+    std::vector<std::vector<uint8_t>> blocks(k, std::vector<uint8_t>(m_blockSize));
+    std::vector<const uint8_t*> sources(k);
+    for (uint32_t j = 0; j < k; ++j)
+    {
+        FillSourceBlock(j, blocks[j].data());
+        sources[j] = blocks[j].data();
+    }
+
+    m_parity.assign(numParity, std::vector<uint8_t>(m_blockSize));
+    for (uint32_t i = 0; i < numParity; ++i)
+    {
+        m_code.Encode(sources, m_blockSize, k + i, m_parity[i].data());
+    }
+
+    NS_LOG_INFO("[FRAGMENT-CODING] Encoded " << numParity << " parity symbols"
+                << " | k=" << k << " | n=" << m_code.GetSymbolCount()
+                << " | blockSize=" << m_blockSize << " bytes");
+}
+
+void
+CodedFragmentSet::Clear()
+{
+    m_code = helper::ReedSolomonCode();
+    m_blockSize = 0;
+    m_sources.clear();
+    m_parity.clear();
+    m_decodeCache.clear();
+    m_decodeCount = 0;
+    m_decodeCacheHits = 0;
+}
+
+bool
+CodedFragmentSet::IsBuilt() const
+{
+    return !m_sources.empty();
+}
+
+uint32_t
+CodedFragmentSet::GetSourceCount() const
+{
+    return m_code.GetSourceCount();
+}
+
+uint32_t
+CodedFragmentSet::GetSymbolCount() const
+{
+    return m_code.GetSymbolCount();
+}
+
+uint32_t
+CodedFragmentSet::GetBlockSize() const
+{
+    return m_blockSize;
+}
+
+void
+CodedFragmentSet::FillSourceBlock(uint32_t sourceIndex, uint8_t* block) const
+{
+    const Fragment& frag = m_sources[sourceIndex];
+    std::memset(block, 0, m_blockSize);
+    std::memcpy(block, &frag.confidence, sizeof(double));
+    std::memcpy(block + 8, &frag.size, sizeof(uint32_t));
+    if (frag.payload)
+    {
+        std::memcpy(block + kBlockHeaderBytes, frag.payload->data(), frag.payload->size());
+    }
+}
+
+bool
+CodedFragmentSet::Decode(const FragmentBitset& heldSymbols, std::vector<Fragment>& fragments) const
+{
+    const uint32_t k = GetSourceCount();
+    if (!IsBuilt())
+    {
+        return false;
+    }
+
+    // Source symbols first (copied, not combined), then parity
+    std::vector<uint32_t> chosen;
+    chosen.reserve(k);
+    for (uint32_t id = heldSymbols.FindNext(0);
+         id < GetSymbolCount() && chosen.size() < k;
+         id = heldSymbols.FindNext(id + 1))
+    {
+        chosen.push_back(id);
+    }
+    if (chosen.size() < k)
+    {
+        return false;
+    }
+
+    auto cached = m_decodeCache.find(chosen);
+    if (cached != m_decodeCache.end())
+    {
+        m_decodeCacheHits++;
+        fragments = cached->second;
+        return true;
+    }
+
+    std::vector<std::vector<uint8_t>> sourceBlocks;
+    sourceBlocks.reserve(k);
+    std::vector<const uint8_t*> symbols(k);
+    for (uint32_t r = 0; r < k; ++r)
+    {
+        if (chosen[r] < k)
+        {
+            sourceBlocks.emplace_back(m_blockSize);
+            FillSourceBlock(chosen[r], sourceBlocks.back().data());
+            symbols[r] = sourceBlocks.back().data();
+        }
+        else
+        {
+            symbols[r] = m_parity[chosen[r] - k].data();
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> decoded;
+    if (!m_code.Decode(chosen, symbols, m_blockSize, decoded))
+    {
+        return false;
+    }
+    m_decodeCount++;
+
+    fragments.clear();
+    fragments.reserve(k);
+    for (uint32_t j = 0; j < k; ++j)
+    {
+        const std::vector<uint8_t>& block = decoded[j];
+        Fragment frag;
+        frag.fragmentId = j;
+        std::memcpy(&frag.confidence, block.data(), sizeof(double));
+        std::memcpy(&frag.size, block.data() + 8, sizeof(uint32_t));
+
+        const uint32_t payloadSize =
+            std::min<uint32_t>(frag.size, m_blockSize - kBlockHeaderBytes);
+        const uint8_t* payloadBegin = block.data() + kBlockHeaderBytes;
+        const FragmentPayload& bsPayload = m_sources[j].payload;
+        if (bsPayload && bsPayload->size() == payloadSize &&
+            std::equal(bsPayload->begin(), bsPayload->end(), payloadBegin))
+        {
+            frag.payload = bsPayload;
+        }
+        else
+        {
+            frag.payload = std::make_shared<const std::vector<uint8_t>>(payloadBegin,
+                                                                        payloadBegin + payloadSize);
+        }
+        fragments.push_back(frag);
+    }
+
+    m_decodeCache.emplace(std::move(chosen), fragments);
+    return true;
+}
+
+uint32_t
+CodedFragmentSet::GetDecodeCount() const
+{
+    return m_decodeCount;
+}
+
+uint32_t
+CodedFragmentSet::GetDecodeCacheHits() const
+{
+    return m_decodeCacheHits;
+}
+
+const CodedFragmentSet&
+GetBsCodedFragments()
+{
+    return g_bsCodedFragments;
+}
+
+void
+BuildBsCodedFragments(uint32_t numParity)
+{
+    g_bsCodedFragments.Build(g_bsGeneratedFragments, numParity);
 }
 
 // Global UAV flight paths storage
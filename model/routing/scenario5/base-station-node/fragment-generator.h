@@ -2,8 +2,12 @@
 #define SCENARIO5_FRAGMENT_GENERATOR_H
 
 #include "../fragment.h"
+#include "broadcast-schedule.h"
+#include "../helper/reed-solomon.h"
 #include "base-station-node.h"
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace ns3 {
 namespace wsn {
@@ -12,9 +16,94 @@ namespace routing {
 
 FragmentCollection GenerateBsFragments(uint32_t numFragments);
 extern FragmentCollection g_bsGeneratedFragments;
+
+// Payloads of the BS-generated fragments; every node's copy shares these
+extern FragmentPayloadPool g_bsFragmentPayloadPool;
+const FragmentPayloadPool& GetBsFragmentPayloadPool();
 const FragmentCollection& GetBsGeneratedFragments();
 void SetBsGeneratedFragments(const FragmentCollection& fragments);
 
+// Broadcast order over the BS fragments, rebuilt by SetBsGeneratedFragments()
+extern FragmentBroadcastSchedule g_bsBroadcastSchedule;
+const FragmentBroadcastSchedule& GetBsBroadcastSchedule();
+// Replace the ordering policy (nullptr restores the params default) and rebuild
+void SetBsBroadcastSchedulePolicy(std::unique_ptr<BroadcastSchedulePolicy> policy);
+
+/**
+ * Reed-Solomon coded view of the BS fragment set.
+ *
+ * Symbol j < k is fragment j itself; parity symbols [k, n) are stored here.
+ * Each source block is [confidence (8) | size (4) | payload], zero-padded to
+ * the largest fragment, so decoding also recovers fragment metadata.
+ */
+class CodedFragmentSet
+{
+public:
+    CodedFragmentSet();
+
+    /**
+     * Encode the parity symbols of a fragment set with dense IDs [0, k).
+     *
+     * \param fragments Source fragments
+     * \param numParity Parity symbols n - k
+     */
+    void Build(const FragmentCollection& fragments, uint32_t numParity);
+
+    void Clear();
+
+    /**
+     * \return true once Build() produced a code
+     */
+    bool IsBuilt() const;
+
+    uint32_t GetSourceCount() const;
+    uint32_t GetSymbolCount() const;
+
+    /**
+     * \return bytes per symbol on air
+     */
+    uint32_t GetBlockSize() const;
+
+    /**
+     * Recover every source fragment from any k held symbols.
+     *
+     * Decodes are cached by symbol set, since nodes under one UAV pass tend
+     * to miss the same symbols.
+     *
+     * \param heldSymbols Held symbol indices (source fragment IDs and parity)
+     * \param fragments Output: all k source fragments, payloads shared with the
+     *        BS pool when the decoded bytes match it
+     * \return false if fewer than k symbols are held
+     */
+    bool Decode(const FragmentBitset& heldSymbols, std::vector<Fragment>& fragments) const;
+
+    /**
+     * \return decodes that ran the GF(256) kernel
+     */
+    uint32_t GetDecodeCount() const;
+
+    /**
+     * \return decodes answered from the cache
+     */
+    uint32_t GetDecodeCacheHits() const;
+
+private:
+    void FillSourceBlock(uint32_t sourceIndex, uint8_t* block) const;
+
+    helper::ReedSolomonCode m_code;
+    uint32_t m_blockSize;
+    std::vector<Fragment> m_sources;              ///< indexed by fragment ID
+    std::vector<std::vector<uint8_t>> m_parity;   ///< symbol k + i at index i
+    mutable std::map<std::vector<uint32_t>, std::vector<Fragment>> m_decodeCache;
+    mutable uint32_t m_decodeCount;
+    mutable uint32_t m_decodeCacheHits;
+};
+
+// Coded view of g_bsGeneratedFragments (built only when fragment coding is on)
+extern CodedFragmentSet g_bsCodedFragments;
+const CodedFragmentSet& GetBsCodedFragments();
+void BuildBsCodedFragments(uint32_t numParity);
+
 // Global storage for UAV flight paths (key = uavNodeId, value = flight path)
 extern std::map<uint32_t, UavFlightPath> g_uavFlightPaths;
 const std::map<uint32_t, UavFlightPath>& GetUavFlightPaths();
@@ -0,0 +1,589 @@
+/*
+ * Scenario 5 - UAV Path Planner Implementation
+ */
+
+#include "uav-path-planner.h"
+#include "../helper/calc-utils.h"
+#include "../helper/tour-optimizer.h"
+#include "../../../../examples/scenarios/scenario5/scenario5-params.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <thread>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+namespace {
+
+// Beardwood-Halton-Hammersley constant: random uniform TSP tour ~ k * sqrt(n * A)
+constexpr double kTourConstant = 0.7124;
+// Area of the regular hexagon inscribed in a disc of radius r is 3*sqrt(3)/2 * r^2
+constexpr double kHexCoverFactor = 2.598;
+constexpr uint32_t kPartitionBisectionSteps = 40;
+
+double
+EstimateTourLength(uint32_t stops, double width, double height)
+{
+    if (stops <= 1)
+    {
+        return 0.0;
+    }
+    const double area = width * height;
+    return std::max(kTourConstant * std::sqrt(stops * area), std::max(width, height));
+}
+
+double
+EstimateApproachDistance(const UavPlanRequest& uav, const TargetSetSummary& summary)
+{
+    const double cx = summary.sumX / summary.count;
+    const double cy = summary.sumY / summary.count;
+    return helper::CalculateDistance(uav.startPos.x, uav.startPos.y, cx, cy);
+}
+
+double
+ComputePathDistance(const Vector& startPos, const UavFlightPath& path)
+{
+    double total = 0.0;
+    Vector prev = startPos;
+    for (const auto& wp : path.waypoints)
+    {
+        total += helper::CalculateDistance(prev.x, prev.y, wp.position.x, wp.position.y);
+        prev = wp.position;
+    }
+    return total;
+}
+
+void
+SortByNodeId(std::vector<PlannerTarget>& targets)
+{
+    std::sort(targets.begin(), targets.end(), [](const PlannerTarget& a, const PlannerTarget& b) {
+        return a.nodeId < b.nodeId;
+    });
+}
+
+/**
+ * Greedy contiguous split of the angular order under a per-UAV time bound.
+ * The last UAV takes the remainder.
+ *
+ * \return true if the last UAV also fits within maxTime
+ */
+bool
+SplitSweep(const UavPathPlanner& planner,
+           const std::vector<UavPlanRequest>& uavs,
+           const std::vector<PlannerTarget>& targets,
+           const std::vector<uint32_t>& order,
+           double maxTime,
+           std::vector<uint32_t>* cuts)
+{
+    const uint32_t k = static_cast<uint32_t>(uavs.size());
+    uint32_t pos = 0;
+    if (cuts)
+    {
+        cuts->assign(k + 1, 0);
+    }
+
+    for (uint32_t u = 0; u + 1 < k; ++u)
+    {
+        TargetSetSummary summary;
+        while (pos < order.size())
+        {
+            TargetSetSummary trial = summary;
+            trial.Add(targets[order[pos]].position);
+            if (planner.EstimateMissionTime(uavs[u], trial) > maxTime)
+            {
+                break;
+            }
+            summary = trial;
+            ++pos;
+        }
+        if (cuts)
+        {
+            (*cuts)[u + 1] = pos;
+        }
+    }
+
+    TargetSetSummary last;
+    for (uint32_t i = pos; i < order.size(); ++i)
+    {
+        last.Add(targets[order[i]].position);
+    }
+    if (cuts)
+    {
+        (*cuts)[k] = static_cast<uint32_t>(order.size());
+    }
+    return planner.EstimateMissionTime(uavs[k - 1], last) <= maxTime;
+}
+
+} // namespace
+
+void
+TargetSetSummary::Add(const Vector& pos)
+{
+    if (count == 0)
+    {
+        minX = maxX = pos.x;
+        minY = maxY = pos.y;
+    }
+    else
+    {
+        minX = std::min(minX, pos.x);
+        maxX = std::max(maxX, pos.x);
+        minY = std::min(minY, pos.y);
+        maxY = std::max(maxY, pos.y);
+    }
+    sumX += pos.x;
+    sumY += pos.y;
+    count++;
+}
+
+// ===== NearestNeighborTourPlanner =====
+
+NearestNeighborTourPlanner::NearestNeighborTourPlanner(const helper::TourRefinementOptions& refinement)
+    : m_refinement(refinement)
+{
+}
+
+const char*
+NearestNeighborTourPlanner::GetName() const
+{
+    return m_refinement.enabled ? "NearestNeighbor2Opt" : "GreedyNearestNeighbor";
+}
+
+UavMissionRole
+NearestNeighborTourPlanner::GetRole() const
+{
+    return UavMissionRole::NODE_VISIT;
+}
+
+double
+NearestNeighborTourPlanner::EstimateMissionTime(const UavPlanRequest& uav,
+                                                const TargetSetSummary& summary) const
+{
+    if (summary.count == 0)
+    {
+        return 0.0;
+    }
+    const double tour =
+        EstimateTourLength(summary.count, summary.maxX - summary.minX, summary.maxY - summary.minY);
+    return (EstimateApproachDistance(uav, summary) + tour) / uav.speed +
+           summary.count * uav.hoverTime;
+}
+
+UavPlanResult
+NearestNeighborTourPlanner::Plan(const UavPlanRequest& uav,
+                                 const std::vector<PlannerTarget>& targets) const
+{
+    UavPlanResult result;
+    result.request = uav;
+    result.targets = targets;
+    result.path.role = GetRole();
+
+    const uint32_t n = static_cast<uint32_t>(targets.size());
+    std::vector<double> xs(n);
+    std::vector<double> ys(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        xs[i] = targets[i].position.x;
+        ys[i] = targets[i].position.y;
+    }
+
+    // Nearest-neighbor order (same as a linear scan), then local search
+    std::vector<uint32_t> order = helper::BuildNearestNeighborTour(uav.startPos.x, uav.startPos.y, xs, ys);
+    helper::RefineOpenTour(uav.startPos.x, uav.startPos.y, xs, ys, m_refinement, order);
+
+    Vector currentPos = uav.startPos;
+    double currentTime = 0.0;
+    for (uint32_t idx : order)
+    {
+        const Vector& pos = targets[idx].position;
+        currentTime += helper::CalculateDistance(currentPos.x, currentPos.y, pos.x, pos.y) / uav.speed;
+
+        Waypoint wp;
+        wp.position = Vector(pos.x, pos.y, uav.altitude);
+        wp.arrivalTime = currentTime;
+        result.path.waypoints.push_back(wp);
+
+        currentTime += uav.hoverTime;
+        currentPos = pos;
+    }
+
+    result.path.totalTime = currentTime;
+    result.servedTargets = static_cast<uint32_t>(order.size());
+    result.totalDistance = ComputePathDistance(uav.startPos, result.path);
+    return result;
+}
+
+// ===== GreedySetCoverPlanner =====
+
+GreedySetCoverPlanner::GreedySetCoverPlanner(double broadcastRadius)
+    : m_broadcastRadius(broadcastRadius)
+{
+}
+
+const char*
+GreedySetCoverPlanner::GetName() const
+{
+    return "GreedySetCover";
+}
+
+UavMissionRole
+GreedySetCoverPlanner::GetRole() const
+{
+    return UavMissionRole::AREA_COVERAGE;
+}
+
+double
+GreedySetCoverPlanner::GetBroadcastRadius() const
+{
+    return m_broadcastRadius;
+}
+
+double
+GreedySetCoverPlanner::EstimateMissionTime(const UavPlanRequest& uav,
+                                           const TargetSetSummary& summary) const
+{
+    if (summary.count == 0)
+    {
+        return 0.0;
+    }
+    const double width = summary.maxX - summary.minX;
+    const double height = summary.maxY - summary.minY;
+    const double discArea = kHexCoverFactor * m_broadcastRadius * m_broadcastRadius;
+    const uint32_t stops = std::min<uint32_t>(
+        summary.count,
+        std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(width * height / discArea))));
+    const double tour = EstimateTourLength(stops, width, height);
+    return (EstimateApproachDistance(uav, summary) + tour) / uav.speed + stops * uav.hoverTime;
+}
+
+UavPlanResult
+GreedySetCoverPlanner::Plan(const UavPlanRequest& uav,
+                            const std::vector<PlannerTarget>& targets) const
+{
+    UavPlanResult result;
+    result.request = uav;
+    result.targets = targets;
+    result.path.role = GetRole();
+
+    const uint32_t n = static_cast<uint32_t>(targets.size());
+    std::vector<double> xs(n);
+    std::vector<double> ys(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        xs[i] = targets[i].position.x;
+        ys[i] = targets[i].position.y;
+    }
+
+    // Candidate waypoints are the target positions; coverage is symmetric
+    std::vector<std::vector<uint32_t>> coverage;
+    helper::BuildCoverageLists(xs, ys, xs, ys, m_broadcastRadius, coverage);
+
+    // Lazy greedy (CELF): heap keys are upper bounds on marginal gain, which
+    // only shrink as targets get covered. Higher bound first, then lower index.
+    using GainEntry = std::pair<uint32_t, uint32_t>; // (gain bound, candidate index)
+    auto lowerPriority = [](const GainEntry& a, const GainEntry& b) {
+        return a.first < b.first || (a.first == b.first && a.second > b.second);
+    };
+    std::priority_queue<GainEntry, std::vector<GainEntry>, decltype(lowerPriority)> heap(lowerPriority);
+    for (uint32_t c = 0; c < n; ++c)
+    {
+        if (!coverage[c].empty())
+        {
+            heap.push({static_cast<uint32_t>(coverage[c].size()), c});
+        }
+    }
+
+    std::vector<bool> covered(n, false);
+    uint32_t coveredCount = 0;
+    Vector currentPos = uav.startPos;
+    double currentTime = 0.0;
+    std::vector<GainEntry> evaluated;
+
+    while (coveredCount < n)
+    {
+        // Best gain, ties broken by distance from current position, then by
+        // lowest index. Every entry whose bound can still tie the best gain is
+        // re-evaluated, so the choice matches the exhaustive greedy scan.
+        uint32_t bestGain = 0;
+        uint32_t bestCandidate = n;
+        double bestDistance = std::numeric_limits<double>::max();
+        evaluated.clear();
+
+        while (!heap.empty() && heap.top().first >= std::max<uint32_t>(bestGain, 1))
+        {
+            const uint32_t c = heap.top().second;
+            heap.pop();
+
+            uint32_t gain = 0;
+            for (uint32_t idx : coverage[c])
+            {
+                if (!covered[idx])
+                {
+                    gain++;
+                }
+            }
+            if (gain == 0)
+            {
+                continue; // gains never grow back
+            }
+            evaluated.push_back({gain, c});
+
+            const Vector& candidatePos = targets[c].position;
+            const double distFromCurrent = helper::CalculateDistance(
+                currentPos.x, currentPos.y, candidatePos.x, candidatePos.y);
+
+            if (gain > bestGain ||
+                (gain == bestGain &&
+                 (distFromCurrent < bestDistance ||
+                  (distFromCurrent == bestDistance && c < bestCandidate))))
+            {
+                bestGain = gain;
+                bestCandidate = c;
+                bestDistance = distFromCurrent;
+            }
+        }
+
+        if (bestCandidate == n)
+        {
+            break;
+        }
+
+        for (const auto& entry : evaluated)
+        {
+            if (entry.second != bestCandidate)
+            {
+                heap.push(entry);
+            }
+        }
+
+        const Vector& bestWaypointPos = targets[bestCandidate].position;
+        currentTime += bestDistance / uav.speed;
+
+        Waypoint wp;
+        wp.position = Vector(bestWaypointPos.x, bestWaypointPos.y, uav.altitude);
+        wp.arrivalTime = currentTime;
+        result.path.waypoints.push_back(wp);
+
+        currentTime += uav.hoverTime;
+
+        // Mark all targets covered by this waypoint
+        for (uint32_t idx : coverage[bestCandidate])
+        {
+            if (!covered[idx])
+            {
+                covered[idx] = true;
+                coveredCount++;
+            }
+        }
+
+        currentPos = bestWaypointPos;
+    }
+
+    result.path.totalTime = currentTime;
+    result.servedTargets = coveredCount;
+    result.totalDistance = ComputePathDistance(uav.startPos, result.path);
+    return result;
+}
+
+// ===== Multi-UAV driver =====
+
+std::vector<std::vector<PlannerTarget>>
+PartitionTargetsByMissionTime(const UavPathPlanner& planner,
+                              const std::vector<UavPlanRequest>& uavs,
+                              const std::vector<PlannerTarget>& targets)
+{
+    std::vector<std::vector<PlannerTarget>> parts(uavs.size());
+    if (uavs.empty())
+    {
+        return parts;
+    }
+    if (uavs.size() == 1 || targets.empty())
+    {
+        parts[0] = targets;
+        return parts;
+    }
+
+    // Angular sweep around the target centroid
+    TargetSetSummary all;
+    for (const auto& target : targets)
+    {
+        all.Add(target.position);
+    }
+    const double cx = all.sumX / all.count;
+    const double cy = all.sumY / all.count;
+
+    std::vector<double> angle(targets.size());
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        angle[i] = std::atan2(targets[i].position.y - cy, targets[i].position.x - cx);
+    }
+
+    std::vector<uint32_t> order(targets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (angle[a] != angle[b])
+        {
+            return angle[a] < angle[b];
+        }
+        return targets[a].nodeId < targets[b].nodeId;
+    });
+
+    // Bisection on the largest per-UAV estimated mission time
+    double lo = 0.0;
+    double hi = 0.0;
+    for (const auto& uav : uavs)
+    {
+        hi = std::max(hi, planner.EstimateMissionTime(uav, all));
+    }
+    for (uint32_t step = 0; step < kPartitionBisectionSteps && hi - lo > 1e-6 * hi; ++step)
+    {
+        const double mid = 0.5 * (lo + hi);
+        if (SplitSweep(planner, uavs, targets, order, mid, nullptr))
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid;
+        }
+    }
+
+    std::vector<uint32_t> cuts;
+    SplitSweep(planner, uavs, targets, order, hi, &cuts);
+    for (size_t u = 0; u < uavs.size(); ++u)
+    {
+        for (uint32_t i = cuts[u]; i < cuts[u + 1]; ++i)
+        {
+            parts[u].push_back(targets[order[i]]);
+        }
+        SortByNodeId(parts[u]);
+    }
+    return parts;
+}
+
+std::vector<UavPlanResult>
+PlanUavGroup(const UavPathPlanner& planner,
+             const std::vector<UavPlanRequest>& uavs,
+             const std::vector<PlannerTarget>& targets,
+             bool parallel)
+{
+    const std::vector<std::vector<PlannerTarget>> parts =
+        PartitionTargetsByMissionTime(planner, uavs, targets);
+    std::vector<UavPlanResult> results(uavs.size());
+
+    auto planOne = [&](size_t u) {
+        const auto start = std::chrono::steady_clock::now();
+        results[u] = planner.Plan(uavs[u], parts[u]);
+        results[u].planningTimeSec =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const size_t hwThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t numWorkers = parallel ? std::min(uavs.size(), hwThreads) : 1;
+    if (numWorkers <= 1)
+    {
+        for (size_t u = 0; u < uavs.size(); ++u)
+        {
+            planOne(u);
+        }
+        return results;
+    }
+
+    // Workers pull UAV indices; each result slot is written by exactly one worker
+    std::atomic<size_t> next{0};
+    std::vector<std::future<void>> workers;
+    workers.reserve(numWorkers);
+    for (size_t w = 0; w < numWorkers; ++w)
+    {
+        workers.push_back(std::async(std::launch::async, [&]() {
+            for (size_t u = next.fetch_add(1); u < uavs.size(); u = next.fetch_add(1))
+            {
+                planOne(u);
+            }
+        }));
+    }
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+    return results;
+}
+
+UavFleetPlanOptions
+GetBsInitFleetPlanOptions()
+{
+    UavFleetPlanOptions options;
+    options.altitude = params::BS_INIT_UAV_PATROL_ALTITUDE;
+    options.visitSpeed = params::UAV1_SPEED;
+    options.visitHoverTime = params::UAV1_HOVER_TIME;
+    options.coverageSpeed = params::UAV2_SPEED;
+    options.coverageHoverTime = params::UAV2_HOVER_TIME;
+    options.broadcastRadius = params::UAV_BROADCAST_RADIUS;
+    options.refinement.enabled = params::UAV1_ROUTE_REFINE;
+    options.refinement.neighbors = params::UAV1_ROUTE_NEIGHBORS;
+    options.refinement.maxPasses = params::UAV1_ROUTE_REFINE_MAX_PASSES;
+    options.refinement.maxMoves = params::UAV1_ROUTE_REFINE_MAX_MOVES;
+    options.refinement.timeLimitSec = params::UAV1_ROUTE_REFINE_TIME_LIMIT;
+    options.parallel = params::UAV_PLANNER_PARALLEL;
+    return options;
+}
+
+UavFleetPlanResult
+PlanUavFleet(const std::vector<uint32_t>& uavNodeIds,
+             const std::vector<Vector>& startPositions,
+             const std::vector<PlannerTarget>& targets,
+             const UavFleetPlanOptions& options)
+{
+    // First ceil(N/2) UAVs visit every node (UAV1 role: fast, hovers),
+    // the rest fly coverage waypoints (UAV2 role: broadcasts, no hover).
+    const size_t numVisitUavs = (uavNodeIds.size() + 1) / 2;
+    std::vector<UavPlanRequest> visitGroup;
+    std::vector<UavPlanRequest> coverageGroup;
+    for (size_t i = 0; i < uavNodeIds.size(); ++i)
+    {
+        if (i < numVisitUavs)
+        {
+            visitGroup.push_back({uavNodeIds[i], startPositions[i], options.altitude,
+                                  options.visitSpeed, options.visitHoverTime});
+        }
+        else
+        {
+            coverageGroup.push_back({uavNodeIds[i], startPositions[i], options.altitude,
+                                     options.coverageSpeed, options.coverageHoverTime});
+        }
+    }
+
+    const NearestNeighborTourPlanner visitPlanner(options.refinement);
+    const GreedySetCoverPlanner coveragePlanner(options.broadcastRadius);
+
+    UavFleetPlanResult result;
+    result.visitStrategy = visitPlanner.GetName();
+    result.coverageStrategy = coveragePlanner.GetName();
+    if (options.parallel && !coverageGroup.empty())
+    {
+        auto coverageFuture = std::async(std::launch::async, [&]() {
+            return PlanUavGroup(coveragePlanner, coverageGroup, targets, true);
+        });
+        result.visitResults = PlanUavGroup(visitPlanner, visitGroup, targets, true);
+        result.coverageResults = coverageFuture.get();
+    }
+    else
+    {
+        result.visitResults = PlanUavGroup(visitPlanner, visitGroup, targets, options.parallel);
+        result.coverageResults = PlanUavGroup(coveragePlanner, coverageGroup, targets, options.parallel);
+    }
+    return result;
+}
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
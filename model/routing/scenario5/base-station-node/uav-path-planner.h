@@ -0,0 +1,254 @@
+/*
+ * Scenario 5 - UAV Path Planner
+ *
+ * Pluggable per-UAV route planners plus a multi-UAV driver that partitions
+ * suspicious nodes across a UAV group by estimated mission time and plans
+ * each UAV's route in parallel. Pure computation, no simulator state.
+ */
+
+#ifndef SCENARIO5_UAV_PATH_PLANNER_H
+#define SCENARIO5_UAV_PATH_PLANNER_H
+
+#include "base-station-node.h"
+#include "../helper/tour-optimizer.h"
+#include "ns3/vector.h"
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+/**
+ * Suspicious node to be served by a UAV.
+ */
+struct PlannerTarget
+{
+    uint32_t nodeId;
+    Vector position;
+};
+
+/**
+ * Per-UAV planning input.
+ */
+struct UavPlanRequest
+{
+    uint32_t uavNodeId;
+    Vector startPos;
+    double altitude;
+    double speed;
+    double hoverTime;
+};
+
+/**
+ * Per-UAV planning output.
+ */
+struct UavPlanResult
+{
+    UavPlanRequest request;
+    std::vector<PlannerTarget> targets; ///< assigned targets, ascending nodeId
+    UavFlightPath path;
+    uint32_t servedTargets = 0;         ///< targets visited or covered by the path
+    double totalDistance = 0.0;         ///< horizontal distance from startPos
+    double planningTimeSec = 0.0;       ///< wall-clock planning time
+};
+
+/**
+ * Running summary of a target set (count, centroid, bounding box).
+ * Lets planners estimate mission time in O(1) while a partition grows.
+ */
+struct TargetSetSummary
+{
+    uint32_t count = 0;
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double minX = 0.0;
+    double minY = 0.0;
+    double maxX = 0.0;
+    double maxY = 0.0;
+
+    void Add(const Vector& pos);
+};
+
+/**
+ * Route planner for a single UAV.
+ */
+class UavPathPlanner
+{
+public:
+    virtual ~UavPathPlanner() = default;
+
+    /**
+     * \return strategy name written to the result log
+     */
+    virtual const char* GetName() const = 0;
+
+    /**
+     * \return mission role of UAVs flying this planner's routes
+     */
+    virtual UavMissionRole GetRole() const = 0;
+
+    /**
+     * Estimate mission time without planning.
+     *
+     * \param uav UAV parameters
+     * \param summary Summary of the targets to serve
+     * \return estimated mission time in seconds
+     */
+    virtual double EstimateMissionTime(const UavPlanRequest& uav,
+                                       const TargetSetSummary& summary) const = 0;
+
+    /**
+     * Plan a route serving all targets.
+     *
+     * \param uav UAV parameters
+     * \param targets Targets in ascending nodeId order
+     * \return planned route, path.role set to GetRole()
+     */
+    virtual UavPlanResult Plan(const UavPlanRequest& uav,
+                               const std::vector<PlannerTarget>& targets) const = 0;
+};
+
+/**
+ * Greedy nearest-neighbor tour visiting every target (UAV1 strategy).
+ *
+ * Construction uses a bucket grid and yields the same order as a linear
+ * nearest-unvisited scan; the tour is then optionally shortened with
+ * 2-opt / Or-opt moves.
+ */
+class NearestNeighborTourPlanner : public UavPathPlanner
+{
+public:
+    NearestNeighborTourPlanner() = default;
+
+    /**
+     * \param refinement Local search applied after construction
+     */
+    explicit NearestNeighborTourPlanner(const helper::TourRefinementOptions& refinement);
+
+    const char* GetName() const override;
+    UavMissionRole GetRole() const override;
+    double EstimateMissionTime(const UavPlanRequest& uav,
+                               const TargetSetSummary& summary) const override;
+    UavPlanResult Plan(const UavPlanRequest& uav,
+                       const std::vector<PlannerTarget>& targets) const override;
+
+private:
+    helper::TourRefinementOptions m_refinement;
+};
+
+/**
+ * Greedy set cover over candidate waypoints at target positions (UAV2 strategy).
+ *
+ * Runs lazy greedy (CELF) over coverage lists built on a spatial grid; the
+ * selected waypoints match the exhaustive greedy scan (max gain, then nearest
+ * to the current position, then lowest index).
+ */
+class GreedySetCoverPlanner : public UavPathPlanner
+{
+public:
+    /**
+     * \param broadcastRadius Coverage radius of one waypoint
+     */
+    explicit GreedySetCoverPlanner(double broadcastRadius);
+
+    const char* GetName() const override;
+    UavMissionRole GetRole() const override;
+    double EstimateMissionTime(const UavPlanRequest& uav,
+                               const TargetSetSummary& summary) const override;
+    UavPlanResult Plan(const UavPlanRequest& uav,
+                       const std::vector<PlannerTarget>& targets) const override;
+
+    double GetBroadcastRadius() const;
+
+private:
+    double m_broadcastRadius;
+};
+
+/**
+ * Partition targets across a UAV group, balancing estimated mission time.
+ *
+ * Targets are swept by polar angle around their centroid and split into
+ * contiguous sectors; the largest per-UAV estimate is minimized by bisection.
+ * A single-UAV group receives every target unchanged.
+ *
+ * \param planner Planner used for the estimates
+ * \param uavs UAV group
+ * \param targets Targets in ascending nodeId order
+ * \return one target list per UAV (same order as uavs), each ascending nodeId
+ */
+std::vector<std::vector<PlannerTarget>> PartitionTargetsByMissionTime(
+    const UavPathPlanner& planner,
+    const std::vector<UavPlanRequest>& uavs,
+    const std::vector<PlannerTarget>& targets);
+
+/**
+ * Partition targets across a UAV group and plan every UAV.
+ *
+ * \param planner Planner shared by the group
+ * \param uavs UAV group
+ * \param targets Targets in ascending nodeId order
+ * \param parallel Plan UAVs on worker threads when the group has more than one UAV
+ * \return one result per UAV (same order as uavs), path.role set to planner role
+ */
+std::vector<UavPlanResult> PlanUavGroup(const UavPathPlanner& planner,
+                                        const std::vector<UavPlanRequest>& uavs,
+                                        const std::vector<PlannerTarget>& targets,
+                                        bool parallel);
+
+/**
+ * Planning parameters of a mixed UAV fleet.
+ */
+struct UavFleetPlanOptions
+{
+    double altitude = 0.0;
+    double visitSpeed = 0.0;                  ///< node-visit group (UAV1 role)
+    double visitHoverTime = 0.0;
+    double coverageSpeed = 0.0;               ///< coverage group (UAV2 role)
+    double coverageHoverTime = 0.0;
+    double broadcastRadius = 0.0;
+    helper::TourRefinementOptions refinement; ///< node-visit tour local search
+    bool parallel = false;                    ///< plan groups and UAVs on worker threads
+};
+
+/**
+ * Planning output of a mixed UAV fleet.
+ */
+struct UavFleetPlanResult
+{
+    std::vector<UavPlanResult> visitResults;    ///< node-visit group, fleet order
+    std::vector<UavPlanResult> coverageResults; ///< coverage group, fleet order
+    const char* visitStrategy = "";
+    const char* coverageStrategy = "";
+};
+
+/**
+ * \return fleet options of the BS init pass (scenario5 params)
+ */
+UavFleetPlanOptions GetBsInitFleetPlanOptions();
+
+/**
+ * Split a UAV fleet into a node-visit and a coverage group and plan both.
+ *
+ * The first ceil(N/2) UAVs visit every target with the nearest-neighbor tour
+ * planner; the rest fly greedy set-cover waypoints. Each group shares the
+ * full target set.
+ *
+ * \param uavNodeIds UAV node IDs
+ * \param startPositions Start position of each UAV (same order)
+ * \param targets Targets in ascending nodeId order
+ * \param options Fleet parameters
+ * \return per-group results
+ */
+UavFleetPlanResult PlanUavFleet(const std::vector<uint32_t>& uavNodeIds,
+                                const std::vector<Vector>& startPositions,
+                                const std::vector<PlannerTarget>& targets,
+                                const UavFleetPlanOptions& options);
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_UAV_PATH_PLANNER_H
@@ -0,0 +1,183 @@
+/*
+ * Scenario 5 - Binary Result Event Log
+ *
+ * Schema-tagged binary replacement for the text result log. Hot events are
+ * fixed-size records kept in per-type column buffers and written in large
+ * blocks; everything else written to params::g_resultFileStream while the
+ * log is open is captured as TEXT records, so the original order is kept.
+ *
+ * File layout (host byte order, little-endian on every supported target):
+ *
+ *   header  "WSNEVT01", u32 schemaCount, then per schema:
+ *           u16 typeId, u16 columnCount, u16 len + text template,
+ *           per column: u8 columnType, u16 len + column name
+ *   groups  repeated until EOF: u32 blockCount, then per block:
+ *           u16 typeId, u16 reserved, u32 rowCount, columns in schema order
+ *           (TEXT: u32 length per row, then the concatenated bytes)
+ *
+ * Column 0 of every type is a u64 sequence number across all types; a
+ * group holds every record of a contiguous sequence range. The template
+ * gives the text form of a record ({column} or {column:spec}), which is
+ * what examples/visualize/event-log-to-text.py uses to rebuild the text log.
+ * {column:@other} formats a float with the stream format stored in column
+ * "other" (floatfield << 16 | precision), as the text stream had it then.
+ */
+
+#ifndef SCENARIO5_EVENT_LOG_H
+#define SCENARIO5_EVENT_LOG_H
+
+#include "../../async-trace-sink.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+/**
+ * Record types of the binary event log.
+ */
+enum class EventLogType : uint16_t
+{
+    TEXT = 0,                      ///< Free-form text (cold paths)
+    FRAGMENT_RECEIVED = 1,         ///< "src-R-dst(fragmentId) "
+    FRAGMENT_SHARED = 2,           ///< "src-S-dst(fragmentId) "
+    CODED_SYMBOL_RECEIVED = 3,     ///< "src-C-dst(symbolIndex) "
+    UAV_FRAGMENT_BROADCAST = 4,    ///< [EVENT] ... event=UAVFragmentBroadcast
+    UAV_CODED_SYMBOL_BROADCAST = 5 ///< [EVENT] ... event=UAVCodedSymbolBroadcast
+};
+
+constexpr uint32_t kEventLogTypeCount = 6;
+
+/**
+ * Binary, columnar result event log.
+ */
+class EventLog
+{
+public:
+    EventLog();
+    ~EventLog();
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    /**
+     * Create the log file and write the schema header.
+     *
+     * \param path Output file
+     * \param blockRecords Records buffered before a group is written
+     * \param asyncBufferBytes Ring size of a background writer thread for the
+     *        groups (0 = write them on the simulation thread)
+     * \param compression File encoding (always uses the writer thread)
+     * \return false if the file cannot be created
+     */
+    bool Open(const std::string& path,
+              uint32_t blockRecords,
+              size_t asyncBufferBytes = 0,
+              AsyncTraceSink::Compression compression = AsyncTraceSink::Compression::NONE);
+
+    /**
+     * Write buffered records and close the file.
+     */
+    void Close();
+
+    bool IsOpen() const;
+
+    /**
+     * Text sink: whatever is written here becomes TEXT records.
+     */
+    std::ostream& GetTextStream();
+
+    /**
+     * Append a fragment/symbol token (FRAGMENT_RECEIVED, FRAGMENT_SHARED or
+     * CODED_SYMBOL_RECEIVED).
+     */
+    void AppendToken(EventLogType type, uint32_t srcNodeId, uint32_t dstNodeId, uint32_t id);
+
+    /**
+     * Append a UAV broadcast event (UAV_FRAGMENT_BROADCAST or
+     * UAV_CODED_SYMBOL_BROADCAST; confidence and size are ignored for the
+     * latter).
+     */
+    void AppendUavBroadcast(EventLogType type,
+                            double time,
+                            uint32_t uavNodeId,
+                            uint32_t index,
+                            uint32_t cycle,
+                            double confidence,
+                            uint32_t size);
+
+    /**
+     * Write every buffered record as one group.
+     */
+    void Flush();
+
+    uint64_t GetRecordCount() const;
+    uint64_t GetBytesWritten() const;
+
+private:
+    class TextBuffer;
+
+    /**
+     * Column buffers of one record type (fixed-width columns as raw bytes).
+     */
+    struct TypeBuffer
+    {
+        std::vector<std::vector<uint8_t>> columns;
+        std::vector<uint8_t> textBytes; ///< TEXT only: concatenated payloads
+        uint32_t rows = 0;
+    };
+
+    void WriteHeader();
+    void BeginRecord(EventLogType type);
+    void SealText();
+    void Write(const void* data, size_t size);
+
+    std::ofstream m_file;
+    AsyncTraceSink m_asyncFile; ///< Used instead of m_file when open
+    std::unique_ptr<TextBuffer> m_textBuffer;
+    std::unique_ptr<std::ostream> m_textStream;
+    std::string m_pendingText;
+    TypeBuffer m_buffers[kEventLogTypeCount];
+    uint32_t m_blockRecords;
+    uint32_t m_bufferedRecords;
+    uint64_t m_nextSequence;
+    uint64_t m_bytesWritten;
+};
+
+/**
+ * \return result event log of the scenario (closed unless opened by the
+ *         example)
+ */
+EventLog& GetResultEventLog();
+
+/**
+ * Write a fragment/symbol token: a binary record if the event log is open,
+ * otherwise its text form on params::g_resultFileStream. Routing code logs
+ * through LogResultToken (trace-policy.h), which filters first.
+ */
+void WriteResultToken(EventLogType type, uint32_t srcNodeId, uint32_t dstNodeId, uint32_t id);
+
+/**
+ * Write a UAV broadcast event (binary record or text line, as
+ * WriteResultToken).
+ */
+void WriteResultUavBroadcast(EventLogType type,
+                             double time,
+                             uint32_t uavNodeId,
+                             uint32_t index,
+                             uint32_t cycle,
+                             double confidence,
+                             uint32_t size);
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_EVENT_LOG_H
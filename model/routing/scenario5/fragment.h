@@ -5,8 +5,11 @@
 #ifndef SCENARIO5_FRAGMENT_H
 #define SCENARIO5_FRAGMENT_H
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace ns3 {
@@ -14,25 +17,186 @@ namespace wsn {
 namespace scenario5 {
 namespace routing {
 
+/**
+ * Immutable fragment payload bytes, shared by every holder of the fragment.
+ */
+using FragmentPayload = std::shared_ptr<const std::vector<uint8_t>>;
+
 /**
  * File fragment with metadata.
+ *
+ * Copies share the payload; only the handle is duplicated.
  */
 struct Fragment
 {
     uint32_t fragmentId;      ///< Unique fragment ID
     double confidence;        ///< Confidence level [0, 1]
     uint32_t size;           ///< Fragment size in bytes
-    std::vector<uint8_t> data; ///< Fragment data (placeholder)
+    FragmentPayload payload;  ///< Shared payload (placeholder), null if not held
+};
+
+/**
+ * Payload store keyed by fragment ID.
+ *
+ * Owns one immutable copy of each fragment's bytes and hands out shared
+ * handles, so node collections never duplicate payload data.
+ */
+class FragmentPayloadPool
+{
+public:
+    /**
+     * Store the payload of a fragment, replacing any previous one.
+     *
+     * \param fragmentId Fragment ID
+     * \param bytes Payload bytes
+     * \return shared handle to the stored payload
+     */
+    FragmentPayload Store(uint32_t fragmentId, std::vector<uint8_t> bytes);
+
+    /**
+     * \return payload handle, or nullptr if the fragment is not stored
+     */
+    FragmentPayload Get(uint32_t fragmentId) const;
+
+    /**
+     * Drop the pool's handles (payloads stay alive while still referenced).
+     */
+    void Clear();
+
+    size_t GetCount() const;
+
+    /**
+     * \return total payload bytes owned by the pool
+     */
+    uint64_t GetTotalBytes() const;
+
+private:
+    std::map<uint32_t, FragmentPayload> m_payloads;
+};
+
+/**
+ * Dynamic bitset over fragment IDs, stored as 64-bit words.
+ *
+ * Set operations run word by word, so comparing two nodes' holdings costs
+ * O(capacity / 64).
+ */
+class FragmentBitset
+{
+public:
+    /**
+     * Grow to hold at least capacity IDs (never shrinks, keeps bits).
+     */
+    void Reserve(uint32_t capacity);
+
+    uint32_t GetCapacity() const;
+
+    /**
+     * \return true if the ID is set (false beyond capacity)
+     */
+    bool Test(uint32_t id) const;
+
+    /**
+     * Set an ID, growing the bitset if needed.
+     */
+    void Set(uint32_t id);
+
+    void Reset(uint32_t id);
+
+    /**
+     * Clear every bit (capacity is kept).
+     */
+    void Clear();
+
+    /**
+     * \return number of set IDs
+     */
+    uint32_t Count() const;
+
+    bool Any() const;
+
+    /**
+     * \return IDs set here but not in other (this AND NOT other)
+     */
+    FragmentBitset AndNot(const FragmentBitset& other) const;
+
+    /**
+     * \return true if some ID is set here but not in other (no allocation)
+     */
+    bool AnyAndNot(const FragmentBitset& other) const;
+
+    /**
+     * Set every ID that is set in other.
+     */
+    void UnionWith(const FragmentBitset& other);
+
+    /**
+     * \return smallest set ID >= from, or GetCapacity() if none
+     */
+    uint32_t FindNext(uint32_t from) const;
+
+    /**
+     * Call f(id) for every set ID in ascending order.
+     */
+    template <typename F>
+    void ForEach(F&& f) const
+    {
+        for (uint32_t w = 0; w < m_words.size(); ++w)
+        {
+            uint64_t word = m_words[w];
+            while (word != 0)
+            {
+                const uint32_t bit = static_cast<uint32_t>(__builtin_ctzll(word));
+                f(w * 64 + bit);
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> m_words;
 };
 
 /**
  * Fragment collection for a node.
+ *
+ * Fragments live in a dense array indexed by fragment ID, with a bitset of
+ * held IDs. Total confidence is maintained incrementally on every add or
+ * update. Iteration visits held fragments in ascending ID order.
  */
-struct FragmentCollection
+class FragmentCollection
 {
-    std::map<uint32_t, Fragment> fragments;
-    double totalConfidence; ///< Cumulative confidence over unique fragments currently held
-    
+public:
+    /**
+     * Forward iterator over held fragments (ascending ID).
+     */
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Fragment;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Fragment*;
+        using reference = const Fragment&;
+
+        ConstIterator(const FragmentCollection* owner, uint32_t id);
+
+        reference operator*() const;
+        pointer operator->() const;
+        ConstIterator& operator++();
+        ConstIterator operator++(int);
+        bool operator==(const ConstIterator& other) const;
+        bool operator!=(const ConstIterator& other) const;
+
+    private:
+        const FragmentCollection* m_owner;
+        uint32_t m_id;
+    };
+
+    /**
+     * Pre-size storage for IDs [0, capacity). Larger IDs still grow on add.
+     */
+    void Reserve(uint32_t capacity);
+
     /**
      * Add or update fragment.
      */
@@ -47,20 +211,59 @@ struct FragmentCollection
      * Get fragment.
      */
     const Fragment* GetFragment(uint32_t fragmentId) const;
+
+    /**
+     * Remove every fragment (capacity is kept).
+     */
+    void Clear();
+
+    /**
+     * \return number of held fragments
+     */
+    uint32_t GetCount() const;
+
+    bool IsEmpty() const;
+
+    /**
+     * \return cumulative confidence over held fragments
+     */
+    double GetTotalConfidence() const;
+
+    /**
+     * \return bitset of held fragment IDs
+     */
+    const FragmentBitset& GetHeldIds() const;
     
     /**
-     * Update total confidence.
+     * Recompute total confidence from scratch (ascending ID order).
      */
     void UpdateTotalConfidence();
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+private:
+    /**
+     * \return smallest held ID >= from, or kEndId
+     */
+    uint32_t NextHeldId(uint32_t from) const;
+
+    static constexpr uint32_t kEndId = 0xFFFFFFFFu;
+
+    std::vector<Fragment> m_slots;  ///< indexed by fragment ID
+    FragmentBitset m_held;
+    uint32_t m_count = 0;
+    double m_totalConfidence = 0.0;
 };
 
 /**
  * Generate fragments with distributed confidence.
  * 
  * \param numFragments Number of fragments to generate
- * \return Fragment collection
+ * \param payloadPool Pool receiving the fragment payloads
+ * \return Fragment collection (payloads shared with payloadPool)
  */
-FragmentCollection GenerateFragments(uint32_t numFragments);
+FragmentCollection GenerateFragments(uint32_t numFragments, FragmentPayloadPool& payloadPool);
 
 } // namespace routing
 } // namespace scenario5
@@ -1,8 +1,13 @@
 #include "cell-cooperation.h"
 #include "ground-node-routing.h"
+#include "confidence-fusion.h"
+#include "../trace-policy.h"
+#include "../../../wsn-metrics.h"
+#include "../../../wsn-profiler.h"
 #include "../helper/calc-utils.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include <vector>
 #include "../../../../examples/scenarios/scenario5/scenario5-params.h"
 
 namespace ns3 {
@@ -15,7 +20,55 @@ namespace routing {
 
 static constexpr double kCooperationThreshold = 0.35;
 
-void InitializeCellCooperation() {}
+// Union of fragment IDs held by the members of each cell, indexed by the
+// dense cell index of GetHexCellIndex()
+static std::vector<FragmentBitset> g_cellHeldUnion;
+
+// Registry metrics (wsn-metrics.h)
+static const Counter g_metricFragmentsShared("cooperation.fragments_shared");
+static const Counter g_metricRequestsSent("cooperation.requests_sent");
+
+static void
+UnionIntoNodeCell(uint32_t nodeId, const FragmentBitset& ids)
+{
+    const uint32_t cell = GetHexCellIndex().GetCellIndexOfNode(nodeId);
+    if (cell < g_cellHeldUnion.size())
+    {
+        g_cellHeldUnion[cell].UnionWith(ids);
+    }
+}
+
+void
+InitializeCellCooperation()
+{
+    const helper::HexCellIndex& cellIndex = GetHexCellIndex();
+    g_cellHeldUnion.assign(cellIndex.GetNumCells(), FragmentBitset());
+
+    for (uint32_t cell = 0; cell < cellIndex.GetNumCells(); ++cell)
+    {
+        for (uint32_t memberId : cellIndex.GetMembers(cell))
+        {
+            auto it = g_groundNetworkPerNode.find(memberId);
+            if (it != g_groundNetworkPerNode.end())
+            {
+                g_cellHeldUnion[cell].UnionWith(it->second.fragments.GetHeldIds());
+            }
+        }
+    }
+
+    NS_LOG_INFO("[CELL-COOPERATION] Indexed " << cellIndex.GetNumNodes() << " nodes in "
+                << cellIndex.GetNumCells() << " cells");
+}
+
+void
+OnCellMemberFragmentAdded(uint32_t nodeId, uint32_t fragmentId)
+{
+    const uint32_t cell = GetHexCellIndex().GetCellIndexOfNode(nodeId);
+    if (cell < g_cellHeldUnion.size())
+    {
+        g_cellHeldUnion[cell].Set(fragmentId);
+    }
+}
 
 void
 ShareFragments(uint32_t fromNode, uint32_t toNode)
@@ -24,32 +77,33 @@ ShareFragments(uint32_t fromNode, uint32_t toNode)
     {
         return;
     }
-    auto& src = g_groundNetworkPerNode[fromNode].fragments.fragments;
+    const auto& src = g_groundNetworkPerNode[fromNode].fragments;
     auto& dst = g_groundNetworkPerNode[toNode].fragments;
     uint32_t mergedCount = 0;
+    ConfidenceFusionEngine& fusion = GetGroundConfidenceFusion();
+    const auto& linkRssi = g_groundNetworkPerNode[toNode].neighborRssi;
+    const auto linkIt = linkRssi.find(fromNode);
+    const double rssiDbm = (linkIt != linkRssi.end()) ? linkIt->second : kUnknownRssiDbm;
     
-    for (const auto& [id, frag] : src)
-    {
-        // Only accept fragments that destination node does not have yet
-        if (!dst.HasFragment(id))
-        {
-            dst.AddFragment(frag);
-            g_groundNetworkPerNode[toNode].fragmentLastUpdateTime[id] = Simulator::Now().GetSeconds();
-            mergedCount++;
-            // Format: srcNodeId1-S-dstNodeId1(fragId1) srcNodeId2-S-dstNodeId2(fragId2) ...
-            if (ns3::wsn::scenario5::params::g_resultFileStream)
-            {        *ns3::wsn::scenario5::params::g_resultFileStream << fromNode
-                    << "-S-" << toNode
-                    << "(" << id << ") ";
-            }
-        }
-    }
+    // Only accept fragments that destination node does not have yet
+    const FragmentBitset missing = src.GetHeldIds().AndNot(dst.GetHeldIds());
+    missing.ForEach([&](uint32_t id) {
+        const Fragment& frag = *src.GetFragment(id);
+        dst.AddFragment(frag);
+        fusion.Observe(toNode, id, frag.confidence, rssiDbm);
+        g_groundNetworkPerNode[toNode].fragmentLastUpdateTime[id] = Simulator::Now().GetSeconds();
+        mergedCount++;
+        g_metricFragmentsShared.Add();
+        // Format: srcNodeId1-S-dstNodeId1(fragId1) srcNodeId2-S-dstNodeId2(fragId2) ...
+        LogResultToken(EventLogType::FRAGMENT_SHARED, fromNode, toNode, id);
+    });
+    UnionIntoNodeCell(toNode, missing);
     
-    g_groundNetworkPerNode[toNode].confidence = dst.totalConfidence;
+    g_groundNetworkPerNode[toNode].confidence = fusion.GetConfidence(toNode);
     auto& toState = g_groundNetworkPerNode[toNode];
     toState.fragmentsReceivedFromPeers += mergedCount;
     toState.fragmentCoverageRatio = (toState.expectedFragmentCount > 0)
-                                    ? static_cast<double>(dst.fragments.size()) /
+                                    ? static_cast<double>(dst.GetCount()) /
                                           toState.expectedFragmentCount
                                     : 0.0;
     toState.lastCooperationTime = Simulator::Now().GetSeconds();
@@ -58,6 +112,8 @@ ShareFragments(uint32_t fromNode, uint32_t toNode)
 void
 RequestFragmentSharing(uint32_t nodeId, int32_t cellId)
 {
+    WSN_PROFILE_SCOPE("cooperation.RequestFragmentSharing");
+
     if (!g_groundNetworkPerNode.count(nodeId))
     {
         return;
@@ -66,37 +122,55 @@ RequestFragmentSharing(uint32_t nodeId, int32_t cellId)
 
     // Node already has full fragment set -> no need to request sharing
     if (state.expectedFragmentCount > 0 &&
-        state.fragments.fragments.size() >= state.expectedFragmentCount)
+        state.fragments.GetCount() >= state.expectedFragmentCount)
     {
         return;
     }
     
     state.cooperationRequestsSent++;
+    g_metricRequestsSent.Add();
     state.lastCooperationTime = Simulator::Now().GetSeconds();
     
-    for (const auto& [peerId, peerState] : g_groundNetworkPerNode)
+    auto tryPeer = [&](uint32_t peerId, const GroundNetworkState& peerState) {
+        if (peerId == nodeId || peerState.cellId != cellId)
+        {
+            return;
+        }
+        // Peer must hold at least one fragment this node lacks
+        if (!peerState.fragments.GetHeldIds().AnyAndNot(state.fragments.GetHeldIds()))
+        {
+            return;
+        }
+
+        state.cellPeers.insert(peerId);
+        state.peerConfidence[peerId] = peerState.confidence;
+        ShareFragments(peerId, nodeId);
+    };
+
+    const helper::HexCellIndex& cellIndex = GetHexCellIndex();
+    const uint32_t cell = cellIndex.GetCellIndex(cellId);
+    if (cell < g_cellHeldUnion.size())
     {
-        if (peerId != nodeId && peerState.cellId == cellId)
+        // Visit only this cell's members, and none at all when the cell holds
+        // nothing this node lacks
+        if (g_cellHeldUnion[cell].AnyAndNot(state.fragments.GetHeldIds()))
         {
-            bool peerHasUsefulFragment = false;
-            for (const auto& [fragId, frag] : peerState.fragments.fragments)
+            for (uint32_t peerId : cellIndex.GetMembers(cell))
             {
-                (void)frag;
-                if (!state.fragments.HasFragment(fragId))
+                auto it = g_groundNetworkPerNode.find(peerId);
+                if (it != g_groundNetworkPerNode.end())
                 {
-                    peerHasUsefulFragment = true;
-                    break;
+                    tryPeer(peerId, it->second);
                 }
             }
-
-            if (!peerHasUsefulFragment)
-            {
-                continue;
-            }
-
-            state.cellPeers.insert(peerId);
-            state.peerConfidence[peerId] = peerState.confidence;
-            ShareFragments(peerId, nodeId);
+        }
+    }
+    else
+    {
+        // Cell not indexed (no BS index yet or unpositioned node): full scan
+        for (const auto& [peerId, peerState] : g_groundNetworkPerNode)
+        {
+            tryPeer(peerId, peerState);
         }
     }
     // Format: [EVENT] time | event=RequestFragmentSharing | nodeId=... | cellId=... | confidence=... | fragments= fragId1 fragId2 ...
@@ -107,8 +181,8 @@ RequestFragmentSharing(uint32_t nodeId, int32_t cellId)
             << " | cellId=" << cellId
             << " | confidence=" << state.confidence
             << " | fragments=";
-        for (const auto& [fragId, frag] : state.fragments.fragments)
-        {             *ns3::wsn::scenario5::params::g_resultFileStream << fragId << " ";
+        for (const auto& frag : state.fragments)
+        {             *ns3::wsn::scenario5::params::g_resultFileStream << frag.fragmentId << " ";
         }
         *ns3::wsn::scenario5::params::g_resultFileStream << "\n";
     }
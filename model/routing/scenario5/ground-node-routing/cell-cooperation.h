@@ -8,7 +8,21 @@ namespace wsn {
 namespace scenario5 {
 namespace routing {
 
+/**
+ * Build the per-cell union of held fragment IDs from current holdings.
+ *
+ * Cells follow GetHexCellIndex(), so call this once the BS has built it.
+ */
 void InitializeCellCooperation();
+
+/**
+ * Keep the cell union current after a node gains a fragment.
+ *
+ * \param nodeId Node that now holds the fragment
+ * \param fragmentId Fragment ID
+ */
+void OnCellMemberFragmentAdded(uint32_t nodeId, uint32_t fragmentId);
+
 void RequestFragmentSharing(uint32_t nodeId, int32_t cellId);
 void ShareFragments(uint32_t fromNode, uint32_t toNode);
 
@@ -17,4 +31,4 @@ void ShareFragments(uint32_t fromNode, uint32_t toNode);
 } // namespace wsn
 } // namespace ns3
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,338 @@
+/*
+ * Scenario 5 - Confidence Fusion Implementation
+ */
+
+#include "confidence-fusion.h"
+#include "../../../../examples/scenarios/scenario5/scenario5-params.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+namespace {
+
+// Keeps log(1 - c) and logit(c) finite at c = 0 or 1
+constexpr double kConfidenceEpsilon = 1e-9;
+
+double
+ClampOpen(double p)
+{
+    return std::clamp(p, kConfidenceEpsilon, 1.0 - kConfidenceEpsilon);
+}
+
+double
+Logit(double p)
+{
+    p = ClampOpen(p);
+    return std::log(p / (1.0 - p));
+}
+
+} // namespace
+
+// ===== Policies =====
+
+double
+ConfidenceFusionPolicy::Accumulate(const double* confidence, const double* rssiDbm, size_t n) const
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += Term(confidence[i], rssiDbm[i]);
+    }
+    return sum;
+}
+
+double
+SumFusionPolicy::Term(double confidence, double /*rssiDbm*/) const
+{
+    return confidence;
+}
+
+double
+SumFusionPolicy::Accumulate(const double* confidence, const double* /*rssiDbm*/, size_t n) const
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += confidence[i];
+    }
+    return sum;
+}
+
+double
+SumFusionPolicy::Finalize(double accumulator) const
+{
+    return accumulator;
+}
+
+std::string
+SumFusionPolicy::GetName() const
+{
+    return "sum";
+}
+
+double
+NoisyOrFusionPolicy::Term(double confidence, double /*rssiDbm*/) const
+{
+    return std::log1p(-std::min(std::max(confidence, 0.0), 1.0 - kConfidenceEpsilon));
+}
+
+double
+NoisyOrFusionPolicy::Finalize(double accumulator) const
+{
+    return -std::expm1(accumulator);
+}
+
+std::string
+NoisyOrFusionPolicy::GetName() const
+{
+    return "noisy-or";
+}
+
+LogOddsFusionPolicy::LogOddsFusionPolicy(double prior)
+    : m_priorLogOdds(Logit(prior))
+{
+}
+
+double
+LogOddsFusionPolicy::Term(double confidence, double /*rssiDbm*/) const
+{
+    return Logit(confidence) - m_priorLogOdds;
+}
+
+double
+LogOddsFusionPolicy::Finalize(double accumulator) const
+{
+    return 1.0 / (1.0 + std::exp(-(m_priorLogOdds + accumulator)));
+}
+
+std::string
+LogOddsFusionPolicy::GetName() const
+{
+    return "log-odds";
+}
+
+RssiWeightedFusionPolicy::RssiWeightedFusionPolicy(double floorDbm, double ceilingDbm)
+    : m_floorDbm(floorDbm),
+      m_ceilingDbm(std::max(ceilingDbm, floorDbm + 1e-6))
+{
+}
+
+double
+RssiWeightedFusionPolicy::Term(double confidence, double rssiDbm) const
+{
+    if (std::isnan(rssiDbm))
+    {
+        return confidence;
+    }
+    const double weight =
+        std::clamp((rssiDbm - m_floorDbm) / (m_ceilingDbm - m_floorDbm), 0.0, 1.0);
+    return confidence * weight;
+}
+
+double
+RssiWeightedFusionPolicy::Finalize(double accumulator) const
+{
+    return accumulator;
+}
+
+std::string
+RssiWeightedFusionPolicy::GetName() const
+{
+    return "rssi-weighted";
+}
+
+std::unique_ptr<ConfidenceFusionPolicy>
+CreateConfidenceFusionPolicy(ConfidenceFusionType type)
+{
+    switch (type)
+    {
+        case ConfidenceFusionType::NOISY_OR:
+            return std::make_unique<NoisyOrFusionPolicy>();
+        case ConfidenceFusionType::LOG_ODDS:
+            return std::make_unique<LogOddsFusionPolicy>(
+                ::ns3::wsn::scenario5::params::CONFIDENCE_FUSION_LOG_ODDS_PRIOR);
+        case ConfidenceFusionType::RSSI_WEIGHTED:
+            return std::make_unique<RssiWeightedFusionPolicy>(
+                ::ns3::wsn::scenario5::params::CONFIDENCE_FUSION_RSSI_FLOOR_DBM,
+                ::ns3::wsn::scenario5::params::CONFIDENCE_FUSION_RSSI_CEILING_DBM);
+        case ConfidenceFusionType::SUM:
+        default:
+            return std::make_unique<SumFusionPolicy>();
+    }
+}
+
+std::unique_ptr<ConfidenceFusionPolicy>
+CreateDefaultConfidenceFusionPolicy()
+{
+    return CreateConfidenceFusionPolicy(static_cast<ConfidenceFusionType>(
+        ::ns3::wsn::scenario5::params::CONFIDENCE_FUSION_POLICY));
+}
+
+// ===== ConfidenceFusionEngine =====
+
+ConfidenceFusionEngine::ConfidenceFusionEngine()
+    : m_policy(std::make_unique<SumFusionPolicy>()),
+      m_numFragments(0)
+{
+}
+
+void
+ConfidenceFusionEngine::Reset(uint32_t numFragments)
+{
+    m_nodes.clear();
+    m_numFragments = numFragments;
+}
+
+void
+ConfidenceFusionEngine::SetPolicy(std::unique_ptr<ConfidenceFusionPolicy> policy)
+{
+    if (!policy)
+    {
+        return;
+    }
+    m_policy = std::move(policy);
+    Rebuild();
+}
+
+const ConfidenceFusionPolicy&
+ConfidenceFusionEngine::GetPolicy() const
+{
+    return *m_policy;
+}
+
+ConfidenceFusionEngine::NodeObservations&
+ConfidenceFusionEngine::GetNode(uint32_t nodeId)
+{
+    if (nodeId >= m_nodes.size())
+    {
+        m_nodes.resize(nodeId + 1);
+    }
+    NodeObservations& node = m_nodes[nodeId];
+    if (node.slotOfFragment.empty() && m_numFragments > 0)
+    {
+        node.slotOfFragment.assign(m_numFragments, kNoSlot);
+        node.confidence.reserve(m_numFragments);
+        node.rssiDbm.reserve(m_numFragments);
+        node.term.reserve(m_numFragments);
+    }
+    return node;
+}
+
+double
+ConfidenceFusionEngine::Observe(uint32_t nodeId,
+                                uint32_t fragmentId,
+                                double confidence,
+                                double rssiDbm)
+{
+    NodeObservations& node = GetNode(nodeId);
+    if (fragmentId >= node.slotOfFragment.size())
+    {
+        node.slotOfFragment.resize(fragmentId + 1, kNoSlot);
+    }
+
+    const double term = m_policy->Term(confidence, rssiDbm);
+    uint32_t& slot = node.slotOfFragment[fragmentId];
+    if (slot == kNoSlot)
+    {
+        slot = static_cast<uint32_t>(node.confidence.size());
+        node.confidence.push_back(confidence);
+        node.rssiDbm.push_back(rssiDbm);
+        node.term.push_back(term);
+        node.accumulator += term;
+    }
+    else
+    {
+        node.accumulator += term - node.term[slot];
+        node.confidence[slot] = confidence;
+        node.rssiDbm[slot] = rssiDbm;
+        node.term[slot] = term;
+    }
+    return m_policy->Finalize(node.accumulator);
+}
+
+double
+ConfidenceFusionEngine::GetConfidence(uint32_t nodeId) const
+{
+    if (nodeId >= m_nodes.size() || m_nodes[nodeId].confidence.empty())
+    {
+        return 0.0;
+    }
+    return m_policy->Finalize(m_nodes[nodeId].accumulator);
+}
+
+uint32_t
+ConfidenceFusionEngine::GetObservationCount(uint32_t nodeId) const
+{
+    return (nodeId < m_nodes.size()) ? static_cast<uint32_t>(m_nodes[nodeId].confidence.size())
+                                     : 0;
+}
+
+void
+ConfidenceFusionEngine::Rebuild()
+{
+    for (NodeObservations& node : m_nodes)
+    {
+        node.accumulator = 0.0;
+        for (size_t i = 0; i < node.confidence.size(); ++i)
+        {
+            node.term[i] = m_policy->Term(node.confidence[i], node.rssiDbm[i]);
+            node.accumulator += node.term[i];
+        }
+    }
+}
+
+void
+ConfidenceFusionEngine::Recompute(const ConfidenceFusionPolicy& policy,
+                                  std::vector<uint32_t>& nodeIds,
+                                  std::vector<double>& confidences) const
+{
+    nodeIds.clear();
+    confidences.clear();
+    for (uint32_t nodeId = 0; nodeId < m_nodes.size(); ++nodeId)
+    {
+        const NodeObservations& node = m_nodes[nodeId];
+        if (node.confidence.empty())
+        {
+            continue;
+        }
+        const double accumulator =
+            policy.Accumulate(node.confidence.data(), node.rssiDbm.data(), node.confidence.size());
+        nodeIds.push_back(nodeId);
+        confidences.push_back(policy.Finalize(accumulator));
+    }
+}
+
+std::vector<uint32_t>
+ConfidenceFusionEngine::CountNodesAtOrAbove(const ConfidenceFusionPolicy& policy,
+                                            const std::vector<double>& thresholds) const
+{
+    std::vector<uint32_t> nodeIds;
+    std::vector<double> confidences;
+    Recompute(policy, nodeIds, confidences);
+    std::sort(confidences.begin(), confidences.end());
+
+    std::vector<uint32_t> counts;
+    counts.reserve(thresholds.size());
+    for (double threshold : thresholds)
+    {
+        auto it = std::lower_bound(confidences.begin(), confidences.end(), threshold);
+        counts.push_back(static_cast<uint32_t>(confidences.end() - it));
+    }
+    return counts;
+}
+
+ConfidenceFusionEngine&
+GetGroundConfidenceFusion()
+{
+    static ConfidenceFusionEngine engine;
+    return engine;
+}
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
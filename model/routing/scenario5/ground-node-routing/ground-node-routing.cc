@@ -6,7 +6,14 @@
 #include "../packet-header.h"
 #include "../helper/calc-utils.h"
 #include "../node-routing.h"
+#include "../base-station-node/fragment-generator.h"
 #include "cell-cooperation.h"
+#include "ground-node-timers.h"
+#include "confidence-fusion.h"
+#include "../trace-policy.h"
+#include "../../../wsn-metrics.h"
+#include "../../../wsn-profiler.h"
+#include "../../../wsn-log.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/mobility-model.h"
@@ -28,15 +35,67 @@ std::map<uint32_t, GroundNetworkState> g_groundNetworkPerNode;
 GlobalTopology g_latestTopologySnapshot;
 bool g_hasLatestTopologySnapshot = false;
 
+// Registry metrics (wsn-metrics.h)
+static const Counter g_metricRxPackets("ground.rx_packets");
+static const Counter g_metricFragmentsReceived("ground.fragments_received");
+static const Counter g_metricFragmentsDuplicate("ground.fragments_duplicate");
+static const Counter g_metricCodedSymbols("ground.coded_symbols_received");
+static const Counter g_metricCodedSymbolsDuplicate("ground.coded_symbols_duplicate");
+static const Counter g_metricFragmentsDecoded("ground.fragments_decoded");
+static const LatencyHistogram g_metricAlertLatency("ground.fragment_to_alert_latency", "us");
+
+// Per node: first fragment arrival (< 0 = none yet) and whether the
+// fragment-to-alert latency has been recorded
+static std::vector<double> g_firstFragmentTime;
+static std::vector<uint8_t> g_alertLatencyRecorded;
+
+/**
+ * Track the time from a node's first fragment until its confidence first
+ * reaches ALERT_THRESHOLD.
+ *
+ * \param nodeId Ground node ID
+ * \param confidence Node confidence after the update
+ * \param now Current time (s)
+ */
+static void
+TrackAlertLatency(uint32_t nodeId, double confidence, double now)
+{
+    if (nodeId >= g_firstFragmentTime.size())
+    {
+        g_firstFragmentTime.resize(nodeId + 1, -1.0);
+        g_alertLatencyRecorded.resize(nodeId + 1, 0);
+    }
+    if (g_firstFragmentTime[nodeId] < 0.0)
+    {
+        g_firstFragmentTime[nodeId] = now;
+    }
+    if (!g_alertLatencyRecorded[nodeId] &&
+        confidence >= ::ns3::wsn::scenario5::params::ALERT_THRESHOLD)
+    {
+        g_alertLatencyRecorded[nodeId] = 1;
+        g_metricAlertLatency.RecordSeconds(now - g_firstFragmentTime[nodeId]);
+    }
+}
+
+static void OnCooperationTimeout(uint32_t nodeId);
+
 void
 InitializeGroundNodeRouting(NodeContainer nodes, uint32_t numFragments)
 {
     NS_LOG_FUNCTION(nodes.GetN() << numFragments);
+
+    ResetGroundTimers();
+    SetGroundTimerHandler(GroundTimerType::COOPERATION_TIMEOUT, &OnCooperationTimeout);
+    GetGroundConfidenceFusion().Reset(numFragments);
+    GetGroundConfidenceFusion().SetPolicy(CreateDefaultConfidenceFusionPolicy());
+    g_firstFragmentTime.clear();
+    g_alertLatencyRecorded.clear();
     
     // Initialize state for each ground node
     for (uint32_t i = 0; i < nodes.GetN(); ++i) {
         Ptr<Node> node = nodes.Get(i);
         uint32_t nodeId = node->GetId();
+        SetNodeRole(nodeId, NodeRole::GROUND);
         
         GroundNetworkState state;
         
@@ -50,13 +109,17 @@ InitializeGroundNodeRouting(NodeContainer nodes, uint32_t numFragments)
         state.lastSyncTime = 0.0;
         
         // === Fragment Management ===
-        state.fragments.fragments.clear();
+        state.fragments.Clear();
+        state.fragments.Reserve(numFragments);
         state.confidence = 0.0; // Tính toán sau khi nhận fragment
         state.expectedFragmentCount = numFragments;
         state.fragmentCoverageRatio = 0.0;
         state.fragmentsReceivedFromUav = 0;
         state.fragmentsReceivedFromPeers = 0;
         state.duplicateFragmentsDiscarded = 0;
+        state.codedSymbolsHeld.Clear();
+        state.codedSymbolsReceived = 0;
+        state.fragmentsDecoded = 0;
         
         // === Neighbor Discovery ===
         state.startupComplete = false;
@@ -119,20 +182,162 @@ InitializeGroundNodeRouting(NodeContainer nodes, uint32_t numFragments)
     NS_LOG_INFO("Ground node routing initialized for " << nodes.GetN() << " nodes");
 }
 
+/**
+ * Refresh confidence and coverage after fragments were added, and complete
+ * the UAV2 mission early when the suspicious seed node reaches alert level.
+ */
+static void
+OnFragmentsChanged(uint32_t nodeId, GroundNetworkState& state)
+{
+    state.confidence = GetGroundConfidenceFusion().GetConfidence(nodeId);
+    TrackAlertLatency(nodeId, state.confidence, Simulator::Now().GetSeconds());
+    state.fragmentCoverageRatio = (state.expectedFragmentCount > 0)
+                                  ? static_cast<double>(state.fragments.GetCount()) /
+                                        state.expectedFragmentCount
+                                  : 0.0;
+
+    // A complete node has nothing left to ask its cell for
+    if (state.expectedFragmentCount > 0 &&
+        state.fragments.GetCount() >= state.expectedFragmentCount)
+    {
+        CancelGroundTimer(nodeId, GroundTimerType::COOPERATION_TIMEOUT);
+    }
+
+    // Early-complete UAV2 mission when suspicious-point node reaches alert threshold.
+    const uint32_t suspiciousSeedNodeId = GetSuspiciousSeedNodeId();
+    if (suspiciousSeedNodeId != std::numeric_limits<uint32_t>::max() &&
+        nodeId == suspiciousSeedNodeId &&
+        state.confidence >= ::ns3::wsn::scenario5::params::ALERT_THRESHOLD)
+    {
+        MarkUav2MissionCompleted(nodeId, state.confidence);
+    }
+}
+
+/**
+ * Cooperation timeout: ask the cell for the fragments still missing.
+ */
+static void
+OnCooperationTimeout(uint32_t nodeId)
+{
+    if (g_groundNetworkPerNode.find(nodeId) == g_groundNetworkPerNode.end())
+        return;
+    
+    auto& state = g_groundNetworkPerNode[nodeId];
+    const bool hasAllFragments =
+        (state.expectedFragmentCount > 0) &&
+        (state.fragments.GetCount() >= state.expectedFragmentCount);
+    if (state.cooperationEnabled && state.cellId >= 0 && !hasAllFragments)
+    {
+        NS_LOG_INFO("Node " << nodeId << " cooperation timeout triggered"
+                   << " | confidence=" << state.confidence);
+        RequestFragmentSharing(nodeId, state.cellId);
+    }
+}
+
+/**
+ * Schedule the per-node cooperation timeout (once, after the first update).
+ */
+static void
+ScheduleCooperationTimeout(uint32_t nodeId, GroundNetworkState& state, double now)
+{
+    if (!state.cooperationEnabled || state.cooperationTimeoutScheduled)
+    {
+        return;
+    }
+
+    // Timeout = 2 × fragment broadcast interval to ensure all fragments arrive
+    const double cooperationDelay = 2.0 * ns3::wsn::scenario5::params::FRAGMENT_BROADCAST_INTERVAL;
+    const double timeoutTime = now + cooperationDelay;
+    
+    state.cooperationTimeoutScheduled = true;
+    state.cooperationTimeoutTime = timeoutTime;
+    
+    NS_LOG_DEBUG("Node " << nodeId << " scheduled cooperation timeout"
+                << " | delay=" << cooperationDelay << "s"
+                << " | timeout_at=" << timeoutTime << "s");
+    
+    // Shared timer wheel: nodes timing out in the same tick run in one event
+    ScheduleGroundTimer(nodeId, GroundTimerType::COOPERATION_TIMEOUT, cooperationDelay);
+}
+
+/**
+ * Recover the missing fragments once any k distinct coded symbols are held
+ * (source fragments from any origin count as their own symbols).
+ *
+ * \return number of fragments added
+ */
+static uint32_t
+TryDecodeFragments(uint32_t nodeId, GroundNetworkState& state, double now)
+{
+    const CodedFragmentSet& coded = GetBsCodedFragments();
+    if (!coded.IsBuilt())
+    {
+        return 0;
+    }
+    const uint32_t k = coded.GetSourceCount();
+    if (state.fragments.GetCount() >= k ||
+        state.fragments.GetCount() + state.codedSymbolsHeld.Count() < k)
+    {
+        return 0;
+    }
+
+    FragmentBitset heldSymbols = state.codedSymbolsHeld;
+    heldSymbols.UnionWith(state.fragments.GetHeldIds());
+    std::vector<Fragment> recovered;
+    if (!coded.Decode(heldSymbols, recovered))
+    {
+        return 0;
+    }
+
+    uint32_t added = 0;
+    for (const Fragment& frag : recovered)
+    {
+        if (state.fragments.HasFragment(frag.fragmentId))
+        {
+            continue;
+        }
+        state.fragments.AddFragment(frag);
+        GetGroundConfidenceFusion().Observe(nodeId, frag.fragmentId, frag.confidence, kUnknownRssiDbm);
+        OnCellMemberFragmentAdded(nodeId, frag.fragmentId);
+        state.fragmentLastUpdateTime[frag.fragmentId] = now;
+        added++;
+    }
+    state.fragmentsDecoded += added;
+    g_metricFragmentsDecoded.Add(added);
+    OnFragmentsChanged(nodeId, state);
+
+    NS_LOG_INFO("Node " << nodeId << " decoded " << added << " fragments from "
+                << heldSymbols.Count() << " symbols");
+
+    // Format: [EVENT] time | event=FragmentDecode | nodeId=... | recovered=... | confidence=...
+    if (ns3::wsn::scenario5::params::g_resultFileStream)
+    {
+        *ns3::wsn::scenario5::params::g_resultFileStream << "\n[EVENT] " << now
+            << " | event=FragmentDecode"
+            << " | nodeId=" << nodeId
+            << " | recovered=" << added
+            << " | confidence=" << state.confidence << "\n";
+    }
+    return added;
+}
+
 void
 OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssiDbm)
 {
-    NS_LOG_FUNCTION(nodeId << packet->GetSize() << rssiDbm);
+    WSN_HOT_LOG_FUNCTION(HOT_LOG_RX, nodeId << packet->GetSize() << rssiDbm);
+    WSN_PROFILE_SCOPE("ground.OnGroundNodeReceivePacket");
     
-    if (g_groundNetworkPerNode.find(nodeId) == g_groundNetworkPerNode.end()) {
-        NS_LOG_WARN("Node " << nodeId << " not initialized");
+    auto stateIt = g_groundNetworkPerNode.find(nodeId);
+    if (stateIt == g_groundNetworkPerNode.end()) {
+        WSN_HOT_LOG_WARN(HOT_LOG_RX, "Node " << nodeId << " not initialized");
         return;
     }
     
-    GroundNetworkState& state = g_groundNetworkPerNode[nodeId];
+    GroundNetworkState& state = stateIt->second;
     
     // Update statistics
     state.packetCount++;
+    g_metricRxPackets.Add();
     state.totalBytesReceived += packet->GetSize();
     state.lastActivityTime = Simulator::Now().GetSeconds();
     state.lastPacketRssiDbm = rssiDbm;
@@ -147,14 +352,21 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
     state.energyConsumedRx += rxEnergyCost;
     state.remainingEnergy = std::max(0.0, state.remainingEnergy - rxEnergyCost);
     
-    // Try to extract packet header
-    Ptr<Packet> copy = packet->Copy();
-    PacketHeader header;
-    copy->RemoveHeader(header);
+    // Peek type (and fragment fields) in one pass on the const packet; only
+    // the other packet types pay for a copy
+    FragmentPacketView view;
+    packet->PeekHeader(view);
+    Ptr<Packet> copy;
+    if (view.GetType() != PACKET_TYPE_FRAGMENT)
+    {
+        copy = packet->Copy();
+        PacketHeader header;
+        copy->RemoveHeader(header);
+    }
     
-    switch (header.GetType()) {
+    switch (view.GetType()) {
         case PACKET_TYPE_STARTUP:
-            NS_LOG_DEBUG("Node " << nodeId << " received STARTUP packet");
+            WSN_HOT_LOG_DEBUG(HOT_LOG_RX, "Node " << nodeId << " received STARTUP packet");
             state.startupPacketsReceived++;
             {
                 StartupPhasePacket startupPkt;
@@ -176,36 +388,29 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
             break;
             
         case PACKET_TYPE_FRAGMENT:
-            NS_LOG_DEBUG("Node " << nodeId << " received FRAGMENT packet");
+            WSN_HOT_LOG_DEBUG(HOT_LOG_RX, "Node " << nodeId << " received FRAGMENT packet");
             state.fragmentPacketsReceived++;
 
             // Handle fragment reception
             {
-                FragmentPacket fragPkt;
-                if (copy->RemoveHeader(fragPkt) == 0)
+                if (!view.IsFragment())
                 {
-                    NS_LOG_WARN("Node " << nodeId << " received malformed FRAGMENT packet");
+                    WSN_HOT_LOG_WARN(HOT_LOG_RX, "Node " << nodeId << " received malformed FRAGMENT packet");
                     break;
                 }
                 
+                const FragmentPacket& fragPkt = view.GetFragment();
                 uint32_t fragId = fragPkt.GetFragmentId();
+                if (fragId >= state.expectedFragmentCount)
+                {
+                    WSN_HOT_LOG_WARN(HOT_LOG_RX, "Node " << nodeId << " dropped fragment " << fragId
+                                                 << " (expected < " << state.expectedFragmentCount << ")");
+                    break;
+                }
                 double confidence = std::clamp(fragPkt.GetConfidence(), 0.0, 1.0);
                 uint32_t srcNodeId = fragPkt.GetSourceId();
                 const double now = Simulator::Now().GetSeconds();
-
-                bool fromUav = false;
-                if (srcNodeId < NodeList::GetNNodes())
-                {
-                    Ptr<Node> srcNode = NodeList::GetNode(srcNodeId);
-                    if (srcNode)
-                    {
-                        Ptr<MobilityModel> srcMobility = srcNode->GetObject<MobilityModel>();
-                        if (srcMobility)
-                        {
-                            fromUav = srcMobility->GetPosition().z > 1.0;
-                        }
-                    }
-                }
+                const bool fromUav = IsUavNode(srcNodeId);
                 
                 // Update fragment if new or higher confidence
                 bool updated = false;
@@ -215,15 +420,14 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
                     Fragment frag;
                     frag.fragmentId = fragId;
                     frag.confidence = confidence;
-                    frag.size = copy->GetSize();
+                    frag.size = packet->GetSize() - view.GetSerializedSize();
+                    frag.payload = GetBsFragmentPayloadPool().Get(fragId);
                     
                     state.fragments.AddFragment(frag);
-                    state.confidence = state.fragments.totalConfidence;
+                    GetGroundConfidenceFusion().Observe(nodeId, fragId, confidence, rssiDbm);
+                    OnCellMemberFragmentAdded(nodeId, fragId);
                     state.fragmentLastUpdateTime[fragId] = now;
-                    state.fragmentCoverageRatio = (state.expectedFragmentCount > 0)
-                                                  ? static_cast<double>(state.fragments.fragments.size()) /
-                                                        state.expectedFragmentCount
-                                                  : 0.0;
+                    OnFragmentsChanged(nodeId, state);
                     
                     if (fromUav)
                     {
@@ -236,68 +440,80 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
                         state.fragmentsReceivedFromPeers++;
                     }
                     updated = true;
-
-                    // Early-complete UAV2 mission when suspicious-point node reaches alert threshold.
-                    const uint32_t suspiciousSeedNodeId = GetSuspiciousSeedNodeId();
-                    if (suspiciousSeedNodeId != std::numeric_limits<uint32_t>::max() &&
-                        nodeId == suspiciousSeedNodeId &&
-                        state.confidence >= ::ns3::wsn::scenario5::params::ALERT_THRESHOLD)
-                    {
-                        MarkUav2MissionCompleted(nodeId, state.confidence);
-                    }
                     
-                    NS_LOG_INFO("Node " << nodeId << " updated fragment " << fragId 
-                                << " with confidence " << confidence);
+                    WSN_HOT_LOG_INFO(HOT_LOG_RX, "Node " << nodeId << " updated fragment " << fragId 
+                                                 << " with confidence " << confidence);
                 }
                 else
                 {
                     state.duplicateFragmentsDiscarded++;
+                    g_metricFragmentsDuplicate.Add();
                 }
 
                 // Format: srcNodeId1-R-nodeId1 (fragId1) srcNodeId2-R-nodeId2 (fragId2) ...
-                if (ns3::wsn::scenario5::params::g_resultFileStream)
+                LogResultToken(EventLogType::FRAGMENT_RECEIVED, srcNodeId, nodeId, fragId);
+                g_metricFragmentsReceived.Add();
+
+                if (updated)
                 {
-                    *ns3::wsn::scenario5::params::g_resultFileStream << srcNodeId
-                        << "-R-" << nodeId
-                        << "(" << fragId << ") ";
+                    TryDecodeFragments(nodeId, state, now);
+
+                    // Schedule per-node cooperation timeout after first fragment
+                    ScheduleCooperationTimeout(nodeId, state, now);
                 }
+            }
+            break;
+            
+        case PACKET_TYPE_CODED_SYMBOL:
+            WSN_HOT_LOG_DEBUG(HOT_LOG_RX, "Node " << nodeId << " received CODED_SYMBOL packet");
+            state.fragmentPacketsReceived++;
 
-                // Schedule per-node cooperation timeout after first fragment
-                if (state.cooperationEnabled && updated && !state.cooperationTimeoutScheduled)
+            {
+                CodedSymbolPacket symbolPkt;
+                if (copy->RemoveHeader(symbolPkt) == 0)
                 {
-                    // Timeout = 2 × fragment broadcast interval to ensure all fragments arrive
-                    const double cooperationDelay = 2.0 * ns3::wsn::scenario5::params::FRAGMENT_BROADCAST_INTERVAL;
-                    const double timeoutTime = now + cooperationDelay;
-                    
-                    state.cooperationTimeoutScheduled = true;
-                    state.cooperationTimeoutTime = timeoutTime;
-                    
-                    NS_LOG_DEBUG("Node " << nodeId << " scheduled cooperation timeout"
-                                << " | delay=" << cooperationDelay << "s"
-                                << " | timeout_at=" << timeoutTime << "s");
-                    
-                    // Schedule timeout callback
-                    Simulator::Schedule(Seconds(cooperationDelay), [nodeId]() {
-                        if (g_groundNetworkPerNode.find(nodeId) == g_groundNetworkPerNode.end())
-                            return;
-                        
-                        auto& state = g_groundNetworkPerNode[nodeId];
-                        const bool hasAllFragments =
-                            (state.expectedFragmentCount > 0) &&
-                            (state.fragments.fragments.size() >= state.expectedFragmentCount);
-                        if (state.cooperationEnabled && state.cellId >= 0 && !hasAllFragments)
-                        {
-                            NS_LOG_INFO("Node " << nodeId << " cooperation timeout triggered"
-                                       << " | confidence=" << state.confidence);
-                            RequestFragmentSharing(nodeId, state.cellId);
-                        }
-                    });
+                    WSN_HOT_LOG_WARN(HOT_LOG_RX, "Node " << nodeId << " received malformed CODED_SYMBOL packet");
+                    break;
+                }
+
+                const uint32_t symbolIndex = symbolPkt.GetSymbolIndex();
+                const uint32_t srcNodeId = symbolPkt.GetSourceId();
+                const double now = Simulator::Now().GetSeconds();
+                const CodedFragmentSet& coded = GetBsCodedFragments();
+                if (!coded.IsBuilt() || symbolPkt.GetSourceCount() != coded.GetSourceCount() ||
+                    symbolIndex < coded.GetSourceCount() || symbolIndex >= coded.GetSymbolCount())
+                {
+                    WSN_HOT_LOG_WARN(HOT_LOG_RX, "Node " << nodeId << " received symbol " << symbolIndex
+                                                 << " outside the current code");
+                    break;
+                }
+
+                // Format: srcNodeId1-C-nodeId1(symbol1) ...
+                LogResultToken(EventLogType::CODED_SYMBOL_RECEIVED, srcNodeId, nodeId, symbolIndex);
+
+                // Symbols are useless once every fragment is held
+                if (state.codedSymbolsHeld.Test(symbolIndex) ||
+                    state.fragments.GetCount() >= coded.GetSourceCount())
+                {
+                    state.duplicateFragmentsDiscarded++;
+                    g_metricCodedSymbolsDuplicate.Add();
+                    break;
+                }
+                state.codedSymbolsHeld.Set(symbolIndex);
+                state.codedSymbolsReceived++;
+                g_metricCodedSymbols.Add();
+                state.lastUavContactTime = now;
+                state.uavEncounters++;
+
+                if (TryDecodeFragments(nodeId, state, now) > 0)
+                {
+                    ScheduleCooperationTimeout(nodeId, state, now);
                 }
             }
             break;
-            
+
         case PACKET_TYPE_COOPERATION:
-            NS_LOG_DEBUG("Node " << nodeId << " received COOPERATION packet");
+            WSN_HOT_LOG_DEBUG(HOT_LOG_RX, "Node " << nodeId << " received COOPERATION packet");
             state.cooperationPacketsReceived++;
             state.cooperationRequestsReceived++;
             state.lastCooperationTime = Simulator::Now().GetSeconds();
@@ -305,7 +521,7 @@ OnGroundNodeReceivePacket(uint32_t nodeId, Ptr<const Packet> packet, double rssi
             break;
             
         default:
-            NS_LOG_WARN("Node " << nodeId << " received unknown packet type");
+            WSN_HOT_LOG_WARN(HOT_LOG_RX, "Node " << nodeId << " received unknown packet type");
             break;
     }
 }
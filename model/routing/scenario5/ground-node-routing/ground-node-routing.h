@@ -54,13 +54,16 @@ struct GroundNetworkState
     
     // === Fragment Management ===
     FragmentCollection fragments;             // Collection của các fragment node đang giữ
-    double confidence;                        // Tổng confidence = fragments.totalConfidence
+    double confidence;                        // Confidence hợp nhất (confidence-fusion); policy SUM = fragments.GetTotalConfidence()
     uint32_t expectedFragmentCount;           // Tổng số fragment kỳ vọng trong phiên
     double fragmentCoverageRatio;             // Tỉ lệ fragment hiện có / kỳ vọng
     std::map<uint32_t, double> fragmentLastUpdateTime; // Lần cập nhật cuối của từng fragment
     uint32_t fragmentsReceivedFromUav;        // Số fragment nhận từ UAV
     uint32_t fragmentsReceivedFromPeers;      // Số fragment nhận từ cell peers (đánh giá độ hiệu quả khi có cell cooperation)
     uint32_t duplicateFragmentsDiscarded;     // Fragment trùng/không tốt hơn bị loại
+    FragmentBitset codedSymbolsHeld;          // Parity symbol đã nhận (index k..n-1, khi bật coding)
+    uint32_t codedSymbolsReceived;            // Số parity symbol mới nhận từ UAV
+    uint32_t fragmentsDecoded;                // Fragment khôi phục bằng giải mã Reed-Solomon
     
     // === Cell Cooperation ===
     std::set<uint32_t> cellPeers;             // Danh sách nodes cùng cell
@@ -0,0 +1,72 @@
+/*
+ * Scenario 5 - Ground Node Protocol Timers
+ *
+ * Per-node protocol timers on one shared timer wheel. All timers expiring
+ * in the same tick run from a single simulator event.
+ */
+
+#ifndef SCENARIO5_GROUND_NODE_TIMERS_H
+#define SCENARIO5_GROUND_NODE_TIMERS_H
+
+#include <cstdint>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+/**
+ * Kinds of per-node timer (at most one pending per node and kind).
+ */
+enum class GroundTimerType : uint8_t
+{
+    COOPERATION_TIMEOUT = 0, ///< Request cell cooperation if still incomplete
+    TOPOLOGY_REPORT = 1,     ///< Next topology report to the BS
+    LIFECYCLE = 2            ///< Next lifecycle phase transition
+};
+
+constexpr uint32_t kGroundTimerTypeCount = 3;
+
+/**
+ * Callback run when a node's timer expires.
+ */
+using GroundTimerHandler = void (*)(uint32_t nodeId);
+
+/**
+ * Set the handler of a timer kind (nullptr = expire silently).
+ */
+void SetGroundTimerHandler(GroundTimerType type, GroundTimerHandler handler);
+
+/**
+ * Schedule a node timer, replacing any pending one of the same kind.
+ *
+ * \param nodeId Ground node ID
+ * \param type Timer kind
+ * \param delaySec Delay from now; rounded up to the wheel tick
+ *        (params::GROUND_TIMER_TICK)
+ */
+void ScheduleGroundTimer(uint32_t nodeId, GroundTimerType type, double delaySec);
+
+/**
+ * \return true if a pending timer was cancelled
+ */
+bool CancelGroundTimer(uint32_t nodeId, GroundTimerType type);
+
+bool IsGroundTimerPending(uint32_t nodeId, GroundTimerType type);
+
+/**
+ * \return absolute expiry time in seconds, or -1 if not pending
+ */
+double GetGroundTimerExpiry(uint32_t nodeId, GroundTimerType type);
+
+/**
+ * Drop every pending timer (handlers are kept).
+ */
+void ResetGroundTimers();
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_GROUND_NODE_TIMERS_H
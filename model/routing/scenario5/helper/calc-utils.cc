@@ -3,7 +3,9 @@
  */
 
 #include "calc-utils.h"
+#include <algorithm>
 #include <cmath>
+#include <unordered_map>
 
 namespace ns3 {
 namespace wsn {
@@ -108,6 +110,64 @@ ComputeSuspiciousScore(double confidence, uint32_t packetCount, double rssiDbm)
     return 0.6 * confidenceScore + 0.3 * packetScore + 0.1 * rssiScore;
 }
 
+void
+BuildCoverageLists(const std::vector<double>& centerX,
+                   const std::vector<double>& centerY,
+                   const std::vector<double>& pointX,
+                   const std::vector<double>& pointY,
+                   double radius,
+                   std::vector<std::vector<uint32_t>>& outCoverage)
+{
+    outCoverage.assign(centerX.size(), std::vector<uint32_t>());
+    if (radius < 0.0 || pointX.empty())
+    {
+        return;
+    }
+
+    // Slightly enlarged cells keep every in-range point inside the 3x3 block
+    // despite rounding in the floor() division.
+    const double cellSize = std::max(radius, 1e-9) * (1.0 + 1e-9);
+    auto cellKey = [](int64_t cx, int64_t cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+               static_cast<uint32_t>(cy);
+    };
+
+    std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+    grid.reserve(pointX.size());
+    for (uint32_t i = 0; i < pointX.size(); ++i)
+    {
+        const int64_t cx = static_cast<int64_t>(std::floor(pointX[i] / cellSize));
+        const int64_t cy = static_cast<int64_t>(std::floor(pointY[i] / cellSize));
+        grid[cellKey(cx, cy)].push_back(i);
+    }
+
+    for (uint32_t c = 0; c < centerX.size(); ++c)
+    {
+        const int64_t cx = static_cast<int64_t>(std::floor(centerX[c] / cellSize));
+        const int64_t cy = static_cast<int64_t>(std::floor(centerY[c] / cellSize));
+        auto& covered = outCoverage[c];
+        for (int64_t dx = -1; dx <= 1; ++dx)
+        {
+            for (int64_t dy = -1; dy <= 1; ++dy)
+            {
+                auto it = grid.find(cellKey(cx + dx, cy + dy));
+                if (it == grid.end())
+                {
+                    continue;
+                }
+                for (uint32_t i : it->second)
+                {
+                    if (CalculateDistance(centerX[c], centerY[c], pointX[i], pointY[i]) <= radius)
+                    {
+                        covered.push_back(i);
+                    }
+                }
+            }
+        }
+        std::sort(covered.begin(), covered.end());
+    }
+}
+
 } // namespace helper
 } // namespace scenario5
 } // namespace wsn
@@ -0,0 +1,211 @@
+/*
+ * Scenario 5 - Hexagonal Cell Index Implementation
+ */
+
+#include "hex-cell-index.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace helper {
+
+namespace {
+
+constexpr int32_t kAxialDirections[HexCellIndex::kNumAxialNeighbors][2] = {
+    {+1, 0}, {+1, -1}, {0, -1}, {-1, 0}, {-1, +1}, {0, +1}};
+
+} // namespace
+
+void
+HexCellIndex::Clear()
+{
+    m_gridOffset = 0;
+    m_cellIds.clear();
+    m_coords.clear();
+    m_memberOffsets.clear();
+    m_members.clear();
+    m_cellOfNode.clear();
+    m_axialNeighbors.clear();
+    m_linkedNeighbors.clear();
+    m_cellIndexById.clear();
+}
+
+void
+HexCellIndex::Build(const std::vector<uint32_t>& nodeIds,
+                    const std::vector<HexCellCoord>& coords,
+                    int32_t gridOffset)
+{
+    Clear();
+    m_gridOffset = gridOffset;
+
+    const uint32_t nodeCount = static_cast<uint32_t>(std::min(nodeIds.size(), coords.size()));
+    if (nodeCount == 0)
+    {
+        m_memberOffsets.push_back(0);
+        return;
+    }
+
+    // Distinct cell IDs in ascending order -> dense indices.
+    std::vector<int32_t> nodeCellIds(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        nodeCellIds[i] = MakeCellId(coords[i].q, coords[i].r, gridOffset);
+    }
+
+    m_cellIds = nodeCellIds;
+    std::sort(m_cellIds.begin(), m_cellIds.end());
+    m_cellIds.erase(std::unique(m_cellIds.begin(), m_cellIds.end()), m_cellIds.end());
+
+    const uint32_t cellCount = static_cast<uint32_t>(m_cellIds.size());
+    m_cellIndexById.reserve(cellCount);
+    for (uint32_t c = 0; c < cellCount; ++c)
+    {
+        m_cellIndexById.emplace(m_cellIds[c], c);
+    }
+
+    const uint32_t maxNodeId = *std::max_element(nodeIds.begin(), nodeIds.begin() + nodeCount);
+    m_cellOfNode.assign(static_cast<size_t>(maxNodeId) + 1, kInvalidCell);
+
+    // Counting sort of nodes into CSR member arrays. Input is ascending by
+    // nodeId, so each cell's member list stays ascending.
+    std::vector<uint32_t> counts(cellCount, 0);
+    m_coords.assign(cellCount, HexCellCoord{0, 0});
+    std::vector<bool> coordSet(cellCount, false);
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        const uint32_t cell = m_cellIndexById.at(nodeCellIds[i]);
+        m_cellOfNode[nodeIds[i]] = cell;
+        counts[cell]++;
+        if (!coordSet[cell])
+        {
+            m_coords[cell] = coords[i];
+            coordSet[cell] = true;
+        }
+    }
+
+    m_memberOffsets.assign(cellCount + 1, 0);
+    std::partial_sum(counts.begin(), counts.end(), m_memberOffsets.begin() + 1);
+
+    m_members.resize(nodeCount);
+    std::vector<uint32_t> cursor(m_memberOffsets.begin(), m_memberOffsets.end() - 1);
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        m_members[cursor[m_cellOfNode[nodeIds[i]]]++] = nodeIds[i];
+    }
+
+    // Axial neighbors resolved once from (q,r).
+    m_axialNeighbors.resize(cellCount);
+    for (uint32_t c = 0; c < cellCount; ++c)
+    {
+        for (uint32_t d = 0; d < kNumAxialNeighbors; ++d)
+        {
+            const int32_t nq = m_coords[c].q + kAxialDirections[d][0];
+            const int32_t nr = m_coords[c].r + kAxialDirections[d][1];
+            m_axialNeighbors[c][d] = GetCellIndex(MakeCellId(nq, nr, gridOffset));
+        }
+    }
+
+    m_linkedNeighbors.assign(cellCount, std::vector<uint32_t>());
+}
+
+void
+HexCellIndex::AddNodeLinks(uint32_t nodeId, const std::set<uint32_t>& neighbors)
+{
+    const uint32_t cell = GetCellIndexOfNode(nodeId);
+    if (cell == kInvalidCell)
+    {
+        return;
+    }
+
+    for (uint32_t neighborId : neighbors)
+    {
+        const uint32_t neighborCell = GetCellIndexOfNode(neighborId);
+        if (neighborCell == kInvalidCell || neighborCell == cell)
+        {
+            continue;
+        }
+        m_linkedNeighbors[cell].push_back(neighborCell);
+        m_linkedNeighbors[neighborCell].push_back(cell);
+    }
+}
+
+void
+HexCellIndex::FinalizeLinks()
+{
+    for (auto& linked : m_linkedNeighbors)
+    {
+        std::sort(linked.begin(), linked.end());
+        linked.erase(std::unique(linked.begin(), linked.end()), linked.end());
+    }
+}
+
+uint32_t
+HexCellIndex::GetNumCells() const
+{
+    return static_cast<uint32_t>(m_cellIds.size());
+}
+
+uint32_t
+HexCellIndex::GetNumNodes() const
+{
+    return static_cast<uint32_t>(m_members.size());
+}
+
+uint32_t
+HexCellIndex::GetCellIndex(int32_t cellId) const
+{
+    auto it = m_cellIndexById.find(cellId);
+    return (it != m_cellIndexById.end()) ? it->second : kInvalidCell;
+}
+
+uint32_t
+HexCellIndex::GetCellIndexOfNode(uint32_t nodeId) const
+{
+    return (nodeId < m_cellOfNode.size()) ? m_cellOfNode[nodeId] : kInvalidCell;
+}
+
+int32_t
+HexCellIndex::GetCellId(uint32_t cell) const
+{
+    return m_cellIds[cell];
+}
+
+HexCellCoord
+HexCellIndex::GetCoord(uint32_t cell) const
+{
+    return m_coords[cell];
+}
+
+NodeIdRange
+HexCellIndex::GetMembers(uint32_t cell) const
+{
+    const uint32_t* base = m_members.data();
+    return NodeIdRange{base + m_memberOffsets[cell], base + m_memberOffsets[cell + 1]};
+}
+
+const std::array<uint32_t, HexCellIndex::kNumAxialNeighbors>&
+HexCellIndex::GetAxialNeighbors(uint32_t cell) const
+{
+    return m_axialNeighbors[cell];
+}
+
+const std::vector<uint32_t>&
+HexCellIndex::GetLinkedNeighbors(uint32_t cell) const
+{
+    return m_linkedNeighbors[cell];
+}
+
+bool
+HexCellIndex::InSameCell(uint32_t nodeA, uint32_t nodeB) const
+{
+    const uint32_t cellA = GetCellIndexOfNode(nodeA);
+    return cellA != kInvalidCell && cellA == GetCellIndexOfNode(nodeB);
+}
+
+} // namespace helper
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
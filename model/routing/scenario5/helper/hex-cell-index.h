@@ -0,0 +1,141 @@
+/*
+ * Scenario 5 - Hexagonal Cell Index
+ *
+ * Persistent cell index over the axial (q,r) hex grid. Built once at BS init
+ * and shared by every pass that needs cell membership or cell adjacency.
+ */
+
+#ifndef SCENARIO5_HEX_CELL_INDEX_H
+#define SCENARIO5_HEX_CELL_INDEX_H
+
+#include "calc-utils.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace helper {
+
+/**
+ * Read-only view over a contiguous range of node IDs.
+ */
+struct NodeIdRange
+{
+    const uint32_t* first;
+    const uint32_t* last;
+
+    const uint32_t* begin() const { return first; }
+    const uint32_t* end() const { return last; }
+    uint32_t size() const { return static_cast<uint32_t>(last - first); }
+    bool empty() const { return first == last; }
+    uint32_t front() const { return *first; }
+};
+
+/**
+ * Hexagonal cell index.
+ *
+ * Cells are given dense indices [0, GetNumCells()) in ascending cellId order,
+ * so iterating dense indices visits cells in the same order as a
+ * std::map<int32_t, ...> keyed by cellId. Members of each cell are stored
+ * contiguously in ascending nodeId order.
+ */
+class HexCellIndex
+{
+public:
+    static constexpr uint32_t kInvalidCell = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t kNumAxialNeighbors = 6;
+
+    /**
+     * Drop all cells, members and adjacency.
+     */
+    void Clear();
+
+    /**
+     * Build cells and member arrays.
+     *
+     * \param nodeIds Node IDs, ascending
+     * \param coords Axial coordinate of each node (same order as nodeIds)
+     * \param gridOffset Offset used by MakeCellId()
+     */
+    void Build(const std::vector<uint32_t>& nodeIds,
+               const std::vector<HexCellCoord>& coords,
+               int32_t gridOffset);
+
+    /**
+     * Record cell adjacency induced by node links.
+     *
+     * Two cells are linked when at least one member of one has a member of
+     * the other in its neighbor set. Must be called after Build().
+     *
+     * \param nodeId Node whose links are reported
+     * \param neighbors Neighbor node IDs of nodeId
+     */
+    void AddNodeLinks(uint32_t nodeId, const std::set<uint32_t>& neighbors);
+
+    /**
+     * Sort and de-duplicate linked neighbor lists after AddNodeLinks() calls.
+     */
+    void FinalizeLinks();
+
+    uint32_t GetNumCells() const;
+    uint32_t GetNumNodes() const;
+
+    /**
+     * \return dense index of cellId, or kInvalidCell
+     */
+    uint32_t GetCellIndex(int32_t cellId) const;
+
+    /**
+     * \return dense cell index of nodeId, or kInvalidCell
+     */
+    uint32_t GetCellIndexOfNode(uint32_t nodeId) const;
+
+    int32_t GetCellId(uint32_t cell) const;
+    HexCellCoord GetCoord(uint32_t cell) const;
+
+    /**
+     * \return members of the cell in ascending nodeId order
+     */
+    NodeIdRange GetMembers(uint32_t cell) const;
+
+    /**
+     * Six axial neighbors as dense indices, in direction order
+     * (+1,0) (+1,-1) (0,-1) (-1,0) (-1,+1) (0,+1).
+     * Directions without a populated cell are kInvalidCell.
+     */
+    const std::array<uint32_t, kNumAxialNeighbors>& GetAxialNeighbors(uint32_t cell) const;
+
+    /**
+     * \return dense indices of cells linked to this cell, ascending
+     */
+    const std::vector<uint32_t>& GetLinkedNeighbors(uint32_t cell) const;
+
+    /**
+     * \return true if both nodes are indexed and belong to the same cell
+     */
+    bool InSameCell(uint32_t nodeA, uint32_t nodeB) const;
+
+private:
+    int32_t m_gridOffset = 0;
+    std::vector<int32_t> m_cellIds;
+    std::vector<HexCellCoord> m_coords;
+    std::vector<uint32_t> m_memberOffsets; ///< CSR offsets, size = numCells + 1
+    std::vector<uint32_t> m_members;
+    std::vector<uint32_t> m_cellOfNode; ///< indexed by nodeId
+    std::vector<std::array<uint32_t, kNumAxialNeighbors>> m_axialNeighbors;
+    std::vector<std::vector<uint32_t>> m_linkedNeighbors;
+    std::unordered_map<int32_t, uint32_t> m_cellIndexById;
+};
+
+} // namespace helper
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_HEX_CELL_INDEX_H
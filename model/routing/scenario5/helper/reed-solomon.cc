@@ -0,0 +1,284 @@
+/*
+ * Scenario 5 - GF(256) Arithmetic and Reed-Solomon Erasure Code Implementation
+ */
+
+#include "reed-solomon.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace helper {
+
+namespace {
+
+constexpr uint32_t kPrimitivePolynomial = 0x11D;
+
+/**
+ * Log/exp and full product tables, built once.
+ */
+struct Gf256Tables
+{
+    uint8_t exp[512];
+    uint8_t log[256];
+    uint8_t mul[256][256];
+
+    Gf256Tables()
+    {
+        uint32_t x = 1;
+        for (uint32_t i = 0; i < 255; ++i)
+        {
+            exp[i] = static_cast<uint8_t>(x);
+            log[x] = static_cast<uint8_t>(i);
+            x <<= 1;
+            if (x & 0x100)
+            {
+                x ^= kPrimitivePolynomial;
+            }
+        }
+        // Doubled so exp[log a + log b] needs no modulo
+        for (uint32_t i = 255; i < 512; ++i)
+        {
+            exp[i] = exp[i - 255];
+        }
+        log[0] = 0;
+
+        for (uint32_t a = 0; a < 256; ++a)
+        {
+            for (uint32_t b = 0; b < 256; ++b)
+            {
+                mul[a][b] = (a == 0 || b == 0) ? 0 : exp[log[a] + log[b]];
+            }
+        }
+    }
+};
+
+const Gf256Tables&
+GetTables()
+{
+    static const Gf256Tables tables;
+    return tables;
+}
+
+} // namespace
+
+uint8_t
+Gf256Mul(uint8_t a, uint8_t b)
+{
+    return GetTables().mul[a][b];
+}
+
+uint8_t
+Gf256Inv(uint8_t a)
+{
+    if (a == 0)
+    {
+        return 0;
+    }
+    const Gf256Tables& t = GetTables();
+    return t.exp[255 - t.log[a]];
+}
+
+void
+Gf256MulAdd(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t len)
+{
+    if (coef == 0)
+    {
+        return;
+    }
+
+    size_t i = 0;
+    if (coef == 1)
+    {
+        for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+        {
+            uint64_t a;
+            uint64_t b;
+            std::memcpy(&a, dst + i, sizeof(a));
+            std::memcpy(&b, src + i, sizeof(b));
+            a ^= b;
+            std::memcpy(dst + i, &a, sizeof(a));
+        }
+        for (; i < len; ++i)
+        {
+            dst[i] ^= src[i];
+        }
+        return;
+    }
+
+    const uint8_t* row = GetTables().mul[coef];
+    for (; i + 4 <= len; i += 4)
+    {
+        dst[i] ^= row[src[i]];
+        dst[i + 1] ^= row[src[i + 1]];
+        dst[i + 2] ^= row[src[i + 2]];
+        dst[i + 3] ^= row[src[i + 3]];
+    }
+    for (; i < len; ++i)
+    {
+        dst[i] ^= row[src[i]];
+    }
+}
+
+ReedSolomonCode::ReedSolomonCode()
+    : m_numSource(0),
+      m_numSymbols(0)
+{
+}
+
+ReedSolomonCode::ReedSolomonCode(uint32_t numSource, uint32_t numSymbols)
+    : m_numSource(std::clamp<uint32_t>(numSource, 1, kMaxSymbols)),
+      m_numSymbols(std::clamp<uint32_t>(numSymbols, m_numSource, kMaxSymbols))
+{
+}
+
+uint32_t
+ReedSolomonCode::GetSourceCount() const
+{
+    return m_numSource;
+}
+
+uint32_t
+ReedSolomonCode::GetSymbolCount() const
+{
+    return m_numSymbols;
+}
+
+uint8_t
+ReedSolomonCode::GetCoefficient(uint32_t symbolIndex, uint32_t sourceIndex) const
+{
+    if (symbolIndex < m_numSource)
+    {
+        return (symbolIndex == sourceIndex) ? 1 : 0;
+    }
+    // Cauchy row: 1 / (x_i + y_j) with x_i = symbolIndex, y_j = sourceIndex.
+    // The x and y sets are disjoint, so every square submatrix is invertible.
+    return Gf256Inv(static_cast<uint8_t>(symbolIndex ^ sourceIndex));
+}
+
+void
+ReedSolomonCode::Encode(const std::vector<const uint8_t*>& sources,
+                        size_t blockSize,
+                        uint32_t symbolIndex,
+                        uint8_t* out) const
+{
+    if (blockSize == 0)
+    {
+        return;
+    }
+    std::memset(out, 0, blockSize);
+    for (uint32_t j = 0; j < m_numSource && j < sources.size(); ++j)
+    {
+        Gf256MulAdd(out, sources[j], GetCoefficient(symbolIndex, j), blockSize);
+    }
+}
+
+bool
+ReedSolomonCode::Decode(const std::vector<uint32_t>& symbolIndices,
+                        const std::vector<const uint8_t*>& symbols,
+                        size_t blockSize,
+                        std::vector<std::vector<uint8_t>>& sources) const
+{
+    const uint32_t k = m_numSource;
+    if (k == 0 || symbolIndices.size() != k || symbols.size() != k)
+    {
+        return false;
+    }
+
+    std::vector<bool> seen(m_numSymbols, false);
+    for (uint32_t index : symbolIndices)
+    {
+        if (index >= m_numSymbols || seen[index])
+        {
+            return false;
+        }
+        seen[index] = true;
+    }
+
+    // Invert the k x k coefficient matrix of the received symbols
+    // (Gauss-Jordan, augmented with the identity).
+    std::vector<uint8_t> a(k * k);
+    std::vector<uint8_t> inv(k * k, 0);
+    for (uint32_t r = 0; r < k; ++r)
+    {
+        for (uint32_t c = 0; c < k; ++c)
+        {
+            a[r * k + c] = GetCoefficient(symbolIndices[r], c);
+        }
+        inv[r * k + r] = 1;
+    }
+
+    for (uint32_t col = 0; col < k; ++col)
+    {
+        uint32_t pivot = col;
+        while (pivot < k && a[pivot * k + col] == 0)
+        {
+            ++pivot;
+        }
+        if (pivot == k)
+        {
+            return false;
+        }
+        if (pivot != col)
+        {
+            std::swap_ranges(a.begin() + pivot * k, a.begin() + (pivot + 1) * k, a.begin() + col * k);
+            std::swap_ranges(inv.begin() + pivot * k,
+                             inv.begin() + (pivot + 1) * k,
+                             inv.begin() + col * k);
+        }
+
+        const uint8_t scale = Gf256Inv(a[col * k + col]);
+        for (uint32_t c = 0; c < k; ++c)
+        {
+            a[col * k + c] = Gf256Mul(a[col * k + c], scale);
+            inv[col * k + c] = Gf256Mul(inv[col * k + c], scale);
+        }
+
+        for (uint32_t r = 0; r < k; ++r)
+        {
+            const uint8_t factor = a[r * k + col];
+            if (r == col || factor == 0)
+            {
+                continue;
+            }
+            Gf256MulAdd(&a[r * k], &a[col * k], factor, k);
+            Gf256MulAdd(&inv[r * k], &inv[col * k], factor, k);
+        }
+    }
+
+    // Received systematic symbols are copied; only the rest are combined.
+    sources.assign(k, std::vector<uint8_t>());
+    for (uint32_t r = 0; r < k; ++r)
+    {
+        if (symbolIndices[r] < k)
+        {
+            sources[symbolIndices[r]].assign(symbols[r], symbols[r] + blockSize);
+        }
+    }
+    for (uint32_t j = 0; j < k; ++j)
+    {
+        if (!sources[j].empty() || blockSize == 0)
+        {
+            continue;
+        }
+        sources[j].assign(blockSize, 0);
+        for (uint32_t m = 0; m < k; ++m)
+        {
+            Gf256MulAdd(sources[j].data(), symbols[m], inv[j * k + m], blockSize);
+        }
+    }
+    if (blockSize == 0)
+    {
+        for (auto& block : sources)
+        {
+            block.clear();
+        }
+    }
+    return true;
+}
+
+} // namespace helper
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
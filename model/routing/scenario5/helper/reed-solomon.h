@@ -0,0 +1,107 @@
+/*
+ * Scenario 5 - GF(256) Arithmetic and Reed-Solomon Erasure Code
+ *
+ * Table-driven GF(2^8) kernels (polynomial 0x11D) and a systematic Cauchy
+ * Reed-Solomon code. Pure computation, no simulation state.
+ */
+
+#ifndef SCENARIO5_REED_SOLOMON_H
+#define SCENARIO5_REED_SOLOMON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace helper {
+
+/**
+ * \return a * b in GF(256)
+ */
+uint8_t Gf256Mul(uint8_t a, uint8_t b);
+
+/**
+ * \return multiplicative inverse of a in GF(256) (0 maps to 0)
+ */
+uint8_t Gf256Inv(uint8_t a);
+
+/**
+ * dst[i] ^= coef * src[i] for i in [0, len).
+ *
+ * Looks up one 256-byte row of the product table per call; coef 0 and 1
+ * take a skip and a word-wise XOR path.
+ */
+void Gf256MulAdd(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t len);
+
+/**
+ * Systematic Reed-Solomon erasure code over GF(256).
+ *
+ * Symbols [0, k) are the source blocks themselves and symbols [k, n) are
+ * parity rows of a Cauchy matrix, so any k distinct symbols recover every
+ * source block. n is at most 256.
+ */
+class ReedSolomonCode
+{
+public:
+    static constexpr uint32_t kMaxSymbols = 256;
+
+    /**
+     * Empty code (no source blocks).
+     */
+    ReedSolomonCode();
+
+    /**
+     * \param numSource Source blocks k (clamped to [1, kMaxSymbols])
+     * \param numSymbols Total symbols n (clamped to [k, kMaxSymbols])
+     */
+    ReedSolomonCode(uint32_t numSource, uint32_t numSymbols);
+
+    uint32_t GetSourceCount() const;
+    uint32_t GetSymbolCount() const;
+
+    /**
+     * \return weight of a source block in a symbol (identity rows for
+     *         systematic symbols)
+     */
+    uint8_t GetCoefficient(uint32_t symbolIndex, uint32_t sourceIndex) const;
+
+    /**
+     * Compute one symbol.
+     *
+     * \param sources k source blocks of blockSize bytes each
+     * \param blockSize Block size in bytes
+     * \param symbolIndex Symbol to compute, in [0, n)
+     * \param out Output buffer of blockSize bytes
+     */
+    void Encode(const std::vector<const uint8_t*>& sources,
+                size_t blockSize,
+                uint32_t symbolIndex,
+                uint8_t* out) const;
+
+    /**
+     * Recover the source blocks from k distinct symbols.
+     *
+     * \param symbolIndices Indices of the received symbols (k distinct values)
+     * \param symbols Received symbol blocks, same order as symbolIndices
+     * \param blockSize Block size in bytes
+     * \param sources Output: k source blocks
+     * \return false if the indices are not k distinct valid symbols
+     */
+    bool Decode(const std::vector<uint32_t>& symbolIndices,
+                const std::vector<const uint8_t*>& symbols,
+                size_t blockSize,
+                std::vector<std::vector<uint8_t>>& sources) const;
+
+private:
+    uint32_t m_numSource;
+    uint32_t m_numSymbols;
+};
+
+} // namespace helper
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_REED_SOLOMON_H
@@ -0,0 +1,644 @@
+/*
+ * Scenario 5 - Open Tour Construction and Refinement Implementation
+ */
+
+#include "tour-optimizer.h"
+#include "calc-utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace helper {
+
+namespace {
+
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+// Minimum length gain (meters) for a move to count as improving
+constexpr double kImproveEps = 1e-7;
+// Guard for the ring-distance bound against rounding in cell assignment
+constexpr double kRingSlack = 1e-9;
+constexpr int32_t kMaxCellIndex = 1 << 30;
+constexpr uint32_t kTimeCheckInterval = 256;
+
+/**
+ * Uniform bucket grid over a point set, sized for ~2 points per cell.
+ * Supports removal so the same grid serves nearest-unvisited queries.
+ */
+class BucketGrid
+{
+public:
+    BucketGrid(const std::vector<double>& xs, const std::vector<double>& ys)
+    {
+        const uint32_t n = static_cast<uint32_t>(xs.size());
+        m_minX = *std::min_element(xs.begin(), xs.end());
+        m_minY = *std::min_element(ys.begin(), ys.end());
+        const double width = *std::max_element(xs.begin(), xs.end()) - m_minX;
+        const double height = *std::max_element(ys.begin(), ys.end()) - m_minY;
+
+        const double pointsPerCell = 2.0;
+        m_cellSize = std::max(std::sqrt(width * height * pointsPerCell / n),
+                              std::max(width, height) * pointsPerCell / n);
+        if (!(m_cellSize > 0.0))
+        {
+            m_cellSize = 1.0;
+        }
+        m_cols = static_cast<int32_t>(width / m_cellSize) + 1;
+        m_rows = static_cast<int32_t>(height / m_cellSize) + 1;
+
+        m_cells.resize(static_cast<size_t>(m_cols) * m_rows);
+        m_cellOf.resize(n);
+        m_slot.resize(n);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const int32_t cx = std::min(CellX(xs[i]), m_cols - 1);
+            const int32_t cy = std::min(CellY(ys[i]), m_rows - 1);
+            const uint32_t cell = static_cast<uint32_t>(cy * m_cols + cx);
+            m_cellOf[i] = cell;
+            m_slot[i] = static_cast<uint32_t>(m_cells[cell].size());
+            m_cells[cell].push_back(i);
+        }
+    }
+
+    int32_t CellX(double x) const
+    {
+        return ClampCell(std::floor((x - m_minX) / m_cellSize));
+    }
+
+    int32_t CellY(double y) const
+    {
+        return ClampCell(std::floor((y - m_minY) / m_cellSize));
+    }
+
+    double GetCellSize() const
+    {
+        return m_cellSize;
+    }
+
+    void Remove(uint32_t i)
+    {
+        std::vector<uint32_t>& members = m_cells[m_cellOf[i]];
+        const uint32_t last = members.back();
+        members[m_slot[i]] = last;
+        m_slot[last] = m_slot[i];
+        members.pop_back();
+    }
+
+    bool Contains(int32_t cx, int32_t cy) const
+    {
+        return cx >= 0 && cy >= 0 && cx < m_cols && cy < m_rows;
+    }
+
+    /**
+     * \return true once rings 0..r around (cx,cy) cover the whole grid
+     */
+    bool RingsCoverGrid(int32_t cx, int32_t cy, int32_t r) const
+    {
+        return int64_t(cx) - r <= 0 && int64_t(cy) - r <= 0 && int64_t(cx) + r >= m_cols - 1 &&
+               int64_t(cy) + r >= m_rows - 1;
+    }
+
+    /**
+     * Visit every member of the cells at Chebyshev distance r from (cx,cy).
+     *
+     * \return number of in-grid cells visited
+     */
+    template <typename F>
+    uint32_t ForEachInRing(int32_t cx, int32_t cy, int32_t r, F&& visit) const
+    {
+        uint32_t cellsVisited = 0;
+        auto visitCell = [&](int32_t x, int32_t y) {
+            cellsVisited++;
+            for (uint32_t i : m_cells[static_cast<size_t>(y) * m_cols + x])
+            {
+                visit(i);
+            }
+        };
+
+        const int64_t yLo = std::max<int64_t>(int64_t(cy) - r, 0);
+        const int64_t yHi = std::min<int64_t>(int64_t(cy) + r, m_rows - 1);
+        const int64_t xLo = std::max<int64_t>(int64_t(cx) - r, 0);
+        const int64_t xHi = std::min<int64_t>(int64_t(cx) + r, m_cols - 1);
+        for (int64_t y = yLo; y <= yHi; ++y)
+        {
+            if (y == int64_t(cy) - r || y == int64_t(cy) + r)
+            {
+                for (int64_t x = xLo; x <= xHi; ++x)
+                {
+                    visitCell(static_cast<int32_t>(x), static_cast<int32_t>(y));
+                }
+            }
+            else
+            {
+                if (int64_t(cx) - r >= 0 && int64_t(cx) - r < m_cols)
+                {
+                    visitCell(cx - r, static_cast<int32_t>(y));
+                }
+                if (r > 0 && int64_t(cx) + r < m_cols && int64_t(cx) + r >= 0)
+                {
+                    visitCell(cx + r, static_cast<int32_t>(y));
+                }
+            }
+        }
+        return cellsVisited;
+    }
+
+private:
+    static int32_t ClampCell(double v)
+    {
+        return static_cast<int32_t>(std::max<double>(-kMaxCellIndex, std::min<double>(kMaxCellIndex, v)));
+    }
+
+    double m_minX = 0.0;
+    double m_minY = 0.0;
+    double m_cellSize = 1.0;
+    int32_t m_cols = 1;
+    int32_t m_rows = 1;
+    std::vector<std::vector<uint32_t>> m_cells;
+    std::vector<uint32_t> m_cellOf;
+    std::vector<uint32_t> m_slot;
+};
+
+/**
+ * (distance, index) lexicographic comparison used for every tie-break.
+ */
+inline bool
+IsCloser(double dist, uint32_t idx, double bestDist, uint32_t bestIdx)
+{
+    return dist < bestDist || (dist == bestDist && idx < bestIdx);
+}
+
+/**
+ * K nearest other points of each point, plus of the start position.
+ * Lists hold tour-space indices (start = 0, point i = i + 1), closest first.
+ */
+std::vector<std::vector<uint32_t>>
+BuildNeighborLists(const BucketGrid& grid,
+                   const std::vector<double>& px,
+                   const std::vector<double>& py,
+                   uint32_t k)
+{
+    const uint32_t total = static_cast<uint32_t>(px.size());
+    std::vector<std::vector<uint32_t>> neighbors(total);
+    std::vector<std::pair<double, uint32_t>> found;
+
+    for (uint32_t a = 0; a < total; ++a)
+    {
+        const int32_t cx = grid.CellX(px[a]);
+        const int32_t cy = grid.CellY(py[a]);
+        found.clear();
+        if (!grid.Contains(cx, cy))
+        {
+            // Only the start can lie off the grid; scan every point once
+            for (uint32_t i = 1; i < total; ++i)
+            {
+                found.push_back({CalculateDistance(px[a], py[a], px[i], py[i]), i});
+            }
+        }
+        for (int32_t r = 0; grid.Contains(cx, cy); ++r)
+        {
+            grid.ForEachInRing(cx, cy, r, [&](uint32_t i) {
+                if (i + 1 != a)
+                {
+                    found.push_back({CalculateDistance(px[a], py[a], px[i + 1], py[i + 1]), i + 1});
+                }
+            });
+            if (grid.RingsCoverGrid(cx, cy, r))
+            {
+                break;
+            }
+            if (found.size() >= k)
+            {
+                std::nth_element(found.begin(), found.begin() + (k - 1), found.end());
+                if (found[k - 1].first < r * grid.GetCellSize() * (1.0 - kRingSlack))
+                {
+                    break;
+                }
+            }
+        }
+        std::sort(found.begin(), found.end());
+        const uint32_t keep = std::min<uint32_t>(k, static_cast<uint32_t>(found.size()));
+        neighbors[a].reserve(keep);
+        for (uint32_t j = 0; j < keep; ++j)
+        {
+            neighbors[a].push_back(found[j].second);
+        }
+    }
+    return neighbors;
+}
+
+/**
+ * First-improvement 2-opt / Or-opt over an open route that starts at
+ * tour-space index 0.
+ */
+class OpenTourSearch
+{
+public:
+    OpenTourSearch(const std::vector<double>& px,
+                   const std::vector<double>& py,
+                   const std::vector<std::vector<uint32_t>>& neighbors,
+                   std::vector<uint32_t>& route)
+        : m_px(px),
+          m_py(py),
+          m_neighbors(neighbors),
+          m_route(route),
+          m_last(static_cast<uint32_t>(route.size()) - 1),
+          m_where(route.size())
+    {
+        for (uint32_t pos = 0; pos <= m_last; ++pos)
+        {
+            m_where[m_route[pos]] = pos;
+        }
+    }
+
+    /**
+     * Try every 2-opt move that adds an edge from the node at pos to one of
+     * its candidates, removing either its successor or predecessor edge.
+     */
+    bool TryTwoOpt(uint32_t pos)
+    {
+        const uint32_t a = m_route[pos];
+
+        if (pos < m_last)
+        {
+            const uint32_t b = m_route[pos + 1];
+            const double dab = Dist(a, b);
+            for (uint32_t c : m_neighbors[a])
+            {
+                const double g = Dist(a, c);
+                if (g >= dab)
+                {
+                    break;
+                }
+                const uint32_t j = m_where[c];
+                if (j > pos + 1)
+                {
+                    // Remove (a,b), (c,d); add (a,c), (b,d)
+                    const uint32_t d = (j < m_last) ? m_route[j + 1] : kNone;
+                    const double delta = g - dab + ((d != kNone) ? Dist(b, d) - Dist(c, d) : 0.0);
+                    if (delta < -kImproveEps)
+                    {
+                        Reverse(pos + 1, j);
+                        return true;
+                    }
+                }
+                else if (j + 1 < pos)
+                {
+                    // Remove (c,cn), (a,b); add (c,a), (cn,b)
+                    const uint32_t cn = m_route[j + 1];
+                    const double delta = g + Dist(cn, b) - Dist(c, cn) - dab;
+                    if (delta < -kImproveEps)
+                    {
+                        Reverse(j + 1, pos);
+                        return true;
+                    }
+                }
+            }
+        }
+
+        if (pos >= 1)
+        {
+            const uint32_t p = m_route[pos - 1];
+            const double dpa = Dist(p, a);
+            for (uint32_t c : m_neighbors[a])
+            {
+                const double g = Dist(a, c);
+                if (g >= dpa)
+                {
+                    break;
+                }
+                const uint32_t j = m_where[c];
+                if (j + 1 < pos && j >= 1)
+                {
+                    // Remove (cp,c), (p,a); add (cp,p), (c,a)
+                    const uint32_t cp = m_route[j - 1];
+                    const double delta = g + Dist(cp, p) - Dist(cp, c) - dpa;
+                    if (delta < -kImproveEps)
+                    {
+                        Reverse(j, pos - 1);
+                        return true;
+                    }
+                }
+                else if (j > pos + 1)
+                {
+                    // Remove (p,a), (cp,c); add (p,cp), (a,c)
+                    const uint32_t cp = m_route[j - 1];
+                    const double delta = g + Dist(p, cp) - dpa - Dist(cp, c);
+                    if (delta < -kImproveEps)
+                    {
+                        Reverse(pos, j - 1);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Try moving route[s .. s+len-1] next to a candidate of either end,
+     * in either orientation.
+     */
+    bool TryOrOpt(uint32_t s, uint32_t len)
+    {
+        const uint32_t e = s + len - 1;
+        if (s < 1 || e > m_last)
+        {
+            return false;
+        }
+        const uint32_t p = m_route[s - 1];
+        const uint32_t first = m_route[s];
+        const uint32_t last = m_route[e];
+        const uint32_t next = (e < m_last) ? m_route[e + 1] : kNone;
+        const double removeGain =
+            Dist(p, first) + ((next != kNone) ? Dist(last, next) - Dist(p, next) : 0.0);
+        if (removeGain <= kImproveEps)
+        {
+            return false;
+        }
+
+        for (uint32_t side = 0; side < ((len == 1) ? 1u : 2u); ++side)
+        {
+            const uint32_t endpoint = (side == 0) ? first : last;
+            const uint32_t other = (side == 0) ? last : first;
+            for (uint32_t c : m_neighbors[endpoint])
+            {
+                const double g = Dist(endpoint, c);
+                if (g >= removeGain)
+                {
+                    break;
+                }
+                const uint32_t t = m_where[c];
+                if (t >= s && t <= e)
+                {
+                    continue;
+                }
+
+                // After c: c, endpoint .. other, y
+                if (t + 1 != s)
+                {
+                    const uint32_t y = (t < m_last) ? m_route[t + 1] : kNone;
+                    const double add = g + ((y != kNone) ? Dist(other, y) - Dist(c, y) : 0.0);
+                    if (add - removeGain < -kImproveEps)
+                    {
+                        MoveSegment(s, e, t + 1, endpoint == last);
+                        return true;
+                    }
+                }
+
+                // Before c: x, other .. endpoint, c
+                if (t != e + 1)
+                {
+                    const uint32_t x = m_route[t - 1];
+                    const double add = g + Dist(x, other) - Dist(x, c);
+                    if (add - removeGain < -kImproveEps)
+                    {
+                        MoveSegment(s, e, t, other == last);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    double Dist(uint32_t a, uint32_t b) const
+    {
+        return CalculateDistance(m_px[a], m_py[a], m_px[b], m_py[b]);
+    }
+
+    void Reverse(uint32_t lo, uint32_t hi)
+    {
+        std::reverse(m_route.begin() + lo, m_route.begin() + hi + 1);
+        for (uint32_t pos = lo; pos <= hi; ++pos)
+        {
+            m_where[m_route[pos]] = pos;
+        }
+    }
+
+    /**
+     * Move route[s..e] so it starts at current position insertAt
+     * (insertAt outside [s, e+1]), optionally reversed.
+     */
+    void MoveSegment(uint32_t s, uint32_t e, uint32_t insertAt, bool reversed)
+    {
+        std::vector<uint32_t> segment(m_route.begin() + s, m_route.begin() + e + 1);
+        if (reversed)
+        {
+            std::reverse(segment.begin(), segment.end());
+        }
+        const uint32_t len = e - s + 1;
+        m_route.erase(m_route.begin() + s, m_route.begin() + e + 1);
+        const uint32_t at = (insertAt > e) ? insertAt - len : insertAt;
+        m_route.insert(m_route.begin() + at, segment.begin(), segment.end());
+
+        const uint32_t lo = std::min(s, at);
+        const uint32_t hi = std::max(e, at + len - 1);
+        for (uint32_t pos = lo; pos <= hi; ++pos)
+        {
+            m_where[m_route[pos]] = pos;
+        }
+    }
+
+    const std::vector<double>& m_px;
+    const std::vector<double>& m_py;
+    const std::vector<std::vector<uint32_t>>& m_neighbors;
+    std::vector<uint32_t>& m_route;
+    uint32_t m_last;
+    std::vector<uint32_t> m_where;
+};
+
+} // namespace
+
+std::vector<uint32_t>
+BuildNearestNeighborTour(double startX,
+                         double startY,
+                         const std::vector<double>& xs,
+                         const std::vector<double>& ys)
+{
+    const uint32_t n = static_cast<uint32_t>(xs.size());
+    std::vector<uint32_t> order;
+    if (n == 0)
+    {
+        return order;
+    }
+    order.reserve(n);
+
+    BucketGrid grid(xs, ys);
+
+    // Compact list of unvisited points for the linear-scan fallback
+    std::vector<uint32_t> remaining(n);
+    std::vector<uint32_t> remainingSlot(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        remaining[i] = i;
+        remainingSlot[i] = i;
+    }
+
+    double currentX = startX;
+    double currentY = startY;
+    while (!remaining.empty())
+    {
+        double bestDist = std::numeric_limits<double>::max();
+        uint32_t best = kNone;
+        auto consider = [&](uint32_t i) {
+            const double dist = CalculateDistance(currentX, currentY, xs[i], ys[i]);
+            if (IsCloser(dist, i, bestDist, best))
+            {
+                bestDist = dist;
+                best = i;
+            }
+        };
+
+        const int32_t cx = grid.CellX(currentX);
+        const int32_t cy = grid.CellY(currentY);
+        uint32_t cellsVisited = 0;
+        for (int32_t r = 0;; ++r)
+        {
+            if (cellsVisited + r > remaining.size())
+            {
+                // Sparse leftovers: a scan of what is left is cheaper
+                bestDist = std::numeric_limits<double>::max();
+                best = kNone;
+                for (uint32_t i : remaining)
+                {
+                    consider(i);
+                }
+                break;
+            }
+            cellsVisited += grid.ForEachInRing(cx, cy, r, consider);
+            if (grid.RingsCoverGrid(cx, cy, r))
+            {
+                break;
+            }
+            if (best != kNone && bestDist < r * grid.GetCellSize() * (1.0 - kRingSlack))
+            {
+                break;
+            }
+        }
+
+        order.push_back(best);
+        grid.Remove(best);
+        const uint32_t moved = remaining.back();
+        remaining[remainingSlot[best]] = moved;
+        remainingSlot[moved] = remainingSlot[best];
+        remaining.pop_back();
+
+        currentX = xs[best];
+        currentY = ys[best];
+    }
+    return order;
+}
+
+uint32_t
+RefineOpenTour(double startX,
+               double startY,
+               const std::vector<double>& xs,
+               const std::vector<double>& ys,
+               const TourRefinementOptions& options,
+               std::vector<uint32_t>& order)
+{
+    const uint32_t n = static_cast<uint32_t>(order.size());
+    if (!options.enabled || n < 2 || options.neighbors == 0)
+    {
+        return 0;
+    }
+
+    // Tour space: index 0 is the fixed start, point i is i + 1
+    std::vector<double> px(n + 1);
+    std::vector<double> py(n + 1);
+    px[0] = startX;
+    py[0] = startY;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        px[i + 1] = xs[i];
+        py[i + 1] = ys[i];
+    }
+    std::vector<uint32_t> route(n + 1);
+    route[0] = 0;
+    for (uint32_t pos = 0; pos < n; ++pos)
+    {
+        route[pos + 1] = order[pos] + 1;
+    }
+
+    const BucketGrid grid(xs, ys);
+    const std::vector<std::vector<uint32_t>> neighbors =
+        BuildNeighborLists(grid, px, py, std::min(options.neighbors, n));
+
+    const auto start = std::chrono::steady_clock::now();
+    auto outOfTime = [&]() {
+        return options.timeLimitSec > 0.0 &&
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >
+                   options.timeLimitSec;
+    };
+
+    OpenTourSearch search(px, py, neighbors, route);
+    uint32_t moves = 0;
+    bool stop = false;
+    auto moveApplied = [&]() {
+        moves++;
+        stop = (options.maxMoves > 0 && moves >= options.maxMoves);
+    };
+    for (uint32_t pass = 0; pass < options.maxPasses && !stop; ++pass)
+    {
+        const uint32_t movesBefore = moves;
+        for (uint32_t pos = 0; pos <= n && !stop; ++pos)
+        {
+            if (search.TryTwoOpt(pos))
+            {
+                moveApplied();
+            }
+            stop = stop || ((pos % kTimeCheckInterval == 0) && outOfTime());
+        }
+        for (uint32_t s = 1; s <= n && !stop; ++s)
+        {
+            for (uint32_t len = 1; len <= 3; ++len)
+            {
+                if (search.TryOrOpt(s, len))
+                {
+                    moveApplied();
+                    break;
+                }
+            }
+            stop = stop || ((s % kTimeCheckInterval == 0) && outOfTime());
+        }
+        if (moves == movesBefore)
+        {
+            break;
+        }
+    }
+
+    for (uint32_t pos = 0; pos < n; ++pos)
+    {
+        order[pos] = route[pos + 1] - 1;
+    }
+    return moves;
+}
+
+double
+ComputeOpenTourLength(double startX,
+                      double startY,
+                      const std::vector<double>& xs,
+                      const std::vector<double>& ys,
+                      const std::vector<uint32_t>& order)
+{
+    double total = 0.0;
+    double prevX = startX;
+    double prevY = startY;
+    for (uint32_t i : order)
+    {
+        total += CalculateDistance(prevX, prevY, xs[i], ys[i]);
+        prevX = xs[i];
+        prevY = ys[i];
+    }
+    return total;
+}
+
+} // namespace helper
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
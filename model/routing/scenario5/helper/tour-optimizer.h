@@ -0,0 +1,88 @@
+/*
+ * Scenario 5 - Open Tour Construction and Refinement
+ *
+ * Grid-accelerated nearest-neighbor construction of an open tour from a
+ * fixed start position, plus 2-opt / Or-opt refinement over K-nearest
+ * candidate lists. Pure computation, no simulation state.
+ */
+
+#ifndef SCENARIO5_TOUR_OPTIMIZER_H
+#define SCENARIO5_TOUR_OPTIMIZER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace helper {
+
+/**
+ * Local search settings for an open tour.
+ */
+struct TourRefinementOptions
+{
+    bool enabled = false;
+    uint32_t neighbors = 8;    ///< candidate list size per point
+    uint32_t maxPasses = 50;   ///< full 2-opt + Or-opt sweeps
+    uint32_t maxMoves = 0;     ///< improving moves cap (0 = passes only)
+    double timeLimitSec = 0.0; ///< wall-clock cap (0 = none); not reproducible
+};
+
+/**
+ * Nearest-neighbor visiting order from a start position.
+ *
+ * Each step picks the closest unvisited point by CalculateDistance, lowest
+ * index on ties, i.e. the same order as a linear scan. Lookups use a bucket
+ * grid and fall back to scanning the remaining points when that is cheaper.
+ *
+ * \param startX Start X coordinate (not part of the tour)
+ * \param startY Start Y coordinate
+ * \param xs Point X coordinates
+ * \param ys Point Y coordinates (same size as xs)
+ * \return point indices in visiting order
+ */
+std::vector<uint32_t> BuildNearestNeighborTour(double startX,
+                                               double startY,
+                                               const std::vector<double>& xs,
+                                               const std::vector<double>& ys);
+
+/**
+ * Shorten an open tour (fixed start, free end) in place.
+ *
+ * Applies improving 2-opt segment reversals and Or-opt moves of 1-3 points
+ * until a full pass finds none, maxPasses or maxMoves is reached or the time
+ * limit expires. Moves are scanned in a fixed order, so the result is
+ * deterministic unless the time limit cuts the search short; bound large
+ * tours with maxMoves to keep runs reproducible.
+ *
+ * \param startX Start X coordinate
+ * \param startY Start Y coordinate
+ * \param xs Point X coordinates
+ * \param ys Point Y coordinates
+ * \param options Search settings
+ * \param order In/out: visiting order (a permutation of point indices)
+ * \return number of improving moves applied
+ */
+uint32_t RefineOpenTour(double startX,
+                        double startY,
+                        const std::vector<double>& xs,
+                        const std::vector<double>& ys,
+                        const TourRefinementOptions& options,
+                        std::vector<uint32_t>& order);
+
+/**
+ * \return horizontal length of start -> order[0] -> ... -> order[n-1]
+ */
+double ComputeOpenTourLength(double startX,
+                             double startY,
+                             const std::vector<double>& xs,
+                             const std::vector<double>& ys,
+                             const std::vector<uint32_t>& order);
+
+} // namespace helper
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_TOUR_OPTIMIZER_H
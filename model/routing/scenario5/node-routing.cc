@@ -4,20 +4,28 @@
  * Helper functions to initialize routing components from scenario layer.
  */
 
+#include "node-routing.h"
 #include "base-station-node/base-station-node.h"
 #include "base-station-node/fragment-generator.h"
 #include "ground-node-routing/ground-node-routing.h"
 #include "ground-node-routing/cell-cooperation.h"
 #include "packet-header.h"
+#include "helper/calc-utils.h"
+#include "trace-policy.h"
+#include "replay-file.h"
+#include "../../wsn-metrics.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
 #include "../../../examples/scenarios/scenario5/scenario5-params.h"
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <limits>
+#include <vector>
 
 namespace ns3 {
 
@@ -35,8 +43,43 @@ static double g_uav1MissionCompletedTime = -1.0;
 static bool g_uav2MissionCompleted = false;
 static double g_uav2MissionCompletedTime = -1.0;
 
+// Per-UAV mission counters, by UAV node ID
+static std::map<uint32_t, UavMissionStats> g_uavMissionStats;
+
+// Registry metrics (wsn-metrics.h)
+static const Counter g_metricUavBroadcasts("uav.broadcasts");
+
+// Per-node role table, indexed by node ID
+static std::vector<NodeRole> g_nodeRoles;
+
+// Per-receiver UAV broadcast loss draws (AssignUavBroadcastStreams)
+static Ptr<UniformRandomVariable> g_uavBroadcastLossRv;
+
+void
+SetNodeRole(uint32_t nodeId, NodeRole role)
+{
+    if (nodeId >= g_nodeRoles.size())
+    {
+        g_nodeRoles.resize(nodeId + 1, NodeRole::UNKNOWN);
+    }
+    g_nodeRoles[nodeId] = role;
+}
+
+NodeRole
+GetNodeRole(uint32_t nodeId)
+{
+    return (nodeId < g_nodeRoles.size()) ? g_nodeRoles[nodeId] : NodeRole::UNKNOWN;
+}
+
+bool
+IsUavNode(uint32_t nodeId)
+{
+    return GetNodeRole(nodeId) == NodeRole::UAV;
+}
+
 void InitializeBaseStation(uint32_t nodeId)
 {
+    SetNodeRole(nodeId, NodeRole::BASE_STATION);
     if (g_baseStation == nullptr) {
         g_baseStation = new BaseStationNode(nodeId);
         g_baseStation->Initialize();
@@ -53,6 +96,7 @@ MarkUav2MissionCompleted(uint32_t triggerNodeId, double triggerConfidence)
 
     g_uav2MissionCompleted = true;
     g_uav2MissionCompletedTime = Simulator::Now().GetSeconds();
+    LogReplayEvent(ReplayEventType::UAV2_MISSION_COMPLETE, kReplayNoNode, triggerNodeId, 0, triggerConfidence);
 
     NS_LOG_WARN("[UAV2-MISSION] Early completion triggered"
                 << " | triggerNodeId=" << triggerNodeId
@@ -94,6 +138,12 @@ GetUav2MissionCompletedTime()
     return g_uav2MissionCompletedTime;
 }
 
+const std::map<uint32_t, UavMissionStats>&
+GetUavMissionStats()
+{
+    return g_uavMissionStats;
+}
+
 void TickBaseStationControl()
 {
     if (g_baseStation == nullptr)
@@ -130,9 +180,6 @@ void InitializeUavFlight()
         return;
     }
 
-    // UAV1 is defined as the first UAV in the planned path map.
-    const uint32_t uav1NodeId = uavPaths.begin()->first;
-
     // Suspicious point node position (seed node selected by BS).
     Vector suspiciousPointPos{0.0, 0.0, 0.0};
     bool hasSuspiciousPointPos = false;
@@ -174,7 +221,8 @@ void InitializeUavFlight()
         for (size_t i = 0; i < path.waypoints.size(); ++i)
         {
             const Waypoint& wp = path.waypoints[i];
-            const bool isUav1 = (uavNodeId == uav1NodeId);
+            // UAV1 role: any node-visit UAV; only the one assigned the seed node passes over it.
+            const bool isUav1 = (path.role == UavMissionRole::NODE_VISIT);
             const bool hasPreviousWaypoint = (i > 0);
             const Waypoint prevWp = hasPreviousWaypoint ? path.waypoints[i - 1] : wp;
             
@@ -196,12 +244,28 @@ void InitializeUavFlight()
                 
                 // Set UAV position to waypoint
                 mob->SetPosition(wp.position);
+
+                UavMissionStats& stats = g_uavMissionStats[uavNodeId];
+                stats.waypointsReached++;
+                stats.lastWaypointTime = Simulator::Now().GetSeconds();
+                if (hasPreviousWaypoint)
+                {
+                    stats.distanceFlown += helper::CalculateDistance(prevWp.position.x, prevWp.position.y,
+                                                                     wp.position.x, wp.position.y);
+                }
                 
                 NS_LOG_INFO("[UAV-FLIGHT] UAV " << uavNodeId 
                             << " arrived at waypoint " << (i + 1)
                             << " | pos=(" << wp.position.x << "," << wp.position.y << "," << wp.position.z << ")"
                             << " | t=" << Simulator::Now().GetSeconds() << "s");
 
+                LogReplayPositionEvent(ReplayEventType::UAV_WAYPOINT_ARRIVAL,
+                                       uavNodeId,
+                                       static_cast<uint32_t>(i),
+                                       wp.position.x,
+                                       wp.position.y,
+                                       wp.position.z);
+
                 // TODO:  in log vào `g_resultFileStream` tại đây
                 // Format: [EVENT] time | event=UAVWaypointArrival | nodeId=... | pos=(x,y,z)
                 if (ns3::wsn::scenario5::params::g_resultFileStream)
@@ -228,6 +292,7 @@ void InitializeUavFlight()
                     {
                         g_uav1MissionCompleted = true;
                         g_uav1MissionCompletedTime = Simulator::Now().GetSeconds();
+                        LogReplayEvent(ReplayEventType::UAV1_MISSION_COMPLETE, uavNodeId, kReplayNoNode, 0);
 
                         NS_LOG_WARN("[UAV1-MISSION] Completed after leaving suspicious point"
                                     << " | t=" << g_uav1MissionCompletedTime << "s");
@@ -247,40 +312,75 @@ void InitializeUavFlight()
     }
 }
 
-void InitializeUavBroadcast()
+int64_t
+AssignUavBroadcastStreams(int64_t stream)
 {
-    NS_LOG_FUNCTION_NOARGS();
-    
-    // Get UAV flight paths
-    const auto& uavPaths = GetUavFlightPaths();
-    
-    if (uavPaths.size() < 2)
+    g_uavBroadcastLossRv = CreateObject<UniformRandomVariable>();
+    g_uavBroadcastLossRv->SetStream(stream);
+    return 1;
+}
+
+bool
+IsUavBroadcastLost()
+{
+    const double lossProbability = ns3::wsn::scenario5::params::UAV_BROADCAST_LOSS_PROBABILITY;
+    if (lossProbability <= 0.0)
     {
-        NS_LOG_WARN("[UAV-BROADCAST] UAV2 not available (need at least 2 UAVs)");
-        return;
+        return false;
     }
-    
-    // Get UAV2 (second UAV in the map)
-    auto it = uavPaths.begin();
-    ++it; // Move to second UAV
-    const uint32_t uav2NodeId = it->first;
-    const UavFlightPath& uav2Path = it->second;
-    
-    if (uav2Path.waypoints.empty())
+    if (!g_uavBroadcastLossRv)
     {
-        NS_LOG_WARN("[UAV-BROADCAST] UAV2 has no waypoints");
-        return;
+        AssignUavBroadcastStreams(ns3::wsn::scenario5::params::UAV_BROADCAST_LOSS_STREAM);
     }
-    
-    // Get fragments to broadcast
-    const FragmentCollection& fragments = GetBsGeneratedFragments();
-    
-    if (fragments.fragments.empty())
+    return g_uavBroadcastLossRv->GetValue() < lossProbability;
+}
+
+Ptr<Packet>
+BuildUavSymbolPacket(uint32_t uavNodeId, uint32_t symbolIndex, const FragmentCollection& fragments)
+{
+    const CodedFragmentSet& coded = GetBsCodedFragments();
+    PacketHeader typeHeader;
+
+    if (coded.IsBuilt() && symbolIndex >= coded.GetSourceCount())
     {
-        NS_LOG_WARN("[UAV-BROADCAST] No fragments available for broadcast");
-        return;
+        if (symbolIndex >= coded.GetSymbolCount())
+        {
+            return nullptr;
+        }
+        Ptr<Packet> pkt = Create<Packet>(coded.GetBlockSize());
+        CodedSymbolPacket symbolHeader;
+        symbolHeader.SetSymbolIndex(symbolIndex);
+        symbolHeader.SetSourceCount(coded.GetSourceCount());
+        symbolHeader.SetSourceId(uavNodeId);
+        pkt->AddHeader(symbolHeader);
+        typeHeader.SetType(PACKET_TYPE_CODED_SYMBOL);
+        pkt->AddHeader(typeHeader);
+        return pkt;
     }
-    
+
+    const Fragment* fragment = fragments.GetFragment(symbolIndex);
+    if (!fragment)
+    {
+        return nullptr;
+    }
+    Ptr<Packet> pkt = Create<Packet>(fragment->size);
+    FragmentPacket fragHeader;
+    fragHeader.SetFragmentId(fragment->fragmentId);
+    fragHeader.SetConfidence(fragment->confidence);
+    fragHeader.SetSourceId(uavNodeId);
+    pkt->AddHeader(fragHeader);
+    typeHeader.SetType(PACKET_TYPE_FRAGMENT);
+    pkt->AddHeader(typeHeader);
+    return pkt;
+}
+
+namespace {
+
+void
+ScheduleUavFragmentBroadcast(uint32_t uav2NodeId,
+                             const UavFlightPath& uav2Path,
+                             const FragmentCollection& fragments)
+{
     // UAV2 broadcasts from first waypoint until last waypoint
     const double broadcastStartTime = uav2Path.waypoints[0].arrivalTime;
     const double broadcastEndTime = uav2Path.waypoints.back().arrivalTime;
@@ -288,13 +388,17 @@ void InitializeUavBroadcast()
     
     // Calculate total broadcast duration and number of cycles
     const double totalBroadcastDuration = broadcastEndTime - broadcastStartTime;
-    const double singleCycleDuration = fragments.fragments.size() * broadcastInterval;
+    const uint32_t symbolsPerCycle = GetBsCodedFragments().IsBuilt()
+                                         ? GetBsCodedFragments().GetSymbolCount()
+                                         : fragments.GetCount();
+    const double singleCycleDuration = symbolsPerCycle * broadcastInterval;
     const uint32_t numBroadcastCycles = static_cast<uint32_t>(
         std::ceil(totalBroadcastDuration / singleCycleDuration));
     
     NS_LOG_INFO("[UAV-BROADCAST] Initializing UAV2 fragment broadcast"
                 << " | uavNodeId=" << uav2NodeId
-                << " | numFragments=" << fragments.fragments.size()
+                << " | numFragments=" << fragments.GetCount()
+                << " | symbolsPerCycle=" << symbolsPerCycle
                 << " | startTime=" << broadcastStartTime << "s"
                 << " | endTime=" << broadcastEndTime << "s"
                 << " | duration=" << totalBroadcastDuration << "s"
@@ -302,13 +406,33 @@ void InitializeUavBroadcast()
                 << " | numCycles=" << numBroadcastCycles
                 << " | interval=" << broadcastInterval << "s");
     
+    // Symbols sent each cycle: the fragment IDs in schedule order, or all n coded symbols
+    // (source symbols are the fragments themselves, sent unchanged)
+    const CodedFragmentSet& coded = GetBsCodedFragments();
+    std::vector<uint32_t> cycleSymbols;
+    if (coded.IsBuilt())
+    {
+        for (uint32_t symbol = 0; symbol < coded.GetSymbolCount(); ++symbol)
+        {
+            cycleSymbols.push_back(symbol);
+        }
+    }
+    else
+    {
+        const FragmentBroadcastSchedule& schedule = GetBsBroadcastSchedule();
+        for (uint32_t round = 0; round < schedule.GetLength(); ++round)
+        {
+            cycleSymbols.push_back(schedule.GetByRound(round).fragmentId);
+        }
+    }
+
     // Schedule broadcast cycles - repeat until reaching last waypoint
     double currentTime = broadcastStartTime;
     uint32_t totalBroadcasts = 0;
     
     for (uint32_t cycle = 0; cycle < numBroadcastCycles; ++cycle)
     {
-        for (const auto& [fragmentId, fragment] : fragments.fragments)
+        for (const uint32_t symbolIndex : cycleSymbols)
         {
             // Stop scheduling if we've reached the last waypoint time
             if (currentTime > broadcastEndTime)
@@ -317,31 +441,39 @@ void InitializeUavBroadcast()
             }
             
             const uint32_t cycleNum = cycle; // Capture for lambda
-            Simulator::Schedule(Seconds(currentTime), [uav2NodeId, fragmentId, fragment, cycleNum]() {
+            Simulator::Schedule(Seconds(currentTime), [uav2NodeId, symbolIndex, &fragments, cycleNum]() {
                 if (g_uav2MissionCompleted)
                 {
                     return;
                 }
 
+                Ptr<Packet> pkt = BuildUavSymbolPacket(uav2NodeId, symbolIndex, fragments);
+                if (!pkt)
+                {
+                    return;
+                }
+
                 NS_LOG_INFO("[UAV-BROADCAST] UAV " << uav2NodeId 
-                            << " broadcasting fragment " << fragmentId
+                            << " broadcasting symbol " << symbolIndex
                             << " (cycle " << (cycleNum + 1) << ")"
-                            << " | confidence=" << std::fixed << std::setprecision(3) << fragment.confidence
-                            << " | size=" << fragment.size << " bytes"
+                            << " | size=" << pkt->GetSize() << " bytes"
                             << " | t=" << Simulator::Now().GetSeconds() << "s");
                 
                 // Log to result file
-                if (ns3::wsn::scenario5::params::g_resultFileStream)
                 {
-                    *ns3::wsn::scenario5::params::g_resultFileStream
-                        << "\n[EVENT] " << Simulator::Now().GetSeconds()
-                        << " | event=UAVFragmentBroadcast"
-                        << " | nodeId=" << uav2NodeId
-                        << " | fragmentId=" << fragmentId
-                        << " | cycle=" << (cycleNum + 1)
-                        << " | confidence=" << std::fixed << std::setprecision(3) << fragment.confidence
-                        << " | size=" << fragment.size
-                        << std::endl;
+                    const Fragment* fragment = fragments.GetFragment(symbolIndex);
+                    const bool isParity = GetBsCodedFragments().IsBuilt() &&
+                                          symbolIndex >= GetBsCodedFragments().GetSourceCount();
+                    g_metricUavBroadcasts.Add();
+                    g_uavMissionStats[uav2NodeId].broadcasts++;
+                    LogResultUavBroadcast(isParity ? EventLogType::UAV_CODED_SYMBOL_BROADCAST
+                                                   : EventLogType::UAV_FRAGMENT_BROADCAST,
+                                          Simulator::Now().GetSeconds(),
+                                          uav2NodeId,
+                                          symbolIndex,
+                                          cycleNum + 1,
+                                          fragment ? fragment->confidence : 0.0,
+                                          fragment ? fragment->size : 0);
                 }
                 
                 // Broadcast fragment to ground nodes within radius
@@ -375,21 +507,11 @@ void InitializeUavBroadcast()
                     
                     if (distance <= broadcastRadius)
                     {
-                        // Create packet with fragment
-                        Ptr<Packet> pkt = Create<Packet>(fragment.size);
-                        
-                        // Add fragment header
-                        FragmentPacket fragHeader;
-                        fragHeader.SetFragmentId(fragmentId);
-                        fragHeader.SetConfidence(fragment.confidence);
-                        fragHeader.SetSourceId(uav2NodeId);
-                        pkt->AddHeader(fragHeader);
-                        
-                        // Add packet type header
-                        PacketHeader typeHeader;
-                        typeHeader.SetType(PACKET_TYPE_FRAGMENT);
-                        pkt->AddHeader(typeHeader);
-                        
+                        if (IsUavBroadcastLost())
+                        {
+                            continue;
+                        }
+
                         // Calculate RSSI based on distance (simplified path loss model)
                         // RSSI = TxPower - PathLoss
                         // PathLoss = 40 + 20*log10(distance) for 2.4GHz
@@ -397,13 +519,13 @@ void InitializeUavBroadcast()
                         double txPower = 0.0; // 0 dBm
                         double rssi = txPower - pathLoss;
                         
-                        // Deliver packet to ground node
+                        // Deliver packet to ground node (receiver works on its own copy)
                         OnGroundNodeReceivePacket(groundNode->GetId(), pkt, rssi);
                         nodesInRange++;
                     }
                 }
                 
-                NS_LOG_DEBUG("[UAV-BROADCAST] Fragment " << fragmentId 
+                NS_LOG_DEBUG("[UAV-BROADCAST] Symbol " << symbolIndex 
                             << " delivered to " << nodesInRange << " ground nodes"
                             << " | radius=" << broadcastRadius << "m");
             });
@@ -423,40 +545,76 @@ void InitializeUavBroadcast()
                 << " | actualEndTime=" << (currentTime - broadcastInterval) << "s");
 }
 
+} // namespace
+
+void InitializeUavBroadcast()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    
+    // Get fragments to broadcast
+    const FragmentCollection& fragments = GetBsGeneratedFragments();
+    
+    if (fragments.IsEmpty())
+    {
+        NS_LOG_WARN("[UAV-BROADCAST] No fragments available for broadcast");
+        return;
+    }
+    
+    // Every coverage UAV (UAV2 role) broadcasts along its own path
+    uint32_t broadcastingUavs = 0;
+    for (const auto& [uavNodeId, path] : GetUavFlightPaths())
+    {
+        if (path.role != UavMissionRole::AREA_COVERAGE)
+        {
+            continue;
+        }
+        if (path.waypoints.empty())
+        {
+            NS_LOG_WARN("[UAV-BROADCAST] UAV " << uavNodeId << " has no waypoints");
+            continue;
+        }
+        ScheduleUavFragmentBroadcast(uavNodeId, path, fragments);
+        broadcastingUavs++;
+    }
+    
+    if (broadcastingUavs == 0)
+    {
+        NS_LOG_WARN("[UAV-BROADCAST] UAV2 not available (need at least 2 UAVs)");
+    }
+}
+
 void InitializeCellCooperationTimeout()
 {
     NS_LOG_FUNCTION_NOARGS();
     
-    // Force cooperation timeout: Triggered when UAV2 reaches its last waypoint.
+    // Force cooperation timeout: Triggered when the last coverage UAV (UAV2 role)
+    // reaches its last waypoint.
     // At this point, all fragments have been broadcast and nodes should share
     // fragments regardless of whether they've reached the cooperation threshold.
     
-    // Get UAV flight paths
-    const auto& uavPaths = GetUavFlightPaths();
-    
-    if (uavPaths.size() < 2)
+    // Timeout = latest last-waypoint arrival among coverage UAVs
+    double cooperationTimeoutSec = -1.0;
+    uint32_t numWaypoints = 0;
+    for (const auto& [uavNodeId, path] : GetUavFlightPaths())
     {
-        NS_LOG_WARN("[CELL-COOPERATION-TIMEOUT] UAV2 not available (need at least 2 UAVs)");
-        return;
+        (void)uavNodeId;
+        if (path.role != UavMissionRole::AREA_COVERAGE || path.waypoints.empty())
+        {
+            continue;
+        }
+        cooperationTimeoutSec = std::max(cooperationTimeoutSec, path.waypoints.back().arrivalTime);
+        numWaypoints += path.waypoints.size();
     }
     
-    // Get UAV2 (second UAV in the map)
-    auto it = uavPaths.begin();
-    ++it; // Move to second UAV
-    const UavFlightPath& uav2Path = it->second;
-    
-    if (uav2Path.waypoints.empty())
+    if (cooperationTimeoutSec < 0.0)
     {
-        NS_LOG_WARN("[CELL-COOPERATION-TIMEOUT] UAV2 has no waypoints");
+        NS_LOG_WARN("[CELL-COOPERATION-TIMEOUT] UAV2 not available (need at least 2 UAVs with waypoints)");
         return;
     }
     
-    // Timeout = time when UAV2 reaches last waypoint
-    const double cooperationTimeoutSec = uav2Path.waypoints.back().arrivalTime;
-    
     NS_LOG_INFO("[CELL-COOPERATION-TIMEOUT] Scheduling forced cooperation trigger"
                 << " | uav2LastWaypointTime=" << cooperationTimeoutSec << "s"
-                << " | numWaypoints=" << uav2Path.waypoints.size());
+                << " | numWaypoints=" << numWaypoints);
     
     Simulator::Schedule(Seconds(cooperationTimeoutSec), []() {
         NS_LOG_INFO("[CELL-COOPERATION-TIMEOUT] Global timeout triggered for fallback cooperation"
@@ -470,7 +628,7 @@ void InitializeCellCooperationTimeout()
         {
             const bool hasAllFragments =
                 (state.expectedFragmentCount > 0) &&
-                (state.fragments.fragments.size() >= state.expectedFragmentCount);
+                (state.fragments.GetCount() >= state.expectedFragmentCount);
             if (state.cooperationEnabled && state.cellId >= 0 && !state.cooperationTimeoutScheduled && !hasAllFragments)
             {
                 RequestFragmentSharing(nodeId, state.cellId);
@@ -5,13 +5,42 @@
 #ifndef SCENARIO5_NODE_ROUTING_H
 #define SCENARIO5_NODE_ROUTING_H
 
+#include "fragment.h"
+#include "ns3/packet.h"
 #include <cstdint>
+#include <map>
 
 namespace ns3 {
 namespace wsn {
 namespace scenario5 {
 namespace routing {
 
+/**
+ * Role of a simulation node, recorded once when the network is built.
+ */
+enum class NodeRole : uint8_t
+{
+    UNKNOWN = 0,
+    GROUND = 1,
+    BASE_STATION = 2,
+    UAV = 3
+};
+
+/**
+ * Record the role of a node (called by the Initialize* functions).
+ */
+void SetNodeRole(uint32_t nodeId, NodeRole role);
+
+/**
+ * \return role of a node, or UNKNOWN if never recorded
+ */
+NodeRole GetNodeRole(uint32_t nodeId);
+
+/**
+ * Check if a node is a UAV without touching its mobility model.
+ */
+bool IsUavNode(uint32_t nodeId);
+
 /**
  * Initialize base station component.
  */
@@ -36,12 +65,42 @@ void InitializeUavBroadcast();
 void InitializeCellCooperationTimeout();
 
 /**
- * Mark UAV2 mission as completed early.
+ * Create the per-run UAV broadcast loss variable on a fixed stream.
+ * Called once per run, before the simulation starts.
+ *
+ * \param stream First RNG stream index
+ * \return number of streams assigned
+ */
+int64_t AssignUavBroadcastStreams(int64_t stream);
+
+/**
+ * Draw whether one UAV broadcast reception is lost
+ * (UAV_BROADCAST_LOSS_PROBABILITY).
+ */
+bool IsUavBroadcastLost();
+
+/**
+ * Build the packet a UAV sends for one broadcast symbol.
+ *
+ * Without coding, or for source symbols, this is the FRAGMENT packet of the
+ * fragment with that ID; coded parity symbols get a CODED_SYMBOL packet.
+ *
+ * \param uavNodeId Sending UAV
+ * \param symbolIndex Fragment ID or coded symbol index
+ * \param fragments BS fragment set
+ * \return packet, or nullptr for an unknown symbol
+ */
+Ptr<Packet> BuildUavSymbolPacket(uint32_t uavNodeId,
+                                 uint32_t symbolIndex,
+                                 const FragmentCollection& fragments);
+
+/**
+ * Mark UAV2 (coverage group) mission as completed early.
  */
 void MarkUav2MissionCompleted(uint32_t triggerNodeId, double triggerConfidence);
 
 /**
- * Check if UAV1 mission already completed.
+ * Check if UAV1 (node-visit group) mission already completed.
  */
 bool IsUav1MissionCompleted();
 
@@ -60,6 +119,24 @@ double GetUav1MissionCompletedTime();
  */
 double GetUav2MissionCompletedTime();
 
+/**
+ * Flight and broadcast counters of one UAV.
+ */
+struct UavMissionStats
+{
+    uint32_t waypointsReached = 0;
+    double distanceFlown = 0.0;     ///< Horizontal, along the reached waypoints (m)
+    double lastWaypointTime = -1.0; ///< Arrival at the last reached waypoint (s)
+    uint32_t broadcasts = 0;        ///< Fragment / coded symbol broadcasts
+};
+
+/**
+ * Get the mission counters of every UAV that moved or broadcast.
+ *
+ * \return UAV node ID -> counters
+ */
+const std::map<uint32_t, UavMissionStats>& GetUavMissionStats();
+
 
 } // namespace routing
 } // namespace scenario5
@@ -277,6 +277,193 @@ FragmentPacket::Deserialize(Buffer::Iterator start)
     return GetSerializedSize();
 }
 
+// ===== FragmentPacketView =====
+
+NS_OBJECT_ENSURE_REGISTERED(FragmentPacketView);
+
+FragmentPacketView::FragmentPacketView()
+    : m_isFragment(false)
+{
+}
+
+FragmentPacketView::~FragmentPacketView()
+{
+}
+
+PacketType
+FragmentPacketView::GetType() const
+{
+    return m_header.GetType();
+}
+
+bool
+FragmentPacketView::IsFragment() const
+{
+    return m_isFragment;
+}
+
+const FragmentPacket&
+FragmentPacketView::GetFragment() const
+{
+    return m_fragment;
+}
+
+TypeId
+FragmentPacketView::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::wsn::scenario5::routing::FragmentPacketView")
+        .SetParent<Header>()
+        .SetGroupName("Wsn")
+        .AddConstructor<FragmentPacketView>();
+    return tid;
+}
+
+TypeId
+FragmentPacketView::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+FragmentPacketView::Print(std::ostream& os) const
+{
+    m_header.Print(os);
+    if (m_isFragment)
+    {
+        os << " ";
+        m_fragment.Print(os);
+    }
+}
+
+uint32_t
+FragmentPacketView::GetSerializedSize() const
+{
+    return m_header.GetSerializedSize() +
+           (m_isFragment ? m_fragment.GetSerializedSize() : 0);
+}
+
+void
+FragmentPacketView::Serialize(Buffer::Iterator start) const
+{
+    m_header.Serialize(start);
+    if (m_isFragment)
+    {
+        start.Next(m_header.GetSerializedSize());
+        m_fragment.Serialize(start);
+    }
+}
+
+uint32_t
+FragmentPacketView::Deserialize(Buffer::Iterator start)
+{
+    start.Next(m_header.Deserialize(start));
+    
+    // Other packet types stop after the type byte
+    m_isFragment = (m_header.GetType() == PACKET_TYPE_FRAGMENT) &&
+                   (start.GetRemainingSize() >= m_fragment.GetSerializedSize());
+    if (m_isFragment)
+    {
+        m_fragment.Deserialize(start);
+    }
+    return GetSerializedSize();
+}
+
+// ===== CodedSymbolPacket =====
+
+NS_OBJECT_ENSURE_REGISTERED(CodedSymbolPacket);
+
+CodedSymbolPacket::CodedSymbolPacket()
+    : m_symbolIndex(0), m_sourceCount(0), m_sourceId(0)
+{
+}
+
+CodedSymbolPacket::~CodedSymbolPacket()
+{
+}
+
+void
+CodedSymbolPacket::SetSymbolIndex(uint32_t symbolIndex)
+{
+    m_symbolIndex = symbolIndex;
+}
+
+uint32_t
+CodedSymbolPacket::GetSymbolIndex() const
+{
+    return m_symbolIndex;
+}
+
+void
+CodedSymbolPacket::SetSourceCount(uint32_t sourceCount)
+{
+    m_sourceCount = sourceCount;
+}
+
+uint32_t
+CodedSymbolPacket::GetSourceCount() const
+{
+    return m_sourceCount;
+}
+
+void
+CodedSymbolPacket::SetSourceId(uint32_t sourceId)
+{
+    m_sourceId = sourceId;
+}
+
+uint32_t
+CodedSymbolPacket::GetSourceId() const
+{
+    return m_sourceId;
+}
+
+TypeId
+CodedSymbolPacket::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::wsn::scenario5::routing::CodedSymbolPacket")
+        .SetParent<Header>()
+        .SetGroupName("Wsn")
+        .AddConstructor<CodedSymbolPacket>();
+    return tid;
+}
+
+TypeId
+CodedSymbolPacket::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+CodedSymbolPacket::Print(std::ostream& os) const
+{
+    os << "CodedSymbolPacket(symbol=" << m_symbolIndex
+       << ", k=" << m_sourceCount
+       << ", source=" << m_sourceId << ")";
+}
+
+uint32_t
+CodedSymbolPacket::GetSerializedSize() const
+{
+    return 4 + 4 + 4; // symbolIndex + sourceCount + sourceId
+}
+
+void
+CodedSymbolPacket::Serialize(Buffer::Iterator start) const
+{
+    start.WriteHtonU32(m_symbolIndex);
+    start.WriteHtonU32(m_sourceCount);
+    start.WriteHtonU32(m_sourceId);
+}
+
+uint32_t
+CodedSymbolPacket::Deserialize(Buffer::Iterator start)
+{
+    m_symbolIndex = start.ReadNtohU32();
+    m_sourceCount = start.ReadNtohU32();
+    m_sourceId = start.ReadNtohU32();
+    return GetSerializedSize();
+}
+
 // ===== CooperationPacket =====
 
 NS_OBJECT_ENSURE_REGISTERED(CooperationPacket);
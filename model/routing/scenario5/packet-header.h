@@ -22,7 +22,8 @@ enum PacketType
     PACKET_TYPE_STARTUP = 1,     ///< Startup phase discovery
     PACKET_TYPE_FRAGMENT = 2,    ///< Fragment data
     PACKET_TYPE_COOPERATION = 3, ///< Cell cooperation request
-    PACKET_TYPE_UAV_COMMAND = 4  ///< UAV command (via callback, not actual network packet)
+    PACKET_TYPE_UAV_COMMAND = 4, ///< UAV command (via callback, not actual network packet)
+    PACKET_TYPE_CODED_SYMBOL = 5 ///< Reed-Solomon parity symbol of the fragment set
 };
 
 /**
@@ -118,6 +119,81 @@ private:
     uint32_t m_sourceId;
 };
 
+/**
+ * Read-only view of a FRAGMENT packet: PacketHeader followed by
+ * FragmentPacket, deserialized in one pass.
+ *
+ * Meant for PeekHeader() on the const received packet, so the fragment
+ * reception path needs neither a packet copy nor two RemoveHeader() calls.
+ * Serializes to the same bytes as the two headers added separately.
+ */
+class FragmentPacketView : public Header
+{
+public:
+    FragmentPacketView();
+    virtual ~FragmentPacketView();
+    
+    PacketType GetType() const;
+    
+    /**
+     * \return true if the packet is a complete FRAGMENT packet
+     */
+    bool IsFragment() const;
+    
+    /**
+     * \return fragment header (valid only if IsFragment())
+     */
+    const FragmentPacket& GetFragment() const;
+    
+    // Header serialization
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Print(std::ostream& os) const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    
+private:
+    PacketHeader m_header;
+    FragmentPacket m_fragment;
+    bool m_isFragment;
+};
+
+/**
+ * Coded symbol packet.
+ * 
+ * Carries one parity symbol of the erasure-coded fragment set. Symbols
+ * [0, k) are sent as plain FragmentPackets; this header is used for [k, n).
+ */
+class CodedSymbolPacket : public Header
+{
+public:
+    CodedSymbolPacket();
+    virtual ~CodedSymbolPacket();
+    
+    void SetSymbolIndex(uint32_t symbolIndex);
+    uint32_t GetSymbolIndex() const;
+    
+    void SetSourceCount(uint32_t sourceCount);
+    uint32_t GetSourceCount() const;
+    
+    void SetSourceId(uint32_t sourceId);
+    uint32_t GetSourceId() const;
+    
+    // Header serialization
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    void Print(std::ostream& os) const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    
+private:
+    uint32_t m_symbolIndex;
+    uint32_t m_sourceCount;
+    uint32_t m_sourceId;
+};
+
 /**
  * Cell cooperation request packet.
  * 
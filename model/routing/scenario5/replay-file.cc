@@ -0,0 +1,527 @@
+/*
+ * Scenario 5 - Binary Replay File Implementation
+ */
+
+#include "replay-file.h"
+#include "ns3/simulator.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+namespace {
+
+constexpr char kFileMagic[8] = {'W', 'S', 'N', 'R', 'P', 'L', '0', '1'};
+
+// Events kept in memory before a write
+constexpr size_t kEventBatch = 4096;
+
+// Stream buffer of the writer (events arrive in small records)
+constexpr size_t kFileBufferBytes = 1 << 20;
+
+// Records are used in place from the mapping
+static_assert(std::is_trivially_copyable_v<ReplayFileHeader>);
+static_assert(sizeof(ReplayFileHeader) % 8 == 0);
+static_assert(sizeof(ReplayNode) == 32);
+static_assert(sizeof(ReplayLink) == 12);
+static_assert(sizeof(ReplayCell) == 24);
+static_assert(sizeof(ReplayEvent) == 40);
+static_assert(sizeof(ReplayPath) == 24);
+static_assert(sizeof(ReplayPathPoint) == 16);
+
+constexpr uint64_t
+AlignUp(uint64_t value)
+{
+    return (value + 7) & ~uint64_t{7};
+}
+
+// Seek interval of a time; writer and reader must round identically
+uint64_t
+GetSeekSlot(double time, uint32_t seekIntervalMs)
+{
+    return static_cast<uint64_t>(std::max(0.0, time) * 1000.0 / seekIntervalMs);
+}
+
+} // namespace
+
+// ===== Writer =====
+
+ReplayWriter::ReplayWriter()
+    : m_header{},
+      m_eventCount(0),
+      m_bytesWritten(0)
+{
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    Close();
+}
+
+bool
+ReplayWriter::Open(const std::string& path, uint32_t seekIntervalMs, ReplayTopology topology)
+{
+    Close();
+    m_fileBuffer.resize(kFileBufferBytes);
+    m_file.rdbuf()->pubsetbuf(m_fileBuffer.data(), static_cast<std::streamsize>(m_fileBuffer.size()));
+    m_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        return false;
+    }
+
+    m_header = ReplayFileHeader{};
+    std::memcpy(m_header.magic, kFileMagic, sizeof(kFileMagic));
+    m_header.version = kReplayVersion;
+    m_header.headerSize = sizeof(ReplayFileHeader);
+    m_header.nodeSize = sizeof(ReplayNode);
+    m_header.linkSize = sizeof(ReplayLink);
+    m_header.cellSize = sizeof(ReplayCell);
+    m_header.eventSize = sizeof(ReplayEvent);
+    m_header.seekIntervalMs = std::max<uint32_t>(1, seekIntervalMs);
+    m_header.cellRadius = topology.cellRadius;
+    m_eventCount = 0;
+    m_bytesWritten = 0;
+    m_pending.clear();
+    m_pending.reserve(kEventBatch);
+    m_seekIndex.clear();
+    m_paths.clear();
+    m_pathPoints.clear();
+
+    // Readers look nodes up by binary search
+    std::sort(topology.nodes.begin(),
+              topology.nodes.end(),
+              [](const ReplayNode& a, const ReplayNode& b) { return a.nodeId < b.nodeId; });
+
+    // Placeholder header (complete = 0) until Close()
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_bytesWritten = sizeof(m_header);
+    m_header.nodes = WriteSection(topology.nodes.data(), sizeof(ReplayNode), topology.nodes.size());
+    m_header.links = WriteSection(topology.links.data(), sizeof(ReplayLink), topology.links.size());
+    m_header.cells = WriteSection(topology.cells.data(), sizeof(ReplayCell), topology.cells.size());
+    m_header.cellMembers =
+        WriteSection(topology.cellMembers.data(), sizeof(uint32_t), topology.cellMembers.size());
+    m_header.events = WriteSection(nullptr, sizeof(ReplayEvent), 0);
+
+    // The events section starts open-ended; a reader of an unclosed file
+    // takes it from the header written here
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_file.seekp(static_cast<std::streamoff>(m_bytesWritten));
+    return true;
+}
+
+ReplaySection
+ReplayWriter::WriteSection(const void* data, size_t recordSize, size_t count)
+{
+    static const char kPadding[8] = {};
+    const uint64_t offset = AlignUp(m_bytesWritten);
+    m_file.write(kPadding, static_cast<std::streamsize>(offset - m_bytesWritten));
+    m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(recordSize * count));
+    m_bytesWritten = offset + recordSize * count;
+    return ReplaySection{offset, count};
+}
+
+void
+ReplayWriter::Append(const ReplayEvent& event)
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    if (m_eventCount == 0)
+    {
+        m_header.startTime = event.time;
+    }
+    m_header.endTime = std::max(m_header.endTime, event.time);
+
+    // One entry per elapsed interval: index of its first event
+    const uint64_t slot = GetSeekSlot(event.time, m_header.seekIntervalMs);
+    while (m_seekIndex.size() <= slot)
+    {
+        m_seekIndex.push_back(m_eventCount);
+    }
+
+    m_pending.push_back(event);
+    m_eventCount++;
+    if (m_pending.size() >= kEventBatch)
+    {
+        FlushEvents();
+    }
+}
+
+void
+ReplayWriter::FlushEvents()
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+    const size_t bytes = m_pending.size() * sizeof(ReplayEvent);
+    m_file.write(reinterpret_cast<const char*>(m_pending.data()), static_cast<std::streamsize>(bytes));
+    m_bytesWritten += bytes;
+    m_pending.clear();
+}
+
+void
+ReplayWriter::SetPaths(std::vector<ReplayPath> paths, std::vector<ReplayPathPoint> points)
+{
+    m_paths = std::move(paths);
+    m_pathPoints = std::move(points);
+}
+
+void
+ReplayWriter::Close()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    FlushEvents();
+    m_header.events.count = m_eventCount;
+
+    // Sentinel: the last interval ends at the event count
+    m_seekIndex.push_back(m_eventCount);
+    m_header.seekIndex = WriteSection(m_seekIndex.data(), sizeof(uint64_t), m_seekIndex.size());
+    m_header.paths = WriteSection(m_paths.data(), sizeof(ReplayPath), m_paths.size());
+    m_header.pathPoints =
+        WriteSection(m_pathPoints.data(), sizeof(ReplayPathPoint), m_pathPoints.size());
+    m_header.complete = 1;
+
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_file.close();
+    m_seekIndex.clear();
+    m_paths.clear();
+    m_pathPoints.clear();
+}
+
+bool
+ReplayWriter::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+uint64_t
+ReplayWriter::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+uint64_t
+ReplayWriter::GetBytesWritten() const
+{
+    return m_bytesWritten;
+}
+
+// ===== Reader =====
+
+ReplayReader::ReplayReader()
+    : m_data(nullptr),
+      m_size(0),
+      m_header{},
+      m_eventCount(0)
+{
+}
+
+ReplayReader::~ReplayReader()
+{
+    Close();
+}
+
+bool
+ReplayReader::Open(const std::string& path, std::string& errorMsg)
+{
+    Close();
+    errorMsg.clear();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        errorMsg = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ReplayFileHeader))
+    {
+        ::close(fd);
+        errorMsg = "not a replay file (too small): " + path;
+        return false;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        errorMsg = "cannot map " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(mapping);
+    m_size = size;
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+
+    if (std::memcmp(m_header.magic, kFileMagic, sizeof(kFileMagic)) != 0)
+    {
+        errorMsg = "not a replay file (bad magic): " + path;
+    }
+    else if (m_header.version != kReplayVersion || m_header.headerSize != sizeof(ReplayFileHeader) ||
+             m_header.nodeSize != sizeof(ReplayNode) || m_header.linkSize != sizeof(ReplayLink) ||
+             m_header.cellSize != sizeof(ReplayCell) || m_header.eventSize != sizeof(ReplayEvent))
+    {
+        errorMsg = "unsupported replay version/layout: " + path;
+    }
+
+    // Unclosed file: the events run to the end of the file
+    m_eventCount = m_header.complete
+                       ? m_header.events.count
+                       : (m_size > m_header.events.offset ? (m_size - m_header.events.offset) /
+                                                                sizeof(ReplayEvent)
+                                                          : 0);
+
+    auto fits = [this](const ReplaySection& section, size_t recordSize, uint64_t count) {
+        return section.offset % 8 == 0 && section.offset <= m_size &&
+               count <= (m_size - section.offset) / recordSize;
+    };
+    const ReplayFileHeader& h = m_header;
+    bool valid = fits(h.nodes, sizeof(ReplayNode), h.nodes.count) &&
+                 fits(h.links, sizeof(ReplayLink), h.links.count) &&
+                 fits(h.cells, sizeof(ReplayCell), h.cells.count) &&
+                 fits(h.cellMembers, sizeof(uint32_t), h.cellMembers.count) &&
+                 fits(h.events, sizeof(ReplayEvent), m_eventCount);
+    if (h.complete)
+    {
+        valid = valid && fits(h.seekIndex, sizeof(uint64_t), h.seekIndex.count) &&
+                fits(h.paths, sizeof(ReplayPath), h.paths.count) &&
+                fits(h.pathPoints, sizeof(ReplayPathPoint), h.pathPoints.count) &&
+                h.seekIntervalMs > 0;
+    }
+    if (errorMsg.empty() && !valid)
+    {
+        errorMsg = "corrupt replay file (section out of range): " + path;
+    }
+    if (!errorMsg.empty())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void
+ReplayReader::Close()
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_header = ReplayFileHeader{};
+    m_eventCount = 0;
+}
+
+bool
+ReplayReader::IsOpen() const
+{
+    return m_data != nullptr;
+}
+
+bool
+ReplayReader::IsComplete() const
+{
+    return m_header.complete != 0;
+}
+
+const ReplayFileHeader&
+ReplayReader::GetHeader() const
+{
+    return m_header;
+}
+
+template <typename T>
+std::span<const T>
+ReplayReader::GetSection(const ReplaySection& section) const
+{
+    if (m_data == nullptr || section.count == 0)
+    {
+        return {};
+    }
+    return {reinterpret_cast<const T*>(m_data + section.offset), static_cast<size_t>(section.count)};
+}
+
+std::span<const ReplayNode>
+ReplayReader::GetNodes() const
+{
+    return GetSection<ReplayNode>(m_header.nodes);
+}
+
+std::span<const ReplayLink>
+ReplayReader::GetLinks() const
+{
+    return GetSection<ReplayLink>(m_header.links);
+}
+
+std::span<const ReplayCell>
+ReplayReader::GetCells() const
+{
+    return GetSection<ReplayCell>(m_header.cells);
+}
+
+std::span<const uint32_t>
+ReplayReader::GetCellMembers(const ReplayCell& cell) const
+{
+    const std::span<const uint32_t> members = GetSection<uint32_t>(m_header.cellMembers);
+    if (cell.firstMember > members.size() || cell.memberCount > members.size() - cell.firstMember)
+    {
+        return {};
+    }
+    return members.subspan(cell.firstMember, cell.memberCount);
+}
+
+std::span<const ReplayEvent>
+ReplayReader::GetEvents() const
+{
+    return GetSection<ReplayEvent>(ReplaySection{m_header.events.offset, m_eventCount});
+}
+
+std::span<const ReplayPath>
+ReplayReader::GetPaths() const
+{
+    return IsComplete() ? GetSection<ReplayPath>(m_header.paths) : std::span<const ReplayPath>{};
+}
+
+std::span<const ReplayPathPoint>
+ReplayReader::GetPathPoints(const ReplayPath& path) const
+{
+    if (!IsComplete())
+    {
+        return {};
+    }
+    const std::span<const ReplayPathPoint> points = GetSection<ReplayPathPoint>(m_header.pathPoints);
+    if (path.firstPoint > points.size() || path.pointCount > points.size() - path.firstPoint)
+    {
+        return {};
+    }
+    return points.subspan(path.firstPoint, path.pointCount);
+}
+
+const ReplayNode*
+ReplayReader::FindNode(uint32_t nodeId) const
+{
+    const std::span<const ReplayNode> nodes = GetNodes();
+    auto it = std::lower_bound(nodes.begin(), nodes.end(), nodeId, [](const ReplayNode& node, uint32_t id) {
+        return node.nodeId < id;
+    });
+    return (it != nodes.end() && it->nodeId == nodeId) ? &*it : nullptr;
+}
+
+size_t
+ReplayReader::FindFirstEventAt(double time) const
+{
+    const std::span<const ReplayEvent> events = GetEvents();
+    size_t lo = 0;
+    size_t hi = events.size();
+
+    // Narrow to one interval of the seek index, then search inside it
+    const std::span<const uint64_t> seek =
+        IsComplete() ? GetSection<uint64_t>(m_header.seekIndex) : std::span<const uint64_t>{};
+    if (seek.size() >= 2 && time >= 0.0)
+    {
+        const uint64_t slot = GetSeekSlot(time, m_header.seekIntervalMs);
+        if (slot >= seek.size() - 1)
+        {
+            lo = static_cast<size_t>(std::min<uint64_t>(seek.back(), hi));
+        }
+        else
+        {
+            const size_t k = static_cast<size_t>(slot);
+            lo = static_cast<size_t>(std::min<uint64_t>(seek[k], hi));
+            hi = static_cast<size_t>(std::min<uint64_t>(seek[k + 1], hi));
+        }
+    }
+
+    auto it = std::lower_bound(events.begin() + lo,
+                               events.begin() + hi,
+                               time,
+                               [](const ReplayEvent& event, double t) { return event.time < t; });
+    return static_cast<size_t>(it - events.begin());
+}
+
+std::span<const ReplayEvent>
+ReplayReader::GetEventsBetween(double from, double to) const
+{
+    if (to <= from)
+    {
+        return {};
+    }
+    const size_t first = FindFirstEventAt(from);
+    const size_t last = std::max(first, FindFirstEventAt(to));
+    return GetEvents().subspan(first, last - first);
+}
+
+// ===== Scenario log =====
+
+ReplayWriter&
+GetResultReplay()
+{
+    static ReplayWriter replay;
+    return replay;
+}
+
+void
+LogReplayEvent(ReplayEventType type, uint32_t nodeId, uint32_t peerId, uint32_t index, double value)
+{
+    ReplayWriter& replay = GetResultReplay();
+    if (!replay.IsOpen())
+    {
+        return;
+    }
+    ReplayEvent event{};
+    event.time = Simulator::Now().GetSeconds();
+    event.type = static_cast<uint16_t>(type);
+    event.nodeId = nodeId;
+    event.peerId = peerId;
+    event.index = index;
+    event.value = static_cast<float>(value);
+    replay.Append(event);
+}
+
+void
+LogReplayPositionEvent(ReplayEventType type,
+                       uint32_t nodeId,
+                       uint32_t index,
+                       double x,
+                       double y,
+                       double z)
+{
+    ReplayWriter& replay = GetResultReplay();
+    if (!replay.IsOpen())
+    {
+        return;
+    }
+    ReplayEvent event{};
+    event.time = Simulator::Now().GetSeconds();
+    event.type = static_cast<uint16_t>(type);
+    event.nodeId = nodeId;
+    event.peerId = kReplayNoNode;
+    event.index = index;
+    event.x = static_cast<float>(x);
+    event.y = static_cast<float>(y);
+    event.z = static_cast<float>(z);
+    replay.Append(event);
+}
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
@@ -0,0 +1,339 @@
+/*
+ * Scenario 5 - Binary Replay File
+ *
+ * Compact, memory-mappable export of a run for the visualizer and offline
+ * analysis: the topology (nodes, links, cells), the planned UAV paths and a
+ * time-ordered event stream with a seek index, so any time window can be
+ * located without scanning or re-running the simulation.
+ *
+ * Every section is an array of fixed-size, 8-byte aligned records; the
+ * reader uses them in place (host byte order, little-endian on every
+ * supported target):
+ *
+ *   ReplayFileHeader  magic "WSNRPL01", record sizes, section table
+ *   nodes             ReplayNode, sorted by node ID
+ *   links             ReplayLink
+ *   cells             ReplayCell, members in the cellMembers section
+ *   cellMembers       u32 node IDs
+ *   events            ReplayEvent, non-decreasing time
+ *   seekIndex         u64 per interval: first event at or after k*interval
+ *   paths             ReplayPath, waypoints in the pathPoints section
+ *   pathPoints        ReplayPathPoint
+ *
+ * Events are streamed to disk while the simulation runs; the seek index,
+ * the UAV paths and the final header are written by Close(). A file whose
+ * writer never closed still opens: the events on disk are used and time
+ * lookups fall back to a binary search.
+ */
+
+#ifndef SCENARIO5_REPLAY_FILE_H
+#define SCENARIO5_REPLAY_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+constexpr uint32_t kReplayVersion = 1;
+constexpr uint32_t kReplayNoNode = UINT32_MAX;
+
+/**
+ * Event types of the replay stream (1-5 match EventLogType).
+ */
+enum class ReplayEventType : uint16_t
+{
+    FRAGMENT_RECEIVED = 1,          ///< nodeId <- peerId, index = fragment ID
+    FRAGMENT_SHARED = 2,            ///< nodeId <- peerId, index = fragment ID
+    CODED_SYMBOL_RECEIVED = 3,      ///< nodeId <- peerId, index = symbol index
+    UAV_FRAGMENT_BROADCAST = 4,     ///< index = fragment ID, value = confidence
+    UAV_CODED_SYMBOL_BROADCAST = 5, ///< index = symbol index
+    UAV_WAYPOINT_ARRIVAL = 6,       ///< index = waypoint index, x/y/z = position
+    UAV1_MISSION_COMPLETE = 7,      ///< nodeId = node-visit UAV
+    UAV2_MISSION_COMPLETE = 8       ///< peerId = trigger node, value = its confidence
+};
+
+/**
+ * Node flags (ReplayNode::flags).
+ */
+enum ReplayNodeFlag : uint8_t
+{
+    REPLAY_NODE_CELL_LEADER = 1 << 0,
+    REPLAY_NODE_SUSPICIOUS = 1 << 1,
+    REPLAY_NODE_GATEWAY = 1 << 2,
+    REPLAY_NODE_SUSPICIOUS_SEED = 1 << 3 ///< Node at the suspicious point
+};
+
+/**
+ * Link kinds (ReplayLink::kind).
+ */
+enum class ReplayLinkKind : uint16_t
+{
+    NEIGHBOR = 1,  ///< Discovered radio neighbours (a < b)
+    ROUTE_TREE = 2 ///< Intra-cell routing tree, a -> next hop b
+};
+
+struct ReplaySection
+{
+    uint64_t offset; ///< Byte offset from the start of the file
+    uint64_t count;  ///< Records
+};
+
+struct ReplayFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint16_t nodeSize;
+    uint16_t linkSize;
+    uint16_t cellSize;
+    uint16_t eventSize;
+    uint32_t seekIntervalMs;
+    uint32_t complete; ///< 1 once Close() has written the trailing sections
+    ReplaySection nodes;
+    ReplaySection links;
+    ReplaySection cells;
+    ReplaySection cellMembers;
+    ReplaySection events;
+    ReplaySection seekIndex;
+    ReplaySection paths;
+    ReplaySection pathPoints;
+    double startTime;  ///< First event (s)
+    double endTime;    ///< Last event (s)
+    double cellRadius; ///< Hex cell radius (m)
+};
+
+struct ReplayNode
+{
+    uint32_t nodeId;
+    int32_t cellId;    ///< -1 for the BS and UAVs
+    uint32_t leaderId; ///< Leader of the cell (the node itself when none)
+    uint8_t role;      ///< NodeRole
+    uint8_t color;
+    uint8_t flags;     ///< ReplayNodeFlag bits
+    uint8_t reserved;
+    float x;
+    float y;
+    float z;
+    uint32_t reserved2;
+};
+
+struct ReplayLink
+{
+    uint32_t a;
+    uint32_t b;
+    uint16_t kind; ///< ReplayLinkKind
+    uint16_t reserved;
+};
+
+struct ReplayCell
+{
+    int32_t cellId;
+    uint32_t leaderId;
+    uint32_t color;
+    uint32_t firstMember; ///< Index into cellMembers
+    uint32_t memberCount;
+    uint32_t reserved;
+};
+
+struct ReplayEvent
+{
+    double time; ///< Simulation time (s)
+    uint16_t type; ///< ReplayEventType
+    uint16_t reserved;
+    uint32_t nodeId;
+    uint32_t peerId; ///< kReplayNoNode if unused
+    uint32_t index;
+    float x;
+    float y;
+    float z;
+    float value;
+};
+
+struct ReplayPath
+{
+    uint32_t uavNodeId;
+    uint32_t role;       ///< UavMissionRole
+    uint32_t firstPoint; ///< Index into pathPoints
+    uint32_t pointCount;
+    double totalTime;
+};
+
+struct ReplayPathPoint
+{
+    float x;
+    float y;
+    float z;
+    float arrivalTime;
+};
+
+/**
+ * Static part of a replay, written by ReplayWriter::Open().
+ */
+struct ReplayTopology
+{
+    double cellRadius = 0.0;
+    std::vector<ReplayNode> nodes;
+    std::vector<ReplayLink> links;
+    std::vector<ReplayCell> cells;
+    std::vector<uint32_t> cellMembers;
+};
+
+/**
+ * Streaming writer of a replay file.
+ */
+class ReplayWriter
+{
+public:
+    ReplayWriter();
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    /**
+     * Create the file and write the topology.
+     *
+     * \param path Output file
+     * \param seekIntervalMs Seek index granularity (ms, > 0)
+     * \param topology Nodes (any order), links and cells
+     * \return false if the file cannot be created
+     */
+    bool Open(const std::string& path, uint32_t seekIntervalMs, ReplayTopology topology);
+
+    /**
+     * Append an event; times must not decrease.
+     */
+    void Append(const ReplayEvent& event);
+
+    /**
+     * Set the planned UAV paths (written by Close()).
+     */
+    void SetPaths(std::vector<ReplayPath> paths, std::vector<ReplayPathPoint> points);
+
+    /**
+     * Write the buffered events, the seek index and the paths, then the
+     * final header.
+     */
+    void Close();
+
+    bool IsOpen() const;
+    uint64_t GetEventCount() const;
+    uint64_t GetBytesWritten() const;
+
+private:
+    void FlushEvents();
+    ReplaySection WriteSection(const void* data, size_t recordSize, size_t count);
+
+    std::ofstream m_file;
+    std::vector<char> m_fileBuffer;
+    ReplayFileHeader m_header;
+    std::vector<ReplayEvent> m_pending;
+    std::vector<uint64_t> m_seekIndex;
+    std::vector<ReplayPath> m_paths;
+    std::vector<ReplayPathPoint> m_pathPoints;
+    uint64_t m_eventCount;
+    uint64_t m_bytesWritten;
+};
+
+/**
+ * Read-only, memory-mapped view of a replay file. Spans stay valid until
+ * Close() or destruction.
+ */
+class ReplayReader
+{
+public:
+    ReplayReader();
+    ~ReplayReader();
+
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+
+    /**
+     * Map a replay file and validate its layout.
+     *
+     * \param path Replay file
+     * \param errorMsg Reason when the file cannot be used
+     * \return false on error
+     */
+    bool Open(const std::string& path, std::string& errorMsg);
+
+    void Close();
+
+    bool IsOpen() const;
+
+    /**
+     * \return false if the writer never closed the file (no seek index or
+     *         paths; events are whatever reached the disk)
+     */
+    bool IsComplete() const;
+
+    const ReplayFileHeader& GetHeader() const;
+
+    std::span<const ReplayNode> GetNodes() const;
+    std::span<const ReplayLink> GetLinks() const;
+    std::span<const ReplayCell> GetCells() const;
+    std::span<const uint32_t> GetCellMembers(const ReplayCell& cell) const;
+    std::span<const ReplayEvent> GetEvents() const;
+    std::span<const ReplayPath> GetPaths() const;
+    std::span<const ReplayPathPoint> GetPathPoints(const ReplayPath& path) const;
+
+    /**
+     * \return node record, or nullptr if the ID is unknown
+     */
+    const ReplayNode* FindNode(uint32_t nodeId) const;
+
+    /**
+     * Events with from <= time < to, located through the seek index.
+     */
+    std::span<const ReplayEvent> GetEventsBetween(double from, double to) const;
+
+private:
+    template <typename T>
+    std::span<const T> GetSection(const ReplaySection& section) const;
+
+    size_t FindFirstEventAt(double time) const;
+
+    const uint8_t* m_data;
+    size_t m_size;
+    ReplayFileHeader m_header;
+    uint64_t m_eventCount; ///< From the header, or the file size if incomplete
+};
+
+/**
+ * \return replay writer of the scenario (closed unless opened by the example)
+ */
+ReplayWriter& GetResultReplay();
+
+/**
+ * Append an event to the result replay if it is open.
+ */
+void LogReplayEvent(ReplayEventType type,
+                    uint32_t nodeId,
+                    uint32_t peerId,
+                    uint32_t index,
+                    double value = 0.0);
+
+/**
+ * Append a positioned event (UAV_WAYPOINT_ARRIVAL) to the result replay if
+ * it is open.
+ */
+void LogReplayPositionEvent(ReplayEventType type,
+                            uint32_t nodeId,
+                            uint32_t index,
+                            double x,
+                            double y,
+                            double z);
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_REPLAY_FILE_H
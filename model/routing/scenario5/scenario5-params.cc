@@ -18,7 +18,7 @@ namespace params
 // Global result file stream definition
 // This is managed by example4.cc - it opens and closes the stream
 // Other files can write directly: if (g_resultFileStream) *g_resultFileStream << "content";
-std::ofstream* g_resultFileStream = nullptr;
+std::ostream* g_resultFileStream = nullptr;
 
 } // namespace params
 } // namespace scenario5
@@ -0,0 +1,473 @@
+/*
+ * Scenario 5 - Network State Snapshot File Implementation
+ */
+
+#include "snapshot-file.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+namespace {
+
+constexpr char kFileMagic[8] = {'W', 'S', 'N', 'S', 'N', 'P', '0', '1'};
+
+static_assert(std::is_trivially_copyable_v<SnapshotFileHeader>);
+static_assert(sizeof(SnapshotFileHeader) == 96);
+static_assert(sizeof(SnapshotFrameHeader) == 16);
+
+constexpr uint64_t
+AlignUp(uint64_t value)
+{
+    return (value + 7) & ~uint64_t{7};
+}
+
+uint64_t
+ZigZag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t
+UnZigZag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void
+PutVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool
+GetVarint(const uint8_t*& pos, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 64 && pos < end; shift += 7)
+    {
+        const uint8_t byte = *pos++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Node table size including the padding to the first frame
+uint64_t
+GetFramesOffset(uint32_t nodeCount)
+{
+    return AlignUp(sizeof(SnapshotFileHeader) + uint64_t{nodeCount} * sizeof(uint32_t));
+}
+
+} // namespace
+
+// ===== Writer =====
+
+SnapshotWriter::SnapshotWriter()
+    : m_header{},
+      m_frameCount(0),
+      m_bytesWritten(0)
+{
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    Close();
+}
+
+bool
+SnapshotWriter::Open(const std::string& path,
+                     uint32_t intervalMs,
+                     uint32_t keyframeInterval,
+                     const std::vector<uint32_t>& nodeIds,
+                     const std::array<double, kSnapshotColumnCount>& columnScale)
+{
+    Close();
+    m_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        return false;
+    }
+
+    m_header = SnapshotFileHeader{};
+    std::memcpy(m_header.magic, kFileMagic, sizeof(kFileMagic));
+    m_header.version = kSnapshotVersion;
+    m_header.headerSize = sizeof(SnapshotFileHeader);
+    m_header.nodeCount = static_cast<uint32_t>(nodeIds.size());
+    m_header.columnCount = kSnapshotColumnCount;
+    m_header.intervalMs = intervalMs;
+    m_header.keyframeInterval = std::max<uint32_t>(1, keyframeInterval);
+    std::copy(columnScale.begin(), columnScale.end(), m_header.columnScale);
+    m_frameCount = 0;
+    for (std::vector<int64_t>& column : m_previous)
+    {
+        column.assign(nodeIds.size(), 0);
+    }
+    m_payload.clear();
+
+    static const char kPadding[8] = {};
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_file.write(reinterpret_cast<const char*>(nodeIds.data()),
+                 static_cast<std::streamsize>(nodeIds.size() * sizeof(uint32_t)));
+    m_bytesWritten = GetFramesOffset(m_header.nodeCount);
+    m_file.write(kPadding,
+                 static_cast<std::streamsize>(m_bytesWritten - sizeof(m_header) -
+                                              nodeIds.size() * sizeof(uint32_t)));
+    return true;
+}
+
+void
+SnapshotWriter::Append(const SnapshotFrame& frame)
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    const bool keyframe = (m_frameCount % m_header.keyframeInterval) == 0;
+    const size_t nodeCount = m_header.nodeCount;
+
+    m_payload.clear();
+    for (uint32_t c = 0; c < kSnapshotColumnCount; ++c)
+    {
+        const std::vector<int64_t>& values = frame.columns[c];
+        std::vector<int64_t>& previous = m_previous[c];
+        uint64_t run = 0;
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            const int64_t base = keyframe ? 0 : previous[i];
+            if (values[i] == base)
+            {
+                run++;
+                continue;
+            }
+            PutVarint(m_payload, run);
+            PutVarint(m_payload, ZigZag(values[i] - base));
+            run = 0;
+        }
+        if (run > 0)
+        {
+            PutVarint(m_payload, run);
+        }
+        std::copy(values.begin(), values.begin() + nodeCount, previous.begin());
+    }
+
+    SnapshotFrameHeader header{};
+    header.time = frame.time;
+    header.payloadBytes = static_cast<uint32_t>(m_payload.size());
+    header.flags = keyframe ? SNAPSHOT_FRAME_KEYFRAME : 0;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_file.write(reinterpret_cast<const char*>(m_payload.data()),
+                 static_cast<std::streamsize>(m_payload.size()));
+    m_bytesWritten += sizeof(header) + m_payload.size();
+
+    if (m_frameCount == 0)
+    {
+        m_header.startTime = frame.time;
+    }
+    m_header.endTime = frame.time;
+    m_frameCount++;
+}
+
+void
+SnapshotWriter::Close()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    m_header.frameCount = m_frameCount;
+    m_header.complete = 1;
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_file.close();
+    for (std::vector<int64_t>& column : m_previous)
+    {
+        column.clear();
+    }
+}
+
+bool
+SnapshotWriter::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+uint32_t
+SnapshotWriter::GetNodeCount() const
+{
+    return m_header.nodeCount;
+}
+
+uint64_t
+SnapshotWriter::GetFrameCount() const
+{
+    return m_frameCount;
+}
+
+uint64_t
+SnapshotWriter::GetBytesWritten() const
+{
+    return m_bytesWritten;
+}
+
+// ===== Reader =====
+
+SnapshotReader::SnapshotReader()
+    : m_data(nullptr),
+      m_size(0),
+      m_header{},
+      m_cursorIndex(SIZE_MAX)
+{
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    Close();
+}
+
+bool
+SnapshotReader::Open(const std::string& path, std::string& errorMsg)
+{
+    Close();
+    errorMsg.clear();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        errorMsg = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SnapshotFileHeader))
+    {
+        ::close(fd);
+        errorMsg = "not a snapshot file (too small): " + path;
+        return false;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        errorMsg = "cannot map " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(mapping);
+    m_size = size;
+
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    if (std::memcmp(m_header.magic, kFileMagic, sizeof(kFileMagic)) != 0)
+    {
+        errorMsg = "not a snapshot file (bad magic): " + path;
+    }
+    else if (m_header.version != kSnapshotVersion ||
+             m_header.headerSize != sizeof(SnapshotFileHeader) ||
+             m_header.columnCount != kSnapshotColumnCount || m_header.keyframeInterval == 0)
+    {
+        errorMsg = "unsupported snapshot version/layout: " + path;
+    }
+    else if (GetFramesOffset(m_header.nodeCount) > m_size)
+    {
+        errorMsg = "corrupt snapshot file (node table out of range): " + path;
+    }
+    if (!errorMsg.empty())
+    {
+        Close();
+        return false;
+    }
+
+    // Index the frames; an unclosed file ends at its last complete frame
+    uint64_t offset = GetFramesOffset(m_header.nodeCount);
+    while (offset + sizeof(SnapshotFrameHeader) <= m_size)
+    {
+        if (m_header.complete && m_frameOffsets.size() == m_header.frameCount)
+        {
+            break;
+        }
+        SnapshotFrameHeader frame;
+        std::memcpy(&frame, m_data + offset, sizeof(frame));
+        if (frame.payloadBytes > m_size - offset - sizeof(frame))
+        {
+            break;
+        }
+        m_frameOffsets.push_back(offset);
+        m_frameTimes.push_back(frame.time);
+        m_keyframes.push_back((frame.flags & SNAPSHOT_FRAME_KEYFRAME) ? 1 : 0);
+        offset += sizeof(frame) + frame.payloadBytes;
+    }
+    if (m_header.complete && m_frameOffsets.size() != m_header.frameCount)
+    {
+        errorMsg = "corrupt snapshot file (frames out of range): " + path;
+        Close();
+        return false;
+    }
+
+    m_cursor.time = 0.0;
+    for (std::vector<int64_t>& column : m_cursor.columns)
+    {
+        column.assign(m_header.nodeCount, 0);
+    }
+    return true;
+}
+
+void
+SnapshotReader::Close()
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_header = SnapshotFileHeader{};
+    m_frameOffsets.clear();
+    m_frameTimes.clear();
+    m_keyframes.clear();
+    m_cursorIndex = SIZE_MAX;
+}
+
+bool
+SnapshotReader::IsOpen() const
+{
+    return m_data != nullptr;
+}
+
+bool
+SnapshotReader::IsComplete() const
+{
+    return m_header.complete != 0;
+}
+
+const SnapshotFileHeader&
+SnapshotReader::GetHeader() const
+{
+    return m_header;
+}
+
+std::span<const uint32_t>
+SnapshotReader::GetNodeIds() const
+{
+    if (m_data == nullptr)
+    {
+        return {};
+    }
+    return {reinterpret_cast<const uint32_t*>(m_data + sizeof(SnapshotFileHeader)),
+            m_header.nodeCount};
+}
+
+size_t
+SnapshotReader::GetFrameCount() const
+{
+    return m_frameOffsets.size();
+}
+
+double
+SnapshotReader::GetFrameTime(size_t index) const
+{
+    return m_frameTimes[index];
+}
+
+bool
+SnapshotReader::ReadFrame(size_t index, SnapshotFrame& frame)
+{
+    if (index >= m_frameOffsets.size())
+    {
+        return false;
+    }
+
+    if (index != m_cursorIndex)
+    {
+        // Continue from the cursor when it is on the way, else from the
+        // keyframe at or before the frame (frame 0 always is one)
+        size_t start = index;
+        while (start > 0 && !m_keyframes[start] &&
+               !(m_cursorIndex != SIZE_MAX && start == m_cursorIndex + 1))
+        {
+            start--;
+        }
+        for (size_t i = start; i <= index; ++i)
+        {
+            if (!DecodeFrame(i))
+            {
+                m_cursorIndex = SIZE_MAX;
+                return false;
+            }
+        }
+    }
+    frame = m_cursor;
+    return true;
+}
+
+bool
+SnapshotReader::DecodeFrame(size_t index)
+{
+    SnapshotFrameHeader header;
+    std::memcpy(&header, m_data + m_frameOffsets[index], sizeof(header));
+    const uint8_t* pos = m_data + m_frameOffsets[index] + sizeof(header);
+    const uint8_t* end = pos + header.payloadBytes;
+    const bool keyframe = (header.flags & SNAPSHOT_FRAME_KEYFRAME) != 0;
+    const uint64_t nodeCount = m_header.nodeCount;
+
+    for (std::vector<int64_t>& values : m_cursor.columns)
+    {
+        if (keyframe)
+        {
+            std::fill(values.begin(), values.end(), 0);
+        }
+        uint64_t node = 0;
+        while (node < nodeCount)
+        {
+            uint64_t run = 0;
+            if (!GetVarint(pos, end, run) || run > nodeCount - node)
+            {
+                return false;
+            }
+            node += run;
+            if (node == nodeCount)
+            {
+                break;
+            }
+            uint64_t delta = 0;
+            if (!GetVarint(pos, end, delta))
+            {
+                return false;
+            }
+            values[node] += UnZigZag(delta);
+            node++;
+        }
+    }
+    m_cursor.time = header.time;
+    m_cursorIndex = index;
+    return pos == end;
+}
+
+SnapshotWriter&
+GetResultSnapshots()
+{
+    static SnapshotWriter snapshots;
+    return snapshots;
+}
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
@@ -0,0 +1,235 @@
+/*
+ * Scenario 5 - Network State Snapshot File
+ *
+ * Time series of per-node state sampled at a fixed interval, for plotting
+ * confidence propagation, fragment collection and energy over a run without
+ * verbose logs. One file holds every frame of one run:
+ *
+ *   SnapshotFileHeader  magic "WSNSNP01", node/column counts, column scales
+ *   nodeIds             u32 per node, the column order of every frame
+ *   frames              SnapshotFrameHeader + payload, in time order
+ *
+ * A payload has one delta-encoded column per SnapshotColumn. Values are
+ * fixed-point integers (value = raw / columnScale[column]); each is stored
+ * as the difference to the same node in the previous frame, or to zero in
+ * a keyframe. A column is a sequence of varint pairs
+ *
+ *   unchanged-run  zigzag(delta)
+ *
+ * that skips the nodes whose value did not change, so a quiet interval
+ * costs a few bytes regardless of the node count. Keyframes every
+ * keyframeInterval frames bound the decoding work of a random frame.
+ */
+
+#ifndef SCENARIO5_SNAPSHOT_FILE_H
+#define SCENARIO5_SNAPSHOT_FILE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+constexpr uint32_t kSnapshotVersion = 1;
+
+/**
+ * Columns of a snapshot frame.
+ */
+enum class SnapshotColumn : uint32_t
+{
+    CONFIDENCE = 0,      ///< Fused confidence
+    FRAGMENT_COUNT = 1,  ///< Fragments held
+    ENERGY = 2,          ///< Remaining energy (J)
+    LIFECYCLE_PHASE = 3  ///< GroundNodeLifecyclePhase
+};
+
+constexpr uint32_t kSnapshotColumnCount = 4;
+
+/**
+ * Frame flags (SnapshotFrameHeader::flags).
+ */
+enum SnapshotFrameFlag : uint16_t
+{
+    SNAPSHOT_FRAME_KEYFRAME = 1 << 0 ///< Deltas are against zero
+};
+
+struct SnapshotFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t nodeCount;
+    uint32_t columnCount;
+    uint32_t intervalMs;
+    uint32_t keyframeInterval;
+    uint64_t frameCount; ///< Set by Close(); readers of unclosed files scan
+    uint32_t complete;   ///< 1 once Close() has patched the header
+    uint32_t reserved;
+    double columnScale[kSnapshotColumnCount]; ///< Fixed-point units per raw unit
+    double startTime; ///< First frame (s)
+    double endTime;   ///< Last frame (s)
+};
+
+struct SnapshotFrameHeader
+{
+    double time;           ///< Simulation time (s)
+    uint32_t payloadBytes; ///< Encoded columns that follow
+    uint16_t flags;        ///< SnapshotFrameFlag bits
+    uint16_t reserved;
+};
+
+/**
+ * Decoded frame: one fixed-point value per node and column, in nodeIds
+ * order.
+ */
+struct SnapshotFrame
+{
+    double time = 0.0;
+    std::array<std::vector<int64_t>, kSnapshotColumnCount> columns;
+
+    /**
+     * \return column values of a node index
+     */
+    int64_t Get(SnapshotColumn column, size_t nodeIndex) const
+    {
+        return columns[static_cast<uint32_t>(column)][nodeIndex];
+    }
+};
+
+/**
+ * Streaming writer of a snapshot file.
+ */
+class SnapshotWriter
+{
+public:
+    SnapshotWriter();
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    /**
+     * Create the file and write the node table.
+     *
+     * \param path Output file
+     * \param intervalMs Sampling interval, recorded for readers
+     * \param keyframeInterval Frames between keyframes (>= 1)
+     * \param nodeIds Nodes, in the column order of every frame
+     * \param columnScale Fixed-point scale of each column
+     * \return false if the file cannot be created
+     */
+    bool Open(const std::string& path,
+              uint32_t intervalMs,
+              uint32_t keyframeInterval,
+              const std::vector<uint32_t>& nodeIds,
+              const std::array<double, kSnapshotColumnCount>& columnScale);
+
+    /**
+     * Encode and append a frame; every column must hold one value per node
+     * and times must not decrease.
+     */
+    void Append(const SnapshotFrame& frame);
+
+    /**
+     * Patch the final header and close the file.
+     */
+    void Close();
+
+    bool IsOpen() const;
+    uint32_t GetNodeCount() const;
+    uint64_t GetFrameCount() const;
+    uint64_t GetBytesWritten() const;
+
+private:
+    std::ofstream m_file;
+    SnapshotFileHeader m_header;
+    std::array<std::vector<int64_t>, kSnapshotColumnCount> m_previous;
+    std::vector<uint8_t> m_payload;
+    uint64_t m_frameCount;
+    uint64_t m_bytesWritten;
+};
+
+/**
+ * Read-only, memory-mapped view of a snapshot file with frame decoding.
+ */
+class SnapshotReader
+{
+public:
+    SnapshotReader();
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    /**
+     * Map a snapshot file and index its frames.
+     *
+     * \param path Snapshot file
+     * \param errorMsg Reason when the file cannot be used
+     * \return false on error
+     */
+    bool Open(const std::string& path, std::string& errorMsg);
+
+    void Close();
+
+    bool IsOpen() const;
+
+    /**
+     * \return false if the writer never closed the file (frames are the
+     *         complete ones that reached the disk)
+     */
+    bool IsComplete() const;
+
+    const SnapshotFileHeader& GetHeader() const;
+
+    std::span<const uint32_t> GetNodeIds() const;
+
+    size_t GetFrameCount() const;
+
+    /**
+     * \return time of a frame (s)
+     */
+    double GetFrameTime(size_t index) const;
+
+    /**
+     * Decode a frame. Reading frames in order decodes each payload once;
+     * a jump decodes from the keyframe at or before the frame.
+     *
+     * \param index Frame index, < GetFrameCount()
+     * \param frame Output values
+     * \return false if a payload is corrupt
+     */
+    bool ReadFrame(size_t index, SnapshotFrame& frame);
+
+private:
+    bool DecodeFrame(size_t index);
+
+    const uint8_t* m_data;
+    size_t m_size;
+    SnapshotFileHeader m_header;
+    std::vector<uint64_t> m_frameOffsets; ///< Frame header offsets
+    std::vector<double> m_frameTimes;
+    std::vector<uint8_t> m_keyframes;     ///< 1 if the frame is a keyframe
+    SnapshotFrame m_cursor;               ///< Values of the last decoded frame
+    size_t m_cursorIndex;                 ///< SIZE_MAX if nothing is decoded
+};
+
+/**
+ * \return snapshot writer of the scenario (closed unless opened by the
+ *         example)
+ */
+SnapshotWriter& GetResultSnapshots();
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_SNAPSHOT_FILE_H
@@ -0,0 +1,180 @@
+/*
+ * Scenario 5 - Result Trace Policy Implementation
+ */
+
+#include "trace-policy.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+namespace {
+
+constexpr uint32_t kAllTypesMask = (1u << kEventLogTypeCount) - 1;
+
+const char* kTypeNames[kEventLogTypeCount] = {"text",
+                                              "received",
+                                              "shared",
+                                              "coded",
+                                              "uavFragment",
+                                              "uavSymbol"};
+
+// SplitMix64 finalizer: sampling decisions independent of event order
+uint64_t
+Mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+TracePolicy g_resultTracePolicy;
+
+TracePolicy::TracePolicy()
+{
+    Reset();
+}
+
+void
+TracePolicy::Reset()
+{
+    m_windowOpen = true;
+    m_seed = 0;
+    m_nodeFilter.clear();
+    for (uint32_t i = 0; i < kEventLogTypeCount; ++i)
+    {
+        m_sampleRate[i] = 1.0;
+        m_sampleThreshold[i] = UINT64_MAX;
+        m_sampleCounter[i] = 0;
+    }
+    UpdateMasks();
+}
+
+void
+TracePolicy::SetSampleRate(EventLogType type, double rate)
+{
+    const uint16_t i = static_cast<uint16_t>(type);
+    m_sampleRate[i] = std::clamp(rate, 0.0, 1.0);
+    m_sampleThreshold[i] = (m_sampleRate[i] >= 1.0)
+                               ? UINT64_MAX
+                               : static_cast<uint64_t>(std::ldexp(m_sampleRate[i], 64));
+    UpdateMasks();
+}
+
+void
+TracePolicy::SetNodeFilter(const std::vector<uint32_t>& nodeIds)
+{
+    m_nodeFilter.clear();
+    if (!nodeIds.empty())
+    {
+        m_nodeFilter.assign(*std::max_element(nodeIds.begin(), nodeIds.end()) + 1, 0);
+        for (uint32_t nodeId : nodeIds)
+        {
+            m_nodeFilter[nodeId] = 1;
+        }
+    }
+    UpdateMasks();
+}
+
+void
+TracePolicy::SetSeed(uint64_t seed)
+{
+    m_seed = seed;
+    std::fill(std::begin(m_sampleCounter), std::end(m_sampleCounter), 0);
+}
+
+void
+TracePolicy::SetWindowOpen(bool open)
+{
+    m_windowOpen = open;
+    UpdateMasks();
+}
+
+bool
+TracePolicy::IsNodeFiltered(EventLogType type) const
+{
+    return !m_nodeFilter.empty() &&
+           (type == EventLogType::FRAGMENT_RECEIVED || type == EventLogType::FRAGMENT_SHARED ||
+            type == EventLogType::CODED_SYMBOL_RECEIVED);
+}
+
+void
+TracePolicy::UpdateMasks()
+{
+    m_enabledMask = 0;
+    m_unfilteredMask = 0;
+    for (uint32_t i = 0; i < kEventLogTypeCount; ++i)
+    {
+        const uint32_t bit = 1u << i;
+        if (m_sampleRate[i] <= 0.0)
+        {
+            continue;
+        }
+        m_enabledMask |= bit;
+        if (m_sampleRate[i] >= 1.0 && !IsNodeFiltered(static_cast<EventLogType>(i)))
+        {
+            m_unfilteredMask |= bit;
+        }
+    }
+    if (!m_windowOpen)
+    {
+        m_enabledMask = 0;
+    }
+    m_enabledMask &= kAllTypesMask;
+}
+
+bool
+TracePolicy::AcceptFiltered(EventLogType type, uint32_t srcNodeId, uint32_t dstNodeId)
+{
+    const uint16_t i = static_cast<uint16_t>(type);
+    if (IsNodeFiltered(type))
+    {
+        const bool srcKept = srcNodeId < m_nodeFilter.size() && m_nodeFilter[srcNodeId];
+        const bool dstKept = dstNodeId < m_nodeFilter.size() && m_nodeFilter[dstNodeId];
+        if (!srcKept && !dstKept)
+        {
+            return false;
+        }
+    }
+    if (m_sampleThreshold[i] == UINT64_MAX)
+    {
+        return true;
+    }
+    const uint64_t draw = Mix(m_seed ^ Mix((static_cast<uint64_t>(i) << 56) ^ m_sampleCounter[i]++));
+    return draw < m_sampleThreshold[i];
+}
+
+std::string
+TracePolicy::Describe() const
+{
+    std::ostringstream oss;
+    oss << "sample:";
+    for (uint32_t i = 1; i < kEventLogTypeCount; ++i)
+    {
+        oss << (i > 1 ? "," : "") << kTypeNames[i] << "=" << m_sampleRate[i];
+    }
+    const size_t filtered = std::count(m_nodeFilter.begin(), m_nodeFilter.end(), 1);
+    oss << " nodes=";
+    if (m_nodeFilter.empty())
+    {
+        oss << "all";
+    }
+    else
+    {
+        oss << filtered;
+    }
+    oss << " window=" << (m_windowOpen ? "open" : "closed");
+    return oss.str();
+}
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
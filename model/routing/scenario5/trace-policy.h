@@ -0,0 +1,144 @@
+/*
+ * Scenario 5 - Result Trace Policy
+ *
+ * Decides which per-packet result events (fragment/symbol tokens and UAV
+ * broadcasts) reach the result log and the replay: per-type sampling, a
+ * node filter for the per-reception tokens and a time window.
+ *
+ * LogResultToken and LogResultUavBroadcast, the entry points of the
+ * routing code, apply the policy before the writers in event-log.h, with
+ * Accept() inlined into the call sites. A type that is switched off, or
+ * outside the time window, is rejected by one mask test; a type with no
+ * sampling or node filter is accepted by a second one. Only sampled or
+ * node-filtered types take the out-of-line path.
+ */
+
+#ifndef SCENARIO5_TRACE_POLICY_H
+#define SCENARIO5_TRACE_POLICY_H
+
+#include "event-log.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+class TracePolicy
+{
+public:
+    TracePolicy();
+
+    /**
+     * Keep every event (the default).
+     */
+    void Reset();
+
+    /**
+     * \param type Event type
+     * \param rate Fraction kept, [0, 1] (0 = off, 1 = all)
+     */
+    void SetSampleRate(EventLogType type, double rate);
+
+    /**
+     * Keep per-reception tokens only when the source or destination node is
+     * in the set (UAV broadcasts are not filtered by node).
+     *
+     * \param nodeIds Nodes to keep; empty = all nodes
+     */
+    void SetNodeFilter(const std::vector<uint32_t>& nodeIds);
+
+    /**
+     * Seed of the sampling sequence (same seed, same kept events).
+     */
+    void SetSeed(uint64_t seed);
+
+    /**
+     * Open or close the time window: a closed window rejects every type.
+     * Driven by scheduled events, so the hot path never reads the clock.
+     */
+    void SetWindowOpen(bool open);
+
+    /**
+     * \param type Event type
+     * \param srcNodeId Source node (the UAV for broadcasts)
+     * \param dstNodeId Destination node (unused for broadcasts)
+     * \return true if the event should be logged
+     */
+    bool Accept(EventLogType type, uint32_t srcNodeId, uint32_t dstNodeId)
+    {
+        const uint32_t bit = 1u << static_cast<uint16_t>(type);
+        if ((m_enabledMask & bit) == 0)
+        {
+            return false;
+        }
+        if ((m_unfilteredMask & bit) != 0)
+        {
+            return true;
+        }
+        return AcceptFiltered(type, srcNodeId, dstNodeId);
+    }
+
+    /**
+     * \return one line describing the active rules (for the run log)
+     */
+    std::string Describe() const;
+
+private:
+    bool AcceptFiltered(EventLogType type, uint32_t srcNodeId, uint32_t dstNodeId);
+    bool IsNodeFiltered(EventLogType type) const;
+    void UpdateMasks();
+
+    uint32_t m_enabledMask;    ///< Types logged now (rate > 0 and window open)
+    uint32_t m_unfilteredMask; ///< Enabled types kept without further checks
+    bool m_windowOpen;
+    uint64_t m_seed;
+    double m_sampleRate[kEventLogTypeCount];
+    uint64_t m_sampleThreshold[kEventLogTypeCount]; ///< Keep if hash < threshold
+    uint64_t m_sampleCounter[kEventLogTypeCount];
+    std::vector<uint8_t> m_nodeFilter; ///< By node ID; empty = no filter
+};
+
+/**
+ * Policy applied by LogResultToken and LogResultUavBroadcast.
+ */
+extern TracePolicy g_resultTracePolicy;
+
+/**
+ * Log a fragment/symbol token if the result trace policy accepts it.
+ */
+inline void
+LogResultToken(EventLogType type, uint32_t srcNodeId, uint32_t dstNodeId, uint32_t id)
+{
+    if (g_resultTracePolicy.Accept(type, srcNodeId, dstNodeId))
+    {
+        WriteResultToken(type, srcNodeId, dstNodeId, id);
+    }
+}
+
+/**
+ * Log a UAV broadcast event if the result trace policy accepts it.
+ */
+inline void
+LogResultUavBroadcast(EventLogType type,
+                      double time,
+                      uint32_t uavNodeId,
+                      uint32_t index,
+                      uint32_t cycle,
+                      double confidence,
+                      uint32_t size)
+{
+    if (g_resultTracePolicy.Accept(type, uavNodeId, uavNodeId))
+    {
+        WriteResultUavBroadcast(type, time, uavNodeId, index, cycle, confidence, size);
+    }
+}
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
+
+#endif // SCENARIO5_TRACE_POLICY_H
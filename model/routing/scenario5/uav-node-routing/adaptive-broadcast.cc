@@ -0,0 +1,221 @@
+/*
+ * Scenario 5 - Adaptive UAV Broadcast Scheduler Implementation
+ */
+
+#include "adaptive-broadcast.h"
+#include "../ground-node-routing/ground-node-routing.h"
+#include "../helper/calc-utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace ns3 {
+namespace wsn {
+namespace scenario5 {
+namespace routing {
+
+AdaptiveBroadcastScheduler::AdaptiveBroadcastScheduler(const FragmentBroadcastSchedule& schedule)
+{
+    const std::vector<Fragment>& fragments = schedule.GetFragments();
+    uint32_t maxId = 0;
+    for (const Fragment& frag : fragments)
+    {
+        maxId = std::max(maxId, frag.fragmentId);
+    }
+    m_rank.assign(fragments.empty() ? 0 : maxId + 1, std::numeric_limits<uint32_t>::max());
+    m_gain.assign(m_rank.size(), 0);
+
+    const std::vector<uint32_t>& order = schedule.GetOrder();
+    for (uint32_t rank = 0; rank < order.size(); ++rank)
+    {
+        const uint32_t fragmentId = fragments[order[rank]].fragmentId;
+        m_poolIds.Set(fragmentId);
+        m_rank[fragmentId] = rank;
+    }
+}
+
+void
+AdaptiveBroadcastScheduler::PushEntry(uint32_t fragmentId)
+{
+    if (m_gain[fragmentId] > 0)
+    {
+        m_heap.push({m_gain[fragmentId], m_rank[fragmentId], fragmentId});
+    }
+}
+
+void
+AdaptiveBroadcastScheduler::AdjustGains(const FragmentBitset& ids, int32_t delta)
+{
+    ids.ForEach([&](uint32_t fragmentId) {
+        m_gain[fragmentId] = static_cast<uint32_t>(static_cast<int32_t>(m_gain[fragmentId]) + delta);
+        PushEntry(fragmentId);
+    });
+}
+
+void
+AdaptiveBroadcastScheduler::BuildGrid(double radius)
+{
+    m_gridRadius = radius;
+    m_gridNodeCount = g_groundNetworkPerNode.size();
+    m_gridCells.clear();
+    m_gridCols = 0;
+    m_gridRows = 0;
+    if (g_groundNetworkPerNode.empty())
+    {
+        return;
+    }
+
+    double maxX = -std::numeric_limits<double>::max();
+    double maxY = -std::numeric_limits<double>::max();
+    m_gridMinX = std::numeric_limits<double>::max();
+    m_gridMinY = std::numeric_limits<double>::max();
+    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
+    {
+        m_gridMinX = std::min(m_gridMinX, state.position.x);
+        m_gridMinY = std::min(m_gridMinY, state.position.y);
+        maxX = std::max(maxX, state.position.x);
+        maxY = std::max(maxY, state.position.y);
+    }
+
+    // Cell size = radius, widened so there are no more cells than nodes
+    const double width = maxX - m_gridMinX;
+    const double height = maxY - m_gridMinY;
+    m_gridCellSize = std::max(radius, std::sqrt(width * height / m_gridNodeCount));
+    if (!(m_gridCellSize > 0.0))
+    {
+        m_gridCellSize = 1.0;
+    }
+    m_gridCols = static_cast<int32_t>(width / m_gridCellSize) + 1;
+    m_gridRows = static_cast<int32_t>(height / m_gridCellSize) + 1;
+    m_gridCells.resize(static_cast<size_t>(m_gridCols) * m_gridRows);
+
+    // Map order: every cell lists its nodes in ascending ID
+    for (const auto& [nodeId, state] : g_groundNetworkPerNode)
+    {
+        const int32_t cx = static_cast<int32_t>((state.position.x - m_gridMinX) / m_gridCellSize);
+        const int32_t cy = static_cast<int32_t>((state.position.y - m_gridMinY) / m_gridCellSize);
+        m_gridCells[static_cast<size_t>(cy) * m_gridCols + cx].push_back(nodeId);
+    }
+}
+
+void
+AdaptiveBroadcastScheduler::Update(const Vector& uavPosition, double radius)
+{
+    if (radius != m_gridRadius || g_groundNetworkPerNode.size() != m_gridNodeCount)
+    {
+        BuildGrid(radius);
+    }
+
+    std::map<uint32_t, FragmentBitset> nextTracked;
+    m_nodesInRange.clear();
+
+    if (!m_gridCells.empty())
+    {
+        const auto clampCol = [this](double x) {
+            return std::clamp(static_cast<int32_t>(std::floor((x - m_gridMinX) / m_gridCellSize)),
+                              0,
+                              m_gridCols - 1);
+        };
+        const auto clampRow = [this](double y) {
+            return std::clamp(static_cast<int32_t>(std::floor((y - m_gridMinY) / m_gridCellSize)),
+                              0,
+                              m_gridRows - 1);
+        };
+        const int32_t col0 = clampCol(uavPosition.x - radius);
+        const int32_t col1 = clampCol(uavPosition.x + radius);
+        const int32_t row0 = clampRow(uavPosition.y - radius);
+        const int32_t row1 = clampRow(uavPosition.y + radius);
+        for (int32_t row = row0; row <= row1; ++row)
+        {
+            for (int32_t col = col0; col <= col1; ++col)
+            {
+                for (uint32_t nodeId : m_gridCells[static_cast<size_t>(row) * m_gridCols + col])
+                {
+                    const GroundNetworkState& state = g_groundNetworkPerNode.at(nodeId);
+                    const double d = helper::CalculateDistance(uavPosition.x,
+                                                               uavPosition.y,
+                                                               state.position.x,
+                                                               state.position.y);
+                    if (d <= radius)
+                    {
+                        m_nodesInRange.push_back(nodeId);
+                    }
+                }
+            }
+        }
+        // Same delivery order as a scan of g_groundNetworkPerNode
+        std::sort(m_nodesInRange.begin(), m_nodesInRange.end());
+    }
+
+    for (uint32_t nodeId : m_nodesInRange)
+    {
+        const GroundNetworkState& state = g_groundNetworkPerNode.at(nodeId);
+        FragmentBitset missing = m_poolIds.AndNot(state.fragments.GetHeldIds());
+        auto tracked = m_trackedMissing.find(nodeId);
+        if (tracked == m_trackedMissing.end())
+        {
+            // Entered range
+            AdjustGains(missing, +1);
+        }
+        else
+        {
+            // Stayed in range: only fragments gained (or lost) since last round
+            AdjustGains(tracked->second.AndNot(missing), -1);
+            AdjustGains(missing.AndNot(tracked->second), +1);
+            m_trackedMissing.erase(tracked);
+        }
+        nextTracked.emplace(nodeId, std::move(missing));
+    }
+
+    // Left range
+    for (const auto& [nodeId, missing] : m_trackedMissing)
+    {
+        AdjustGains(missing, -1);
+    }
+    m_trackedMissing.swap(nextTracked);
+
+    // Drop stale heap entries in bulk once they dominate
+    if (m_heap.size() > 4 * m_gain.size() + 64)
+    {
+        m_heap = std::priority_queue<HeapEntry>();
+        for (uint32_t fragmentId = 0; fragmentId < m_gain.size(); ++fragmentId)
+        {
+            PushEntry(fragmentId);
+        }
+    }
+}
+
+bool
+AdaptiveBroadcastScheduler::SelectNext(uint32_t& fragmentId)
+{
+    while (!m_heap.empty())
+    {
+        const HeapEntry& top = m_heap.top();
+        if (top.gain != m_gain[top.fragmentId])
+        {
+            m_heap.pop();
+            continue;
+        }
+        fragmentId = top.fragmentId;
+        return true;
+    }
+    return false;
+}
+
+const std::vector<uint32_t>&
+AdaptiveBroadcastScheduler::GetNodesInRange() const
+{
+    return m_nodesInRange;
+}
+
+uint32_t
+AdaptiveBroadcastScheduler::GetGain(uint32_t fragmentId) const
+{
+    return fragmentId < m_gain.size() ? m_gain[fragmentId] : 0;
+}
+
+} // namespace routing
+} // namespace scenario5
+} // namespace wsn
+} // namespace ns3
@@ -1,14 +1,19 @@
 #include "fragment-broadcast.h"
+#include "adaptive-broadcast.h"
 #include "../packet-header.h"
 #include "../helper/calc-utils.h"
 #include "../ground-node-routing/ground-node-routing.h"
 #include "../base-station-node/fragment-generator.h"
+#include "../node-routing.h"
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
 #include "ns3/node-list.h"
 #include "ns3/mobility-model.h"
 #include "ns3/log.h"
+#include "../../../wsn-log.h"
+#include "../../../../examples/scenarios/scenario5/scenario5-params.h"
 #include <algorithm>
+#include <map>
 
 namespace ns3 {
 
@@ -23,19 +28,29 @@ namespace
 static constexpr double kBroadcastInterval = 1.0;
 static constexpr uint32_t kMaxBroadcastRounds = 8;
 
+// Adaptive scheduler of each broadcasting UAV
+std::map<uint32_t, AdaptiveBroadcastScheduler> g_adaptiveSchedulers;
+
 const Fragment*
 GetFragmentByRound(uint32_t round)
 {
-    const FragmentCollection& pool = GetBsGeneratedFragments();
-    if (pool.fragments.empty())
+    const FragmentBroadcastSchedule& schedule = GetBsBroadcastSchedule();
+    if (schedule.IsEmpty())
     {
         return nullptr;
     }
+    return &schedule.GetByRound(round);
+}
 
-    const uint32_t index = round % static_cast<uint32_t>(pool.fragments.size());
-    auto it = pool.fragments.begin();
-    std::advance(it, index);
-    return &(it->second);
+/**
+ * Symbol sent in a round when fragment coding is on: all n coded symbols in
+ * turn, so the 8 rounds reach past the k source fragments.
+ */
+uint32_t
+GetCodedSymbolByRound(uint32_t round)
+{
+    const CodedFragmentSet& coded = GetBsCodedFragments();
+    return round % coded.GetSymbolCount();
 }
 
 void
@@ -55,7 +70,13 @@ BroadcastOneRound(uint32_t uavNodeId, uint32_t round)
 
     Vector up = uavMobility->GetPosition();
 
-    const Fragment* selectedFragment = GetFragmentByRound(round);
+    const bool coded = GetBsCodedFragments().IsBuilt();
+    const uint32_t symbolIndex = coded ? GetCodedSymbolByRound(round) : 0;
+    const Fragment* selectedFragment = coded ? nullptr : GetFragmentByRound(round);
+    Ptr<Packet> codedPacket = coded ? BuildUavSymbolPacket(uavNodeId,
+                                                           symbolIndex,
+                                                           GetBsGeneratedFragments())
+                                    : nullptr;
 
     for (auto& [nodeId, state] : g_groundNetworkPerNode)
     {
@@ -74,6 +95,16 @@ BroadcastOneRound(uint32_t uavNodeId, uint32_t round)
         double d = helper::CalculateDistance(up.x, up.y, gp.x, gp.y);
         double syntheticRssi = -55.0 - 0.12 * d;
 
+        if (IsUavBroadcastLost())
+        {
+            continue;
+        }
+        if (codedPacket)
+        {
+            OnGroundNodeReceivePacket(nodeId, codedPacket, syntheticRssi);
+            continue;
+        }
+
         Ptr<Packet> p = Create<Packet>();
         FragmentPacket f;
         const uint32_t fragmentId = selectedFragment ? selectedFragment->fragmentId : (round % 16);
@@ -96,14 +127,88 @@ BroadcastOneRound(uint32_t uavNodeId, uint32_t round)
         Simulator::Schedule(Seconds(kBroadcastInterval), &BroadcastOneRound, uavNodeId, round + 1);
     }
 }
+void
+BroadcastAdaptiveRound(uint32_t uavNodeId, uint32_t round)
+{
+    auto it = g_adaptiveSchedulers.find(uavNodeId);
+    if (it == g_adaptiveSchedulers.end())
+    {
+        return;
+    }
+    AdaptiveBroadcastScheduler& scheduler = it->second;
+
+    Ptr<Node> uav = NodeList::GetNode(uavNodeId);
+    Ptr<MobilityModel> uavMobility = uav ? uav->GetObject<MobilityModel>() : nullptr;
+    if (!uavMobility)
+    {
+        g_adaptiveSchedulers.erase(it);
+        return;
+    }
+
+    Vector up = uavMobility->GetPosition();
+    scheduler.Update(up, ::ns3::wsn::scenario5::params::UAV_BROADCAST_RADIUS);
+
+    uint32_t fragmentId = 0;
+    if (scheduler.SelectNext(fragmentId))
+    {
+        Ptr<Packet> p = BuildUavSymbolPacket(uavNodeId, fragmentId, GetBsGeneratedFragments());
+        WSN_HOT_LOG_DEBUG(HOT_LOG_BROADCAST, "UAV " << uavNodeId << " round " << round
+                                             << " | fragment=" << fragmentId
+                                             << " | gain=" << scheduler.GetGain(fragmentId)
+                                             << " | inRange=" << scheduler.GetNodesInRange().size());
+        for (uint32_t nodeId : scheduler.GetNodesInRange())
+        {
+            if (!p || IsUavBroadcastLost())
+            {
+                continue;
+            }
+            const GroundNetworkState& state = g_groundNetworkPerNode[nodeId];
+            double d = helper::CalculateDistance(up.x, up.y, state.position.x, state.position.y);
+            double syntheticRssi = -55.0 - 0.12 * d;
+            OnGroundNodeReceivePacket(nodeId, p, syntheticRssi);
+        }
+    }
+    else if (!scheduler.GetNodesInRange().empty())
+    {
+        NS_LOG_INFO("UAV " << uavNodeId << " stops broadcasting after round " << round
+                    << " | all " << scheduler.GetNodesInRange().size()
+                    << " nodes in range hold every fragment");
+        g_adaptiveSchedulers.erase(it);
+        return;
+    }
+
+    if (round + 1 < ::ns3::wsn::scenario5::params::UAV_ADAPTIVE_BROADCAST_MAX_ROUNDS)
+    {
+        Simulator::Schedule(Seconds(::ns3::wsn::scenario5::params::UAV_ADAPTIVE_BROADCAST_INTERVAL),
+                            &BroadcastAdaptiveRound,
+                            uavNodeId,
+                            round + 1);
+    }
+    else
+    {
+        g_adaptiveSchedulers.erase(it);
+    }
+}
 } // namespace
 
 void
 StartFragmentBroadcast(uint32_t uavNodeId)
 {
-    const uint32_t poolSize = static_cast<uint32_t>(GetBsGeneratedFragments().fragments.size());
+    const uint32_t poolSize = static_cast<uint32_t>(GetBsGeneratedFragments().GetCount());
+    // Coded symbols are all useful to every node, so coding keeps the fixed rounds
+    const bool adaptive = ::ns3::wsn::scenario5::params::UAV_ADAPTIVE_BROADCAST &&
+                          !GetBsCodedFragments().IsBuilt() &&
+                          !GetBsBroadcastSchedule().IsEmpty();
     NS_LOG_INFO("UAV " << uavNodeId << " starts fragment broadcasting"
-                << " | bsFragmentPool=" << poolSize);
+                << " | bsFragmentPool=" << poolSize
+                << " | adaptive=" << adaptive);
+    if (adaptive)
+    {
+        g_adaptiveSchedulers.erase(uavNodeId);
+        g_adaptiveSchedulers.emplace(uavNodeId, AdaptiveBroadcastScheduler(GetBsBroadcastSchedule()));
+        Simulator::ScheduleNow(&BroadcastAdaptiveRound, uavNodeId, 0);
+        return;
+    }
     Simulator::ScheduleNow(&BroadcastOneRound, uavNodeId, 0);
 }
 
@@ -7,6 +7,7 @@
 #include "ground-node-mac.h"
 
 #include "ns3/log.h"
+#include "../wsn-log.h"
 #include "ns3/simulator.h"
 
 #include <limits>
@@ -52,7 +53,7 @@ GroundNodeMac::~GroundNodeMac()
 void
 GroundNodeMac::ReceivePacket(uint32_t seqNum, Vector uavPos, double distance, double rssiDbm)
 {
-    NS_LOG_FUNCTION(this << seqNum << distance << rssiDbm);
+    WSN_HOT_LOG_FUNCTION(wsn::HOT_LOG_MAC, this << seqNum << distance << rssiDbm);
     
     m_packetsReceived++;
     m_rssiSum += rssiDbm;
@@ -68,9 +69,9 @@ GroundNodeMac::ReceivePacket(uint32_t seqNum, Vector uavPos, double distance, do
         m_receptionCallback(seqNum, distance, rssiDbm);
     }
     
-    NS_LOG_DEBUG("Ground node received packet #" << seqNum 
-                 << " | Distance: " << distance << "m"
-                 << " | RSSI: " << rssiDbm << " dBm");
+    WSN_HOT_LOG_DEBUG(wsn::HOT_LOG_MAC, "Ground node received packet #" << seqNum 
+                                        << " | Distance: " << distance << "m"
+                                        << " | RSSI: " << rssiDbm << " dBm");
 }
 
 uint32_t
@@ -119,12 +120,12 @@ GroundNodeMac::SetReceptionCallback(ReceptionCallback cb)
 void
 GroundNodeMac::ReceiveFragment(const Fragment& fragment, double rssiDbm)
 {
-    NS_LOG_FUNCTION(this << fragment.fragmentId << rssiDbm);
+    WSN_HOT_LOG_FUNCTION(wsn::HOT_LOG_MAC, this << fragment.fragmentId << rssiDbm);
     
     // Check if fragment already received (deduplication)
     if (m_receivedFragmentIds.count(fragment.fragmentId) > 0)
     {
-        NS_LOG_DEBUG("Fragment #" << fragment.fragmentId << " already received, ignoring duplicate");
+        WSN_HOT_LOG_DEBUG(wsn::HOT_LOG_MAC, "Fragment #" << fragment.fragmentId << " already received, ignoring duplicate");
         return;
     }
     
@@ -142,9 +143,9 @@ GroundNodeMac::ReceiveFragment(const Fragment& fragment, double rssiDbm)
     // Track sensor type diversity
     m_sensorTypeSeen.insert(fragment.sensorType);
     
-    NS_LOG_DEBUG("Fragment #" << fragment.fragmentId 
-                 << " processed | Confidence delta: " << delta 
-                 << " | Total confidence: " << m_confidence);
+    WSN_HOT_LOG_DEBUG(wsn::HOT_LOG_MAC, "Fragment #" << fragment.fragmentId 
+                                        << " processed | Confidence delta: " << delta 
+                                        << " | Total confidence: " << m_confidence);
     
     // Check alert condition
     if (m_confidence >= m_confidenceThreshold && !m_alerted)
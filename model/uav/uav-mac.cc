@@ -8,6 +8,7 @@
 #include "ground-node-mac.h"
 
 #include "ns3/log.h"
+#include "../wsn-log.h"
 #include "ns3/simulator.h"
 #include "ns3/double.h"
 
@@ -103,12 +104,12 @@ UavMac::StopBroadcast()
 void
 UavMac::DoBroadcast()
 {
-    NS_LOG_FUNCTION(this);
+    WSN_HOT_LOG_FUNCTION(wsn::HOT_LOG_MAC, this);
     
     Time now = Simulator::Now();
     if (now >= m_stopTime)
     {
-        NS_LOG_INFO("Broadcast stopped at t=" << now.GetSeconds() << "s");
+        WSN_HOT_LOG_INFO(wsn::HOT_LOG_MAC, "Broadcast stopped at t=" << now.GetSeconds() << "s");
         return;
     }
     
@@ -117,10 +118,10 @@ UavMac::DoBroadcast()
     Ptr<MobilityModel> uavMobility = m_uavNode->GetObject<MobilityModel>();
     Vector uavPos = uavMobility->GetPosition();
     
-    NS_LOG_INFO(std::fixed << std::setprecision(2)
-                << "\n[t=" << now.GetSeconds() << "s] UAV Broadcast #" << m_seqNum);
-    NS_LOG_INFO("  UAV Position: (" << uavPos.x << ", " << uavPos.y << ", " << uavPos.z << ")");
-    NS_LOG_INFO("  TX Power: " << m_txPowerDbm << " dBm");
+    WSN_HOT_LOG_INFO(wsn::HOT_LOG_MAC, std::fixed << std::setprecision(2)
+                                       << "\n[t=" << now.GetSeconds() << "s] UAV Broadcast #" << m_seqNum);
+    WSN_HOT_LOG_INFO(wsn::HOT_LOG_MAC, "  UAV Position: (" << uavPos.x << ", " << uavPos.y << ", " << uavPos.z << ")");
+    WSN_HOT_LOG_INFO(wsn::HOT_LOG_MAC, "  TX Power: " << m_txPowerDbm << " dBm");
     
     // Invoke callback if set
     if (!m_broadcastCallback.IsNull())
@@ -141,8 +142,8 @@ UavMac::DoBroadcast()
     frag.broadcastPosition = uavPos;
     frag.timestamp = Simulator::Now().GetNanoSeconds();
     
-    NS_LOG_DEBUG("Broadcasting fragment " << m_currentFragmentIndex << "/" << m_numFragments
-                 << " (ID: " << frag.fragmentId << ", Conf: " << frag.baseConfidence << ")");
+    WSN_HOT_LOG_DEBUG(wsn::HOT_LOG_MAC, "Broadcasting fragment " << m_currentFragmentIndex << "/" << m_numFragments
+                                        << " (ID: " << frag.fragmentId << ", Conf: " << frag.baseConfidence << ")");
     
     // Move to next fragment (loop back to 0 after last)
     m_currentFragmentIndex = (m_currentFragmentIndex + 1) % m_numFragments;
@@ -173,19 +174,19 @@ UavMac::DoBroadcast()
                 groundMac->ReceiveFragment(frag, rxPowerDbm);
             }
             
-            NS_LOG_INFO("  ✓ Node " << groundNode->GetId() 
-                        << " @ (" << groundPos.x << ", " << groundPos.y << ")"
-                        << " | Distance: " << std::fixed << std::setprecision(1) << distance << "m"
-                        << " | RSSI: " << std::fixed << std::setprecision(1) << rxPowerDbm << " dBm");
+            WSN_HOT_LOG_INFO(wsn::HOT_LOG_MAC, "  ✓ Node " << groundNode->GetId() 
+                                               << " @ (" << groundPos.x << ", " << groundPos.y << ")"
+                                               << " | Distance: " << std::fixed << std::setprecision(1) << distance << "m"
+                                               << " | RSSI: " << std::fixed << std::setprecision(1) << rxPowerDbm << " dBm");
         }
         else
         {
-            NS_LOG_DEBUG("  ✗ Node " << groundNode->GetId() 
-                         << " out of range (RSSI: " << rxPowerDbm << " dBm)");
+            WSN_HOT_LOG_DEBUG(wsn::HOT_LOG_MAC, "  ✗ Node " << groundNode->GetId() 
+                                                << " out of range (RSSI: " << rxPowerDbm << " dBm)");
         }
     }
     
-    NS_LOG_INFO("  Reception: " << successfulReceptions << "/" << m_groundNodes.GetN() << " nodes");
+    WSN_HOT_LOG_INFO(wsn::HOT_LOG_MAC, "  Reception: " << successfulReceptions << "/" << m_groundNodes.GetN() << " nodes");
     
     m_seqNum++;
     
@@ -0,0 +1,86 @@
+#include "wsn-log.h"
+
+#include <sstream>
+
+namespace ns3 {
+namespace wsn {
+
+namespace {
+
+struct CategoryName
+{
+    const char *name;
+    uint32_t mask;
+};
+
+constexpr CategoryName kCategoryNames[] = {
+    {"rx", HOT_LOG_RX},
+    {"broadcast", HOT_LOG_BROADCAST},
+    {"mac", HOT_LOG_MAC},
+};
+
+} // namespace
+
+uint32_t g_hotLogMask = HOT_LOG_ALL;
+
+bool SetHotLogCategories(const std::string &spec)
+{
+    if (spec == "all")
+    {
+        g_hotLogMask = HOT_LOG_ALL;
+        return true;
+    }
+    if (spec == "none")
+    {
+        g_hotLogMask = 0;
+        return true;
+    }
+
+    uint32_t mask = 0;
+    std::istringstream iss(spec);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        bool known = false;
+        for (const CategoryName &category : kCategoryNames)
+        {
+            if (item == category.name)
+            {
+                mask |= category.mask;
+                known = true;
+            }
+        }
+        if (!known)
+            return false;
+    }
+    g_hotLogMask = mask;
+    return true;
+}
+
+std::string GetHotLogCategories()
+{
+    if (g_hotLogMask == HOT_LOG_ALL)
+        return "all";
+    if (g_hotLogMask == 0)
+        return "none";
+
+    std::string names;
+    for (const CategoryName &category : kCategoryNames)
+    {
+        if (g_hotLogMask & category.mask)
+        {
+            names += names.empty() ? "" : ",";
+            names += category.name;
+        }
+    }
+    return names;
+}
+
+const char *GetHotLogLevelName()
+{
+    static const char *const kLevelNames[] = {"off", "warn", "info", "debug", "function"};
+    return kLevelNames[WSN_HOT_LOG_LEVEL];
+}
+
+} // namespace wsn
+} // namespace ns3
@@ -0,0 +1,116 @@
+#ifndef WSN_LOG_H
+#define WSN_LOG_H
+
+#pragma once
+#include "ns3/log.h"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Hot-path logging.
+ *
+ * Per-packet and per-broadcast NS_LOG statements go through the
+ * WSN_HOT_LOG_* macros, which add two gates in front of the NS_LOG
+ * component check:
+ *
+ * - compile time: statements above WSN_HOT_LOG_LEVEL are removed together
+ *   with their stream formatting (CMake option WSN_HOT_LOG_LEVEL; release
+ *   and optimized builds keep warnings only);
+ * - run time: a category mask (SetHotLogCategories, example5 --hotLog)
+ *   turns whole groups of statements off with one load and test.
+ *
+ * A compiled-in statement whose category is on still needs its NS_LOG
+ * component enabled, as before.
+ */
+
+#define WSN_HOT_LOG_LEVEL_OFF 0
+#define WSN_HOT_LOG_LEVEL_WARN 1
+#define WSN_HOT_LOG_LEVEL_INFO 2
+#define WSN_HOT_LOG_LEVEL_DEBUG 3
+#define WSN_HOT_LOG_LEVEL_FUNCTION 4
+
+#ifndef WSN_HOT_LOG_LEVEL
+#define WSN_HOT_LOG_LEVEL WSN_HOT_LOG_LEVEL_FUNCTION
+#endif
+
+namespace ns3 {
+namespace wsn {
+
+/**
+ * Hot-path log categories (bit mask).
+ */
+enum HotLogCategory : uint32_t
+{
+    HOT_LOG_RX = 1 << 0,        ///< Ground node packet reception
+    HOT_LOG_BROADCAST = 1 << 1, ///< UAV broadcast rounds
+    HOT_LOG_MAC = 1 << 2,       ///< Legacy UAV / ground node MAC
+    HOT_LOG_ALL = HOT_LOG_RX | HOT_LOG_BROADCAST | HOT_LOG_MAC
+};
+
+/**
+ * Enabled categories (default: all).
+ */
+extern uint32_t g_hotLogMask;
+
+inline bool
+IsHotLogEnabled(uint32_t category)
+{
+    return (g_hotLogMask & category) != 0;
+}
+
+/**
+ * Set the enabled categories.
+ *
+ * \param spec "all", "none" or a comma-separated list of rx, broadcast, mac
+ * \return false (mask unchanged) if the list names an unknown category
+ */
+bool SetHotLogCategories(const std::string& spec);
+
+/**
+ * \return enabled categories, in the SetHotLogCategories() syntax
+ */
+std::string GetHotLogCategories();
+
+/**
+ * \return name of the compiled-in level (off, warn, info, debug, function)
+ */
+const char* GetHotLogLevelName();
+
+} // namespace wsn
+} // namespace ns3
+
+#define WSN_HOT_LOG_IF_(category, statement)                                                      \
+    do                                                                                            \
+    {                                                                                             \
+        if (::ns3::wsn::IsHotLogEnabled(category))                                                \
+        {                                                                                         \
+            statement;                                                                            \
+        }                                                                                         \
+    } while (false)
+
+#if WSN_HOT_LOG_LEVEL >= WSN_HOT_LOG_LEVEL_WARN
+#define WSN_HOT_LOG_WARN(category, msg) WSN_HOT_LOG_IF_(category, NS_LOG_WARN(msg))
+#else
+#define WSN_HOT_LOG_WARN(category, msg) static_cast<void>(0)
+#endif
+
+#if WSN_HOT_LOG_LEVEL >= WSN_HOT_LOG_LEVEL_INFO
+#define WSN_HOT_LOG_INFO(category, msg) WSN_HOT_LOG_IF_(category, NS_LOG_INFO(msg))
+#else
+#define WSN_HOT_LOG_INFO(category, msg) static_cast<void>(0)
+#endif
+
+#if WSN_HOT_LOG_LEVEL >= WSN_HOT_LOG_LEVEL_DEBUG
+#define WSN_HOT_LOG_DEBUG(category, msg) WSN_HOT_LOG_IF_(category, NS_LOG_DEBUG(msg))
+#else
+#define WSN_HOT_LOG_DEBUG(category, msg) static_cast<void>(0)
+#endif
+
+#if WSN_HOT_LOG_LEVEL >= WSN_HOT_LOG_LEVEL_FUNCTION
+#define WSN_HOT_LOG_FUNCTION(category, params) WSN_HOT_LOG_IF_(category, NS_LOG_FUNCTION(params))
+#else
+#define WSN_HOT_LOG_FUNCTION(category, params) static_cast<void>(0)
+#endif
+
+#endif // WSN_LOG_H
@@ -0,0 +1,312 @@
+#include "wsn-metrics.h"
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+
+namespace ns3 {
+namespace wsn {
+
+namespace {
+
+thread_local void *t_shard = nullptr;
+
+// Single-writer update: only the owning thread stores into its shard
+inline void Bump(std::atomic<uint64_t> &cell, uint64_t delta)
+{
+    cell.store(cell.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+void WriteJsonString(std::ostream &os, const std::string &text)
+{
+    os << '"';
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            os << '\\';
+        os << c;
+    }
+    os << '"';
+}
+
+} // namespace
+
+// ===== Bucket layout =====
+
+uint32_t MetricsRegistry::GetBucketIndex(uint64_t value)
+{
+    if (value < kSubBucketCount)
+        return static_cast<uint32_t>(value);
+    const uint32_t msb = 63 - static_cast<uint32_t>(__builtin_clzll(value));
+    const uint32_t shift = msb - kSubBucketBits;
+    const uint32_t mantissa = static_cast<uint32_t>(value >> shift); // [32, 64)
+    return (shift + 1) * kSubBucketCount + (mantissa - kSubBucketCount);
+}
+
+uint64_t MetricsRegistry::GetBucketUpperBound(uint32_t index)
+{
+    if (index < kSubBucketCount)
+        return index;
+    const uint32_t shift = index / kSubBucketCount - 1;
+    const uint64_t mantissa = index % kSubBucketCount + kSubBucketCount;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+uint64_t MetricsRegistry::HistogramSummary::GetQuantile(double q) const
+{
+    if (count == 0)
+        return 0;
+    const uint64_t rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count)));
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::clamp(GetBucketUpperBound(i), min, max);
+    }
+    return max;
+}
+
+double MetricsRegistry::HistogramSummary::GetMean() const
+{
+    return count > 0 ? static_cast<double>(sum) / count : 0.0;
+}
+
+// ===== Registry =====
+
+MetricsRegistry &MetricsRegistry::Get()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+uint32_t MetricsRegistry::Register(Kind kind, const std::string &name, const std::string &unit)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_metrics.find(name);
+    if (it != m_metrics.end())
+    {
+        NS_ABORT_MSG_IF(it->second.kind != kind, "Metric " << name << " registered with another kind");
+        return it->second.slot;
+    }
+
+    std::vector<std::string> &names = m_names[static_cast<uint8_t>(kind)];
+    const uint32_t limit = (kind == Kind::COUNTER) ? kMaxCounters
+                           : (kind == Kind::GAUGE) ? kMaxGauges
+                                                   : kMaxHistograms;
+    NS_ABORT_MSG_IF(names.size() >= limit, "Too many metrics of this kind: " << name);
+
+    const uint32_t slot = static_cast<uint32_t>(names.size());
+    names.push_back(name);
+    m_metrics.emplace(name, MetricInfo{kind, slot, unit});
+    return slot;
+}
+
+MetricsRegistry::Shard &MetricsRegistry::GetLocalShard()
+{
+    if (t_shard == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shards.push_back(std::make_unique<Shard>());
+        t_shard = m_shards.back().get();
+    }
+    return *static_cast<Shard *>(t_shard);
+}
+
+MetricsRegistry::HistogramShard &MetricsRegistry::GetLocalHistogram(uint32_t slot)
+{
+    Shard &shard = GetLocalShard();
+    HistogramShard *histogram = shard.histograms[slot].load(std::memory_order_acquire);
+    if (histogram == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        shard.ownedHistograms.push_back(std::make_unique<HistogramShard>());
+        histogram = shard.ownedHistograms.back().get();
+        shard.histograms[slot].store(histogram, std::memory_order_release);
+    }
+    return *histogram;
+}
+
+void MetricsRegistry::AddCounter(uint32_t slot, uint64_t delta)
+{
+    Bump(GetLocalShard().counters[slot], delta);
+}
+
+void MetricsRegistry::SetGauge(uint32_t slot, double value)
+{
+    Shard &shard = GetLocalShard();
+    shard.gauges[slot].store(value, std::memory_order_relaxed);
+    shard.gaugeStamps[slot].store(m_gaugeClock.fetch_add(1, std::memory_order_relaxed) + 1,
+                                  std::memory_order_release);
+}
+
+void MetricsRegistry::RecordHistogram(uint32_t slot, uint64_t value)
+{
+    HistogramShard &histogram = GetLocalHistogram(slot);
+    Bump(histogram.buckets[GetBucketIndex(value)], 1);
+    Bump(histogram.count, 1);
+    Bump(histogram.sum, value);
+    if (value < histogram.min.load(std::memory_order_relaxed))
+        histogram.min.store(value, std::memory_order_relaxed);
+    if (value > histogram.max.load(std::memory_order_relaxed))
+        histogram.max.store(value, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &shard : m_shards)
+    {
+        for (auto &counter : shard->counters)
+            counter.store(0, std::memory_order_relaxed);
+        for (auto &stamp : shard->gaugeStamps)
+            stamp.store(0, std::memory_order_relaxed);
+        for (auto &histogram : shard->ownedHistograms)
+        {
+            for (auto &bucket : histogram->buckets)
+                bucket.store(0, std::memory_order_relaxed);
+            histogram->count.store(0, std::memory_order_relaxed);
+            histogram->sum.store(0, std::memory_order_relaxed);
+            histogram->min.store(UINT64_MAX, std::memory_order_relaxed);
+            histogram->max.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// ===== Aggregation =====
+
+const MetricsRegistry::MetricInfo *MetricsRegistry::Find(const std::string &name, Kind kind) const
+{
+    auto it = m_metrics.find(name);
+    return (it != m_metrics.end() && it->second.kind == kind) ? &it->second : nullptr;
+}
+
+uint64_t MetricsRegistry::GetCounter(const std::string &name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const MetricInfo *info = Find(name, Kind::COUNTER);
+    uint64_t total = 0;
+    if (info)
+    {
+        for (const auto &shard : m_shards)
+            total += shard->counters[info->slot].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+double MetricsRegistry::GetGauge(const std::string &name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const MetricInfo *info = Find(name, Kind::GAUGE);
+    double value = 0.0;
+    uint64_t newest = 0;
+    if (info)
+    {
+        for (const auto &shard : m_shards)
+        {
+            const uint64_t stamp = shard->gaugeStamps[info->slot].load(std::memory_order_acquire);
+            if (stamp > newest)
+            {
+                newest = stamp;
+                value = shard->gauges[info->slot].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return value;
+}
+
+MetricsRegistry::HistogramSummary MetricsRegistry::GetHistogram(const std::string &name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    HistogramSummary summary;
+    summary.buckets.assign(kHistogramBuckets, 0);
+    summary.min = UINT64_MAX;
+
+    const MetricInfo *info = Find(name, Kind::HISTOGRAM);
+    if (info)
+    {
+        for (const auto &shard : m_shards)
+        {
+            const HistogramShard *histogram =
+                shard->histograms[info->slot].load(std::memory_order_acquire);
+            if (histogram == nullptr)
+                continue;
+            for (uint32_t i = 0; i < kHistogramBuckets; ++i)
+                summary.buckets[i] += histogram->buckets[i].load(std::memory_order_relaxed);
+            summary.count += histogram->count.load(std::memory_order_relaxed);
+            summary.sum += histogram->sum.load(std::memory_order_relaxed);
+            summary.min = std::min(summary.min, histogram->min.load(std::memory_order_relaxed));
+            summary.max = std::max(summary.max, histogram->max.load(std::memory_order_relaxed));
+        }
+    }
+    if (summary.count == 0)
+        summary.min = 0;
+    return summary;
+}
+
+void MetricsRegistry::WriteJson(std::ostream &os) const
+{
+    // Sorted names keep reports diffable between runs
+    std::map<std::string, MetricInfo> metrics;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        metrics.insert(m_metrics.begin(), m_metrics.end());
+    }
+
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::defaultfloat << std::setprecision(10);
+
+    auto writeSection = [&](const char *section, Kind kind, auto &&writeValue) {
+        WriteJsonString(os, section);
+        os << ":{";
+        bool first = true;
+        for (const auto &[name, info] : metrics)
+        {
+            if (info.kind != kind)
+                continue;
+            os << (first ? "" : ",");
+            first = false;
+            WriteJsonString(os, name);
+            os << ':';
+            writeValue(name, info);
+        }
+        os << '}';
+    };
+
+    os << '{';
+    writeSection("counters", Kind::COUNTER, [&](const std::string &name, const MetricInfo &) {
+        os << GetCounter(name);
+    });
+    os << ',';
+    writeSection("gauges", Kind::GAUGE, [&](const std::string &name, const MetricInfo &) {
+        const double value = GetGauge(name);
+        if (std::isfinite(value))
+            os << value;
+        else
+            os << "null";
+    });
+    os << ',';
+    writeSection("histograms", Kind::HISTOGRAM, [&](const std::string &name, const MetricInfo &info) {
+        const HistogramSummary summary = GetHistogram(name);
+        os << "{\"unit\":";
+        WriteJsonString(os, info.unit);
+        os << ",\"count\":" << summary.count
+           << ",\"min\":" << summary.min
+           << ",\"max\":" << summary.max
+           << ",\"mean\":" << summary.GetMean()
+           << ",\"p50\":" << summary.GetQuantile(0.50)
+           << ",\"p90\":" << summary.GetQuantile(0.90)
+           << ",\"p99\":" << summary.GetQuantile(0.99) << '}';
+    });
+    os << '}';
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace wsn
+} // namespace ns3
@@ -0,0 +1,207 @@
+#ifndef WSN_METRICS_H
+#define WSN_METRICS_H
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+
+/**
+ * Process-wide registry of named counters, gauges and latency histograms.
+ *
+ * Instrumentation sites keep a handle (Counter, Gauge, LatencyHistogram),
+ * typically a function-local static, so the name lookup happens once.
+ * Updates go to a per-thread shard with plain relaxed stores, no locking
+ * or read-modify-write; shards are summed when a report is taken.
+ *
+ * Histograms are HDR-style log-linear: 32 linear sub-buckets per power of
+ * two, i.e. about 3% relative error over the whole uint64 range.
+ */
+class MetricsRegistry
+{
+public:
+    enum class Kind : uint8_t
+    {
+        COUNTER = 0,
+        GAUGE = 1,
+        HISTOGRAM = 2
+    };
+
+    static constexpr uint32_t kMaxCounters = 256;
+    static constexpr uint32_t kMaxGauges = 64;
+    static constexpr uint32_t kMaxHistograms = 32;
+    static constexpr uint32_t kSubBucketBits = 5;
+    static constexpr uint32_t kSubBucketCount = 1u << kSubBucketBits;
+    static constexpr uint32_t kHistogramBuckets = (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+    /**
+     * Snapshot of one histogram (all threads).
+     */
+    struct HistogramSummary
+    {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t min = 0;
+        uint64_t max = 0;
+        std::vector<uint64_t> buckets; ///< kHistogramBuckets entries
+
+        /**
+         * \param q Quantile [0, 1]
+         * \return upper bound of the bucket holding the quantile
+         */
+        uint64_t GetQuantile(double q) const;
+        double GetMean() const;
+    };
+
+    static MetricsRegistry& Get();
+
+    /**
+     * Find or create a metric.
+     *
+     * \param kind Metric kind (a name is bound to one kind)
+     * \param name Dotted metric name, e.g. "ground.fragments_received"
+     * \param unit Unit shown in reports (histograms; may be empty)
+     * \return slot of the metric within its kind
+     */
+    uint32_t Register(Kind kind, const std::string& name, const std::string& unit = "");
+
+    /**
+     * Zero every metric (registrations are kept).
+     */
+    void Reset();
+
+    uint64_t GetCounter(const std::string& name) const;
+    double GetGauge(const std::string& name) const;
+    HistogramSummary GetHistogram(const std::string& name) const;
+
+    /**
+     * Write every metric as one JSON object:
+     * {"counters":{..},"gauges":{..},"histograms":{name:{unit,count,min,
+     * max,mean,p50,p90,p99}}}
+     */
+    void WriteJson(std::ostream& os) const;
+
+    // Hot path, called through the handles below
+    void AddCounter(uint32_t slot, uint64_t delta);
+    void SetGauge(uint32_t slot, double value);
+    void RecordHistogram(uint32_t slot, uint64_t value);
+
+    static uint32_t GetBucketIndex(uint64_t value);
+    static uint64_t GetBucketUpperBound(uint32_t index);
+
+private:
+    struct HistogramShard
+    {
+        std::array<std::atomic<uint64_t>, kHistogramBuckets> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> min{UINT64_MAX};
+        std::atomic<uint64_t> max{0};
+    };
+
+    /**
+     * Metrics of one thread. Written only by its thread; read under
+     * m_mutex at report time. Owned by the registry, so a shard outlives
+     * its thread and its counts are kept.
+     */
+    struct Shard
+    {
+        std::array<std::atomic<uint64_t>, kMaxCounters> counters{};
+        std::array<std::atomic<double>, kMaxGauges> gauges{};
+        std::array<std::atomic<uint64_t>, kMaxGauges> gaugeStamps{}; ///< 0 = never set
+        std::array<std::atomic<HistogramShard*>, kMaxHistograms> histograms{};
+        std::vector<std::unique_ptr<HistogramShard>> ownedHistograms;
+    };
+
+    struct MetricInfo
+    {
+        Kind kind;
+        uint32_t slot;
+        std::string unit;
+    };
+
+    MetricsRegistry() = default;
+
+    Shard& GetLocalShard();
+    HistogramShard& GetLocalHistogram(uint32_t slot);
+    const MetricInfo* Find(const std::string& name, Kind kind) const;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, MetricInfo> m_metrics;
+    std::vector<std::string> m_names[3]; ///< per kind, by slot
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::atomic<uint64_t> m_gaugeClock{0};
+};
+
+/**
+ * Monotonic event count.
+ */
+class Counter
+{
+public:
+    explicit Counter(const std::string& name)
+        : m_slot(MetricsRegistry::Get().Register(MetricsRegistry::Kind::COUNTER, name))
+    {
+    }
+
+    void Add(uint64_t delta = 1) const { MetricsRegistry::Get().AddCounter(m_slot, delta); }
+
+private:
+    uint32_t m_slot;
+};
+
+/**
+ * Last-set value (the most recent Set() across threads wins).
+ */
+class Gauge
+{
+public:
+    explicit Gauge(const std::string& name)
+        : m_slot(MetricsRegistry::Get().Register(MetricsRegistry::Kind::GAUGE, name))
+    {
+    }
+
+    void Set(double value) const { MetricsRegistry::Get().SetGauge(m_slot, value); }
+
+private:
+    uint32_t m_slot;
+};
+
+/**
+ * Value distribution (latencies in integer units, e.g. microseconds).
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram(const std::string& name, const std::string& unit)
+        : m_slot(MetricsRegistry::Get().Register(MetricsRegistry::Kind::HISTOGRAM, name, unit))
+    {
+    }
+
+    void Record(uint64_t value) const { MetricsRegistry::Get().RecordHistogram(m_slot, value); }
+
+    /**
+     * Record a duration in seconds as whole microseconds.
+     */
+    void RecordSeconds(double seconds) const
+    {
+        Record(seconds > 0.0 ? static_cast<uint64_t>(seconds * 1e6 + 0.5) : 0);
+    }
+
+private:
+    uint32_t m_slot;
+};
+
+} // namespace wsn
+} // namespace ns3
+
+#endif // WSN_METRICS_H
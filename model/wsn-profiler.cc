@@ -0,0 +1,175 @@
+#include "wsn-profiler.h"
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+namespace wsn {
+
+namespace {
+
+// Shortest steady_clock interval used to calibrate the TSC
+constexpr auto kMinCalibration = std::chrono::milliseconds(50);
+
+thread_local void *t_shard = nullptr;
+
+// Single-writer update: only the owning thread stores into its shard
+inline void Bump(std::atomic<uint64_t> &cell, uint64_t delta)
+{
+    cell.store(cell.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+} // namespace
+
+thread_local Profiler::Scope *Profiler::Scope::t_current = nullptr;
+
+Profiler &Profiler::Get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : m_originTime(std::chrono::steady_clock::now()),
+      m_originTicks(ReadTicks())
+{
+}
+
+Profiler::Site *Profiler::Register(const std::string &label)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_byLabel.find(label);
+    if (it != m_byLabel.end())
+        return it->second;
+    NS_ABORT_MSG_IF(m_sites.size() >= kMaxSites, "Too many profiler labels: " << label);
+    m_sites.push_back(Site{label, static_cast<uint32_t>(m_sites.size())});
+    m_byLabel.emplace(label, &m_sites.back());
+    return &m_sites.back();
+}
+
+Profiler::Shard &Profiler::GetLocalShard()
+{
+    if (t_shard == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shards.push_back(std::make_unique<Shard>());
+        t_shard = m_shards.back().get();
+    }
+    return *static_cast<Shard *>(t_shard);
+}
+
+void Profiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &shard : m_shards)
+    {
+        for (SiteStats &stats : shard->sites)
+        {
+            stats.calls.store(0, std::memory_order_relaxed);
+            stats.totalTicks.store(0, std::memory_order_relaxed);
+            stats.childTicks.store(0, std::memory_order_relaxed);
+            stats.maxTicks.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Profiler::Add(uint32_t index, uint64_t ticks, uint64_t childTicks)
+{
+    SiteStats &stats = GetLocalShard().sites[index];
+    Bump(stats.calls, 1);
+    Bump(stats.totalTicks, ticks);
+    if (childTicks > 0)
+        Bump(stats.childTicks, childTicks);
+    if (ticks > stats.maxTicks.load(std::memory_order_relaxed))
+        stats.maxTicks.store(ticks, std::memory_order_relaxed);
+}
+
+double Profiler::GetTicksPerSecond() const
+{
+#if defined(__x86_64__) || defined(__i386__)
+    auto elapsed = std::chrono::steady_clock::now() - m_originTime;
+    if (elapsed < kMinCalibration)
+    {
+        std::this_thread::sleep_for(kMinCalibration - elapsed);
+        elapsed = std::chrono::steady_clock::now() - m_originTime;
+    }
+    const uint64_t ticks = ReadTicks() - m_originTicks;
+    return static_cast<double>(ticks) / std::chrono::duration<double>(elapsed).count();
+#else
+    return 1e9;
+#endif
+}
+
+void Profiler::WriteTable(std::ostream &os) const
+{
+    struct Row
+    {
+        std::string label;
+        uint64_t calls;
+        uint64_t total;
+        uint64_t self;
+        uint64_t max;
+    };
+
+    std::vector<Row> rows;
+    uint64_t selfSum = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const Site &site : m_sites)
+        {
+            Row row{site.label, 0, 0, 0, 0};
+            uint64_t child = 0;
+            for (const auto &shard : m_shards)
+            {
+                const SiteStats &stats = shard->sites[site.index];
+                row.calls += stats.calls.load(std::memory_order_relaxed);
+                row.total += stats.totalTicks.load(std::memory_order_relaxed);
+                child += stats.childTicks.load(std::memory_order_relaxed);
+                row.max = std::max(row.max, stats.maxTicks.load(std::memory_order_relaxed));
+            }
+            if (row.calls == 0)
+                continue;
+            row.self = row.total > child ? row.total - child : 0;
+            rows.push_back(row);
+            selfSum += row.self;
+        }
+    }
+    std::sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) { return a.self > b.self; });
+
+    const double msPerTick = 1e3 / GetTicksPerSecond();
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+
+    os << "=== Profile (wall clock) ===\n"
+       << std::left << std::setw(36) << "label" << std::right
+       << std::setw(12) << "calls"
+       << std::setw(12) << "total ms"
+       << std::setw(12) << "self ms"
+       << std::setw(8) << "self %"
+       << std::setw(12) << "avg us"
+       << std::setw(12) << "max us" << "\n"
+       << std::fixed;
+    for (const Row &row : rows)
+    {
+        os << std::left << std::setw(36) << row.label << std::right
+           << std::setw(12) << row.calls
+           << std::setprecision(2)
+           << std::setw(12) << row.total * msPerTick
+           << std::setw(12) << row.self * msPerTick
+           << std::setprecision(1)
+           << std::setw(8) << (selfSum > 0 ? 100.0 * row.self / selfSum : 0.0)
+           << std::setprecision(2)
+           << std::setw(12) << row.total * msPerTick * 1e3 / row.calls
+           << std::setw(12) << row.max * msPerTick * 1e3 << "\n";
+    }
+    os.flush();
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace wsn
+} // namespace ns3
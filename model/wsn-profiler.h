@@ -0,0 +1,183 @@
+#ifndef WSN_PROFILER_H
+#define WSN_PROFILER_H
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace ns3 {
+namespace wsn {
+
+/**
+ * Opt-in wall-clock profiler for the simulation hot path.
+ *
+ * WSN_PROFILE_SCOPE("label") times the rest of the enclosing block and
+ * charges it to the label. Nested scopes are subtracted from their parent,
+ * so each label reports both inclusive and self time; WriteTable() prints
+ * one row per label at the end of a run.
+ *
+ * Built only with WSN_ENABLE_PROFILING (CMake option of the same name);
+ * otherwise the macro expands to nothing and costs nothing. Enabled, a
+ * scope is two TSC reads and a few stores to a per-thread shard.
+ */
+class Profiler
+{
+public:
+    static constexpr uint32_t kMaxSites = 128;
+
+    /**
+     * One profiled label.
+     */
+    struct Site
+    {
+        std::string label;
+        uint32_t index;
+    };
+
+    /**
+     * RAII timer; use through WSN_PROFILE_SCOPE.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(Site* site)
+            : m_site(site),
+              m_parent(t_current),
+              m_childTicks(0)
+        {
+            t_current = this;
+            m_start = ReadTicks();
+        }
+
+        ~Scope()
+        {
+            const uint64_t elapsed = ReadTicks() - m_start;
+            Profiler::Get().Add(m_site->index, elapsed, m_childTicks);
+            if (m_parent)
+                m_parent->m_childTicks += elapsed;
+            t_current = m_parent;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        static thread_local Scope* t_current;
+
+        Site* m_site;
+        Scope* m_parent;
+        uint64_t m_start;
+        uint64_t m_childTicks;
+    };
+
+    static Profiler& Get();
+
+    /**
+     * \return true if the library was built with WSN_ENABLE_PROFILING
+     */
+    static constexpr bool IsEnabled()
+    {
+#ifdef WSN_ENABLE_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Timestamp in profiler ticks (TSC on x86, steady_clock ns elsewhere).
+     */
+    static uint64_t ReadTicks()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+#endif
+    }
+
+    /**
+     * Find or create the site of a label (once per call site).
+     */
+    Site* Register(const std::string& label);
+
+    /**
+     * Zero every site (sites are kept).
+     */
+    void Reset();
+
+    void Add(uint32_t index, uint64_t ticks, uint64_t childTicks);
+
+    /**
+     * Ticks per second, measured against steady_clock since construction.
+     */
+    double GetTicksPerSecond() const;
+
+    /**
+     * Print one row per label: calls, total, self, average and max time,
+     * sorted by self time.
+     */
+    void WriteTable(std::ostream& os) const;
+
+private:
+    struct SiteStats
+    {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> totalTicks{0}; ///< Inclusive
+        std::atomic<uint64_t> childTicks{0}; ///< Spent in nested scopes
+        std::atomic<uint64_t> maxTicks{0};
+    };
+
+    /**
+     * Times of one thread; written only by its thread, summed in
+     * WriteTable(). Owned by the profiler, so it outlives its thread.
+     */
+    struct Shard
+    {
+        std::array<SiteStats, kMaxSites> sites{};
+    };
+
+    Profiler();
+
+    Shard& GetLocalShard();
+
+    mutable std::mutex m_mutex;
+    std::deque<Site> m_sites; ///< Stable addresses for the call sites
+    std::unordered_map<std::string, Site*> m_byLabel;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::chrono::steady_clock::time_point m_originTime;
+    uint64_t m_originTicks;
+};
+
+} // namespace wsn
+} // namespace ns3
+
+#define WSN_PROFILE_CONCAT_(a, b) a##b
+#define WSN_PROFILE_CONCAT(a, b) WSN_PROFILE_CONCAT_(a, b)
+
+#ifdef WSN_ENABLE_PROFILING
+#define WSN_PROFILE_SCOPE(label)                                                              \
+    static ::ns3::wsn::Profiler::Site* const WSN_PROFILE_CONCAT(wsnProfileSite_, __LINE__) = \
+        ::ns3::wsn::Profiler::Get().Register(label);                                          \
+    ::ns3::wsn::Profiler::Scope WSN_PROFILE_CONCAT(wsnProfileScope_, __LINE__)(               \
+        WSN_PROFILE_CONCAT(wsnProfileSite_, __LINE__))
+#else
+#define WSN_PROFILE_SCOPE(label) static_cast<void>(0)
+#endif
+
+#endif // WSN_PROFILER_H
@@ -24,8 +24,29 @@ bool WsnTrace::Open(const std::string &path)
     return true;
 }
 
+bool WsnTrace::Open(const std::string &path,
+                    size_t asyncBufferBytes,
+                    AsyncTraceSink::OverflowPolicy policy)
+{
+    m_path = path;
+    if (!m_async.Open(path, asyncBufferBytes, policy, true))   // append mode
+        return false;
+
+    Trace("==== WSN Trace Start ====");
+    return true;
+}
+
 void WsnTrace::Trace(const std::string &msg)
 {
+    if (m_async.IsOpen())
+    {
+        // One record per line, so a dropped record never splits a line
+        m_line.assign(msg);
+        m_line.push_back('\n');
+        m_async.Write(m_line.data(), m_line.size());
+        return;
+    }
+
     if (!m_ofs.is_open())
     {
         std::cerr << "[WsnTrace] Trace called but file not opened!\n";
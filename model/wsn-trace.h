@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include "ns3/simulator.h"
+#include "async-trace-sink.h"
 
 namespace ns3 {
 namespace wsn {
@@ -18,12 +19,18 @@ public:
     ~WsnTrace();
     
     bool Open(const std::string &path);
+    // Same, but lines go through a background writer thread
+    bool Open(const std::string &path,
+              size_t asyncBufferBytes,
+              AsyncTraceSink::OverflowPolicy policy);
     void Trace(const std::string &msg);
-    bool IsOpen() const { return m_ofs.is_open(); }
+    bool IsOpen() const { return m_ofs.is_open() || m_async.IsOpen(); }
 
 private:
     std::ofstream m_ofs;
     std::string   m_path;
+    AsyncTraceSink m_async;
+    std::string   m_line;   // reused line buffer for the async path
 };
 
 } // namespace wsn